@@ -7,7 +7,9 @@
 /* ============================================================
  * Graph Limits (from GRAPH_MODEL.md)
  * ============================================================ */
-#define MAX_NODES       256
+#ifndef MAX_NODES
+#define MAX_NODES       256     /* Host tools may override; .gph layout depends on it */
+#endif
 #define MAX_IN_PORTS    4
 #define MAX_OUT_PORTS   4
 #define MAX_PARAMS      8
@@ -67,6 +67,8 @@ Status graph_alloc_node(Graph *g, NodeType type, NodeId *out_id)
             for (j = 0; j < MAX_NODE_STATE; j++) {
                 g->nodes[i].state_u32[j] = 0;
             }
+            g->nodes[i].rate_mode = NODE_RATE_EVERY_FRAME;
+            g->nodes[i].rate_div = 1;
 
             g->node_count++;
             *out_id = (NodeId)i;
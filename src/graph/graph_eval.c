@@ -1,16 +1,67 @@
+/* Host node-profiler builds read CLOCK_MONOTONIC (cycles.h); must precede any system header */
+#if defined(LGS_NODE_PROFILER) && !defined(_EE) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include "graph_eval.h"
 #include "graph_core.h"
+#include "graph_validate.h"
 #include "../nodes/node_registry.h"
+#include "../nodes/node_particles.h"
 #include <string.h>
 
+#ifdef LGS_NODE_PROFILER
+#include "../system/cycles.h"
+#endif
+
 /* ============================================================
  * Graph Evaluation
  * ============================================================
  * Memory usage:
- *   OutputBank: ~4KB (MAX_NODES * MAX_OUT_PORTS * sizeof(float))
- *              = 256 * 4 * 4 = 4096 bytes
+ *   OutputBank: ~10.5KB
+ *     out:        MAX_NODES * MAX_OUT_PORTS * 4 = 4096 bytes
+ *     last_in:    MAX_NODES * MAX_IN_PORTS * 4  = 4096 bytes
+ *     dt_accum:   MAX_NODES * 4                 = 1024 bytes
+ *     sink_color: MAX_NODES * 4                 = 1024 bytes
+ *     has_run:    MAX_NODES                     = 256 bytes
  * ============================================================ */
 
+static BranchPolicy s_branch_policy = BRANCH_POLICY_FREEZE;
+static ProbeBank   *s_probes = NULL;
+#ifdef LGS_NODE_PROFILER
+static NodeProfile *s_profile = NULL;
+#endif
+
+/* ============================================================
+ * Branch Policy
+ * ============================================================ */
+void graph_eval_set_branch_policy(BranchPolicy policy)
+{
+    if (policy < BRANCH_POLICY_COUNT) {
+        s_branch_policy = policy;
+    }
+}
+
+BranchPolicy graph_eval_get_branch_policy(void)
+{
+    return s_branch_policy;
+}
+
+/* ============================================================
+ * Instrumentation (probes, profiler)
+ * ============================================================ */
+void graph_eval_set_probes(ProbeBank *probes)
+{
+    s_probes = probes;
+}
+
+#ifdef LGS_NODE_PROFILER
+void graph_eval_set_profile(NodeProfile *profile)
+{
+    s_profile = profile;
+}
+#endif
+
 /* ============================================================
  * Initialize Output Bank
  * ============================================================ */
@@ -19,7 +70,7 @@ void graph_eval_init_outputs(OutputBank *bank)
     if (!bank) {
         return;
     }
-    memset(bank->out, 0, sizeof(bank->out));
+    memset(bank, 0, sizeof(*bank));
 }
 
 /* ============================================================
@@ -81,18 +132,38 @@ static void gather_inputs(const Graph *graph,
     }
 }
 
+/* ============================================================
+ * Pack Sink Color
+ * ============================================================
+ * RECT/CIRCLE/LINE sinks take R, G, B, A on inputs 0-3. Unconnected
+ * inputs mean 1.0 (white, opaque). Gathered here once per run so the
+ * render pass never walks connections.
+ * ============================================================ */
+static uint32_t pack_sink_color(const Node *node, const float inputs[MAX_IN_PORTS])
+{
+    uint32_t packed = 0;
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        float v = (node->inputs[i].src_node != INVALID_NODE_ID) ? inputs[i] : 1.0f;
+        float scale = (i == 3) ? 128.0f : 255.0f;  /* Alpha 0-128 for gsKit */
+        v = LGS_CLAMP(v, 0.0f, 1.0f);
+        packed |= (uint32_t)(v * scale) << (i * 8);
+    }
+    return packed;
+}
+
 /* ============================================================
  * Evaluate Single Node
  * ============================================================ */
 static void eval_node(const Graph *graph,
-                      const OutputBank *bank,
                       NodeId node_id,
+                      const float inputs[MAX_IN_PORTS],
                       float outputs[MAX_OUT_PORTS],
                       const RuntimeContext *ctx)
 {
     const Node *node;
     NodeEvalFunc eval_func;
-    float inputs[MAX_IN_PORTS];
     int i;
 
     /* Zero outputs first */
@@ -100,17 +171,7 @@ static void eval_node(const Graph *graph,
         outputs[i] = 0.0f;
     }
 
-    if (node_id == INVALID_NODE_ID || node_id >= MAX_NODES) {
-        return;
-    }
-
     node = &graph->nodes[node_id];
-    if (node->type == NODE_TYPE_NONE) {
-        return;
-    }
-
-    /* Gather inputs from connected nodes */
-    gather_inputs(graph, bank, node_id, inputs);
 
     /* Get and call eval function */
     eval_func = node_registry_get_eval(node->type);
@@ -120,31 +181,162 @@ static void eval_node(const Graph *graph,
 }
 
 /* ============================================================
- * Evaluate Graph
+ * Update-Rate Check
+ * ============================================================
+ * Returns 1 if the node at plan entry idx is due this frame.
+ * EVERY_FRAME nodes are always due. ON_CHANGE nodes are due on
+ * their first run after a plan change or when any input differs
+ * from the inputs they last ran with.
+ * ============================================================ */
+static int node_is_due(const Node *node,
+                       const EvalPlan *plan,
+                       uint16_t idx,
+                       const OutputBank *bank,
+                       NodeId node_id,
+                       const float inputs[MAX_IN_PORTS],
+                       const RuntimeContext *ctx)
+{
+    int i;
+
+    switch (node->rate_mode) {
+        case NODE_RATE_DIVIDED:
+            if (!bank->has_run[node_id]) {
+                return 1;
+            }
+            return (ctx->frame % graph_node_rate_div(node)) == plan->phase[idx];
+
+        case NODE_RATE_ON_CHANGE:
+            if (!bank->has_run[node_id]) {
+                return 1;
+            }
+            for (i = 0; i < MAX_IN_PORTS; i++) {
+                if (inputs[i] != bank->last_in[node_id][i]) {
+                    return 1;
+                }
+            }
+            return 0;
+
+        default:
+            return 1;
+    }
+}
+
+/* ============================================================
+ * Branch Liveness
+ * ============================================================
+ * Returns 1 if a guarded node's branch is selected this frame: its
+ * guard picks guard_port, and the guard itself is live. Selector
+ * inputs are already evaluated (the plan orders them first).
+ * ============================================================ */
+static int branch_is_live(const Graph *graph,
+                          const EvalPlan *plan,
+                          const OutputBank *bank,
+                          NodeId node_id)
+{
+    NodeId guard = plan->guard_node[node_id];
+    uint8_t port = plan->guard_port[node_id];
+    uint16_t depth;
+
+    for (depth = 0; depth < MAX_NODES && guard != INVALID_NODE_ID; depth++) {
+        const Node *g = &graph->nodes[guard];
+        int sel_port = graph_branch_selector_port(g->type);
+        const Connection *conn;
+        float sel = 0.0f;
+        int open;
+
+        if (sel_port < 0) {
+            return 1;
+        }
+        conn = &g->inputs[sel_port];
+        if (conn->src_node != INVALID_NODE_ID && conn->src_node < MAX_NODES &&
+            conn->src_port < MAX_OUT_PORTS) {
+            sel = bank->out[conn->src_node][conn->src_port];
+        }
+        open = sel >= g->params[0];
+
+        /* SELECT: a (0) when closed, b (1) when open. GATE: signal when open */
+        if (g->type == NODE_TYPE_SELECT) {
+            if ((port == 1) != open) {
+                return 0;
+            }
+        } else if (!open) {
+            return 0;
+        }
+
+        port = plan->guard_port[guard];
+        guard = plan->guard_node[guard];
+    }
+
+    return 1;
+}
+
+/* ============================================================
+ * Begin Evaluation Pass
+ * ============================================================ */
+void graph_eval_begin(const EvalPlan *plan, OutputBank *bank)
+{
+    if (!plan || !bank) {
+        return;
+    }
+
+    /* New plan: every rate-limited node runs once with fresh state */
+    if (bank->plan_serial != plan->serial) {
+        memset(bank->has_run, 0, sizeof(bank->has_run));
+        memset(bank->dt_accum, 0, sizeof(bank->dt_accum));
+        bank->plan_serial = plan->serial;
+    }
+
+    bank->stat_evaluated = 0;
+    bank->stat_rate_skipped = 0;
+    bank->stat_branch_skipped = 0;
+}
+
+/* ============================================================
+ * Evaluate Plan Range
  * ============================================================
- * Iterates through nodes in topological order (from EvalPlan).
+ * Iterates through plan entries [first, last) in topological order.
  * Each node's outputs are computed and stored in OutputBank.
  * ============================================================ */
-void graph_eval(const Graph *graph,
-                const EvalPlan *plan,
-                OutputBank *bank,
-                const RuntimeContext *ctx)
+uint16_t graph_eval_range(const Graph *graph,
+                          const EvalPlan *plan,
+                          OutputBank *bank,
+                          const RuntimeContext *ctx,
+                          uint16_t first,
+                          uint16_t last)
 {
     uint16_t i;
     uint16_t eval_count;
     NodeId node_id;
+    float inputs[MAX_IN_PORTS];
     float outputs[MAX_OUT_PORTS];
+    RuntimeContext rate_ctx;
     int j;
+#ifdef LGS_NODE_PROFILER
+    uint32_t prof_start = 0;
+#endif
 
     if (!graph || !plan || !bank || !ctx) {
-        return;
+        return first;
     }
 
     /* Clamp count to MAX_NODES defensively */
     eval_count = (plan->count <= MAX_NODES) ? plan->count : MAX_NODES;
+    if (last > eval_count) {
+        last = eval_count;
+    }
+
+    if (s_probes) {
+        graph_probe_sync(s_probes, graph, plan);
+    }
+    particles_sync_plan(graph, plan);
+#ifdef LGS_NODE_PROFILER
+    if (s_profile) {
+        node_profile_sync(s_profile, plan);
+    }
+#endif
 
     /* Evaluate nodes in topological order */
-    for (i = 0; i < eval_count; i++) {
+    for (i = first; i < last; i++) {
         node_id = plan->order[i];
 
         /* Skip invalid entries */
@@ -157,14 +349,89 @@ void graph_eval(const Graph *graph,
             continue;
         }
 
-        /* Evaluate this node */
-        eval_node(graph, bank, node_id, outputs, ctx);
+        /* Skip unselected branches (FREEZE: state and dt stop too) */
+        if (plan->guard_node[node_id] != INVALID_NODE_ID &&
+            !(s_branch_policy == BRANCH_POLICY_TICK && plan->branch_tick[node_id]) &&
+            !branch_is_live(graph, plan, bank, node_id)) {
+            bank->stat_branch_skipped++;
+            continue;
+        }
+
+#ifdef LGS_NODE_PROFILER
+        if (s_profile) {
+            prof_start = lgs_cycles_now();
+        }
+#endif
+
+        /* Gather inputs from connected nodes */
+        gather_inputs(graph, bank, node_id, inputs);
+
+        if (graph->nodes[node_id].rate_mode == NODE_RATE_EVERY_FRAME) {
+            eval_node(graph, node_id, inputs, outputs, ctx);
+        } else {
+            /* Rate-limited: accumulate dt until the node runs */
+            bank->dt_accum[node_id] += ctx->dt;
+            if (!node_is_due(&graph->nodes[node_id], plan, i, bank, node_id, inputs, ctx)) {
+                bank->stat_rate_skipped++;
+                continue;
+            }
+
+            rate_ctx = *ctx;
+            rate_ctx.dt = bank->dt_accum[node_id];
+            bank->dt_accum[node_id] = 0.0f;
+            bank->has_run[node_id] = 1;
+            for (j = 0; j < MAX_IN_PORTS; j++) {
+                bank->last_in[node_id][j] = inputs[j];
+            }
+
+            eval_node(graph, node_id, inputs, outputs, &rate_ctx);
+        }
+        bank->stat_evaluated++;
 
         /* Store outputs in bank */
         for (j = 0; j < MAX_OUT_PORTS; j++) {
             bank->out[node_id][j] = outputs[j];
         }
+
+        if (s_probes && graph->nodes[node_id].type == NODE_TYPE_DEBUG) {
+            graph_probe_capture(s_probes, graph, node_id, outputs);
+        }
+
+        switch (node_registry_sink_kind(graph->nodes[node_id].type)) {
+            case SINK_KIND_RECT:
+            case SINK_KIND_CIRCLE:
+            case SINK_KIND_LINE:
+                bank->sink_color[node_id] = pack_sink_color(&graph->nodes[node_id], inputs);
+                break;
+            default:
+                break;
+        }
+
+#ifdef LGS_NODE_PROFILER
+        if (s_profile) {
+            node_profile_record(s_profile, node_id, graph->nodes[node_id].type,
+                                lgs_cycles_now() - prof_start);
+        }
+#endif
     }
+
+    return (last > first) ? last : first;
+}
+
+/* ============================================================
+ * Evaluate Graph
+ * ============================================================ */
+void graph_eval(const Graph *graph,
+                const EvalPlan *plan,
+                OutputBank *bank,
+                const RuntimeContext *ctx)
+{
+    if (!graph || !plan || !bank || !ctx) {
+        return;
+    }
+
+    graph_eval_begin(plan, bank);
+    graph_eval_range(graph, plan, bank, ctx, 0, plan->count);
 }
 
 /* ============================================================
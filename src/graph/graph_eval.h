@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 #include "graph_types.h"
+#include "graph_probe.h"
+#include "graph_profile.h"
 #include "../runtime/runtime.h"
 
 /* ============================================================
@@ -12,6 +14,31 @@
  * Node outputs are stored in the OutputBank for downstream use.
  * ============================================================ */
 
+/* ============================================================
+ * Branch Policy
+ * ============================================================
+ * Nodes consumed only through an unselected SELECT/GATE input are
+ * skipped (see EvalPlan.guard_node). The policy decides what happens
+ * to stateful nodes (NOISE, SMOOTH, DELAY, ...) in a skipped branch.
+ * ============================================================ */
+typedef enum {
+    BRANCH_POLICY_FREEZE = 0,   /* Skip everything; state resumes where it stopped */
+    BRANCH_POLICY_TICK,         /* Keep stateful nodes (and their inputs) running */
+    BRANCH_POLICY_COUNT
+} BranchPolicy;
+
+/* Set/get the policy used by graph_eval (default FREEZE) */
+void graph_eval_set_branch_policy(BranchPolicy policy);
+BranchPolicy graph_eval_get_branch_policy(void);
+
+/* Record DEBUG node outputs into probes (NULL = off, the default) */
+void graph_eval_set_probes(ProbeBank *probes);
+
+#ifdef LGS_NODE_PROFILER
+/* Time every node run into profile (NULL = off, the default) */
+void graph_eval_set_profile(NodeProfile *profile);
+#endif
+
 /* Initialize output bank (zero all outputs).
  * Must be called before graph_eval(). */
 void graph_eval_init_outputs(OutputBank *bank);
@@ -27,6 +54,19 @@ void graph_eval(const Graph *graph,
                 OutputBank *bank,
                 const RuntimeContext *ctx);
 
+/* Evaluate a graph in pieces (used by the time-sliced evaluator).
+ * graph_eval() is graph_eval_begin() + graph_eval_range(0, count).
+ * - begin: resets per-pass stats, and rate state if the plan changed
+ * - range: evaluates plan entries [first, last); returns the next
+ *   entry to evaluate (last clamped to plan->count) */
+void graph_eval_begin(const EvalPlan *plan, OutputBank *bank);
+uint16_t graph_eval_range(const Graph *graph,
+                          const EvalPlan *plan,
+                          OutputBank *bank,
+                          const RuntimeContext *ctx,
+                          uint16_t first,
+                          uint16_t last);
+
 /* Get output value from a specific node/port.
  * Returns 0.0f if node_id is invalid. */
 float graph_eval_get_output(const OutputBank *bank,
@@ -0,0 +1,149 @@
+#include "graph_eval_block.h"
+#include "../nodes/node_registry.h"
+#include <string.h>
+
+/* Shared input block for unconnected ports */
+static const float s_zero_block[EVAL_BLOCK_SIZE];
+
+/* ============================================================
+ * Initialize Block Bank
+ * ============================================================ */
+void graph_eval_block_init(BlockBank *bank)
+{
+    if (!bank) {
+        return;
+    }
+    memset(bank->out, 0, sizeof(bank->out));
+}
+
+/* ============================================================
+ * Get Output Block
+ * ============================================================ */
+const float *graph_eval_block_get_output(const BlockBank *bank,
+                                         NodeId node_id,
+                                         uint8_t port)
+{
+    if (!bank || node_id == INVALID_NODE_ID || node_id >= MAX_NODES ||
+        port >= MAX_OUT_PORTS) {
+        return s_zero_block;
+    }
+    return bank->out[node_id][port];
+}
+
+/* ============================================================
+ * Gather Input Blocks for a Node
+ * ============================================================
+ * Same connection rules as graph_eval's gather_inputs, but hands
+ * out pointers to source blocks instead of copying values.
+ * ============================================================ */
+static void gather_input_blocks(const Graph *graph,
+                                const BlockBank *bank,
+                                const Node *node,
+                                const float *inputs[MAX_IN_PORTS])
+{
+    int i;
+
+    for (i = 0; i < MAX_IN_PORTS; i++) {
+        const Connection *conn = &node->inputs[i];
+        inputs[i] = s_zero_block;
+        if (conn->src_node != INVALID_NODE_ID &&
+            conn->src_node < MAX_NODES &&
+            conn->src_port < MAX_OUT_PORTS &&
+            graph->nodes[conn->src_node].type != NODE_TYPE_NONE) {
+            inputs[i] = bank->out[conn->src_node][conn->src_port];
+        }
+    }
+}
+
+/* ============================================================
+ * Per-Sample Fallback
+ * ============================================================
+ * Runs the scalar eval function once per sample with a context
+ * whose time/dt match that sample.
+ * ============================================================ */
+static void eval_node_per_sample(const Node *node,
+                                 const float *const inputs[MAX_IN_PORTS],
+                                 float *const outputs[MAX_OUT_PORTS],
+                                 uint32_t n,
+                                 const RuntimeContext *ctx)
+{
+    NodeEvalFunc eval_func = node_registry_get_eval(node->type);
+    RuntimeContext sample_ctx = *ctx;
+    float in[MAX_IN_PORTS];
+    float out[MAX_OUT_PORTS];
+    uint32_t s;
+    int p;
+
+    sample_ctx.dt = ctx->sample_dt;
+
+    for (s = 0; s < n; s++) {
+        sample_ctx.time = ctx->time + (float)s * ctx->sample_dt;
+
+        for (p = 0; p < MAX_IN_PORTS; p++) {
+            in[p] = inputs[p][s];
+        }
+        for (p = 0; p < MAX_OUT_PORTS; p++) {
+            out[p] = 0.0f;
+        }
+
+        eval_func(node, in, out, &sample_ctx);
+
+        for (p = 0; p < MAX_OUT_PORTS; p++) {
+            outputs[p][s] = out[p];
+        }
+    }
+}
+
+/* ============================================================
+ * Evaluate Graph for One Block
+ * ============================================================ */
+void graph_eval_block(const Graph *graph,
+                      const EvalPlan *plan,
+                      BlockBank *bank,
+                      const RuntimeContext *ctx,
+                      uint32_t n)
+{
+    const float *inputs[MAX_IN_PORTS];
+    float *outputs[MAX_OUT_PORTS];
+    RuntimeContext block_ctx;
+    uint16_t i, eval_count;
+    int p;
+
+    if (!graph || !plan || !bank || !ctx || n == 0) {
+        return;
+    }
+    if (n > EVAL_BLOCK_SIZE) {
+        n = EVAL_BLOCK_SIZE;
+    }
+
+    block_ctx = *ctx;
+    block_ctx.block_size = (uint16_t)n;
+
+    eval_count = (plan->count <= MAX_NODES) ? plan->count : MAX_NODES;
+
+    for (i = 0; i < eval_count; i++) {
+        NodeId node_id = plan->order[i];
+        const Node *node;
+        NodeBlockFunc block_func;
+
+        if (node_id == INVALID_NODE_ID || node_id >= MAX_NODES) {
+            continue;
+        }
+        node = &graph->nodes[node_id];
+        if (node->type == NODE_TYPE_NONE) {
+            continue;
+        }
+
+        gather_input_blocks(graph, bank, node, inputs);
+        for (p = 0; p < MAX_OUT_PORTS; p++) {
+            outputs[p] = bank->out[node_id][p];
+        }
+
+        block_func = node_registry_get_block_eval(node->type);
+        if (block_func) {
+            block_func(node, inputs, outputs, n, &block_ctx);
+        } else {
+            eval_node_per_sample(node, inputs, outputs, n, &block_ctx);
+        }
+    }
+}
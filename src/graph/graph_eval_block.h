@@ -0,0 +1,46 @@
+#ifndef GRAPH_EVAL_BLOCK_H
+#define GRAPH_EVAL_BLOCK_H
+
+#include <stdint.h>
+#include "graph_types.h"
+#include "../runtime/runtime.h"
+
+/* ============================================================
+ * Block Evaluation (audio-style)
+ * ============================================================
+ * Evaluates the graph for a block of up to EVAL_BLOCK_SIZE samples
+ * at once. Each port carries one sample per lane; node types with a
+ * block kernel are dispatched once per block, others fall back to
+ * calling their per-sample eval function for every sample.
+ * Node update rates (NodeRateMode) and branch guards are ignored:
+ * every node runs every block.
+ *
+ * Memory usage:
+ *   BlockBank: MAX_NODES * MAX_OUT_PORTS * EVAL_BLOCK_SIZE * 4
+ *            = 256 * 4 * 64 * 4 = 256KB
+ * Intended for host runners; the frame loop keeps using OutputBank.
+ * ============================================================ */
+#define EVAL_BLOCK_SIZE 64
+
+typedef struct {
+    float out[MAX_NODES][MAX_OUT_PORTS][EVAL_BLOCK_SIZE];
+} BlockBank;
+
+/* Zero all block outputs. Must be called before graph_eval_block(). */
+void graph_eval_block_init(BlockBank *bank);
+
+/* Evaluate n samples (clamped to EVAL_BLOCK_SIZE) in plan order.
+ * ctx->time is the time of sample 0 and ctx->sample_dt the step
+ * between samples (must be > 0). ctx->block_size is ignored. */
+void graph_eval_block(const Graph *graph,
+                      const EvalPlan *plan,
+                      BlockBank *bank,
+                      const RuntimeContext *ctx,
+                      uint32_t n);
+
+/* Get a node output block. Returns a block of zeros if invalid. */
+const float *graph_eval_block_get_output(const BlockBank *bank,
+                                         NodeId node_id,
+                                         uint8_t port);
+
+#endif /* GRAPH_EVAL_BLOCK_H */
@@ -0,0 +1,204 @@
+#include "graph_eval_fixed.h"
+#include "graph_eval.h"
+#include <string.h>
+
+/* ============================================================
+ * Helpers
+ * ============================================================ */
+static void stepper_keep_prev(EvalStepper *st)
+{
+    memcpy(st->prev, st->work.out, sizeof(st->prev));
+    memcpy(st->prev_color, st->work.sink_color, sizeof(st->prev_color));
+}
+
+/* Blend two packed colors channel by channel, a in 0..256 */
+static uint32_t stepper_blend_color(uint32_t c0, uint32_t c1, uint32_t a)
+{
+    uint32_t out = 0;
+    int shift;
+
+    for (shift = 0; shift < 32; shift += 8) {
+        uint32_t v0 = (c0 >> shift) & 0xFFu;
+        uint32_t v1 = (c1 >> shift) & 0xFFu;
+        out |= ((v0 * (256u - a) + v1 * a) >> 8) << shift;
+    }
+    return out;
+}
+
+/* ============================================================
+ * Simulation Rate
+ * ============================================================ */
+static uint16_t s_sim_rate = EVAL_STEP_RATE_FRAME;
+
+void graph_eval_set_sim_rate(uint16_t rate_hz)
+{
+    s_sim_rate = rate_hz;
+}
+
+uint16_t graph_eval_get_sim_rate(void)
+{
+    return s_sim_rate;
+}
+
+/* ============================================================
+ * Initialize / Reset
+ * ============================================================ */
+void eval_stepper_init(EvalStepper *st, uint16_t rate_hz)
+{
+    RuntimeContext ctx;
+
+    if (!st) {
+        return;
+    }
+
+    memset(st, 0, sizeof(*st));
+    graph_eval_init_outputs(&st->work);
+    runtime_init(&ctx);
+    eval_stepper_reset(st, &st->work, &ctx, rate_hz);
+}
+
+void eval_stepper_reset(EvalStepper *st,
+                        const OutputBank *seed,
+                        const RuntimeContext *ctx,
+                        uint16_t rate_hz)
+{
+    if (!st || !seed || !ctx) {
+        return;
+    }
+
+    if (seed != &st->work) {
+        st->work = *seed;
+    }
+    st->view = st->work;
+    stepper_keep_prev(st);
+    st->plan_serial = st->work.plan_serial;
+
+    /* Steps carry on from the last frame evaluated before ctx */
+    st->step_ctx = *ctx;
+    st->step_ctx.frame = ctx->frame - 1u;
+    st->step_ctx.time = ctx->time - ctx->dt;
+    st->pending_pressed = 0;
+    st->pending_released = 0;
+    eval_stepper_set_rate(st, rate_hz);
+}
+
+void eval_stepper_set_rate(EvalStepper *st, uint16_t rate_hz)
+{
+    if (!st) {
+        return;
+    }
+
+    st->rate_hz = rate_hz;
+    runtime_stepper_init(&st->clock, rate_hz, EVAL_STEP_MAX_CATCHUP);
+}
+
+void eval_stepper_handoff(const EvalStepper *st, RuntimeContext *ctx)
+{
+    if (!st || !ctx) {
+        return;
+    }
+
+    ctx->frame = st->step_ctx.frame + 1u;
+    ctx->time = st->step_ctx.time + ctx->dt;
+}
+
+/* ============================================================
+ * View (blend of the last two steps)
+ * ============================================================ */
+static void stepper_build_view(EvalStepper *st, const EvalPlan *plan)
+{
+    OutputBank *view = &st->view;
+    const OutputBank *work = &st->work;
+    float a = st->clock.alpha;
+    uint32_t a256 = (uint32_t)(a * 256.0f);
+    uint16_t count = (plan->sink_count <= MAX_NODES) ? plan->sink_count : MAX_NODES;
+    uint16_t i;
+    int p;
+
+    /* Plan changed with no step run since: prev and work hold the old
+     * plan's outputs, so show work as is and leave the next step to
+     * restart blending */
+    if (plan->serial != st->plan_serial) {
+        *view = *work;
+        stepper_keep_prev(st);
+        return;
+    }
+
+    view->stat_evaluated = work->stat_evaluated;
+    view->stat_rate_skipped = work->stat_rate_skipped;
+    view->stat_branch_skipped = work->stat_branch_skipped;
+
+    for (i = 0; i < count; i++) {
+        NodeId id = plan->sinks[i].node;
+
+        if (id >= MAX_NODES) {
+            continue;
+        }
+        for (p = 0; p < MAX_OUT_PORTS; p++) {
+            float v0 = st->prev[id][p];
+            view->out[id][p] = v0 + (work->out[id][p] - v0) * a;
+        }
+        view->sink_color[id] = stepper_blend_color(st->prev_color[id], work->sink_color[id], a256);
+    }
+}
+
+/* ============================================================
+ * Step (one frame's worth of simulation)
+ * ============================================================ */
+uint16_t eval_stepper_step(EvalStepper *st,
+                           const Graph *graph,
+                           const EvalPlan *plan,
+                           const RuntimeContext *ctx)
+{
+    RuntimeContext *sc;
+    uint16_t steps, i;
+
+    if (!st || !graph || !plan || !ctx) {
+        return 0;
+    }
+
+    sc = &st->step_ctx;
+    st->pending_pressed |= ctx->buttons_pressed;
+    st->pending_released |= ctx->buttons_released;
+
+    steps = runtime_stepper_advance(&st->clock, ctx->dt);
+    for (i = 0; i < steps; i++) {
+        int new_plan = (plan->serial != st->plan_serial);
+
+        /* Pad as of this frame; edges go to the first step that runs */
+        sc->pad_lx = ctx->pad_lx;
+        sc->pad_ly = ctx->pad_ly;
+        sc->pad_rx = ctx->pad_rx;
+        sc->pad_ry = ctx->pad_ry;
+        sc->pad_l2 = ctx->pad_l2;
+        sc->pad_r2 = ctx->pad_r2;
+        sc->buttons_held = ctx->buttons_held;
+        sc->buttons_pressed = st->pending_pressed;
+        sc->buttons_released = st->pending_released;
+        st->pending_pressed = 0;
+        st->pending_released = 0;
+
+        sc->dt = st->clock.step_dt;
+        sc->time += sc->dt;
+        sc->frame++;
+
+        if (!new_plan) {
+            stepper_keep_prev(st);
+        }
+        graph_eval(graph, plan, &st->work, sc);
+
+        /* Node IDs may mean other nodes now: don't blend across */
+        if (new_plan) {
+            stepper_keep_prev(st);
+            st->plan_serial = plan->serial;
+        }
+    }
+
+    stepper_build_view(st, plan);
+    return steps;
+}
+
+const OutputBank *eval_stepper_view(const EvalStepper *st)
+{
+    return st ? &st->view : NULL;
+}
@@ -0,0 +1,89 @@
+#ifndef GRAPH_EVAL_FIXED_H
+#define GRAPH_EVAL_FIXED_H
+
+#include <stdint.h>
+#include "graph_types.h"
+#include "../runtime/runtime.h"
+
+/* ============================================================
+ * Fixed-Step Evaluation
+ * ============================================================
+ * Evaluates the graph at a fixed simulation rate instead of once
+ * per rendered frame, so stateful nodes (SMOOTH, NOISE, PULSE,
+ * DELAY, PARTICLES) behave the same at 50Hz, 60Hz and under frame
+ * drops. A RuntimeStepper turns each frame's dt into whole steps;
+ * every step runs with dt = 1/rate, and its frame number counts
+ * steps (DELAY and divided update rates count steps, too). Step
+ * frame and time carry on from the frame before stepping started,
+ * and eval_stepper_handoff() carries them back into the runtime
+ * context when stepping stops, so the frame count never runs
+ * backwards across a mode or rate change.
+ *
+ * Renderers read the view bank: the sink outputs and colors of the
+ * last two steps blended by how far the clock is past the last one,
+ * so animation stays smooth when steps and frames don't line up.
+ * Nothing is blended across a plan change.
+ * Only sinks and stats are kept in the view. Node state outside the
+ * bank (PARTICLES pools) is stepped at the fixed rate but drawn as
+ * of the last step.
+ *
+ * Button edges that arrive in a frame with no step are held for the
+ * next step; a frame with several steps reports them to the first.
+ *
+ * Memory usage:
+ *   EvalStepper: 2 * sizeof(OutputBank) + MAX_NODES * (MAX_OUT_PORTS + 1) * 4
+ *              + ctx = ~26KB
+ * ============================================================ */
+
+#define EVAL_STEP_RATE_FRAME    0       /* No fixed step: evaluate once per frame */
+#define EVAL_STEP_MAX_CATCHUP   8       /* Steps per frame before time is dropped */
+
+/* Set/get the simulation rate in Hz the app steps at
+ * (EVAL_STEP_RATE_FRAME, the default, evaluates once per frame) */
+void graph_eval_set_sim_rate(uint16_t rate_hz);
+uint16_t graph_eval_get_sim_rate(void);
+
+typedef struct {
+    OutputBank     work;            /* Latest step (owns rate state) */
+    OutputBank     view;            /* Interpolated sinks (read by renderers) */
+    float          prev[MAX_NODES][MAX_OUT_PORTS]; /* Outputs of the step before */
+    uint32_t       prev_color[MAX_NODES];          /* Sink colors of the step before */
+    RuntimeContext step_ctx;        /* Context of the latest step */
+    RuntimeStepper clock;
+    uint32_t       plan_serial;     /* Plan prev belongs to */
+    uint16_t       rate_hz;         /* Step rate */
+    uint16_t       pending_pressed; /* Button edges no step has seen yet */
+    uint16_t       pending_released;
+    uint8_t        _pad[2];
+} EvalStepper;
+
+/* Clear both banks and run at rate_hz */
+void eval_stepper_init(EvalStepper *st, uint16_t rate_hz);
+
+/* Start stepping at rate_hz from an existing bank and the current
+ * context (the first step follows the frame before ctx). seed may be
+ * the stepper's own work bank. */
+void eval_stepper_reset(EvalStepper *st,
+                        const OutputBank *seed,
+                        const RuntimeContext *ctx,
+                        uint16_t rate_hz);
+
+/* Change the step rate, keeping both banks and the step frame/time */
+void eval_stepper_set_rate(EvalStepper *st, uint16_t rate_hz);
+
+/* Stepping stops: make ctx (already updated for this frame) the
+ * frame after the last step */
+void eval_stepper_handoff(const EvalStepper *st, RuntimeContext *ctx);
+
+/* Run the steps due for one frame (ctx->dt is the frame's dt, pad
+ * state is copied into each step) and rebuild the view.
+ * Returns the number of steps run (0 when the frame was short). */
+uint16_t eval_stepper_step(EvalStepper *st,
+                           const Graph *graph,
+                           const EvalPlan *plan,
+                           const RuntimeContext *ctx);
+
+/* Interpolated bank for renderers */
+const OutputBank *eval_stepper_view(const EvalStepper *st);
+
+#endif /* GRAPH_EVAL_FIXED_H */
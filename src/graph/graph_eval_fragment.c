@@ -0,0 +1,314 @@
+#include "graph_eval_fragment.h"
+#include "../nodes/node_registry.h"
+#include <string.h>
+
+/* Shared input block for unconnected ports */
+static const float s_zero_block[EVAL_BLOCK_SIZE];
+
+#define FRAG_NO_SLOT 0xFFFFu
+
+/* ============================================================
+ * Helper: Valid source of a connection, or INVALID_NODE_ID
+ * ============================================================ */
+static NodeId conn_source(const Graph *g, const Connection *conn)
+{
+    if (conn->src_node == INVALID_NODE_ID || conn->src_node >= MAX_NODES ||
+        conn->src_port >= MAX_OUT_PORTS ||
+        g->nodes[conn->src_node].type == NODE_TYPE_NONE) {
+        return INVALID_NODE_ID;
+    }
+    return conn->src_node;
+}
+
+/* ============================================================
+ * Build Fragment Plan
+ * ============================================================
+ * 1. Forward pass in plan order: a node varies if it is a UV/PIXEL
+ *    source or reads a varying node.
+ * 2. Backward pass: keep varying nodes that FRAG_OUT depends on.
+ * 3. Assign lane slots in plan order and resolve every input to
+ *    lanes, a deduplicated uniform slot, or zeros.
+ * ============================================================ */
+Status graph_build_fragment_plan(const Graph *g, const EvalPlan *plan, FragmentPlan *frag)
+{
+    uint8_t varying[MAX_NODES];
+    uint8_t needed[MAX_NODES];
+    uint16_t slot_of[MAX_NODES];
+    uint16_t uniform_of[MAX_NODES][MAX_OUT_PORTS];
+    NodeId output = INVALID_NODE_ID;
+    uint16_t i, count;
+    int p;
+
+    if (!g || !plan || !frag) {
+        return STATUS_ERR_INVALID_NODE;
+    }
+
+    memset(frag, 0, sizeof(*frag));
+    frag->output = INVALID_NODE_ID;
+
+    for (i = 0; i < plan->sink_count; i++) {
+        if (plan->sinks[i].kind == SINK_KIND_FRAGMENT) {
+            output = plan->sinks[i].node;
+            break;
+        }
+    }
+    if (output == INVALID_NODE_ID) {
+        return STATUS_ERR_NO_SINK;
+    }
+
+    count = (plan->count <= MAX_NODES) ? plan->count : MAX_NODES;
+    memset(varying, 0, sizeof(varying));
+    memset(needed, 0, sizeof(needed));
+
+    for (i = 0; i < count; i++) {
+        NodeId id = plan->order[i];
+        const Node *node;
+
+        if (id == INVALID_NODE_ID || id >= MAX_NODES) {
+            continue;
+        }
+        node = &g->nodes[id];
+        if (node->type == NODE_TYPE_UV || node->type == NODE_TYPE_PIXEL || id == output) {
+            varying[id] = 1;
+            continue;
+        }
+        for (p = 0; p < MAX_IN_PORTS; p++) {
+            NodeId src = conn_source(g, &node->inputs[p]);
+            if (src != INVALID_NODE_ID && varying[src]) {
+                varying[id] = 1;
+                break;
+            }
+        }
+    }
+
+    needed[output] = 1;
+    for (i = count; i-- > 0;) {
+        NodeId id = plan->order[i];
+
+        if (id == INVALID_NODE_ID || id >= MAX_NODES || !needed[id]) {
+            continue;
+        }
+        for (p = 0; p < MAX_IN_PORTS; p++) {
+            NodeId src = conn_source(g, &g->nodes[id].inputs[p]);
+            if (src != INVALID_NODE_ID && varying[src]) {
+                needed[src] = 1;
+            }
+        }
+    }
+
+    /* Slots in plan order; FRAG_OUT has no consumers, so it is last */
+    for (i = 0; i < MAX_NODES; i++) {
+        slot_of[i] = FRAG_NO_SLOT;
+    }
+    for (i = 0; i < count; i++) {
+        NodeId id = plan->order[i];
+
+        if (id == INVALID_NODE_ID || id >= MAX_NODES || !needed[id]) {
+            continue;
+        }
+        if (node_registry_is_stateful(g->nodes[id].type)) {
+            return STATUS_ERR_VALIDATION_FAIL;
+        }
+        slot_of[id] = frag->count;
+        frag->node[frag->count++] = id;
+    }
+    frag->output = output;
+    frag->output_slot = slot_of[output];
+
+    memset(uniform_of, 0xFF, sizeof(uniform_of));
+    for (i = 0; i < frag->count; i++) {
+        const Node *node = &g->nodes[frag->node[i]];
+
+        for (p = 0; p < MAX_IN_PORTS; p++) {
+            const Connection *conn = &node->inputs[p];
+            FragmentInput *in = &frag->input[i][p];
+            NodeId src = conn_source(g, conn);
+
+            if (src == INVALID_NODE_ID) {
+                in->src = FRAG_SRC_ZERO;
+            } else if (slot_of[src] != FRAG_NO_SLOT) {
+                in->src = FRAG_SRC_LANES;
+                in->port = conn->src_port;
+                in->index = slot_of[src];
+            } else {
+                uint16_t *u = &uniform_of[src][conn->src_port];
+                if (*u == FRAG_NO_SLOT) {
+                    *u = frag->uniform_count;
+                    frag->uniform_node[frag->uniform_count] = src;
+                    frag->uniform_port[frag->uniform_count] = conn->src_port;
+                    frag->uniform_count++;
+                }
+                in->src = FRAG_SRC_UNIFORM;
+                in->index = *u;
+            }
+        }
+    }
+
+    /* A per-pixel selector has no single frame value to gate on */
+    for (i = 0; i < MAX_NODES; i++) {
+        NodeId guard = plan->guard_node[i];
+        if (guard != INVALID_NODE_ID && guard < MAX_NODES && varying[guard]) {
+            frag->unguard[frag->unguard_count++] = i;
+        }
+    }
+
+    frag->serial = plan->serial;
+    return STATUS_OK;
+}
+
+/* ============================================================
+ * Frame-Pass Plan
+ * ============================================================ */
+void graph_fragment_uniform_plan(const FragmentPlan *frag,
+                                 const EvalPlan *plan,
+                                 EvalPlan *out)
+{
+    uint16_t i;
+
+    if (!frag || !plan || !out) {
+        return;
+    }
+
+    *out = *plan;
+    if (frag->serial != plan->serial) {
+        return;
+    }
+    for (i = 0; i < frag->unguard_count; i++) {
+        NodeId id = frag->unguard[i];
+        if (out->guard_node[id] != INVALID_NODE_ID) {
+            out->guard_node[id] = INVALID_NODE_ID;
+            if (out->guarded_count > 0) {
+                out->guarded_count--;
+            }
+        }
+    }
+}
+
+/* ============================================================
+ * Load Uniforms
+ * ============================================================ */
+void graph_fragment_load_uniforms(const FragmentPlan *frag,
+                                  const OutputBank *bank,
+                                  FragmentUniforms *uniforms)
+{
+    uint16_t u;
+    int i;
+
+    if (!frag || !bank || !uniforms) {
+        return;
+    }
+    for (u = 0; u < frag->uniform_count; u++) {
+        float value = bank->out[frag->uniform_node[u]][frag->uniform_port[u]];
+        float *block = uniforms->block[u];
+        for (i = 0; i < EVAL_BLOCK_SIZE; i++) {
+            block[i] = value;
+        }
+    }
+}
+
+/* ============================================================
+ * Per-Pixel Fallback
+ * ============================================================
+ * Runs the scalar eval function once per lane with frag_x set to
+ * that lane's pixel.
+ * ============================================================ */
+static void eval_node_per_pixel(const Node *node,
+                                const float *const inputs[MAX_IN_PORTS],
+                                float *const outputs[MAX_OUT_PORTS],
+                                uint32_t n,
+                                const RuntimeContext *ctx)
+{
+    NodeEvalFunc eval_func = node_registry_get_eval(node->type);
+    RuntimeContext pixel_ctx = *ctx;
+    float in[MAX_IN_PORTS];
+    float out[MAX_OUT_PORTS];
+    uint32_t s;
+    int p;
+
+    for (s = 0; s < n; s++) {
+        pixel_ctx.frag_x = (uint16_t)(ctx->frag_x + s);
+
+        for (p = 0; p < MAX_IN_PORTS; p++) {
+            in[p] = inputs[p][s];
+        }
+        for (p = 0; p < MAX_OUT_PORTS; p++) {
+            out[p] = 0.0f;
+        }
+
+        eval_func(node, in, out, &pixel_ctx);
+
+        for (p = 0; p < MAX_OUT_PORTS; p++) {
+            outputs[p][s] = out[p];
+        }
+    }
+}
+
+/* ============================================================
+ * Evaluate One Block of Pixels
+ * ============================================================ */
+void graph_eval_fragment(const Graph *graph,
+                         const FragmentPlan *frag,
+                         const FragmentUniforms *uniforms,
+                         FragmentBank *bank,
+                         const RuntimeContext *ctx,
+                         uint32_t n)
+{
+    const float *inputs[MAX_IN_PORTS];
+    float *outputs[MAX_OUT_PORTS];
+    RuntimeContext block_ctx;
+    uint16_t i;
+    int p;
+
+    if (!graph || !frag || !uniforms || !bank || !ctx || n == 0) {
+        return;
+    }
+    if (n > EVAL_BLOCK_SIZE) {
+        n = EVAL_BLOCK_SIZE;
+    }
+
+    block_ctx = *ctx;
+    block_ctx.block_size = (uint16_t)n;
+
+    for (i = 0; i < frag->count; i++) {
+        const Node *node = &graph->nodes[frag->node[i]];
+        NodeBlockFunc block_func;
+
+        for (p = 0; p < MAX_IN_PORTS; p++) {
+            const FragmentInput *in = &frag->input[i][p];
+            switch (in->src) {
+                case FRAG_SRC_LANES:
+                    inputs[p] = bank->out[in->index][in->port];
+                    break;
+                case FRAG_SRC_UNIFORM:
+                    inputs[p] = uniforms->block[in->index];
+                    break;
+                default:
+                    inputs[p] = s_zero_block;
+                    break;
+            }
+        }
+        for (p = 0; p < MAX_OUT_PORTS; p++) {
+            outputs[p] = bank->out[i][p];
+        }
+
+        block_func = node_registry_get_block_eval(node->type);
+        if (block_func) {
+            block_func(node, inputs, outputs, n, &block_ctx);
+        } else {
+            eval_node_per_pixel(node, inputs, outputs, n, &block_ctx);
+        }
+    }
+}
+
+/* ============================================================
+ * Get Color Block
+ * ============================================================ */
+const float *graph_eval_fragment_color(const FragmentBank *bank,
+                                       const FragmentPlan *frag,
+                                       uint8_t channel)
+{
+    if (!bank || !frag || frag->output == INVALID_NODE_ID || channel >= 3) {
+        return s_zero_block;
+    }
+    return bank->out[frag->output_slot][channel];
+}
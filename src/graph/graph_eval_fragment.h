@@ -0,0 +1,115 @@
+#ifndef GRAPH_EVAL_FRAGMENT_H
+#define GRAPH_EVAL_FRAGMENT_H
+
+#include <stdint.h>
+#include "graph_types.h"
+#include "graph_eval_block.h"
+#include "../runtime/runtime.h"
+
+/* ============================================================
+ * Fragment Evaluation (per-pixel graphs)
+ * ============================================================
+ * Evaluates the part of a graph that feeds its FRAG_OUT node once
+ * per pixel, EVAL_BLOCK_SIZE pixels of one row at a time. Each port
+ * carries one value per pixel (SoA lanes), so block kernels run as
+ * straight loops across pixels.
+ *
+ * Nodes are split when the plan is built:
+ * - varying: UV/PIXEL sources, nodes depending on them, and the
+ *   FRAG_OUT node itself; only those feeding FRAG_OUT are kept.
+ *   They run per pixel and must be stateless.
+ * - uniform: everything else. They run once per frame in the normal
+ *   graph_eval pass and their outputs are broadcast to every lane.
+ *
+ * Branch guards are not applied per pixel. Nodes guarded by a
+ * varying SELECT/GATE must stay current in frame mode, so the frame
+ * pass runs with graph_fragment_uniform_plan()'s copy of the plan,
+ * which drops those guards; the EvalPlan itself is left intact.
+ *
+ * Evaluation only reads the graph, plan and uniforms, so several
+ * threads can run rows at once, each with its own FragmentBank.
+ *
+ * Memory usage:
+ *   FragmentPlan:     ~8KB
+ *   FragmentUniforms: FRAG_MAX_UNIFORMS * EVAL_BLOCK_SIZE * 4 = 256KB
+ *   FragmentBank:     MAX_NODES * MAX_OUT_PORTS * EVAL_BLOCK_SIZE * 4
+ *                   = 256KB (one per thread)
+ * Host renderers only; the PS2 preview does not draw FRAG_OUT.
+ * ============================================================ */
+
+/* Distinct uniform (node, port) outputs read by varying nodes */
+#define FRAG_MAX_UNIFORMS   (MAX_NODES * MAX_IN_PORTS)
+
+/* Where a varying node input reads from */
+typedef enum {
+    FRAG_SRC_ZERO = 0,          /* Unconnected: zeros */
+    FRAG_SRC_LANES,             /* Varying node: index = slot */
+    FRAG_SRC_UNIFORM            /* Uniform output: index = uniform slot */
+} FragSrc;
+
+typedef struct {
+    uint8_t  src;               /* FragSrc */
+    uint8_t  port;              /* Source output port (FRAG_SRC_LANES) */
+    uint16_t index;
+} FragmentInput;
+
+typedef struct {
+    /* Varying nodes in plan order; slot i evaluates node[i] */
+    NodeId        node[MAX_NODES];
+    FragmentInput input[MAX_NODES][MAX_IN_PORTS];
+    uint16_t      count;
+
+    /* Uniform outputs broadcast to lanes */
+    NodeId        uniform_node[FRAG_MAX_UNIFORMS];
+    uint8_t       uniform_port[FRAG_MAX_UNIFORMS];
+    uint16_t      uniform_count;
+
+    /* Nodes whose branch guard is a varying SELECT/GATE */
+    NodeId        unguard[MAX_NODES];
+    uint16_t      unguard_count;
+
+    NodeId        output;       /* FRAG_OUT node */
+    uint16_t      output_slot;  /* Its slot (always the last one) */
+    uint32_t      serial;       /* EvalPlan serial this was built from */
+} FragmentPlan;
+
+typedef struct {
+    float block[FRAG_MAX_UNIFORMS][EVAL_BLOCK_SIZE];
+} FragmentUniforms;
+
+typedef struct {
+    float out[MAX_NODES][MAX_OUT_PORTS][EVAL_BLOCK_SIZE];
+} FragmentBank;
+
+/* Build the per-pixel plan for the first FRAG_OUT sink of plan.
+ * Returns STATUS_ERR_NO_SINK if there is no FRAG_OUT node and
+ * STATUS_ERR_VALIDATION_FAIL if a varying node is stateful. */
+Status graph_build_fragment_plan(const Graph *g, const EvalPlan *plan, FragmentPlan *frag);
+
+/* Copy plan to out without the guards that depend on a varying
+ * selector (the plan for the frame pass that feeds the uniforms).
+ * out is a plain copy if frag was built from another plan. */
+void graph_fragment_uniform_plan(const FragmentPlan *frag,
+                                 const EvalPlan *plan,
+                                 EvalPlan *out);
+
+/* Broadcast this frame's uniform outputs (after graph_eval) */
+void graph_fragment_load_uniforms(const FragmentPlan *frag,
+                                  const OutputBank *bank,
+                                  FragmentUniforms *uniforms);
+
+/* Evaluate n pixels (clamped to EVAL_BLOCK_SIZE) starting at
+ * (ctx->frag_x, ctx->frag_y) of a frag_width x frag_height image */
+void graph_eval_fragment(const Graph *graph,
+                         const FragmentPlan *frag,
+                         const FragmentUniforms *uniforms,
+                         FragmentBank *bank,
+                         const RuntimeContext *ctx,
+                         uint32_t n);
+
+/* FRAG_OUT channel block (0 = r, 1 = g, 2 = b), values 0..1 */
+const float *graph_eval_fragment_color(const FragmentBank *bank,
+                                       const FragmentPlan *frag,
+                                       uint8_t channel);
+
+#endif /* GRAPH_EVAL_FRAGMENT_H */
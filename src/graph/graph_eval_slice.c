@@ -0,0 +1,144 @@
+/* Host builds read CLOCK_MONOTONIC (cycles.h); must precede any system header */
+#if !defined(_EE) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "graph_eval_slice.h"
+#include "graph_eval.h"
+#include "../system/cycles.h"
+#include <string.h>
+
+/* ============================================================
+ * Initialize Slicer
+ * ============================================================ */
+void eval_slicer_init(EvalSlicer *slicer, uint32_t budget_us)
+{
+    if (!slicer) {
+        return;
+    }
+
+    memset(slicer, 0, sizeof(*slicer));
+    graph_eval_init_outputs(&slicer->work);
+    graph_eval_init_outputs(&slicer->front);
+    slicer->latency_frames = 1;
+    eval_slicer_set_budget(slicer, budget_us);
+}
+
+/* ============================================================
+ * Set Budget
+ * ============================================================ */
+void eval_slicer_set_budget(EvalSlicer *slicer, uint32_t budget_us)
+{
+    if (!slicer) {
+        return;
+    }
+    slicer->budget_cycles = lgs_cycles_from_us(budget_us);
+}
+
+/* ============================================================
+ * Reset (seed banks, drop pass in progress)
+ * ============================================================ */
+void eval_slicer_reset(EvalSlicer *slicer, const OutputBank *seed)
+{
+    if (!slicer) {
+        return;
+    }
+
+    if (seed) {
+        slicer->work = *seed;
+        slicer->front = *seed;
+    }
+    slicer->in_pass = 0;
+    slicer->cursor = 0;
+    slicer->frames_in_pass = 0;
+    slicer->dt_since_pass = 0.0f;
+    slicer->latency_frames = 1;
+}
+
+/* ============================================================
+ * Start a Pass
+ * ============================================================
+ * Captures the context the whole pass runs with.
+ * ============================================================ */
+static void slicer_begin_pass(EvalSlicer *slicer,
+                              const EvalPlan *plan,
+                              const RuntimeContext *ctx)
+{
+    slicer->pass_ctx = *ctx;
+    slicer->pass_ctx.dt = slicer->dt_since_pass;
+    slicer->pass_ctx.frame = slicer->pass_count;
+    slicer->dt_since_pass = 0.0f;
+
+    slicer->cursor = 0;
+    slicer->frames_in_pass = 0;
+    slicer->plan_serial = plan->serial;
+    slicer->in_pass = 1;
+
+    graph_eval_begin(plan, &slicer->work);
+}
+
+/* ============================================================
+ * Step (one frame's worth of evaluation)
+ * ============================================================ */
+int eval_slicer_step(EvalSlicer *slicer,
+                     const Graph *graph,
+                     const EvalPlan *plan,
+                     const RuntimeContext *ctx)
+{
+    uint16_t eval_count;
+    uint32_t start;
+
+    if (!slicer || !graph || !plan || !ctx) {
+        return 0;
+    }
+
+    slicer->dt_since_pass += ctx->dt;
+
+    /* Plan changed mid-pass: restart with this frame's dt. Nodes the
+     * interrupted pass ran have already advanced by its dt. */
+    if (slicer->in_pass && slicer->plan_serial != plan->serial) {
+        slicer->dt_since_pass = ctx->dt;
+        slicer->in_pass = 0;
+    }
+
+    if (!slicer->in_pass) {
+        slicer_begin_pass(slicer, plan, ctx);
+    }
+
+    eval_count = (plan->count <= MAX_NODES) ? plan->count : MAX_NODES;
+    start = lgs_cycles_now();
+    slicer->frames_in_pass++;
+
+    for (;;) {
+        slicer->cursor = graph_eval_range(graph, plan, &slicer->work, &slicer->pass_ctx,
+                                          slicer->cursor,
+                                          (uint16_t)(slicer->cursor + EVAL_SLICE_CHUNK));
+
+        if (slicer->cursor >= eval_count) {
+            /* Pass complete: publish to readers */
+            memcpy(&slicer->front, &slicer->work, sizeof(slicer->front));
+            slicer->latency_frames = slicer->frames_in_pass;
+            slicer->pass_count++;
+            slicer->in_pass = 0;
+            return 1;
+        }
+
+        if (slicer->budget_cycles != 0 &&
+            (uint32_t)(lgs_cycles_now() - start) >= slicer->budget_cycles) {
+            return 0;
+        }
+    }
+}
+
+/* ============================================================
+ * Accessors
+ * ============================================================ */
+const OutputBank *eval_slicer_front(const EvalSlicer *slicer)
+{
+    return slicer ? &slicer->front : NULL;
+}
+
+uint16_t eval_slicer_latency(const EvalSlicer *slicer)
+{
+    return slicer ? slicer->latency_frames : 0;
+}
@@ -0,0 +1,75 @@
+#ifndef GRAPH_EVAL_SLICE_H
+#define GRAPH_EVAL_SLICE_H
+
+#include <stdint.h>
+#include "graph_types.h"
+#include "../runtime/runtime.h"
+
+/* ============================================================
+ * Time-Sliced Evaluation
+ * ============================================================
+ * Spreads one evaluation pass over as many frames as needed to stay
+ * inside a per-frame time budget. The pass in progress writes the
+ * work bank; readers use the front bank, a copy of the last pass
+ * that completed, so rendering never sees a half-evaluated graph.
+ *
+ * A pass runs with the RuntimeContext captured when it started.
+ * Its dt is the time since the previous pass started, and its frame
+ * number counts passes, so stateful and rate-limited nodes advance
+ * once per pass at the right speed.
+ *
+ * Node state stored outside the bank (e.g. PARTICLES pools) is not
+ * double-buffered and is read live.
+ *
+ * Memory usage:
+ *   EvalSlicer: 2 * sizeof(OutputBank) + ctx = ~19KB
+ * ============================================================ */
+
+/* Plan entries evaluated between clock checks */
+#define EVAL_SLICE_CHUNK            8
+
+/* Default budget: half an NTSC frame */
+#define EVAL_SLICE_DEFAULT_BUDGET_US 8000
+
+typedef struct {
+    OutputBank     work;            /* Pass in progress (owns rate state) */
+    OutputBank     front;           /* Last completed pass (read by renderers) */
+    RuntimeContext pass_ctx;        /* Context the pass in progress runs with */
+    uint32_t       plan_serial;     /* Plan the pass in progress belongs to */
+    uint32_t       pass_count;      /* Completed passes */
+    uint32_t       budget_cycles;   /* Per-frame budget, 0 = unlimited */
+    float          dt_since_pass;   /* Time since the pass in progress started */
+    uint16_t       cursor;          /* Next plan entry to evaluate */
+    uint16_t       frames_in_pass;  /* Frames spent on the pass in progress */
+    uint16_t       latency_frames;  /* Frames the last completed pass took */
+    uint8_t        in_pass;         /* A pass is in progress */
+    uint8_t        _pad[1];
+} EvalSlicer;
+
+/* Initialize slicer with a per-frame budget in microseconds
+ * (0 = unlimited: every frame completes a full pass) */
+void eval_slicer_init(EvalSlicer *slicer, uint32_t budget_us);
+
+/* Change the per-frame budget (takes effect next frame) */
+void eval_slicer_set_budget(EvalSlicer *slicer, uint32_t budget_us);
+
+/* Seed both banks from an existing bank and drop any pass in
+ * progress (used when switching from graph_eval to sliced mode) */
+void eval_slicer_reset(EvalSlicer *slicer, const OutputBank *seed);
+
+/* Advance evaluation by one frame's budget.
+ * At least EVAL_SLICE_CHUNK entries run per call so every pass
+ * finishes. A plan change restarts the pass in progress.
+ * Returns 1 if a pass completed (front bank updated) this call. */
+int eval_slicer_step(EvalSlicer *slicer,
+                     const Graph *graph,
+                     const EvalPlan *plan,
+                     const RuntimeContext *ctx);
+
+/* Bank of the last completed pass */
+const OutputBank *eval_slicer_front(const EvalSlicer *slicer);
+
+/* Frames per full evaluation (1 when the graph fits the budget) */
+uint16_t eval_slicer_latency(const EvalSlicer *slicer);
+
+#endif /* GRAPH_EVAL_SLICE_H */
@@ -0,0 +1,216 @@
+#include "graph_probe.h"
+#include <string.h>
+
+/* ============================================================
+ * Helpers
+ * ============================================================ */
+static void probe_release(ProbeBank *pb, uint8_t slot)
+{
+    ProbeRing *ring = &pb->ring[slot];
+
+    if (ring->node < MAX_NODES) {
+        pb->slot_of[ring->node] = PROBE_NONE;
+    }
+    ring->node = INVALID_NODE_ID;
+    ring->head = 0;
+    ring->count = 0;
+}
+
+static uint8_t probe_bind(ProbeBank *pb, const Graph *graph, NodeId id)
+{
+    uint8_t s;
+
+    for (s = 0; s < PROBE_SLOTS; s++) {
+        ProbeRing *ring = &pb->ring[s];
+        if (ring->node == INVALID_NODE_ID) {
+            ring->node = id;
+            ring->len = graph_probe_length(pb, &graph->nodes[id]);
+            ring->head = 0;
+            ring->count = 0;
+            ring->skip = 0;
+            pb->slot_of[id] = s;
+            return s;
+        }
+    }
+    return PROBE_NONE;
+}
+
+/* ============================================================
+ * Init
+ * ============================================================ */
+void graph_probe_init(ProbeBank *pb)
+{
+    uint8_t s;
+
+    if (!pb) {
+        return;
+    }
+    memset(pb, 0, sizeof(*pb));
+    memset(pb->slot_of, PROBE_NONE, sizeof(pb->slot_of));
+    for (s = 0; s < PROBE_SLOTS; s++) {
+        pb->ring[s].node = INVALID_NODE_ID;
+        pb->ring[s].len = PROBE_HISTORY_MIN;
+    }
+    pb->rate_hz = PROBE_RATE_HZ;
+    pb->stride = 1;
+}
+
+void graph_probe_set_rate(ProbeBank *pb, float rate_hz)
+{
+    if (!pb || !(rate_hz > 0.0f) || rate_hz == pb->rate_hz) {
+        return;
+    }
+    pb->rate_hz = rate_hz;
+    pb->stride = rate_hz > PROBE_RATE_HZ ? (uint16_t)(rate_hz / PROBE_RATE_HZ + 0.5f) : 1;
+    pb->plan_serial = 0;    /* Recheck ring lengths at the next sync */
+}
+
+uint16_t graph_probe_length(const ProbeBank *pb, const Node *node)
+{
+    float secs = node ? node->params[0] : 0.0f;
+    float hz = pb ? pb->rate_hz / (float)pb->stride : PROBE_RATE_HZ;
+    float len;
+
+    /* Graphs saved before DEBUG had a param load it as 0 */
+    if (!(secs > 0.0f)) {
+        secs = PROBE_SECS_DEFAULT;
+    }
+    len = secs * hz + 0.5f;
+    return (uint16_t)LGS_CLAMP(len, (float)PROBE_HISTORY_MIN, (float)PROBE_HISTORY_MAX);
+}
+
+/* ============================================================
+ * Capture
+ * ============================================================ */
+void graph_probe_sync(ProbeBank *pb, const Graph *graph, const EvalPlan *plan)
+{
+    uint8_t s;
+
+    if (!pb || !graph || !plan || pb->plan_serial == plan->serial) {
+        return;
+    }
+    pb->plan_serial = plan->serial;
+
+    for (s = 0; s < PROBE_SLOTS; s++) {
+        ProbeRing *ring = &pb->ring[s];
+        uint16_t len;
+
+        if (ring->node == INVALID_NODE_ID) {
+            continue;
+        }
+        if (ring->node >= MAX_NODES || graph->nodes[ring->node].type != NODE_TYPE_DEBUG) {
+            probe_release(pb, s);
+            continue;
+        }
+        len = graph_probe_length(pb, &graph->nodes[ring->node]);
+        if (len != ring->len) {
+            ring->len = len;
+            ring->head = 0;
+            ring->count = 0;
+            ring->skip = 0;
+        }
+    }
+}
+
+void graph_probe_capture(ProbeBank *pb,
+                         const Graph *graph,
+                         NodeId id,
+                         const float outputs[MAX_OUT_PORTS])
+{
+    ProbeRing *ring;
+    float *dst;
+    uint8_t slot;
+
+    if (!pb || !graph || !outputs || id >= MAX_NODES) {
+        return;
+    }
+
+    slot = pb->slot_of[id];
+    if (slot == PROBE_NONE) {
+        slot = probe_bind(pb, graph, id);
+        if (slot == PROBE_NONE) {
+            return;     /* All slots in use */
+        }
+    }
+
+    ring = &pb->ring[slot];
+    if (++ring->skip < pb->stride) {
+        return;
+    }
+    ring->skip = 0;
+
+    dst = ring->hist[ring->head];
+    dst[0] = outputs[0];
+    dst[1] = outputs[1];
+    dst[2] = outputs[2];
+    dst[3] = outputs[3];
+    if (++ring->head >= ring->len) {
+        ring->head = 0;
+    }
+    if (ring->count < ring->len) {
+        ring->count++;
+    }
+}
+
+/* ============================================================
+ * Queries
+ * ============================================================ */
+const ProbeRing *graph_probe_find(const ProbeBank *pb, NodeId id)
+{
+    const ProbeRing *ring;
+
+    if (!pb || id >= MAX_NODES || pb->slot_of[id] == PROBE_NONE) {
+        return NULL;
+    }
+    ring = &pb->ring[pb->slot_of[id]];
+    return ring->count > 0 ? ring : NULL;
+}
+
+uint16_t graph_probe_decimate(const ProbeRing *ring,
+                              uint8_t port,
+                              uint16_t columns,
+                              float *col_min,
+                              float *col_max)
+{
+    uint32_t oldest;
+    uint16_t c;
+
+    if (!ring || port >= PROBE_PORTS || columns == 0 || !col_min || !col_max ||
+        ring->count == 0 || ring->len == 0) {
+        return 0;
+    }
+
+    oldest = (uint32_t)(ring->head + ring->len - ring->count) % ring->len;
+
+    for (c = 0; c < columns; c++) {
+        uint32_t k0 = (uint32_t)c * ring->count / columns;
+        uint32_t k1 = (uint32_t)(c + 1) * ring->count / columns;
+        uint32_t idx, k;
+        float lo, hi;
+
+        if (k0 > 0) {
+            k0--;               /* Join up with the previous column */
+        }
+        if (k1 <= k0) {
+            k1 = k0 + 1;
+        }
+
+        idx = oldest + k0;
+        if (idx >= ring->len) {
+            idx -= ring->len;
+        }
+        lo = hi = ring->hist[idx][port];
+        for (k = k0 + 1; k < k1; k++) {
+            float v;
+            if (++idx >= ring->len) {
+                idx = 0;
+            }
+            v = ring->hist[idx][port];
+            lo = LGS_MIN(lo, v);
+            hi = LGS_MAX(hi, v);
+        }
+        col_min[c] = lo;
+        col_max[c] = hi;
+    }
+    return columns;
+}
@@ -0,0 +1,93 @@
+#ifndef GRAPH_PROBE_H
+#define GRAPH_PROBE_H
+
+#include <stdint.h>
+#include "graph_types.h"
+
+/* ============================================================
+ * Value Probes (DEBUG node history)
+ * ============================================================
+ * Every DEBUG node the evaluator runs gets a ring buffer of its
+ * recent outputs, one sample of all four ports per run. Capturing a
+ * sample is a slot lookup, four stores and a head bump. The ring
+ * length comes from the node's Secs param (seconds at the sample
+ * rate), clamped to PROBE_HISTORY_MAX samples.
+ *
+ * The evaluator's run rate is set with graph_probe_set_rate() (a
+ * fixed-step sim rate, or PROBE_RATE_HZ for once per frame). Above
+ * PROBE_RATE_HZ only every stride-th run is recorded, so samples
+ * stay near PROBE_RATE_HZ and Secs keeps its meaning at any rate.
+ *
+ * Slots are bound on a DEBUG node's first run and released when a
+ * new plan no longer has that node as DEBUG; history survives
+ * commits otherwise. Beyond PROBE_SLOTS DEBUG nodes, the extra ones
+ * are not recorded.
+ *
+ * graph_probe_decimate() reduces a ring to per-column min/max pairs
+ * so a plot costs one primitive per pixel column, however long the
+ * history.
+ *
+ * Memory usage:
+ *   ProbeBank: PROBE_SLOTS * (PROBE_HISTORY_MAX * PROBE_PORTS * 4 + 10)
+ *            + MAX_NODES + 12 = ~31KB
+ * ============================================================ */
+
+#define PROBE_SLOTS           8
+#define PROBE_PORTS           4        /* DEBUG outputs */
+#define PROBE_HISTORY_MAX     240
+#define PROBE_HISTORY_MIN     8
+#define PROBE_RATE_HZ         60.0f    /* Runs per second of per-frame evaluation */
+#define PROBE_SECS_DEFAULT    2.0f
+#define PROBE_NONE            0xFF
+
+typedef struct {
+    NodeId   node;                      /* INVALID_NODE_ID = free */
+    uint16_t len;                       /* Ring length in samples */
+    uint16_t head;                      /* Next sample written */
+    uint16_t count;                     /* Valid samples (<= len) */
+    uint16_t skip;                      /* Runs since the last sample */
+    float    hist[PROBE_HISTORY_MAX][PROBE_PORTS];
+} ProbeRing;
+
+typedef struct {
+    ProbeRing ring[PROBE_SLOTS];
+    uint8_t   slot_of[MAX_NODES];       /* Ring per node, PROBE_NONE if none */
+    uint32_t  plan_serial;              /* Plan the bindings were checked against */
+    float     rate_hz;                  /* Evaluator runs per second */
+    uint16_t  stride;                   /* Runs per recorded sample */
+} ProbeBank;
+
+/* Release every slot and clear all history */
+void graph_probe_init(ProbeBank *pb);
+
+/* Set the evaluator's runs per second (PROBE_RATE_HZ by default).
+ * A change resets rings whose length changes at the next sync. */
+void graph_probe_set_rate(ProbeBank *pb, float rate_hz);
+
+/* Ring length in samples for a DEBUG node's Secs param */
+uint16_t graph_probe_length(const ProbeBank *pb, const Node *node);
+
+/* On a new plan, release slots whose node is no longer DEBUG and
+ * reset rings whose length changed (called by graph_eval) */
+void graph_probe_sync(ProbeBank *pb, const Graph *graph, const EvalPlan *plan);
+
+/* Record one run of DEBUG node id (called by graph_eval) */
+void graph_probe_capture(ProbeBank *pb,
+                         const Graph *graph,
+                         NodeId id,
+                         const float outputs[MAX_OUT_PORTS]);
+
+/* Ring of a node, NULL if it has none or no samples yet */
+const ProbeRing *graph_probe_find(const ProbeBank *pb, NodeId id);
+
+/* Split a ring's history of one port (oldest first) into columns
+ * equal spans and write each span's min and max. Spans include the
+ * previous span's last sample so adjacent columns join up. Returns
+ * the number of columns written (0 if the ring is empty). */
+uint16_t graph_probe_decimate(const ProbeRing *ring,
+                              uint8_t port,
+                              uint16_t columns,
+                              float *col_min,
+                              float *col_max);
+
+#endif /* GRAPH_PROBE_H */
@@ -0,0 +1,75 @@
+#include "graph_profile.h"
+
+#ifdef LGS_NODE_PROFILER
+
+#include <string.h>
+
+/* ============================================================
+ * Reset
+ * ============================================================ */
+void node_profile_reset(NodeProfile *p)
+{
+    if (!p) {
+        return;
+    }
+    memset(p, 0, sizeof(*p));
+}
+
+void node_profile_sync(NodeProfile *p, const EvalPlan *plan)
+{
+    if (!p || !plan || p->plan_serial == plan->serial) {
+        return;
+    }
+    memset(p->avg, 0, sizeof(p->avg));
+    memset(p->type, 0, sizeof(p->type));
+    p->plan_serial = plan->serial;
+}
+
+/* ============================================================
+ * Summary
+ * ============================================================ */
+void node_profile_summarize(const NodeProfile *p, NodeProfileSummary *out)
+{
+    int i;
+
+    if (!out) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+    if (!p) {
+        return;
+    }
+
+    for (i = 0; i < MAX_NODES; i++) {
+        uint8_t type = p->type[i];
+        float avg = p->avg[i];
+        int pos;
+
+        if (type == NODE_TYPE_NONE || type >= NODE_TYPE_COUNT) {
+            continue;
+        }
+        out->node_count++;
+        out->total += avg;
+        out->max = LGS_MAX(out->max, avg);
+        out->type_total[type] += avg;
+        out->type_nodes[type]++;
+
+        /* Insertion into the top list (short, kept sorted) */
+        pos = out->top_count;
+        if (pos == NODE_PROFILE_TOP) {
+            if (avg <= p->avg[out->top[pos - 1]]) {
+                continue;
+            }
+            pos--;
+        } else {
+            out->top_count++;
+        }
+        while (pos > 0 && avg > p->avg[out->top[pos - 1]]) {
+            out->top[pos] = out->top[pos - 1];
+            pos--;
+        }
+        out->top[pos] = (NodeId)i;
+    }
+}
+
+#endif /* LGS_NODE_PROFILER */
@@ -0,0 +1,69 @@
+#ifndef GRAPH_PROFILE_H
+#define GRAPH_PROFILE_H
+
+#include <stdint.h>
+#include "graph_types.h"
+
+/* ============================================================
+ * Node Profiler (LGS_NODE_PROFILER builds only)
+ * ============================================================
+ * graph_eval times every node it runs (gather, eval, store) and
+ * folds the ticks into a per-node exponential average. Summaries
+ * rank the nodes and total them per node type for the editor's
+ * heatmap and top list.
+ *
+ * Ticks are lgs_cycles_now() ticks: CPU cycles on the EE (COP0
+ * Count), microseconds on hosts. Compare them with each other, not
+ * across machines.
+ *
+ * Without LGS_NODE_PROFILER this header declares nothing and
+ * graph_eval carries no timing code.
+ *
+ * Memory usage:
+ *   NodeProfile: MAX_NODES * 5 + 4 = ~1.3KB
+ *   NodeProfileSummary: NODE_TYPE_COUNT * 6 + 32 = ~0.3KB
+ * ============================================================ */
+#ifdef LGS_NODE_PROFILER
+
+#define NODE_PROFILE_EMA  0.0625f   /* Weight of each new run */
+#define NODE_PROFILE_TOP  10
+
+typedef struct {
+    float    avg[MAX_NODES];        /* Ticks per run, exponential average */
+    uint8_t  type[MAX_NODES];       /* NodeType timed, NODE_TYPE_NONE = not run */
+    uint32_t plan_serial;           /* Plan the averages belong to */
+} NodeProfile;
+
+typedef struct {
+    NodeId   top[NODE_PROFILE_TOP]; /* Most expensive first */
+    uint16_t top_count;
+    uint16_t node_count;            /* Nodes timed */
+    float    total;                 /* Sum of averages: ticks per full pass */
+    float    max;                   /* Largest average */
+    float    type_total[NODE_TYPE_COUNT];
+    uint16_t type_nodes[NODE_TYPE_COUNT];
+} NodeProfileSummary;
+
+/* Fold one run into a node's average (the first run seeds it) */
+static inline void node_profile_record(NodeProfile *p, NodeId id, NodeType type, uint32_t ticks)
+{
+    if (p->type[id] != (uint8_t)type) {
+        p->type[id] = (uint8_t)type;
+        p->avg[id] = (float)ticks;
+    } else {
+        p->avg[id] += ((float)ticks - p->avg[id]) * NODE_PROFILE_EMA;
+    }
+}
+
+/* Forget every average */
+void node_profile_reset(NodeProfile *p);
+
+/* Forget every average if the plan changed (called by graph_eval) */
+void node_profile_sync(NodeProfile *p, const EvalPlan *plan);
+
+/* Rank nodes and total them per type */
+void node_profile_summarize(const NodeProfile *p, NodeProfileSummary *out);
+
+#endif /* LGS_NODE_PROFILER */
+
+#endif /* GRAPH_PROFILE_H */
@@ -56,9 +56,45 @@ typedef enum {
     NODE_TYPE_RENDER_LINE,  /* Render line */
     /* Utility */
     NODE_TYPE_DEBUG,
+    /* Simulation (appended to keep saved type IDs stable) */
+    NODE_TYPE_PARTICLES,    /* SoA particle emitter */
+    /* Fragment (per-pixel graphs, see graph_eval_fragment.h) */
+    NODE_TYPE_UV,           /* Normalized pixel coordinates */
+    NODE_TYPE_PIXEL,        /* Pixel coordinates and image size */
+    NODE_TYPE_FRAG_OUT,     /* Per-pixel color sink */
     NODE_TYPE_COUNT
 } NodeType;
 
+/* ============================================================
+ * Node Update Rate
+ * ============================================================
+ * Nodes may run below frame rate. Skipped nodes keep their last
+ * outputs; dt is accumulated so stateful nodes see the full
+ * elapsed time when they do run.
+ * ============================================================ */
+typedef enum {
+    NODE_RATE_EVERY_FRAME = 0,  /* Evaluate every frame (default) */
+    NODE_RATE_DIVIDED,          /* Evaluate every rate_div frames */
+    NODE_RATE_ON_CHANGE,        /* Evaluate only when an input changes */
+    NODE_RATE_MODE_COUNT
+} NodeRateMode;
+
+#define NODE_RATE_DIV_MIN 2
+#define NODE_RATE_DIV_MAX 60
+
+/* ============================================================
+ * Sink Kind (how the render pass draws a node)
+ * ============================================================ */
+typedef enum {
+    SINK_KIND_NONE = 0,         /* Not drawn */
+    SINK_KIND_RECT,             /* RENDER2D: out x, y, w, h */
+    SINK_KIND_CIRCLE,           /* RENDER_CIRCLE: out x, y, radius */
+    SINK_KIND_LINE,             /* RENDER_LINE: out x1, y1, x2, y2 */
+    SINK_KIND_PARTICLES,        /* PARTICLES: draws its particle pool */
+    SINK_KIND_FRAGMENT,         /* FRAG_OUT: out r, g, b per pixel (host fragment renderer) */
+    SINK_KIND_COUNT
+} SinkKind;
+
 /* ============================================================
  * Connection (input reference)
  * ============================================================ */
@@ -76,6 +112,9 @@ typedef struct {
     Connection  inputs[MAX_IN_PORTS];
     float       params[MAX_PARAMS];
     uint32_t    state_u32[MAX_NODE_STATE];
+    uint8_t     rate_mode;    /* NodeRateMode */
+    uint8_t     rate_div;     /* Frame divider for NODE_RATE_DIVIDED */
+    uint8_t     _rate_pad[2]; /* Padding for alignment */
 } Node;
 
 /* ============================================================
@@ -92,15 +131,54 @@ typedef struct {
  * ============================================================ */
 typedef struct {
     float out[MAX_NODES][MAX_OUT_PORTS];
+
+    /* Multi-rate bookkeeping (see NodeRateMode) */
+    float    dt_accum[MAX_NODES];               /* dt since node last ran */
+    float    last_in[MAX_NODES][MAX_IN_PORTS];  /* Inputs at last run (ON_CHANGE) */
+    uint8_t  has_run[MAX_NODES];                /* Ran since plan change */
+    uint32_t plan_serial;                       /* Plan these flags belong to */
+
+    /* Per-frame stats (written by graph_eval) */
+    uint16_t stat_evaluated;                    /* Nodes evaluated */
+    uint16_t stat_rate_skipped;                 /* Nodes skipped by update rate */
+    uint16_t stat_branch_skipped;               /* Nodes skipped in unselected branches */
+
+    /* Sink colors (written when a RECT/CIRCLE/LINE sink runs).
+     * Packed like RENDER_COLOR: R bits 0-7 ... A bits 24-31, A 0-128. */
+    uint32_t sink_color[MAX_NODES];
 } OutputBank;
 
+/* ============================================================
+ * PlanSink (one drawable node in the plan's sink list)
+ * ============================================================ */
+typedef struct {
+    NodeId   node;
+    uint8_t  kind;              /* SinkKind */
+    uint8_t  _pad[1];           /* Padding for alignment */
+} PlanSink;
+
 /* ============================================================
  * EvalPlan (topological order for evaluation)
  * ============================================================ */
 typedef struct {
     uint16_t count;
-    NodeId   sink_id;
+    NodeId   sink_id;           /* Primary sink (first in sinks[]) */
     NodeId   order[MAX_NODES];
+    uint8_t  phase[MAX_NODES];  /* Frame phase per order entry (DIVIDED nodes) */
+    uint32_t serial;            /* Unique per successful build */
+
+    /* Conditional branches, indexed by node ID. A guarded node is
+     * consumed only through input guard_port of SELECT/GATE
+     * guard_node (directly or via other nodes of that branch) and
+     * is skipped while that input is not selected. */
+    NodeId   guard_node[MAX_NODES];   /* INVALID_NODE_ID = always evaluated */
+    uint8_t  guard_port[MAX_NODES];   /* Guarded input port of guard_node */
+    uint8_t  branch_tick[MAX_NODES];  /* Stateful or feeds a stateful node in its branch */
+    uint16_t guarded_count;           /* Nodes with a guard */
+
+    /* Drawable sinks in node ID order (the order they are drawn) */
+    PlanSink sinks[MAX_NODES];
+    uint16_t sink_count;
 } EvalPlan;
 
 /* ============================================================
@@ -1,21 +1,83 @@
 #include "graph_validate.h"
 #include "graph_core.h"
+#include "../nodes/node_registry.h"
+#include <string.h>
+
+/* Frames covered when balancing DIVIDED node phases
+ * (a multiple of the common dividers 2-6, 8, 10, 12, 15, 20, 30, 60) */
+#define RATE_BALANCE_WINDOW 120
+
+/* Serial source for EvalPlan.serial (0 = never built) */
+static uint32_t s_plan_serial = 0;
 
 /* ============================================================
  * Internal State for Topological Sort (Kahn's Algorithm)
  * ============================================================ */
 typedef struct {
-    uint8_t  in_degree[MAX_NODES];    /* Incoming edge count per node */
+    uint16_t in_degree[MAX_NODES];    /* Incoming edge count per node */
     uint8_t  visited[MAX_NODES];      /* Visited flag for processing */
     NodeId   queue[MAX_NODES];        /* Processing queue */
     uint16_t queue_head;
     uint16_t queue_tail;
 } TopoState;
 
+/* ============================================================
+ * Branch Ports
+ * ============================================================ */
+int graph_branch_selector_port(NodeType type)
+{
+    switch (type) {
+        case NODE_TYPE_SELECT: return 2;  /* a, b, cond */
+        case NODE_TYPE_GATE:   return 1;  /* signal, gate */
+        default:               return -1;
+    }
+}
+
+int graph_is_branch_port(NodeType type, uint8_t port)
+{
+    switch (type) {
+        case NODE_TYPE_SELECT: return port == 0 || port == 1;
+        case NODE_TYPE_GATE:   return port == 0;
+        default:               return 0;
+    }
+}
+
+/* ============================================================
+ * Helper: Count guard dependencies of a node
+ * ============================================================
+ * A guarded node can only decide whether to run once the selector
+ * inputs of its guard and of every enclosing guard are computed, so
+ * each selector source is an extra ordering edge into the node.
+ * Counts edges from src, or all edges if src is INVALID_NODE_ID.
+ * ============================================================ */
+static uint16_t count_guard_deps(const Graph *g, const EvalPlan *plan,
+                                 NodeId id, NodeId src)
+{
+    uint16_t count = 0;
+    uint16_t depth;
+    NodeId guard = plan->guard_node[id];
+
+    for (depth = 0; depth < MAX_NODES && guard != INVALID_NODE_ID; depth++) {
+        int port = graph_branch_selector_port(g->nodes[guard].type);
+        if (port >= 0) {
+            NodeId cond = g->nodes[guard].inputs[port].src_node;
+            if (cond != INVALID_NODE_ID && cond < MAX_NODES &&
+                g->nodes[cond].type != NODE_TYPE_NONE &&
+                (src == INVALID_NODE_ID || cond == src)) {
+                count++;
+            }
+        }
+        guard = plan->guard_node[guard];
+    }
+
+    return count;
+}
+
 /* ============================================================
  * Helper: Count incoming edges for each node
  * ============================================================ */
-static void compute_in_degrees(const Graph *g, TopoState *state)
+static void compute_in_degrees(const Graph *g, const EvalPlan *plan,
+                               int use_guards, TopoState *state)
 {
     uint16_t i, j;
     NodeId src;
@@ -39,6 +101,9 @@ static void compute_in_degrees(const Graph *g, TopoState *state)
                 }
             }
         }
+        if (use_guards) {
+            state->in_degree[i] += count_guard_deps(g, plan, (NodeId)i, INVALID_NODE_ID);
+        }
     }
 }
 
@@ -115,7 +180,7 @@ int graph_has_sink(const Graph *g)
     }
 
     for (i = 0; i < MAX_NODES; i++) {
-        if (g->nodes[i].type == NODE_TYPE_RENDER2D) {
+        if (node_registry_sink_kind(g->nodes[i].type) != SINK_KIND_NONE) {
             return 1;
         }
     }
@@ -135,7 +200,7 @@ uint16_t graph_count_sinks(const Graph *g)
     }
 
     for (i = 0; i < MAX_NODES; i++) {
-        if (g->nodes[i].type == NODE_TYPE_RENDER2D) {
+        if (node_registry_sink_kind(g->nodes[i].type) != SINK_KIND_NONE) {
             count++;
         }
     }
@@ -144,67 +209,104 @@ uint16_t graph_count_sinks(const Graph *g)
 }
 
 /* ============================================================
- * Find primary sink node (first RENDER2D)
+ * Collect Drawable Sinks
+ * ============================================================
+ * Fills plan->sinks[] in node ID order so the render pass walks a
+ * short typed list instead of scanning every node each frame.
  * ============================================================ */
-static NodeId find_sink(const Graph *g)
+static void collect_sinks(const Graph *g, EvalPlan *plan)
 {
     uint16_t i;
 
+    plan->sink_count = 0;
     for (i = 0; i < MAX_NODES; i++) {
-        if (g->nodes[i].type == NODE_TYPE_RENDER2D) {
-            return (NodeId)i;
+        SinkKind kind = node_registry_sink_kind(g->nodes[i].type);
+        if (kind != SINK_KIND_NONE) {
+            plan->sinks[plan->sink_count].node = (NodeId)i;
+            plan->sinks[plan->sink_count].kind = (uint8_t)kind;
+            plan->sink_count++;
         }
     }
-
-    return INVALID_NODE_ID;
 }
 
 /* ============================================================
- * Build Evaluation Plan (Kahn's Algorithm for Topological Sort)
+ * Clamp a node's frame divider to the supported range
  * ============================================================ */
-Status graph_build_eval_plan(const Graph *g, EvalPlan *plan)
+uint8_t graph_node_rate_div(const Node *node)
 {
-    TopoState state;
-    uint16_t i, j;
-    uint16_t active_count = 0;
-    NodeId current;
-    NodeId src;
-
-    if (g == NULL || plan == NULL) {
-        return STATUS_ERR_INVALID_NODE;
+    if (node->rate_div < NODE_RATE_DIV_MIN) {
+        return NODE_RATE_DIV_MIN;
     }
+    if (node->rate_div > NODE_RATE_DIV_MAX) {
+        return NODE_RATE_DIV_MAX;
+    }
+    return node->rate_div;
+}
 
-    /* Initialize plan */
-    plan->count = 0;
-    plan->sink_id = INVALID_NODE_ID;
+/* ============================================================
+ * Assign Frame Phases to DIVIDED Nodes
+ * ============================================================
+ * Greedy balancing: each divided node takes the phase whose frames
+ * currently carry the least load, so N nodes at 1/4 rate run about
+ * N/4 per frame instead of all N on every 4th frame.
+ * ============================================================ */
+static void assign_rate_phases(const Graph *g, EvalPlan *plan)
+{
+    uint16_t load[RATE_BALANCE_WINDOW];
+    uint16_t i;
 
-    /* Find sink node */
-    plan->sink_id = find_sink(g);
-    if (plan->sink_id == INVALID_NODE_ID) {
-        return STATUS_ERR_NO_SINK;
-    }
+    memset(load, 0, sizeof(load));
 
-    /* Validate all connections first */
-    for (i = 0; i < MAX_NODES; i++) {
-        if (g->nodes[i].type == NODE_TYPE_NONE) {
+    for (i = 0; i < plan->count; i++) {
+        const Node *node = &g->nodes[plan->order[i]];
+        uint32_t best_cost = 0xFFFFFFFFu;
+        uint8_t best_phase = 0;
+        uint8_t div, p;
+        uint16_t f;
+
+        plan->phase[i] = 0;
+        if (node->rate_mode != NODE_RATE_DIVIDED) {
             continue;
         }
-        active_count++;
-        for (j = 0; j < MAX_IN_PORTS; j++) {
-            Status s = graph_validate_connection(g, &g->nodes[i].inputs[j]);
-            if (s != STATUS_OK) {
-                return STATUS_ERR_VALIDATION_FAIL;
+
+        div = graph_node_rate_div(node);
+        for (p = 0; p < div; p++) {
+            uint32_t cost = 0;
+            for (f = p; f < RATE_BALANCE_WINDOW; f += div) {
+                cost += load[f];
+            }
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_phase = p;
             }
         }
-    }
 
-    /* No nodes? Return early (but we have a sink, so this shouldn't happen) */
-    if (active_count == 0) {
-        return STATUS_OK;
+        plan->phase[i] = best_phase;
+        for (f = best_phase; f < RATE_BALANCE_WINDOW; f += div) {
+            load[f]++;
+        }
     }
+}
+
+/* ============================================================
+ * Topological Sort (Kahn's Algorithm)
+ * ============================================================
+ * Fills plan->order. With use_guards, guarded nodes are also
+ * ordered after the selector sources of their guards.
+ * Returns 0 if not every active node could be ordered (cycle).
+ * ============================================================ */
+static int topo_sort(const Graph *g, EvalPlan *plan,
+                     uint16_t active_count, int use_guards)
+{
+    TopoState state;
+    uint16_t i, j;
+    NodeId current;
+    NodeId src;
+
+    plan->count = 0;
 
     /* Compute in-degrees */
-    compute_in_degrees(g, &state);
+    compute_in_degrees(g, plan, use_guards, &state);
 
     /* Initialize queue with nodes that have no incoming edges */
     queue_init(&state);
@@ -230,6 +332,8 @@ Status graph_build_eval_plan(const Graph *g, EvalPlan *plan)
 
         /* Reduce in-degree of nodes that depend on this one */
         for (i = 0; i < MAX_NODES; i++) {
+            uint16_t edges = 0;
+
             if (g->nodes[i].type == NODE_TYPE_NONE) {
                 continue;
             }
@@ -240,11 +344,14 @@ Status graph_build_eval_plan(const Graph *g, EvalPlan *plan)
             for (j = 0; j < MAX_IN_PORTS; j++) {
                 src = g->nodes[i].inputs[j].src_node;
                 if (src == current) {
-                    if (state.in_degree[i] > 0) {
-                        state.in_degree[i]--;
-                    }
+                    edges++;
                 }
             }
+            if (use_guards) {
+                edges += count_guard_deps(g, plan, (NodeId)i, current);
+            }
+            state.in_degree[i] = (state.in_degree[i] > edges) ?
+                                 (uint16_t)(state.in_degree[i] - edges) : 0;
 
             /* If all dependencies satisfied, add to queue */
             if (state.in_degree[i] == 0 && !state.visited[i]) {
@@ -255,11 +362,177 @@ Status graph_build_eval_plan(const Graph *g, EvalPlan *plan)
     }
 
     /* Check for cycles: if we didn't process all nodes, there's a cycle */
-    if (plan->count != active_count) {
+    return plan->count == active_count;
+}
+
+/* ============================================================
+ * Clear Branch Guards (every node always evaluated)
+ * ============================================================ */
+static void clear_branch_guards(EvalPlan *plan)
+{
+    uint16_t i;
+
+    for (i = 0; i < MAX_NODES; i++) {
+        plan->guard_node[i] = INVALID_NODE_ID;
+        plan->guard_port[i] = 0;
+        plan->branch_tick[i] = 0;
+    }
+    plan->guarded_count = 0;
+}
+
+/* ============================================================
+ * Assign Branch Guards
+ * ============================================================
+ * Walks the order backwards so every consumer is classified before
+ * its producers. Each output edge of a node is attributed to a
+ * branch: the edge's own (SELECT/GATE, port) if it feeds a branch
+ * port, else the branch of the consumer. A node whose edges all
+ * agree on one branch is guarded by it. Nodes with no consumers
+ * (sinks, dangling nodes) are never guarded.
+ * ============================================================ */
+static void assign_branch_guards(const Graph *g, EvalPlan *plan)
+{
+    uint16_t k, c;
+    uint8_t p;
+
+    clear_branch_guards(plan);
+
+    for (k = plan->count; k-- > 0; ) {
+        NodeId n = plan->order[k];
+        NodeId guard = INVALID_NODE_ID;
+        uint8_t guard_port = 0;
+        uint16_t consumers = 0;
+        int shared = 0;
+        int tick = node_registry_is_stateful(g->nodes[n].type);
+
+        for (c = 0; c < MAX_NODES && !shared; c++) {
+            const Node *consumer = &g->nodes[c];
+            if (consumer->type == NODE_TYPE_NONE) {
+                continue;
+            }
+            for (p = 0; p < MAX_IN_PORTS; p++) {
+                NodeId edge_guard;
+                uint8_t edge_port;
+
+                if (consumer->inputs[p].src_node != n) {
+                    continue;
+                }
+
+                if (graph_is_branch_port(consumer->type, p)) {
+                    edge_guard = (NodeId)c;
+                    edge_port = p;
+                } else {
+                    edge_guard = plan->guard_node[c];
+                    edge_port = plan->guard_port[c];
+                    if (plan->branch_tick[c]) {
+                        tick = 1;
+                    }
+                }
+
+                if (edge_guard == INVALID_NODE_ID ||
+                    (consumers > 0 && (edge_guard != guard || edge_port != guard_port))) {
+                    shared = 1;
+                    break;
+                }
+                guard = edge_guard;
+                guard_port = edge_port;
+                consumers++;
+            }
+        }
+
+        if (!shared && consumers > 0) {
+            plan->guard_node[n] = guard;
+            plan->guard_port[n] = guard_port;
+            plan->branch_tick[n] = (uint8_t)tick;
+            plan->guarded_count++;
+        }
+    }
+}
+
+/* ============================================================
+ * Build Evaluation Order
+ * ============================================================ */
+Status graph_build_eval_order(const Graph *g, EvalPlan *plan)
+{
+    uint16_t i, j;
+    uint16_t active_count = 0;
+
+    if (g == NULL || plan == NULL) {
+        return STATUS_ERR_INVALID_NODE;
+    }
+
+    /* Initialize plan */
+    plan->count = 0;
+    plan->sink_id = INVALID_NODE_ID;
+    plan->sink_count = 0;
+    clear_branch_guards(plan);
+
+    /* Validate all connections first */
+    for (i = 0; i < MAX_NODES; i++) {
+        if (g->nodes[i].type == NODE_TYPE_NONE) {
+            continue;
+        }
+        active_count++;
+        for (j = 0; j < MAX_IN_PORTS; j++) {
+            Status s = graph_validate_connection(g, &g->nodes[i].inputs[j]);
+            if (s != STATUS_OK) {
+                return STATUS_ERR_VALIDATION_FAIL;
+            }
+        }
+    }
+
+    /* No nodes? Return early */
+    if (active_count == 0) {
+        plan->serial = ++s_plan_serial;
+        return STATUS_OK;
+    }
+
+    if (!topo_sort(g, plan, active_count, 0)) {
         plan->count = 0;
         plan->sink_id = INVALID_NODE_ID;
         return STATUS_ERR_CYCLE_DETECTED;
     }
 
+    collect_sinks(g, plan);
+
+    /* Re-sort so selector inputs run before the branches they pick.
+     * The guard edges cannot form a cycle (a branch node never feeds
+     * its own selector), but fall back to unguarded if they do. */
+    assign_branch_guards(g, plan);
+    if (plan->guarded_count > 0 && !topo_sort(g, plan, active_count, 1)) {
+        clear_branch_guards(plan);
+        topo_sort(g, plan, active_count, 0);
+    }
+
+    assign_rate_phases(g, plan);
+    plan->serial = ++s_plan_serial;
+
+    return STATUS_OK;
+}
+
+/* ============================================================
+ * Build Evaluation Plan (order + sink list)
+ * ============================================================ */
+Status graph_build_eval_plan(const Graph *g, EvalPlan *plan)
+{
+    Status s;
+
+    if (g == NULL || plan == NULL) {
+        return STATUS_ERR_INVALID_NODE;
+    }
+
+    if (!graph_has_sink(g)) {
+        plan->count = 0;
+        plan->sink_id = INVALID_NODE_ID;
+        plan->sink_count = 0;
+        return STATUS_ERR_NO_SINK;
+    }
+
+    s = graph_build_eval_order(g, plan);
+    if (s != STATUS_OK) {
+        return s;
+    }
+
+    plan->sink_id = plan->sinks[0].node;
     return STATUS_OK;
 }
@@ -7,21 +7,44 @@
  * Graph Validation and Evaluation Plan Building
  * ============================================================
  * Validates the graph structure and builds a topologically sorted
- * evaluation plan. Rejects cycles and locates the primary sink node.
+ * evaluation plan. Rejects cycles and collects the drawable sinks.
  * ============================================================ */
 
 /* Build evaluation plan from graph
  * - Validates all node references
  * - Detects cycles (returns STATUS_ERR_CYCLE_DETECTED)
- * - Locates RENDER2D sink (returns STATUS_ERR_NO_SINK if missing)
+ * - Collects drawable sinks (RENDER2D, RENDER_CIRCLE, RENDER_LINE,
+ *   PARTICLES, FRAG_OUT) into plan->sinks[]; plan->sink_id is the first one
+ *   (returns STATUS_ERR_NO_SINK if there are none)
  * - Produces stable topological ordering in plan->order[]
+ * - Spreads NODE_RATE_DIVIDED nodes across frames (plan->phase[])
+ * - Marks nodes consumed only through one SELECT/GATE branch input
+ *   (plan->guard_node[]) and orders them after the selector inputs
  */
 Status graph_build_eval_plan(const Graph *g, EvalPlan *plan);
 
+/* Build topological order only (no sink required).
+ * Used by headless runners (e.g. block/audio evaluation) whose
+ * graphs have no render sink. plan->sink_id is INVALID_NODE_ID;
+ * plan->sinks[] still lists any sinks present. */
+Status graph_build_eval_order(const Graph *g, EvalPlan *plan);
+
+/* Effective frame divider of a NODE_RATE_DIVIDED node
+ * (rate_div clamped to NODE_RATE_DIV_MIN..NODE_RATE_DIV_MAX) */
+uint8_t graph_node_rate_div(const Node *node);
+
+/* Selector input port of a branching node type (SELECT: cond,
+ * GATE: gate), or -1 if the type does not branch */
+int graph_branch_selector_port(NodeType type);
+
+/* Check if an input port of a branching node type is a branch input
+ * (SELECT: a/b, GATE: signal) whose subgraph can be skipped */
+int graph_is_branch_port(NodeType type, uint8_t port);
+
 /* Validate a single connection reference */
 Status graph_validate_connection(const Graph *g, const Connection *conn);
 
-/* Check if graph has at least one sink node */
+/* Check if graph has at least one drawable sink node */
 int graph_has_sink(const Graph *g);
 uint16_t graph_count_sinks(const Graph *g);
 
@@ -19,6 +19,19 @@ static const char * const s_io_result_strings[] = {
     "Error: Buffer too small"
 };
 
+/* ============================================================
+ * Legacy Node Layout (file version 1)
+ * ============================================================
+ * Version 2 appended the update-rate fields, so a v1 record is a
+ * byte-for-byte prefix of the current Node.
+ * ============================================================ */
+typedef struct {
+    NodeType    type;
+    Connection  inputs[MAX_IN_PORTS];
+    float       params[MAX_PARAMS];
+    uint32_t    state_u32[MAX_NODE_STATE];
+} NodeV1;
+
 /* ============================================================
  * Checksum Helper
  * ============================================================ */
@@ -64,6 +77,16 @@ int graph_io_sanitize(Graph *g)
             continue;
         }
 
+        /* Validate update rate */
+        if (node->rate_mode >= NODE_RATE_MODE_COUNT) {
+            node->rate_mode = NODE_RATE_EVERY_FRAME;
+            sanitized++;
+        }
+        if (node->rate_div > NODE_RATE_DIV_MAX) {
+            node->rate_div = NODE_RATE_DIV_MAX;
+            sanitized++;
+        }
+
         /* Validate connections */
         for (p = 0; p < MAX_IN_PORTS; p++) {
             Connection *conn = &node->inputs[p];
@@ -193,8 +216,10 @@ GraphIoResult graph_io_deserialize(const void *buffer, size_t buffer_size,
     const uint8_t *ptr;
     GraphFileHeader header;
     size_t expected_size;
+    size_t node_size;
     uint32_t computed_checksum;
     int has_ui_meta;
+    NodeId i;
 
     if (!buffer || !g) {
         return GRAPH_IO_ERR_NULL_PTR;
@@ -221,7 +246,8 @@ GraphIoResult graph_io_deserialize(const void *buffer, size_t buffer_size,
     }
 
     has_ui_meta = (header.flags & 1) != 0;
-    expected_size = sizeof(GraphFileHeader) + sizeof(Node) * MAX_NODES;
+    node_size = (header.version >= 2) ? sizeof(Node) : sizeof(NodeV1);
+    expected_size = sizeof(GraphFileHeader) + node_size * MAX_NODES;
     if (has_ui_meta) {
         expected_size += sizeof(UiMeta) * MAX_NODES;
     }
@@ -240,9 +266,17 @@ GraphIoResult graph_io_deserialize(const void *buffer, size_t buffer_size,
     /* Initialize graph */
     graph_init(g);
 
-    /* Read nodes */
-    memcpy(g->nodes, ptr, sizeof(Node) * MAX_NODES);
-    ptr += sizeof(Node) * MAX_NODES;
+    /* Read nodes (v1 records are a prefix of Node; rate defaults) */
+    if (node_size == sizeof(Node)) {
+        memcpy(g->nodes, ptr, sizeof(Node) * MAX_NODES);
+    } else {
+        for (i = 0; i < MAX_NODES; i++) {
+            memcpy(&g->nodes[i], ptr + node_size * i, sizeof(NodeV1));
+            g->nodes[i].rate_mode = NODE_RATE_EVERY_FRAME;
+            g->nodes[i].rate_div = 1;
+        }
+    }
+    ptr += node_size * MAX_NODES;
 
     g->node_count = header.node_count;
     g->version = header.graph_version;
@@ -16,7 +16,11 @@
  * File Format Constants
  * ============================================================ */
 #define GRAPH_IO_MAGIC       0x4C475348  /* "LGSH" - Live Graph Studio Header */
-#define GRAPH_IO_VERSION     1
+#define GRAPH_IO_VERSION     2
+
+/* Version history:
+ *   1: Node without update rate (68 bytes per node)
+ *   2: Node gains rate_mode/rate_div (v1 files load as EVERY_FRAME) */
 
 /* ============================================================
  * File Header Structure
@@ -5,13 +5,18 @@
 #include "graph/graph_core.h"
 #include "graph/graph_validate.h"
 #include "graph/graph_eval.h"
+#include "graph/graph_eval_slice.h"
+#include "graph/graph_eval_fixed.h"
 #include "graph/graph_publish.h"
 #include "nodes/node_registry.h"
 #include "runtime/runtime.h"
 #include "system/pad.h"
 #include "system/timing.h"
+#include "system/profiler.h"
 #include "render/render.h"
+#include "render/render_sinks.h"
 #include "render/font.h"
+#include "render/text_fmt.h"
 #include "ui/editor.h"
 #include "io/graph_io.h"
 #include "io/assets.h"
@@ -26,6 +31,16 @@
 static Graph        s_active_graph;    /* Live graph being evaluated */
 static EvalPlan     s_eval_plan;       /* Current evaluation order */
 static OutputBank   s_output_bank;     /* Node output storage */
+static EvalSlicer   s_slicer;          /* Time-sliced evaluation (L3 toggle) */
+static int          s_eval_sliced = 0; /* Evaluate within a per-frame budget */
+static EvalStepper  s_stepper;         /* Fixed-step evaluation (Sim Rate) */
+static int          s_stepping = 0;    /* s_stepper owns the rate state */
+static uint16_t     s_steps = 1;       /* Evaluations last frame */
+static const OutputBank *s_display_bank = &s_output_bank; /* Bank renderers read */
+static ProbeBank    s_probes;          /* DEBUG node history (editor plots) */
+#ifdef LGS_NODE_PROFILER
+static NodeProfile  s_node_profile;    /* Per-node eval cost (editor overlay) */
+#endif
 static RuntimeContext s_runtime;       /* Runtime context (time, pad) */
 static EditorState  s_editor;          /* Editor UI state */
 static PadState     s_pad;             /* Controller state */
@@ -35,6 +50,60 @@ static const char  *s_asset_error = NULL; /* Asset error message for banner */
 static int          s_editor_visible = 1; /* Editor visibility (R3 toggle) */
 static PadState     s_pad_prev;          /* Previous frame pad for edge detect */
 
+/* HUD lines, top-right (re-formatted only when their value changes) */
+typedef enum {
+    HUD_FPS = 0,    /* Measured, over the timing window */
+    HUD_DT,
+    HUD_FT_AVG,     /* Frame time (ms): average, shortest, longest, 99th pct */
+    HUD_FT_MIN,
+    HUD_FT_MAX,
+    HUD_FT_P99,
+    HUD_MISSED,     /* Vsyncs missed since start */
+    HUD_FRAME,
+    HUD_NODES,      /* Nodes evaluated this frame (rate-limited nodes skip) */
+    HUD_BRANCH,     /* Nodes skipped in unselected SELECT/GATE branches */
+    HUD_EVAL,       /* Frames per full evaluation (above 1 when time-sliced) */
+    HUD_STEP,       /* Fixed steps last frame / sim rate (Hz, 0 = per frame) */
+    HUD_TEXT,       /* Text sprites last frame vs one sprite per glyph pixel */
+    HUD_UI,         /* Editor primitives generated vs replayed from its cache */
+    HUD_LINE_COUNT
+} HudLine;
+static TextLabel    s_hud[HUD_LINE_COUNT];
+
+/* Jitter histogram under the HUD lines: one bar per bin, height is
+ * the bin's share of the timing window */
+#define HUD_JITTER_Y        (10 + HUD_LINE_COUNT * 12)
+#define HUD_JITTER_H        16
+#define HUD_JITTER_BAR_W    8
+#define HUD_JITTER_GAP      2
+
+#ifdef LGS_FRAME_PROFILER
+/* Frame graph, below the HUD lines: one column per frame, stages
+ * stacked bottom-up, full height = two frame budgets */
+#define PROF_GRAPH_H        48
+#define PROF_GRAPH_Y        (HUD_JITTER_Y + HUD_JITTER_H + 8)
+#define PROF_LEGEND_REFRESH 15      /* Frames between legend re-formats */
+#define PROF_LEGEND_LEN     20
+
+static const uint64_t s_prof_colors[PROF_ZONE_COUNT] = {
+    RENDER_COLOR(90, 90, 90, 128),      /* FRAME (untimed) */
+    RENDER_COLOR(60, 60, 160, 128),     /* TIMING */
+    RENDER_COLOR(160, 60, 160, 128),    /* PAD */
+    RENDER_COLOR(220, 160, 40, 128),    /* EDITOR */
+    RENDER_COLOR(220, 60, 60, 128),     /* EVAL */
+    RENDER_COLOR(60, 160, 220, 128),    /* RENDER */
+    RENDER_COLOR(60, 200, 120, 128),    /* SINKS */
+    RENDER_COLOR(200, 200, 80, 128),    /* UI */
+    RENDER_COLOR(140, 140, 220, 128),   /* FLIP */
+    RENDER_COLOR(120, 80, 40, 128),     /* QUEUE */
+    RENDER_COLOR(200, 120, 200, 128)    /* WRITE */
+};
+static char     s_prof_legend[PROF_ZONE_COUNT][PROF_LEGEND_LEN];
+static uint8_t  s_prof_legend_zone[PROF_ZONE_COUNT];
+static int      s_prof_legend_count;
+static uint32_t s_prof_legend_frame;
+#endif
+
 /* ============================================================
  * Default Graph Setup
  * ============================================================ */
@@ -84,28 +153,15 @@ static void create_default_graph(void)
     }
 }
 
-static int graph_has_render_sink(const Graph *g)
-{
-    NodeId i;
-
-    if (!g) {
-        return 0;
-    }
-
-    for (i = 0; i < MAX_NODES; i++) {
-        if (g->nodes[i].type == NODE_TYPE_RENDER2D) {
-            return 1;
-        }
-    }
-
-    return 0;
-}
-
 /* ============================================================
  * Initialization
  * ============================================================ */
 static int app_init(void)
 {
+#ifdef LGS_FRAME_PROFILER
+    profiler_init();
+#endif
+
     scr_printf("  timing_init...\n");
     /* Initialize timing (NTSC 60Hz) */
     timing_init(TIMING_MODE_NTSC);
@@ -131,6 +187,21 @@ static int app_init(void)
         return -1;
     }
 
+    text_label_init(&s_hud[HUD_FPS], "FPS: ", TEXT_LABEL_U32, 0);
+    text_label_init(&s_hud[HUD_DT], "dt: ", TEXT_LABEL_FIXED, 3);
+    text_label_init(&s_hud[HUD_FT_AVG], "ms: ", TEXT_LABEL_FIXED, 2);
+    text_label_init(&s_hud[HUD_FT_MIN], "lo: ", TEXT_LABEL_FIXED, 2);
+    text_label_init(&s_hud[HUD_FT_MAX], "hi: ", TEXT_LABEL_FIXED, 2);
+    text_label_init(&s_hud[HUD_FT_P99], "p99: ", TEXT_LABEL_FIXED, 2);
+    text_label_init(&s_hud[HUD_MISSED], "miss: ", TEXT_LABEL_U32, 0);
+    text_label_init(&s_hud[HUD_FRAME], "F: ", TEXT_LABEL_U32, 0);
+    text_label_init(&s_hud[HUD_NODES], "N: ", TEXT_LABEL_U32_PAIR, 0);
+    text_label_init(&s_hud[HUD_BRANCH], "B: ", TEXT_LABEL_U32, 0);
+    text_label_init(&s_hud[HUD_EVAL], "E: ", TEXT_LABEL_U32, 0);
+    text_label_init(&s_hud[HUD_STEP], "S: ", TEXT_LABEL_U32_PAIR, 0);
+    text_label_init(&s_hud[HUD_TEXT], "T: ", TEXT_LABEL_U32_PAIR, 0);
+    text_label_init(&s_hud[HUD_UI], "U: ", TEXT_LABEL_U32_PAIR, 0);
+
     scr_printf("  node_registry_init...\n");
     /* Initialize node registry */
     node_registry_init();
@@ -187,8 +258,8 @@ static int app_init(void)
         create_default_graph();
     } else {
         printf("Loaded graph from file\n");
-        if (!graph_has_render_sink(&s_active_graph)) {
-            printf("Warning: Loaded graph has no RENDER2D sink, creating default\n");
+        if (!graph_has_sink(&s_active_graph)) {
+            printf("Warning: Loaded graph has no sink, creating default\n");
             create_default_graph();
         } else if (graph_build_eval_plan(&s_active_graph, &s_eval_plan) != STATUS_OK) {
             printf("Warning: Loaded graph invalid, creating default\n");
@@ -208,6 +279,16 @@ static int app_init(void)
     scr_printf("  graph_eval_init_outputs...\n");
     /* Initialize output bank */
     graph_eval_init_outputs(&s_output_bank);
+    eval_slicer_init(&s_slicer, EVAL_SLICE_DEFAULT_BUDGET_US);
+    eval_stepper_init(&s_stepper, EVAL_STEP_RATE_FRAME);
+    graph_probe_init(&s_probes);
+    graph_eval_set_probes(&s_probes);
+    ui_editor_set_probes(&s_probes);
+#ifdef LGS_NODE_PROFILER
+    node_profile_reset(&s_node_profile);
+    graph_eval_set_profile(&s_node_profile);
+    ui_editor_set_profile(&s_node_profile);
+#endif
 
     printf("PS2 Live Graph Studio initialized\n");
     return 0;
@@ -226,18 +307,39 @@ static void app_shutdown(void)
     printf("PS2 Live Graph Studio shutdown\n");
 }
 
+/* ============================================================
+ * Fixed-Step Mode
+ * ============================================================
+ * While stepping, s_stepper's work bank holds the rate state and
+ * its context the frame count; hand both back when per-frame or
+ * sliced evaluation takes over.
+ * ============================================================ */
+static void app_stop_stepping(void)
+{
+    if (s_stepping) {
+        s_output_bank = s_stepper.work;
+        eval_stepper_handoff(&s_stepper, &s_runtime);
+        s_stepping = 0;
+    }
+}
+
 /* ============================================================
  * Update
  * ============================================================ */
 static void app_update(void)
 {
     float dt;
+    uint16_t sim_rate;
 
     /* Update timing */
+    LGS_PROF_BEGIN(PROF_ZONE_TIMING);
     dt = timing_update();
+    LGS_PROF_END(PROF_ZONE_TIMING);
 
     /* Poll controller */
+    LGS_PROF_BEGIN(PROF_ZONE_PAD);
     pad_update(0, &s_pad);
+    LGS_PROF_END(PROF_ZONE_PAD);
 
     /* Update runtime context */
     runtime_update_timing(&s_runtime, dt);
@@ -251,6 +353,7 @@ static void app_update(void)
                        s_pad.held);
 
     /* Update editor (handles input, mode transitions) */
+    LGS_PROF_BEGIN(PROF_ZONE_EDITOR);
     editor_update(&s_editor, &s_runtime, &s_active_graph);
 
     /* Rebuild eval plan if graph was committed */
@@ -259,9 +362,44 @@ static void app_update(void)
             printf("Warning: Failed to rebuild eval plan after commit\n");
         }
     }
+    LGS_PROF_END(PROF_ZONE_EDITOR);
+
+    /* Toggle time-sliced evaluation on L3 */
+    if ((s_pad.held & BTN_L3) && !(s_pad_prev.held & BTN_L3)) {
+        s_eval_sliced = !s_eval_sliced;
+        if (s_eval_sliced) {
+            app_stop_stepping();
+            eval_slicer_reset(&s_slicer, &s_output_bank);
+        } else {
+            s_output_bank = s_slicer.work;
+        }
+    }
 
-    /* Evaluate active graph */
-    graph_eval(&s_active_graph, &s_eval_plan, &s_output_bank, &s_runtime);
+    /* Evaluate active graph (time-sliced mode ignores the sim rate) */
+    LGS_PROF_BEGIN(PROF_ZONE_EVAL);
+    sim_rate = graph_eval_get_sim_rate();
+    graph_probe_set_rate(&s_probes, (!s_eval_sliced && sim_rate != EVAL_STEP_RATE_FRAME) ?
+                                    (float)sim_rate : PROBE_RATE_HZ);
+    if (s_eval_sliced) {
+        eval_slicer_step(&s_slicer, &s_active_graph, &s_eval_plan, &s_runtime);
+        s_display_bank = eval_slicer_front(&s_slicer);
+        s_steps = 1;
+    } else if (sim_rate != EVAL_STEP_RATE_FRAME) {
+        if (!s_stepping) {
+            eval_stepper_reset(&s_stepper, &s_output_bank, &s_runtime, sim_rate);
+            s_stepping = 1;
+        } else if (s_stepper.rate_hz != sim_rate) {
+            eval_stepper_set_rate(&s_stepper, sim_rate);
+        }
+        s_steps = eval_stepper_step(&s_stepper, &s_active_graph, &s_eval_plan, &s_runtime);
+        s_display_bank = eval_stepper_view(&s_stepper);
+    } else {
+        app_stop_stepping();
+        graph_eval(&s_active_graph, &s_eval_plan, &s_output_bank, &s_runtime);
+        s_display_bank = &s_output_bank;
+        s_steps = 1;
+    }
+    LGS_PROF_END(PROF_ZONE_EVAL);
 
     /* Check for exit (Select + Start) */
     if ((s_pad.held & 0x0001) && (s_pad.held & 0x0008)) {  /* SELECT + START */
@@ -289,76 +427,118 @@ static void app_update(void)
     s_pad_prev = s_pad;
 }
 
+#ifdef LGS_FRAME_PROFILER
 /* ============================================================
- * Render Graph Output (reads sink nodes and draws in preview area)
- * Preview area: top 65% of screen (0 to PREVIEW_HEIGHT)
+ * Frame Profiler Graph
+ * ============================================================
+ * Columns oldest to newest, each stage a segment of its self time;
+ * segments under a pixel carry over into the next. The legend lists
+ * stages averaged over the history, re-formatted every
+ * PROF_LEGEND_REFRESH frames.
  * ============================================================ */
-static void render_graph_output(void)
+static void app_prof_legend_refresh(const ProfHistory *h)
 {
-    NodeId i;
-    float x, y, w, h;
-    float r, g, b, a;
-    uint64_t color;
-
-    /* Find and render all RENDER2D sink nodes (full screen) */
-    for (i = 0; i < MAX_NODES; i++) {
-        const Node *node = &s_active_graph.nodes[i];
-        if (node->type != NODE_TYPE_RENDER2D) {
-            continue;
-        }
+    int z, i;
 
-        /* Read geometry from sink outputs (set by node_eval_render2d) */
-        x = graph_eval_get_output(&s_output_bank, i, 0);
-        y = graph_eval_get_output(&s_output_bank, i, 1);
-        w = graph_eval_get_output(&s_output_bank, i, 2);
-        h = graph_eval_get_output(&s_output_bank, i, 3);
+    s_prof_legend_count = 0;
+    for (z = 0; z < PROF_ZONE_COUNT; z++) {
+        float avg = 0.0f;
+        char *line;
+        int pos;
 
-        /* Skip if dimensions are too small (node not properly set up) */
-        if (w < 0.001f || h < 0.001f) {
-            continue;
-        }
-
-        /* Read color from connected inputs */
-        r = 1.0f;
-        g = 1.0f;
-        b = 1.0f;
-        a = 1.0f;
-
-        /* Gather color from connected nodes */
-        if (node->inputs[0].src_node != INVALID_NODE_ID) {
-            r = graph_eval_get_output(&s_output_bank,
-                                       node->inputs[0].src_node,
-                                       node->inputs[0].src_port);
+        for (i = 0; i < h->count; i++) {
+            avg += h->ms[i][z];
         }
-        if (node->inputs[1].src_node != INVALID_NODE_ID) {
-            g = graph_eval_get_output(&s_output_bank,
-                                       node->inputs[1].src_node,
-                                       node->inputs[1].src_port);
+        avg /= (float)(h->count ? h->count : 1);
+        if (avg < 0.005f) {
+            continue;
         }
-        if (node->inputs[2].src_node != INVALID_NODE_ID) {
-            b = graph_eval_get_output(&s_output_bank,
-                                       node->inputs[2].src_node,
-                                       node->inputs[2].src_port);
+        line = s_prof_legend[s_prof_legend_count];
+        s_prof_legend_zone[s_prof_legend_count++] = (uint8_t)z;
+        pos = text_fmt_str(line, PROF_LEGEND_LEN, 0, profiler_zone_name((ProfZone)z));
+        while (pos < 7) {
+            pos = text_fmt_char(line, PROF_LEGEND_LEN, pos, ' ');
         }
-        if (node->inputs[3].src_node != INVALID_NODE_ID) {
-            a = graph_eval_get_output(&s_output_bank,
-                                       node->inputs[3].src_node,
-                                       node->inputs[3].src_port);
+        pos = text_fmt_fixed(line, PROF_LEGEND_LEN, pos, avg, 2);
+        text_fmt_str(line, PROF_LEGEND_LEN, pos, "ms");
+    }
+}
+
+static void app_draw_profiler(void)
+{
+    const ProfHistory *h = profiler_history();
+    int x0 = render_get_width() - 10 - PROF_HISTORY;
+    int y_base = PROF_GRAPH_Y + PROF_GRAPH_H;
+    float px_per_ms = (float)PROF_GRAPH_H * (float)timing_get_target_fps() / 2000.0f;
+    int i, z;
+
+    render_rect_screen(x0, PROF_GRAPH_Y, PROF_HISTORY, PROF_GRAPH_H, RENDER_COLOR(0, 0, 0, 80));
+
+    for (i = 0; i < h->count; i++) {
+        int slot = (h->head + PROF_HISTORY - h->count + i) % PROF_HISTORY;
+        int x = x0 + PROF_HISTORY - h->count + i;
+        float top = 0.0f;
+        int drawn = 0;
+
+        for (z = 0; z < PROF_ZONE_COUNT && drawn < PROF_GRAPH_H; z++) {
+            int end;
+            top += h->ms[slot][z] * px_per_ms;
+            end = (int)(top + 0.5f);
+            if (end > PROF_GRAPH_H) {
+                end = PROF_GRAPH_H;
+            }
+            if (end > drawn) {
+                render_rect_screen(x, y_base - end, 1, end - drawn, s_prof_colors[z]);
+                drawn = end;
+            }
         }
+    }
+
+    /* Frame budget */
+    render_rect_screen(x0, y_base - PROF_GRAPH_H / 2, PROF_HISTORY, 1, RENDER_COLOR_WHITE);
 
-        /* Clamp color values to 0-1 and convert to 0-255 */
-        r = LGS_CLAMP(r, 0.0f, 1.0f);
-        g = LGS_CLAMP(g, 0.0f, 1.0f);
-        b = LGS_CLAMP(b, 0.0f, 1.0f);
-        a = LGS_CLAMP(a, 0.0f, 1.0f);
+    if (s_prof_legend_frame == 0 || profiler_frame() - s_prof_legend_frame >= PROF_LEGEND_REFRESH) {
+        s_prof_legend_frame = profiler_frame();
+        app_prof_legend_refresh(h);
+    }
+    for (i = 0; i < s_prof_legend_count; i++) {
+        int y = y_base + 4 + i * 10;
+        render_rect_screen(x0, y, 6, 6, s_prof_colors[s_prof_legend_zone[i]]);
+        font_draw_string_screen(s_prof_legend[i], x0 + 10, y, RENDER_COLOR_GRAY, 1);
+    }
+    if (profiler_export_status() < 0) {
+        font_draw_string_screen("TRACE FAILED", x0, y_base + 4 + i * 10,
+                                RENDER_COLOR(255, 80, 80, 128), 1);
+    }
+}
+#endif
 
-        color = RENDER_COLOR((uint8_t)(r * 255.0f),
-                             (uint8_t)(g * 255.0f),
-                             (uint8_t)(b * 255.0f),
-                             (uint8_t)(a * 128.0f));  /* Alpha 0-128 for gsKit */
+/* ============================================================
+ * Frame Pacing Histogram
+ * ============================================================
+ * Bins of |frame time - target period|, doubling from 0.25ms; the
+ * first two are on time, the last is a dropped frame or worse.
+ * ============================================================ */
+static void app_draw_jitter(const TimingStats *ts)
+{
+    int x0 = render_get_width() - 80;
+    int bin;
 
-        /* Draw rectangle at normalized coordinates (full screen) */
-        render_rect(x, y, w, h, color);
+    if (ts->frames == 0) {
+        return;
+    }
+    for (bin = 0; bin < TIMING_JITTER_BINS; bin++) {
+        int h = (int)(((uint32_t)ts->jitter[bin] * HUD_JITTER_H + ts->frames - 1) / ts->frames);
+        int x = x0 + bin * (HUD_JITTER_BAR_W + HUD_JITTER_GAP);
+        uint64_t color = bin < 2 ? RENDER_COLOR(80, 200, 80, 128) :
+                         bin < 5 ? RENDER_COLOR(220, 200, 60, 128) :
+                                   RENDER_COLOR(220, 60, 60, 128);
+
+        render_rect_screen(x, HUD_JITTER_Y, HUD_JITTER_BAR_W, HUD_JITTER_H,
+                           RENDER_COLOR(0, 0, 0, 60));
+        if (h > 0) {
+            render_rect_screen(x, HUD_JITTER_Y + HUD_JITTER_H - h, HUD_JITTER_BAR_W, h, color);
+        }
     }
 }
 
@@ -367,32 +547,76 @@ static void render_graph_output(void)
  * ============================================================ */
 static void app_render(void)
 {
+    FontStats text_stats;
+    UiEditorDrawStats ui_stats;
+    TimingStats timing_stats;
+    int line;
+
+    LGS_PROF_BEGIN(PROF_ZONE_RENDER);
+
+    /* Text and editor primitive counts of the previous frame */
+    font_get_stats(&text_stats);
+    font_stats_reset();
+    ui_editor_get_draw_stats(&ui_stats);
+    ui_editor_draw_stats_reset();
+
     /* Begin frame */
     render_begin_frame();
     render_clear(RENDER_COLOR(20, 20, 30, 128));
 
-    /* Render graph output first (background layer - full screen) */
-    render_graph_output();
+    /* Render graph output first (scene and particle layers - full screen) */
+    LGS_PROF_BEGIN(PROF_ZONE_SINKS);
+    render_sinks(&s_active_graph, &s_eval_plan, s_display_bank);
+    LGS_PROF_END(PROF_ZONE_SINKS);
 
     /* Draw editor UI overlay on top (if visible) */
     if (s_editor_visible) {
+        LGS_PROF_BEGIN(PROF_ZONE_UI);
         editor_draw(&s_editor);
+        LGS_PROF_END(PROF_ZONE_UI);
     }
 
-    /* Draw FPS counter */
-    font_printf_screen(RENDER_SCREEN_WIDTH - 80, 10, RENDER_COLOR_WHITE, 1,
-                       "FPS: %d", timing_get_target_fps());
-    font_printf_screen(RENDER_SCREEN_WIDTH - 80, 22, RENDER_COLOR_WHITE, 1,
-                       "dt: %.3f", (double)timing_get_dt());
+    /* HUD draws over everything */
+    render_set_layer(DL_LAYER_HUD);
+
+    /* Draw HUD lines (FPS, dt, frame times, missed, frame, N, B, E, S, T, U) */
+    timing_get_stats(&timing_stats);
+    text_label_u32(&s_hud[HUD_FPS], (uint32_t)(timing_stats.fps + 0.5f));
+    text_label_fixed(&s_hud[HUD_DT], timing_get_dt());
+    text_label_fixed(&s_hud[HUD_FT_AVG], timing_stats.avg_ms);
+    text_label_fixed(&s_hud[HUD_FT_MIN], timing_stats.min_ms);
+    text_label_fixed(&s_hud[HUD_FT_MAX], timing_stats.max_ms);
+    text_label_fixed(&s_hud[HUD_FT_P99], timing_stats.p99_ms);
+    text_label_u32(&s_hud[HUD_MISSED], timing_stats.missed_vsyncs);
+    text_label_u32(&s_hud[HUD_FRAME], timing_get_frame());
+    text_label_u32_pair(&s_hud[HUD_NODES], s_display_bank->stat_evaluated, s_eval_plan.count);
+    text_label_u32(&s_hud[HUD_BRANCH], s_display_bank->stat_branch_skipped);
+    text_label_u32(&s_hud[HUD_EVAL], s_eval_sliced ? eval_slicer_latency(&s_slicer) : 1u);
+    text_label_u32_pair(&s_hud[HUD_STEP], s_steps, s_stepping ? s_stepper.rate_hz : 0u);
+    text_label_u32_pair(&s_hud[HUD_TEXT], text_stats.prims, text_stats.pixel_prims);
+    text_label_u32_pair(&s_hud[HUD_UI], ui_stats.generated, ui_stats.replayed);
+
+    for (line = 0; line < HUD_LINE_COUNT; line++) {
+        uint64_t color = RENDER_COLOR_GRAY;
+        if (line <= HUD_FT_AVG || (line == HUD_EVAL && s_eval_sliced) ||
+            (line == HUD_STEP && s_stepping)) {
+            color = RENDER_COLOR_WHITE;
+        } else if (line == HUD_MISSED && timing_stats.missed_vsyncs > 0) {
+            color = RENDER_COLOR(255, 120, 80, 128);
+        }
+        font_draw_string_screen(text_label_str(&s_hud[line]), render_get_width() - 80,
+                                10 + line * 12, color, 1);
+    }
+    app_draw_jitter(&timing_stats);
 
-    /* Draw frame counter */
-    font_printf_screen(RENDER_SCREEN_WIDTH - 80, 34, RENDER_COLOR_GRAY, 1,
-                       "F: %u", timing_get_frame());
+#ifdef LGS_FRAME_PROFILER
+    app_draw_profiler();
+#endif
 
     /* Draw editor toggle hint */
     if (!s_editor_visible) {
-        font_printf_screen(10, SCREEN_H - 16, RENDER_COLOR_GRAY, 1,
-                           "R3: Show Editor");
+        font_draw_string_screen("R3: Show Editor", 10, SCREEN_H - 16,
+                                RENDER_COLOR_GRAY, 1);
     }
 
     /* Draw asset error banner if preload failed */
@@ -404,8 +628,12 @@ static void app_render(void)
                            "Asset load failed: %s (running fallback)", s_asset_error);
     }
 
-    /* End frame */
+    LGS_PROF_END(PROF_ZONE_RENDER);
+
+    /* End frame (flush, kick, vsync) */
+    LGS_PROF_BEGIN(PROF_ZONE_FLIP);
     render_end_frame();
+    LGS_PROF_END(PROF_ZONE_FLIP);
 }
 
 /* ============================================================
@@ -431,8 +659,10 @@ int main(int argc, char *argv[])
 
     /* Main loop */
     while (s_running) {
+        LGS_PROF_FRAME_BEGIN();
         app_update();
         app_render();
+        LGS_PROF_FRAME_END();
     }
 
     /* Shutdown */
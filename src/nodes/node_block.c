@@ -0,0 +1,511 @@
+/*
+ * PS2 Live Graph Studio - Block Node Kernels
+ * node_block.c - Block-rate (K samples per call) versions of nodes
+ *
+ * Each kernel must match its per-sample NodeEvalFunc (up to float
+ * rounding) run with time = ctx->time + i * sample_dt, dt = sample_dt.
+ * Stateful kernels (NOISE, SMOOTH) share state_u32 layout with the
+ * scalar versions so a graph can switch modes without resetting.
+ */
+
+#include "node_registry.h"
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846f
+#endif
+
+/* ============================================================
+ * Helpers
+ * ============================================================ */
+static void block_fill(float *out, float value, uint32_t n)
+{
+    uint32_t i;
+    for (i = 0; i < n; i++) {
+        out[i] = value;
+    }
+}
+
+/* Zero output ports [first, MAX_OUT_PORTS) */
+static void block_zero_from(float *const outputs[MAX_OUT_PORTS], int first, uint32_t n)
+{
+    int p;
+    for (p = first; p < MAX_OUT_PORTS; p++) {
+        block_fill(outputs[p], 0.0f, n);
+    }
+}
+
+/* ============================================================
+ * Sources
+ * ============================================================ */
+void node_block_const(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                      float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                      const RuntimeContext *ctx)
+{
+    (void)inputs;
+    (void)ctx;
+
+    block_fill(outputs[0], node->params[0], n);
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_time(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                     float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                     const RuntimeContext *ctx)
+{
+    float scale = node->params[0];
+    float *restrict out = outputs[0];
+    uint32_t i;
+    (void)inputs;
+
+    if (scale == 0.0f) scale = 1.0f;
+
+    for (i = 0; i < n; i++) {
+        out[i] = (ctx->time + (float)i * ctx->sample_dt) * scale;
+    }
+    block_fill(outputs[1], ctx->sample_dt * scale, n);
+    block_zero_from(outputs, 2, n);
+}
+
+/* Same LCG and state layout as node_eval_noise */
+void node_block_noise(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                      float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                      const RuntimeContext *ctx)
+{
+    uint32_t *state = (uint32_t *)&((Node *)node)->state_u32[0];
+    float *smooth = (float *)&((Node *)node)->state_u32[1];
+    float speed = node->params[0];
+    uint32_t seed, i;
+    float s, blend;
+    (void)inputs;
+
+    if (speed < 0.1f) speed = 1.0f;
+    if (*state == 0) {
+        *state = (uint32_t)(ctx->time * 1000.0f) + 1;
+    }
+
+    /* Blend is constant across the block: one expf per block */
+    blend = 1.0f - expf(-speed * ctx->sample_dt);
+    seed = *state;
+    s = *smooth;
+
+    for (i = 0; i < n; i++) {
+        float raw;
+        seed = (seed * 1103515245u + 12345u) & 0x7fffffffu;
+        raw = (float)(seed & 0xFFFF) / 65535.0f;
+        s = s + (raw - s) * blend;
+        outputs[0][i] = raw;
+        outputs[1][i] = s;
+        outputs[2][i] = raw * 2.0f - 1.0f;
+    }
+
+    *state = seed;
+    *smooth = s;
+    block_zero_from(outputs, 3, n);
+}
+
+void node_block_lfo(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    float freq = node->params[0];
+    float phase = node->params[1];
+    int shape = (int)node->params[2];
+    float t0, dt_phase;
+    uint32_t i;
+    (void)inputs;
+
+    if (freq < 0.001f) freq = 1.0f;
+
+    /* Phase advances linearly; wrap once per sample instead of fmodf */
+    t0 = fmodf(ctx->time * freq + phase, 1.0f);
+    if (t0 < 0.0f) t0 += 1.0f;
+    dt_phase = ctx->sample_dt * freq;
+
+    for (i = 0; i < n; i++) {
+        float t = t0 + (float)i * dt_phase;
+        float value;
+
+        t -= (float)(int)t;
+
+        switch (shape) {
+            case 1:  value = t < 0.5f ? (t * 4.0f - 1.0f) : (3.0f - t * 4.0f); break;
+            case 2:  value = t * 2.0f - 1.0f; break;
+            case 3:  value = t < 0.5f ? 1.0f : -1.0f; break;
+            default: value = sinf(t * 2.0f * M_PI); break;
+        }
+
+        outputs[0][i] = value;
+        outputs[1][i] = (value + 1.0f) * 0.5f;
+        outputs[2][i] = t;
+    }
+    block_zero_from(outputs, 3, n);
+}
+
+/* ============================================================
+ * Math (branch-free loops, vectorizable)
+ * ============================================================ */
+void node_block_add(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    const float *restrict b = inputs[1];
+    float *restrict out = outputs[0];
+    uint32_t i;
+    (void)node;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        out[i] = a[i] + b[i];
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_sub(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    const float *restrict b = inputs[1];
+    float *restrict out = outputs[0];
+    uint32_t i;
+    (void)node;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        out[i] = a[i] - b[i];
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_mul(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    const float *restrict b = inputs[1];
+    float *restrict out = outputs[0];
+    uint32_t i;
+    (void)node;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        out[i] = a[i] * b[i];
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_abs(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    float *restrict out = outputs[0];
+    uint32_t i;
+    (void)node;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        out[i] = fabsf(a[i]);
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_neg(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    float *restrict out = outputs[0];
+    uint32_t i;
+    (void)node;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        out[i] = -a[i];
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_min(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    const float *restrict b = inputs[1];
+    float *restrict out = outputs[0];
+    uint32_t i;
+    (void)node;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        out[i] = a[i] < b[i] ? a[i] : b[i];
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_max(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    const float *restrict b = inputs[1];
+    float *restrict out = outputs[0];
+    uint32_t i;
+    (void)node;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        out[i] = a[i] > b[i] ? a[i] : b[i];
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_div(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    const float *restrict b = inputs[1];
+    float *restrict out = outputs[0];
+    uint32_t i;
+    (void)node;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        out[i] = fabsf(b[i]) < 0.0001f ? 0.0f : a[i] / b[i];
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_clamp(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                      float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                      const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    float *restrict out = outputs[0];
+    float lo = node->params[0];
+    float hi = node->params[1];
+    uint32_t i;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        float v = a[i] < lo ? lo : a[i];
+        out[i] = v > hi ? hi : v;
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_map(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    float *restrict out = outputs[0];
+    float *restrict norm = outputs[1];
+    float in_min = node->params[0];
+    float in_max = node->params[1];
+    float out_min = node->params[2];
+    float out_max = node->params[3];
+    float in_range = in_max - in_min;
+    uint32_t i;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        float t = fabsf(in_range) < 0.0001f ? 0.0f : (a[i] - in_min) / in_range;
+        out[i] = out_min + t * (out_max - out_min);
+        norm[i] = t;
+    }
+    block_zero_from(outputs, 2, n);
+}
+
+/* ============================================================
+ * Trigonometry
+ * ============================================================ */
+void node_block_sin(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    float *restrict out = outputs[0];
+    float freq = node->params[0];
+    float amp = node->params[1];
+    uint32_t i;
+    (void)ctx;
+
+    if (freq == 0.0f) freq = 1.0f;
+    if (amp == 0.0f) amp = 1.0f;
+
+    for (i = 0; i < n; i++) {
+        out[i] = sinf(a[i] * freq) * amp;
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_cos(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                    float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                    const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    float *restrict out = outputs[0];
+    float freq = node->params[0];
+    float amp = node->params[1];
+    uint32_t i;
+    (void)ctx;
+
+    if (freq == 0.0f) freq = 1.0f;
+    if (amp == 0.0f) amp = 1.0f;
+
+    for (i = 0; i < n; i++) {
+        out[i] = cosf(a[i] * freq) * amp;
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+/* ============================================================
+ * Filters
+ * ============================================================ */
+void node_block_lerp(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                     float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                     const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    const float *restrict b = inputs[1];
+    const float *restrict tv = inputs[2];
+    float *restrict out = outputs[0];
+    uint32_t i;
+    (void)node;
+    (void)ctx;
+
+    for (i = 0; i < n; i++) {
+        float t = LGS_CLAMP(tv[i], 0.0f, 1.0f);
+        out[i] = a[i] + (b[i] - a[i]) * t;
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+/* Same state layout as node_eval_smooth (state_u32[0] = value) */
+void node_block_step(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                     float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                     const RuntimeContext *ctx)
+{
+    const float *restrict a = inputs[0];
+    float *restrict out = outputs[0];
+    float threshold = node->params[0];
+    float edge = node->params[1];
+    uint32_t i;
+    (void)ctx;
+
+    if (edge < 0.001f) {
+        for (i = 0; i < n; i++) {
+            out[i] = a[i] >= threshold ? 1.0f : 0.0f;
+        }
+    } else {
+        float scale = 1.0f / (2.0f * edge);
+        for (i = 0; i < n; i++) {
+            float t = (a[i] - threshold + edge) * scale;
+            t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+            out[i] = t * t * (3.0f - 2.0f * t);
+        }
+    }
+    block_zero_from(outputs, 1, n);
+}
+
+void node_block_smooth(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                       float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                       const RuntimeContext *ctx)
+{
+    float *state = (float *)&((Node *)node)->state_u32[0];
+    float speed = node->params[0];
+    float current = *state;
+    float blend;
+    uint32_t i;
+
+    if (speed < 0.1f) speed = 0.1f;
+    blend = 1.0f - expf(-speed * ctx->sample_dt);
+
+    for (i = 0; i < n; i++) {
+        current = current + (inputs[0][i] - current) * blend;
+        outputs[0][i] = current;
+    }
+
+    *state = current;
+    block_zero_from(outputs, 1, n);
+}
+
+/* ============================================================
+ * Fragment
+ * ============================================================
+ * Lanes are consecutive pixels of one row (see RuntimeContext
+ * frag_*); outside fragment mode these match the scalar zeros.
+ * ============================================================ */
+void node_block_uv(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                   float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                   const RuntimeContext *ctx)
+{
+    float *restrict u = outputs[0];
+    float *restrict cx = outputs[2];
+    float w, h, x0, inv_w, aspect, v;
+    uint32_t i;
+    (void)node;
+    (void)inputs;
+
+    if (ctx->frag_width == 0 || ctx->frag_height == 0) {
+        block_zero_from(outputs, 0, n);
+        return;
+    }
+
+    w = (float)ctx->frag_width;
+    h = (float)ctx->frag_height;
+    x0 = (float)ctx->frag_x + 0.5f;
+    inv_w = 1.0f / w;
+    aspect = w / h;
+    v = ((float)ctx->frag_y + 0.5f) / h;
+
+    for (i = 0; i < n; i++) {
+        float ui = (x0 + (float)i) * inv_w;
+        u[i] = ui;
+        cx[i] = (ui * 2.0f - 1.0f) * aspect;
+    }
+    block_fill(outputs[1], v, n);
+    block_fill(outputs[3], v * 2.0f - 1.0f, n);
+}
+
+void node_block_pixel(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                      float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                      const RuntimeContext *ctx)
+{
+    float *restrict x = outputs[0];
+    float x0 = (float)ctx->frag_x;
+    uint32_t i;
+    (void)node;
+    (void)inputs;
+
+    for (i = 0; i < n; i++) {
+        x[i] = x0 + (float)i;
+    }
+    block_fill(outputs[1], (float)ctx->frag_y, n);
+    block_fill(outputs[2], (float)ctx->frag_width, n);
+    block_fill(outputs[3], (float)ctx->frag_height, n);
+}
+
+void node_block_frag_out(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                         float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                         const RuntimeContext *ctx)
+{
+    uint32_t i;
+    int c;
+    (void)node;
+    (void)ctx;
+
+    for (c = 0; c < 3; c++) {
+        const float *restrict in = inputs[c];
+        float *restrict out = outputs[c];
+        for (i = 0; i < n; i++) {
+            float v = in[i] < 0.0f ? 0.0f : in[i];
+            out[i] = v > 1.0f ? 1.0f : v;
+        }
+    }
+    block_zero_from(outputs, 3, n);
+}
@@ -0,0 +1,74 @@
+/*
+ * PS2 Live Graph Studio - Fragment Nodes
+ * node_fragment.c - Pixel coordinate sources and the FRAG_OUT sink
+ *
+ * These nodes only vary per pixel under graph_eval_fragment, which
+ * sets ctx->frag_*. In frame mode (frag_width == 0) the coordinate
+ * sources output zeros.
+ */
+
+#include "node_registry.h"
+
+/* ============================================================
+ * NODE_TYPE_UV: Normalized pixel-centre coordinates
+ * ============================================================
+ * out0 u:  0..1 left to right
+ * out1 v:  0..1 top to bottom
+ * out2 cx: -aspect..aspect, 0 at the image centre
+ * out3 cy: -1..1, 0 at the image centre
+ */
+void node_eval_uv(const Node *node, const float inputs[MAX_IN_PORTS],
+                  float outputs[MAX_OUT_PORTS], const RuntimeContext *ctx)
+{
+    float w, h, u, v;
+    (void)node;
+    (void)inputs;
+
+    if (ctx->frag_width == 0 || ctx->frag_height == 0) {
+        outputs[0] = outputs[1] = outputs[2] = outputs[3] = 0.0f;
+        return;
+    }
+
+    w = (float)ctx->frag_width;
+    h = (float)ctx->frag_height;
+    u = ((float)ctx->frag_x + 0.5f) / w;
+    v = ((float)ctx->frag_y + 0.5f) / h;
+    outputs[0] = u;
+    outputs[1] = v;
+    outputs[2] = (u * 2.0f - 1.0f) * (w / h);
+    outputs[3] = v * 2.0f - 1.0f;
+}
+
+/* ============================================================
+ * NODE_TYPE_PIXEL: Pixel coordinates and image size
+ * ============================================================ */
+void node_eval_pixel(const Node *node, const float inputs[MAX_IN_PORTS],
+                     float outputs[MAX_OUT_PORTS], const RuntimeContext *ctx)
+{
+    (void)node;
+    (void)inputs;
+
+    outputs[0] = (float)ctx->frag_x;
+    outputs[1] = (float)ctx->frag_y;
+    outputs[2] = (float)ctx->frag_width;
+    outputs[3] = (float)ctx->frag_height;
+}
+
+/* ============================================================
+ * NODE_TYPE_FRAG_OUT: Per-pixel color sink
+ * ============================================================
+ * Passes r, g, b through clamped to 0..1; the fragment renderer
+ * packs the outputs into the image. Unconnected channels are 0.
+ */
+void node_eval_frag_out(const Node *node, const float inputs[MAX_IN_PORTS],
+                        float outputs[MAX_OUT_PORTS], const RuntimeContext *ctx)
+{
+    int i;
+    (void)node;
+    (void)ctx;
+
+    for (i = 0; i < 3; i++) {
+        outputs[i] = LGS_CLAMP(inputs[i], 0.0f, 1.0f);
+    }
+    outputs[3] = 0.0f;
+}
@@ -0,0 +1,365 @@
+/*
+ * PS2 Live Graph Studio - Particle System
+ * node_particles.c - SoA particle pools and the PARTICLES node
+ */
+
+#include "node_particles.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846f
+#endif
+
+/* Highest spawn rate the node accepts (particles per second) */
+#define PARTICLE_RATE_MAX 2000.0f
+
+/* ============================================================
+ * Random Helpers
+ * ============================================================ */
+static uint32_t particle_rand(uint32_t *seed)
+{
+    *seed = (*seed * 1103515245u + 12345u) & 0x7fffffffu;
+    return *seed;
+}
+
+/* Uniform float in [0, 1] */
+static float particle_randf(uint32_t *seed)
+{
+    return (float)(particle_rand(seed) & 0xFFFF) / 65535.0f;
+}
+
+/* ============================================================
+ * Pool Init / Clear
+ * ============================================================ */
+void particle_pool_init(ParticlePool *pool, float *float_storage,
+                        uint32_t *color_storage, uint32_t capacity)
+{
+    if (!pool) {
+        return;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    if (!float_storage || !color_storage) {
+        return;
+    }
+
+    /* Carve the float block into one contiguous array per field */
+    pool->pos_x = float_storage;
+    pool->pos_y = float_storage + capacity;
+    pool->vel_x = float_storage + capacity * 2;
+    pool->vel_y = float_storage + capacity * 3;
+    pool->age   = float_storage + capacity * 4;
+    pool->life  = float_storage + capacity * 5;
+    pool->color = color_storage;
+    pool->capacity = capacity;
+    pool->seed = 0x1234567u;
+}
+
+void particle_pool_clear(ParticlePool *pool)
+{
+    if (!pool) {
+        return;
+    }
+    pool->count = 0;
+    pool->spawn_accum = 0.0f;
+}
+
+/* ============================================================
+ * Spawn
+ * ============================================================
+ * New particles are appended at [count, count + n).
+ * Direction is "up" (-Y) jittered by +/- spread/2.
+ * ============================================================ */
+uint32_t particle_pool_spawn(ParticlePool *pool, const ParticleEmitter *em, uint32_t n)
+{
+    uint32_t i, end;
+    float life;
+
+    if (!pool || !em || pool->count >= pool->capacity) {
+        return 0;
+    }
+
+    if (n > pool->capacity - pool->count) {
+        n = pool->capacity - pool->count;
+    }
+
+    life = em->life > 0.01f ? em->life : 0.01f;
+    end = pool->count + n;
+
+    for (i = pool->count; i < end; i++) {
+        float angle = -(float)M_PI * 0.5f +
+                      (particle_randf(&pool->seed) - 0.5f) * em->spread;
+        float speed = em->speed * (0.5f + 0.5f * particle_randf(&pool->seed));
+
+        pool->pos_x[i] = em->x;
+        pool->pos_y[i] = em->y;
+        pool->vel_x[i] = cosf(angle) * speed;
+        pool->vel_y[i] = sinf(angle) * speed;
+        pool->age[i] = 0.0f;
+        pool->life[i] = life * (0.75f + 0.25f * particle_randf(&pool->seed));
+        pool->color[i] = em->color;
+    }
+
+    pool->count = end;
+    return n;
+}
+
+/* ============================================================
+ * Integrate
+ * ============================================================
+ * Branch-free loops over restrict-qualified arrays so the compiler
+ * can vectorize them (SSE on host, 128-bit MMI-friendly on EE).
+ * ============================================================ */
+void particle_pool_integrate(ParticlePool *pool, float force_x, float force_y, float dt)
+{
+    float *restrict px = pool->pos_x;
+    float *restrict py = pool->pos_y;
+    float *restrict vx = pool->vel_x;
+    float *restrict vy = pool->vel_y;
+    float *restrict age = pool->age;
+    const float ax = force_x * dt;
+    const float ay = force_y * dt;
+    uint32_t n = pool->count;
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        vx[i] += ax;
+        vy[i] += ay;
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        age[i] += dt;
+    }
+}
+
+/* ============================================================
+ * Compact (swap-remove dead particles)
+ * ============================================================
+ * Order is not preserved; the last live particle fills each hole.
+ * ============================================================ */
+void particle_pool_compact(ParticlePool *pool)
+{
+    uint32_t i = 0;
+    uint32_t n = pool->count;
+
+    while (i < n) {
+        if (pool->age[i] < pool->life[i]) {
+            i++;
+            continue;
+        }
+
+        n--;
+        pool->pos_x[i] = pool->pos_x[n];
+        pool->pos_y[i] = pool->pos_y[n];
+        pool->vel_x[i] = pool->vel_x[n];
+        pool->vel_y[i] = pool->vel_y[n];
+        pool->age[i] = pool->age[n];
+        pool->life[i] = pool->life[n];
+        pool->color[i] = pool->color[n];
+    }
+
+    pool->count = n;
+}
+
+/* ============================================================
+ * Update (integrate -> compact -> spawn)
+ * ============================================================
+ * Spawning last means fresh particles start exactly at the
+ * emitter with age 0 on the frame they appear.
+ * ============================================================ */
+uint32_t particle_pool_update(ParticlePool *pool, const ParticleEmitter *em,
+                              float rate, float force_x, float force_y, float dt)
+{
+    uint32_t n;
+
+    if (!pool || pool->capacity == 0) {
+        return 0;
+    }
+
+    particle_pool_integrate(pool, force_x, force_y, dt);
+    particle_pool_compact(pool);
+
+    if (rate <= 0.0f || dt <= 0.0f) {
+        pool->spawn_accum = 0.0f;
+        return 0;
+    }
+
+    pool->spawn_accum += rate * dt;
+    n = (uint32_t)pool->spawn_accum;
+    pool->spawn_accum -= (float)n;
+
+    return particle_pool_spawn(pool, em, n);
+}
+
+/* ============================================================
+ * Node Pools
+ * ============================================================
+ * A PARTICLES node stores (slot + 1) in state_u32[0]. Because
+ * graph_publish copies node state from the edit graph, the slot
+ * also records its owner node so a stale index is never trusted.
+ * A pool is released only when a new plan no longer contains its
+ * owner (node deleted): owners may legitimately skip frames (update
+ * rate, closed branch, time slicing, fixed steps) and keep theirs.
+ *
+ * Memory usage: see PARTICLE_POOL_COUNT in node_particles.h
+ * ============================================================ */
+static float        s_pool_floats[PARTICLE_POOL_COUNT][PARTICLE_POOL_FLOATS(PARTICLE_POOL_CAPACITY)];
+static uint32_t     s_pool_colors[PARTICLE_POOL_COUNT][PARTICLE_POOL_CAPACITY];
+static ParticlePool s_pools[PARTICLE_POOL_COUNT];
+static const Node  *s_pool_owner[PARTICLE_POOL_COUNT];
+static uint32_t     s_pool_plan_serial = 0;  /* Plan owners were checked against */
+
+void particles_sync_plan(const Graph *graph, const EvalPlan *plan)
+{
+    uint16_t count, k;
+    uint32_t i;
+
+    if (!graph || !plan || plan->serial == s_pool_plan_serial) {
+        return;
+    }
+    s_pool_plan_serial = plan->serial;
+
+    count = (plan->count <= MAX_NODES) ? plan->count : MAX_NODES;
+    for (i = 0; i < PARTICLE_POOL_COUNT; i++) {
+        int live = 0;
+
+        if (s_pool_owner[i] == NULL) {
+            continue;
+        }
+        for (k = 0; k < count && !live; k++) {
+            NodeId id = plan->order[k];
+            live = id < MAX_NODES && &graph->nodes[id] == s_pool_owner[i] &&
+                   graph->nodes[id].type == NODE_TYPE_PARTICLES;
+        }
+        if (!live) {
+            s_pool_owner[i] = NULL;
+        }
+    }
+}
+
+static ParticlePool *particles_bind_pool(const Node *node)
+{
+    uint32_t *slot_state = (uint32_t *)&((Node *)node)->state_u32[0];
+    uint32_t slot = *slot_state;
+    uint32_t i;
+
+    /* Fast path: cached slot still owned by this node */
+    if (slot >= 1 && slot <= PARTICLE_POOL_COUNT && s_pool_owner[slot - 1] == node) {
+        return &s_pools[slot - 1];
+    }
+
+    /* Slot lost (state copied from edit graph): look up by owner */
+    for (i = 0; i < PARTICLE_POOL_COUNT; i++) {
+        if (s_pool_owner[i] == node) {
+            *slot_state = i + 1;
+            return &s_pools[i];
+        }
+    }
+
+    /* Claim a free pool */
+    for (i = 0; i < PARTICLE_POOL_COUNT; i++) {
+        if (s_pool_owner[i] == NULL) {
+            particle_pool_init(&s_pools[i], s_pool_floats[i], s_pool_colors[i],
+                               PARTICLE_POOL_CAPACITY);
+            s_pools[i].seed = 0x1234567u + i * 7919u;
+            s_pool_owner[i] = node;
+            *slot_state = i + 1;
+            return &s_pools[i];
+        }
+    }
+
+    *slot_state = 0;
+    return NULL;
+}
+
+const ParticlePool *particles_get_pool(const Node *node)
+{
+    uint32_t slot;
+
+    if (!node || node->type != NODE_TYPE_PARTICLES) {
+        return NULL;
+    }
+
+    slot = node->state_u32[0];
+    if (slot < 1 || slot > PARTICLE_POOL_COUNT || s_pool_owner[slot - 1] != node) {
+        return NULL;
+    }
+    return &s_pools[slot - 1];
+}
+
+/* ============================================================
+ * Hue -> packed RGBA (render color layout, alpha 128 = opaque)
+ * ============================================================ */
+static uint32_t particles_hue_color(float h)
+{
+    float r, g, b;
+    float f;
+    int hi;
+
+    h = fmodf(h, 1.0f);
+    if (h < 0.0f) h += 1.0f;
+
+    hi = (int)(h * 6.0f);
+    f = h * 6.0f - (float)hi;
+
+    switch (hi % 6) {
+        case 0:  r = 1.0f;     g = f;        b = 0.0f;     break;
+        case 1:  r = 1.0f - f; g = 1.0f;     b = 0.0f;     break;
+        case 2:  r = 0.0f;     g = 1.0f;     b = f;        break;
+        case 3:  r = 0.0f;     g = 1.0f - f; b = 1.0f;     break;
+        case 4:  r = f;        g = 0.0f;     b = 1.0f;     break;
+        default: r = 1.0f;     g = 0.0f;     b = 1.0f - f; break;
+    }
+
+    return (uint32_t)(r * 255.0f) |
+           ((uint32_t)(g * 255.0f) << 8) |
+           ((uint32_t)(b * 255.0f) << 16) |
+           (128u << 24);
+}
+
+/* ============================================================
+ * NODE_TYPE_PARTICLES: Particle emitter
+ * ============================================================
+ * Inputs: rate, life, fx, fy (rate/life <= 0 use params)
+ * Params: X, Y, rate, life, speed, spread, size, hue
+ * Output 0: Live particle count
+ * Output 1: Particles spawned this frame
+ * Output 2: Pool fill (0-1)
+ * ============================================================ */
+void node_eval_particles(const Node *node, const float inputs[MAX_IN_PORTS],
+                         float outputs[MAX_OUT_PORTS], const RuntimeContext *ctx)
+{
+    ParticlePool *pool;
+    ParticleEmitter em;
+    float rate, hue_jitter;
+    uint32_t spawned;
+
+    outputs[0] = 0.0f;
+    outputs[1] = 0.0f;
+    outputs[2] = 0.0f;
+    outputs[3] = 0.0f;
+
+    pool = particles_bind_pool(node);
+    if (!pool) {
+        return;  /* All pools in use */
+    }
+
+    rate = inputs[0] > 0.0f ? inputs[0] : node->params[2];
+    rate = LGS_CLAMP(rate, 0.0f, PARTICLE_RATE_MAX);
+
+    em.x = node->params[0];
+    em.y = node->params[1];
+    em.life = inputs[1] > 0.0f ? inputs[1] : node->params[3];
+    em.speed = node->params[4];
+    em.spread = node->params[5];
+
+    /* Slight per-frame hue drift keeps dense bursts readable */
+    hue_jitter = (particle_randf(&pool->seed) - 0.5f) * 0.05f;
+    em.color = particles_hue_color(node->params[7] + hue_jitter);
+
+    spawned = particle_pool_update(pool, &em, rate, inputs[2], inputs[3], ctx->dt);
+
+    outputs[0] = (float)pool->count;
+    outputs[1] = (float)spawned;
+    outputs[2] = (float)pool->count / (float)pool->capacity;
+}
@@ -0,0 +1,98 @@
+/*
+ * PS2 Live Graph Studio - Particle System
+ * node_particles.h - SoA particle pools backing the PARTICLES node
+ */
+
+#ifndef NODE_PARTICLES_H
+#define NODE_PARTICLES_H
+
+#include "../common.h"
+#include "../graph/graph_types.h"
+#include "../runtime/runtime.h"
+
+/* ============================================================
+ * Particle Limits
+ * ============================================================
+ * Memory usage (static pools used by the PARTICLES node):
+ *   PARTICLE_POOL_COUNT * PARTICLE_POOL_CAPACITY * 28 bytes
+ *   = 4 * 2048 * 28 = ~224KB
+ * ============================================================ */
+#define PARTICLE_POOL_COUNT           4     /* PARTICLES nodes live at once */
+#define PARTICLE_POOL_CAPACITY        2048  /* Particles per node pool */
+
+/* Float arrays per particle: pos_x, pos_y, vel_x, vel_y, age, life */
+#define PARTICLE_FLOAT_ARRAYS         6
+#define PARTICLE_POOL_FLOATS(cap)     ((cap) * PARTICLE_FLOAT_ARRAYS)
+
+/* ============================================================
+ * ParticlePool (structure of arrays)
+ * ============================================================
+ * Storage is provided by the caller so the same code runs on the
+ * static node pools and on large host benchmark pools.
+ * Dead particles are swap-removed, so [0, count) is always dense.
+ * ============================================================ */
+typedef struct {
+    float    *pos_x;         /* Normalized position (0-1 = screen) */
+    float    *pos_y;
+    float    *vel_x;         /* Velocity (normalized units/sec) */
+    float    *vel_y;
+    float    *age;           /* Seconds since spawn */
+    float    *life;          /* Lifetime in seconds */
+    uint32_t *color;         /* Packed RGBA (render color layout) */
+    uint32_t  count;         /* Live particles */
+    uint32_t  capacity;      /* Max particles */
+    float     spawn_accum;   /* Fractional spawn carry */
+    uint32_t  seed;          /* LCG state for spawn jitter */
+} ParticlePool;
+
+/* ============================================================
+ * Emitter (spawn parameters)
+ * ============================================================ */
+typedef struct {
+    float    x;              /* Spawn position (normalized) */
+    float    y;
+    float    speed;          /* Initial speed (normalized units/sec) */
+    float    spread;         /* Cone angle in radians around "up" */
+    float    life;           /* Lifetime in seconds */
+    uint32_t color;          /* Packed RGBA */
+} ParticleEmitter;
+
+/* ============================================================
+ * Pool API
+ * ============================================================ */
+
+/* Bind caller storage to a pool and clear it.
+ * float_storage: PARTICLE_POOL_FLOATS(capacity) floats
+ * color_storage: capacity entries */
+void particle_pool_init(ParticlePool *pool, float *float_storage,
+                        uint32_t *color_storage, uint32_t capacity);
+
+/* Remove all particles (keeps storage binding). */
+void particle_pool_clear(ParticlePool *pool);
+
+/* Spawn up to n particles. Returns number actually spawned. */
+uint32_t particle_pool_spawn(ParticlePool *pool, const ParticleEmitter *em, uint32_t n);
+
+/* Integrate velocity and position with a constant force (SoA loop). */
+void particle_pool_integrate(ParticlePool *pool, float force_x, float force_y, float dt);
+
+/* Swap-remove particles whose age exceeds their lifetime. */
+void particle_pool_compact(ParticlePool *pool);
+
+/* Full step: rate-based spawn, integrate, compact.
+ * rate: particles per second. Returns number spawned. */
+uint32_t particle_pool_update(ParticlePool *pool, const ParticleEmitter *em,
+                              float rate, float force_x, float force_y, float dt);
+
+/* ============================================================
+ * Node Binding
+ * ============================================================ */
+
+/* Get the pool bound to a PARTICLES node, or NULL if none yet. */
+const ParticlePool *particles_get_pool(const Node *node);
+
+/* Release pools whose owner is not in plan. Cheap when plan is the
+ * one last synced (called by graph_eval_range; one graph at a time). */
+void particles_sync_plan(const Graph *graph, const EvalPlan *plan);
+
+#endif /* NODE_PARTICLES_H */
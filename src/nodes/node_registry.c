@@ -1,4 +1,5 @@
 #include "node_registry.h"
+#include "../graph/graph_probe.h"
 #include <string.h>
 
 /* ============================================================
@@ -87,6 +88,86 @@ extern void node_eval_render_circle(const Node *node, const float inputs[MAX_IN_
 extern void node_eval_render_line(const Node *node, const float inputs[MAX_IN_PORTS],
                                   float outputs[MAX_OUT_PORTS], const RuntimeContext *ctx);
 
+/* Simulation nodes (node_particles.c) */
+extern void node_eval_particles(const Node *node, const float inputs[MAX_IN_PORTS],
+                                float outputs[MAX_OUT_PORTS], const RuntimeContext *ctx);
+
+/* Fragment nodes (node_fragment.c) */
+extern void node_eval_uv(const Node *node, const float inputs[MAX_IN_PORTS],
+                         float outputs[MAX_OUT_PORTS], const RuntimeContext *ctx);
+extern void node_eval_pixel(const Node *node, const float inputs[MAX_IN_PORTS],
+                            float outputs[MAX_OUT_PORTS], const RuntimeContext *ctx);
+extern void node_eval_frag_out(const Node *node, const float inputs[MAX_IN_PORTS],
+                               float outputs[MAX_OUT_PORTS], const RuntimeContext *ctx);
+
+/* Block kernels (node_block.c) */
+extern void node_block_const(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                             float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                             const RuntimeContext *ctx);
+extern void node_block_time(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                            float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                            const RuntimeContext *ctx);
+extern void node_block_noise(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                             float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                             const RuntimeContext *ctx);
+extern void node_block_lfo(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_add(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_sub(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_mul(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_abs(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_neg(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_div(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_clamp(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                             float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                             const RuntimeContext *ctx);
+extern void node_block_map(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_min(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_max(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_sin(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_cos(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                           float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                           const RuntimeContext *ctx);
+extern void node_block_lerp(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                            float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                            const RuntimeContext *ctx);
+extern void node_block_step(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                            float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                            const RuntimeContext *ctx);
+extern void node_block_smooth(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                              float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                              const RuntimeContext *ctx);
+extern void node_block_uv(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                          float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                          const RuntimeContext *ctx);
+extern void node_block_pixel(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                             float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                             const RuntimeContext *ctx);
+extern void node_block_frag_out(const Node *node, const float *const inputs[MAX_IN_PORTS],
+                                float *const outputs[MAX_OUT_PORTS], uint32_t n,
+                                const RuntimeContext *ctx);
+
 /* ============================================================
  * Fallback: Unimplemented node outputs zeros
  * ============================================================ */
@@ -108,9 +189,11 @@ static void node_eval_none(const Node *node, const float inputs[MAX_IN_PORTS],
  * ============================================================
  * Memory usage:
  *   s_eval_funcs: ~52 bytes (NODE_TYPE_COUNT * sizeof(ptr))
+ *   s_block_funcs: ~180 bytes (NODE_TYPE_COUNT * sizeof(ptr))
  *   s_meta: ~5.4KB (NODE_TYPE_COUNT * sizeof(NodeMeta))
  * ============================================================ */
 static NodeEvalFunc s_eval_funcs[NODE_TYPE_COUNT];
+static NodeBlockFunc s_block_funcs[NODE_TYPE_COUNT];
 static NodeMeta     s_meta[NODE_TYPE_COUNT];
 static int          s_initialized = 0;
 
@@ -173,6 +256,7 @@ static void init_meta(void)
 
     /* NODE_TYPE_NOISE */
     s_meta[NODE_TYPE_NOISE].name = "Noise";
+    s_meta[NODE_TYPE_NOISE].stateful = 1;
     s_meta[NODE_TYPE_NOISE].num_inputs = 0;
     s_meta[NODE_TYPE_NOISE].num_outputs = 3;
     s_meta[NODE_TYPE_NOISE].num_params = 1;
@@ -366,6 +450,7 @@ static void init_meta(void)
 
     /* NODE_TYPE_SMOOTH */
     s_meta[NODE_TYPE_SMOOTH].name = "Smooth";
+    s_meta[NODE_TYPE_SMOOTH].stateful = 1;
     s_meta[NODE_TYPE_SMOOTH].num_inputs = 1;
     s_meta[NODE_TYPE_SMOOTH].num_outputs = 1;
     s_meta[NODE_TYPE_SMOOTH].num_params = 1;
@@ -390,6 +475,7 @@ static void init_meta(void)
 
     /* NODE_TYPE_PULSE */
     s_meta[NODE_TYPE_PULSE].name = "Pulse";
+    s_meta[NODE_TYPE_PULSE].stateful = 1;
     s_meta[NODE_TYPE_PULSE].num_inputs = 1;
     s_meta[NODE_TYPE_PULSE].num_outputs = 2;
     s_meta[NODE_TYPE_PULSE].num_params = 2;
@@ -405,6 +491,7 @@ static void init_meta(void)
 
     /* NODE_TYPE_HOLD */
     s_meta[NODE_TYPE_HOLD].name = "Hold";
+    s_meta[NODE_TYPE_HOLD].stateful = 1;
     s_meta[NODE_TYPE_HOLD].num_inputs = 2;
     s_meta[NODE_TYPE_HOLD].num_outputs = 1;
     s_meta[NODE_TYPE_HOLD].num_params = 1;
@@ -416,6 +503,7 @@ static void init_meta(void)
 
     /* NODE_TYPE_DELAY */
     s_meta[NODE_TYPE_DELAY].name = "Delay";
+    s_meta[NODE_TYPE_DELAY].stateful = 1;
     s_meta[NODE_TYPE_DELAY].num_inputs = 1;
     s_meta[NODE_TYPE_DELAY].num_outputs = 1;
     s_meta[NODE_TYPE_DELAY].num_params = 1;
@@ -577,6 +665,7 @@ static void init_meta(void)
 
     /* NODE_TYPE_RENDER2D */
     s_meta[NODE_TYPE_RENDER2D].name = "Render2D";
+    s_meta[NODE_TYPE_RENDER2D].sink_kind = SINK_KIND_RECT;
     s_meta[NODE_TYPE_RENDER2D].num_inputs = 4;
     s_meta[NODE_TYPE_RENDER2D].num_outputs = 4;  /* x, y, w, h for render pass */
     s_meta[NODE_TYPE_RENDER2D].num_params = 4;
@@ -607,6 +696,7 @@ static void init_meta(void)
 
     /* NODE_TYPE_RENDER_CIRCLE */
     s_meta[NODE_TYPE_RENDER_CIRCLE].name = "Circle";
+    s_meta[NODE_TYPE_RENDER_CIRCLE].sink_kind = SINK_KIND_CIRCLE;
     s_meta[NODE_TYPE_RENDER_CIRCLE].num_inputs = 4;
     s_meta[NODE_TYPE_RENDER_CIRCLE].num_outputs = 3;
     s_meta[NODE_TYPE_RENDER_CIRCLE].num_params = 3;
@@ -632,6 +722,7 @@ static void init_meta(void)
 
     /* NODE_TYPE_RENDER_LINE */
     s_meta[NODE_TYPE_RENDER_LINE].name = "Line";
+    s_meta[NODE_TYPE_RENDER_LINE].sink_kind = SINK_KIND_LINE;
     s_meta[NODE_TYPE_RENDER_LINE].num_inputs = 4;
     s_meta[NODE_TYPE_RENDER_LINE].num_outputs = 4;
     s_meta[NODE_TYPE_RENDER_LINE].num_params = 4;
@@ -664,7 +755,7 @@ static void init_meta(void)
     s_meta[NODE_TYPE_DEBUG].name = "Debug";
     s_meta[NODE_TYPE_DEBUG].num_inputs = 4;
     s_meta[NODE_TYPE_DEBUG].num_outputs = 4;
-    s_meta[NODE_TYPE_DEBUG].num_params = 0;
+    s_meta[NODE_TYPE_DEBUG].num_params = 1;
     s_meta[NODE_TYPE_DEBUG].input_names[0] = "in0";
     s_meta[NODE_TYPE_DEBUG].input_names[1] = "in1";
     s_meta[NODE_TYPE_DEBUG].input_names[2] = "in2";
@@ -673,6 +764,90 @@ static void init_meta(void)
     s_meta[NODE_TYPE_DEBUG].output_names[1] = "out1";
     s_meta[NODE_TYPE_DEBUG].output_names[2] = "out2";
     s_meta[NODE_TYPE_DEBUG].output_names[3] = "out3";
+    s_meta[NODE_TYPE_DEBUG].param_names[0] = "Secs";   /* Probe history (graph_probe.h) */
+    s_meta[NODE_TYPE_DEBUG].param_defaults[0] = PROBE_SECS_DEFAULT;
+    s_meta[NODE_TYPE_DEBUG].param_min[0] = PROBE_HISTORY_MIN / PROBE_RATE_HZ;
+    s_meta[NODE_TYPE_DEBUG].param_max[0] = PROBE_HISTORY_MAX / PROBE_RATE_HZ;
+
+    /* NODE_TYPE_PARTICLES */
+    s_meta[NODE_TYPE_PARTICLES].name = "Particles";
+    s_meta[NODE_TYPE_PARTICLES].stateful = 1;
+    s_meta[NODE_TYPE_PARTICLES].sink_kind = SINK_KIND_PARTICLES;
+    s_meta[NODE_TYPE_PARTICLES].num_inputs = 4;
+    s_meta[NODE_TYPE_PARTICLES].num_outputs = 3;
+    s_meta[NODE_TYPE_PARTICLES].num_params = 8;
+    s_meta[NODE_TYPE_PARTICLES].input_names[0] = "rate";
+    s_meta[NODE_TYPE_PARTICLES].input_names[1] = "life";
+    s_meta[NODE_TYPE_PARTICLES].input_names[2] = "fx";
+    s_meta[NODE_TYPE_PARTICLES].input_names[3] = "fy";
+    s_meta[NODE_TYPE_PARTICLES].output_names[0] = "count";
+    s_meta[NODE_TYPE_PARTICLES].output_names[1] = "spawned";
+    s_meta[NODE_TYPE_PARTICLES].output_names[2] = "fill";
+    s_meta[NODE_TYPE_PARTICLES].param_names[0] = "X";
+    s_meta[NODE_TYPE_PARTICLES].param_names[1] = "Y";
+    s_meta[NODE_TYPE_PARTICLES].param_names[2] = "rate";
+    s_meta[NODE_TYPE_PARTICLES].param_names[3] = "life";
+    s_meta[NODE_TYPE_PARTICLES].param_names[4] = "speed";
+    s_meta[NODE_TYPE_PARTICLES].param_names[5] = "spread";
+    s_meta[NODE_TYPE_PARTICLES].param_names[6] = "size";
+    s_meta[NODE_TYPE_PARTICLES].param_names[7] = "hue";
+    s_meta[NODE_TYPE_PARTICLES].param_defaults[0] = 0.5f;
+    s_meta[NODE_TYPE_PARTICLES].param_defaults[1] = 0.8f;
+    s_meta[NODE_TYPE_PARTICLES].param_defaults[2] = 120.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_defaults[3] = 2.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_defaults[4] = 0.4f;
+    s_meta[NODE_TYPE_PARTICLES].param_defaults[5] = 1.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_defaults[6] = 0.006f;
+    s_meta[NODE_TYPE_PARTICLES].param_defaults[7] = 0.1f;
+    s_meta[NODE_TYPE_PARTICLES].param_min[0] = 0.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_min[1] = 0.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_min[2] = 0.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_min[3] = 0.05f;
+    s_meta[NODE_TYPE_PARTICLES].param_min[4] = 0.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_min[5] = 0.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_min[6] = 0.001f;
+    s_meta[NODE_TYPE_PARTICLES].param_min[7] = 0.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_max[0] = 1.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_max[1] = 1.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_max[2] = 2000.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_max[3] = 10.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_max[4] = 2.0f;
+    s_meta[NODE_TYPE_PARTICLES].param_max[5] = 6.28f;
+    s_meta[NODE_TYPE_PARTICLES].param_max[6] = 0.05f;
+    s_meta[NODE_TYPE_PARTICLES].param_max[7] = 1.0f;
+
+    /* NODE_TYPE_UV */
+    s_meta[NODE_TYPE_UV].name = "UV";
+    s_meta[NODE_TYPE_UV].num_inputs = 0;
+    s_meta[NODE_TYPE_UV].num_outputs = 4;
+    s_meta[NODE_TYPE_UV].num_params = 0;
+    s_meta[NODE_TYPE_UV].output_names[0] = "u";
+    s_meta[NODE_TYPE_UV].output_names[1] = "v";
+    s_meta[NODE_TYPE_UV].output_names[2] = "cx";
+    s_meta[NODE_TYPE_UV].output_names[3] = "cy";
+
+    /* NODE_TYPE_PIXEL */
+    s_meta[NODE_TYPE_PIXEL].name = "Pixel";
+    s_meta[NODE_TYPE_PIXEL].num_inputs = 0;
+    s_meta[NODE_TYPE_PIXEL].num_outputs = 4;
+    s_meta[NODE_TYPE_PIXEL].num_params = 0;
+    s_meta[NODE_TYPE_PIXEL].output_names[0] = "x";
+    s_meta[NODE_TYPE_PIXEL].output_names[1] = "y";
+    s_meta[NODE_TYPE_PIXEL].output_names[2] = "width";
+    s_meta[NODE_TYPE_PIXEL].output_names[3] = "height";
+
+    /* NODE_TYPE_FRAG_OUT */
+    s_meta[NODE_TYPE_FRAG_OUT].name = "FragOut";
+    s_meta[NODE_TYPE_FRAG_OUT].sink_kind = SINK_KIND_FRAGMENT;
+    s_meta[NODE_TYPE_FRAG_OUT].num_inputs = 3;
+    s_meta[NODE_TYPE_FRAG_OUT].num_outputs = 3;
+    s_meta[NODE_TYPE_FRAG_OUT].num_params = 0;
+    s_meta[NODE_TYPE_FRAG_OUT].input_names[0] = "R";
+    s_meta[NODE_TYPE_FRAG_OUT].input_names[1] = "G";
+    s_meta[NODE_TYPE_FRAG_OUT].input_names[2] = "B";
+    s_meta[NODE_TYPE_FRAG_OUT].output_names[0] = "R";
+    s_meta[NODE_TYPE_FRAG_OUT].output_names[1] = "G";
+    s_meta[NODE_TYPE_FRAG_OUT].output_names[2] = "B";
 }
 
 /* ============================================================
@@ -740,6 +915,36 @@ void node_registry_init(void)
     s_eval_funcs[NODE_TYPE_RENDER_LINE] = node_eval_render_line;
     /* Utility */
     s_eval_funcs[NODE_TYPE_DEBUG] = node_eval_debug;
+    /* Simulation */
+    s_eval_funcs[NODE_TYPE_PARTICLES] = node_eval_particles;
+    /* Fragment */
+    s_eval_funcs[NODE_TYPE_UV] = node_eval_uv;
+    s_eval_funcs[NODE_TYPE_PIXEL] = node_eval_pixel;
+    s_eval_funcs[NODE_TYPE_FRAG_OUT] = node_eval_frag_out;
+
+    /* Block kernels (others fall back to per-sample eval) */
+    s_block_funcs[NODE_TYPE_CONST] = node_block_const;
+    s_block_funcs[NODE_TYPE_TIME] = node_block_time;
+    s_block_funcs[NODE_TYPE_NOISE] = node_block_noise;
+    s_block_funcs[NODE_TYPE_LFO] = node_block_lfo;
+    s_block_funcs[NODE_TYPE_ADD] = node_block_add;
+    s_block_funcs[NODE_TYPE_SUB] = node_block_sub;
+    s_block_funcs[NODE_TYPE_MUL] = node_block_mul;
+    s_block_funcs[NODE_TYPE_ABS] = node_block_abs;
+    s_block_funcs[NODE_TYPE_NEG] = node_block_neg;
+    s_block_funcs[NODE_TYPE_DIV] = node_block_div;
+    s_block_funcs[NODE_TYPE_CLAMP] = node_block_clamp;
+    s_block_funcs[NODE_TYPE_MAP] = node_block_map;
+    s_block_funcs[NODE_TYPE_MIN] = node_block_min;
+    s_block_funcs[NODE_TYPE_MAX] = node_block_max;
+    s_block_funcs[NODE_TYPE_SIN] = node_block_sin;
+    s_block_funcs[NODE_TYPE_COS] = node_block_cos;
+    s_block_funcs[NODE_TYPE_LERP] = node_block_lerp;
+    s_block_funcs[NODE_TYPE_STEP] = node_block_step;
+    s_block_funcs[NODE_TYPE_SMOOTH] = node_block_smooth;
+    s_block_funcs[NODE_TYPE_UV] = node_block_uv;
+    s_block_funcs[NODE_TYPE_PIXEL] = node_block_pixel;
+    s_block_funcs[NODE_TYPE_FRAG_OUT] = node_block_frag_out;
 
     /* Initialize metadata */
     init_meta();
@@ -761,6 +966,17 @@ NodeEvalFunc node_registry_get_eval(NodeType type)
     return s_eval_funcs[type];
 }
 
+/* ============================================================
+ * Get Block Kernel
+ * ============================================================ */
+NodeBlockFunc node_registry_get_block_eval(NodeType type)
+{
+    if (!s_initialized || type >= NODE_TYPE_COUNT) {
+        return NULL;
+    }
+    return s_block_funcs[type];
+}
+
 /* ============================================================
  * Get Metadata
  * ============================================================ */
@@ -800,6 +1016,17 @@ int node_registry_is_source(NodeType type)
     return s_meta[type].num_inputs == 0;
 }
 
+/* ============================================================
+ * Check if Stateful (keeps state_u32 between frames)
+ * ============================================================ */
+int node_registry_is_stateful(NodeType type)
+{
+    if (!s_initialized || type >= NODE_TYPE_COUNT) {
+        return 0;
+    }
+    return s_meta[type].stateful;
+}
+
 /* ============================================================
  * Check if Sink (no outputs)
  * ============================================================ */
@@ -810,3 +1037,14 @@ int node_registry_is_sink(NodeType type)
     }
     return s_meta[type].num_outputs == 0;
 }
+
+/* ============================================================
+ * Get Sink Kind
+ * ============================================================ */
+SinkKind node_registry_sink_kind(NodeType type)
+{
+    if (!s_initialized || type >= NODE_TYPE_COUNT) {
+        return SINK_KIND_NONE;
+    }
+    return (SinkKind)s_meta[type].sink_kind;
+}
@@ -19,6 +19,22 @@ typedef void (*NodeEvalFunc)(const Node *node,
                              float outputs[MAX_OUT_PORTS],
                              const RuntimeContext *ctx);
 
+/* ============================================================
+ * Block Evaluation Function Signature
+ * ============================================================
+ * Optional per-type kernel for graph_eval_block. Processes n
+ * samples per port in one call.
+ * - inputs[port][i]: sample i of each input (never NULL)
+ * - outputs[port][i]: sample i of each output (all ports written)
+ * - ctx->time is the time of sample 0, ctx->sample_dt the step
+ * Types without a kernel fall back to per-sample NodeEvalFunc.
+ * ============================================================ */
+typedef void (*NodeBlockFunc)(const Node *node,
+                              const float *const inputs[MAX_IN_PORTS],
+                              float *const outputs[MAX_OUT_PORTS],
+                              uint32_t n,
+                              const RuntimeContext *ctx);
+
 /* ============================================================
  * Node Metadata
  * ============================================================ */
@@ -27,6 +43,8 @@ typedef struct {
     uint8_t       num_inputs;        /* Number of input ports used */
     uint8_t       num_outputs;       /* Number of output ports used */
     uint8_t       num_params;        /* Number of params used */
+    uint8_t       stateful;          /* Keeps state_u32 between frames */
+    uint8_t       sink_kind;         /* SinkKind drawn by the render pass */
     const char   *input_names[MAX_IN_PORTS];
     const char   *output_names[MAX_OUT_PORTS];
     const char   *param_names[MAX_PARAMS];
@@ -45,6 +63,9 @@ void node_registry_init(void);
 /* Get eval function for a node type. Returns fallback if not initialized. */
 NodeEvalFunc node_registry_get_eval(NodeType type);
 
+/* Get block kernel for a node type. Returns NULL if the type has none. */
+NodeBlockFunc node_registry_get_block_eval(NodeType type);
+
 /* Get metadata for a node type. Returns NULL if registry not initialized. */
 const NodeMeta *node_registry_get_meta(NodeType type);
 
@@ -54,7 +75,13 @@ const char *node_registry_get_name(NodeType type);
 /* Check if node type is a source (no inputs) */
 int node_registry_is_source(NodeType type);
 
+/* Check if node type keeps state between frames (NOISE, SMOOTH, ...) */
+int node_registry_is_stateful(NodeType type);
+
 /* Check if node type is a sink (no outputs, renders) */
 int node_registry_is_sink(NodeType type);
 
+/* Get how the render pass draws a node type (SINK_KIND_NONE if not drawn) */
+SinkKind node_registry_sink_kind(NodeType type);
+
 #endif /* NODE_REGISTRY_H */
@@ -0,0 +1,101 @@
+#include "circle_lut.h"
+#include <stdint.h>
+#include <math.h>
+
+/* ============================================================
+ * Unit-Circle Tables
+ * ============================================================
+ * Tables for all counts are packed back to back; s_offset[n] is
+ * the first entry of count n.
+ * ============================================================ */
+
+#define CIRCLE_LUT_PI 3.14159265358979323846f
+
+/* Sum of (n + 1) for n = MIN..MAX */
+#define CIRCLE_LUT_TOTAL \
+    ((CIRCLE_LUT_MAX_SEGMENTS + 2) * (CIRCLE_LUT_MAX_SEGMENTS + 1) / 2 - \
+     (CIRCLE_LUT_MIN_SEGMENTS + 1) * CIRCLE_LUT_MIN_SEGMENTS / 2)
+
+static float    s_cos[CIRCLE_LUT_TOTAL];
+static float    s_sin[CIRCLE_LUT_TOTAL];
+static uint16_t s_offset[CIRCLE_LUT_MAX_SEGMENTS + 1];
+static int      s_ready = 0;
+
+/* ============================================================
+ * Build Tables
+ * ============================================================ */
+void circle_lut_init(void)
+{
+    unsigned int next = 0;
+    int n, i;
+
+    if (s_ready) {
+        return;
+    }
+
+    for (n = CIRCLE_LUT_MIN_SEGMENTS; n <= CIRCLE_LUT_MAX_SEGMENTS; n++) {
+        float step = (2.0f * CIRCLE_LUT_PI) / (float)n;
+
+        s_offset[n] = (uint16_t)next;
+        for (i = 0; i < n; i++) {
+            s_cos[next + i] = cosf((float)i * step);
+            s_sin[next + i] = sinf((float)i * step);
+        }
+        /* Closing vertex is exactly the first one */
+        s_cos[next + n] = s_cos[next];
+        s_sin[next + n] = s_sin[next];
+        next += (unsigned int)n + 1;
+    }
+
+    s_ready = 1;
+}
+
+/* ============================================================
+ * Lookups
+ * ============================================================ */
+int circle_lut_clamp(int segments)
+{
+    if (segments < CIRCLE_LUT_MIN_SEGMENTS) return CIRCLE_LUT_MIN_SEGMENTS;
+    if (segments > CIRCLE_LUT_MAX_SEGMENTS) return CIRCLE_LUT_MAX_SEGMENTS;
+    return segments;
+}
+
+const float *circle_lut_cos(int segments)
+{
+    if (!s_ready) {
+        circle_lut_init();
+    }
+    return &s_cos[s_offset[circle_lut_clamp(segments)]];
+}
+
+const float *circle_lut_sin(int segments)
+{
+    if (!s_ready) {
+        circle_lut_init();
+    }
+    return &s_sin[s_offset[circle_lut_clamp(segments)]];
+}
+
+/* ============================================================
+ * Adaptive Segment Count
+ * ============================================================
+ * A chord over angle 2pi/n strays r * (1 - cos(pi/n)) ~= r*pi^2/(2n^2)
+ * from the circle; keeping that under half a pixel gives
+ * n >= pi * sqrt(r).
+ * ============================================================ */
+int circle_auto_segments(float radius_px)
+{
+    int n;
+
+    if (!(radius_px > 0.0f)) {
+        return CIRCLE_AUTO_MIN_SEGMENTS;
+    }
+    if (radius_px > 1024.0f) {
+        return CIRCLE_LUT_MAX_SEGMENTS;
+    }
+
+    n = (int)(CIRCLE_LUT_PI * sqrtf(radius_px)) + 1;
+    if (n < CIRCLE_AUTO_MIN_SEGMENTS) n = CIRCLE_AUTO_MIN_SEGMENTS;
+    if (n > CIRCLE_LUT_MAX_SEGMENTS) n = CIRCLE_LUT_MAX_SEGMENTS;
+    return n;
+}
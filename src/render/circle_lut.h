@@ -0,0 +1,41 @@
+#ifndef CIRCLE_LUT_H
+#define CIRCLE_LUT_H
+
+/* ============================================================
+ * Unit-Circle Tables
+ * ============================================================
+ * cos/sin of i * 2pi / n for every segment count n in
+ * CIRCLE_LUT_MIN_SEGMENTS..CIRCLE_LUT_MAX_SEGMENTS, generated once,
+ * so tessellating a circle is table lookups instead of cosf/sinf
+ * per vertex. Each table has n + 1 entries; entry n repeats entry 0
+ * so fans and outlines close exactly.
+ *
+ * Portable C: no gsKit dependency.
+ *
+ * Memory usage:
+ *   s_cos + s_sin: 2 * CIRCLE_LUT_TOTAL * 4 = ~17KB
+ * ============================================================ */
+
+#define CIRCLE_LUT_MIN_SEGMENTS  3
+#define CIRCLE_LUT_MAX_SEGMENTS  64
+
+/* Adaptive range: tiny circles use the minimum, large ones the max */
+#define CIRCLE_AUTO_MIN_SEGMENTS 6
+
+/* Build all tables. Called by render_init(); lookups also build
+ * them on first use. */
+void circle_lut_init(void);
+
+/* Clamp a segment count to the table range */
+int circle_lut_clamp(int segments);
+
+/* Tables for a (clamped) segment count, segments + 1 entries each */
+const float *circle_lut_cos(int segments);
+const float *circle_lut_sin(int segments);
+
+/* Segments for a circle of the given on-screen radius in pixels:
+ * enough that each chord strays at most ~half a pixel from the true
+ * circle (CIRCLE_AUTO_MIN_SEGMENTS..CIRCLE_LUT_MAX_SEGMENTS). */
+int circle_auto_segments(float radius_px);
+
+#endif /* CIRCLE_LUT_H */
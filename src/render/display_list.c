@@ -0,0 +1,452 @@
+#include "display_list.h"
+#include <string.h>
+
+/* ============================================================
+ * Initialize / Reset
+ * ============================================================ */
+void dl_init(DisplayList *dl, const DlBackend *backend)
+{
+    if (!dl) {
+        return;
+    }
+
+    dl->count = 0;
+    dl->layer = DL_LAYER_SCENE;
+    dl->blend = DL_BLEND_OPAQUE;
+    dl->sorted = 1;
+    dl->backend = backend;
+    dl_stats_reset(dl);
+}
+
+void dl_reset(DisplayList *dl)
+{
+    if (!dl) {
+        return;
+    }
+    dl->count = 0;
+    dl->sorted = 1;
+}
+
+void dl_stats_reset(DisplayList *dl)
+{
+    if (!dl) {
+        return;
+    }
+    dl->stat_cmds = 0;
+    dl->stat_batches = 0;
+    dl->stat_flushes = 0;
+}
+
+void dl_set_layer(DisplayList *dl, uint8_t layer)
+{
+    if (dl) {
+        dl->layer = layer;
+    }
+}
+
+void dl_set_blend(DisplayList *dl, DlBlend blend)
+{
+    if (dl && blend < DL_BLEND_COUNT) {
+        dl->blend = (uint8_t)blend;
+    }
+}
+
+/* ============================================================
+ * Append
+ * ============================================================ */
+static int16_t dl_coord(int v)
+{
+    if (v < -32768) return -32768;
+    if (v > 32767) return 32767;
+    return (int16_t)v;
+}
+
+/* Reserve a record and fill its key; NULL if the list is full */
+static DlCmd *dl_alloc(DisplayList *dl, DlPrim prim, uint32_t color)
+{
+    DlCmd *cmd;
+    uint32_t index;
+
+    if (!dl) {
+        return NULL;
+    }
+
+    if (dl->count >= DL_MAX_CMDS) {
+        if (!dl->backend) {
+            return NULL;
+        }
+        dl_flush(dl);
+    }
+
+    index = dl->count++;
+    cmd = &dl->cmds[index];
+    cmd->key = ((uint32_t)dl->layer << DL_KEY_LAYER_SHIFT) |
+               ((uint32_t)prim << DL_KEY_PRIM_SHIFT) |
+               ((uint32_t)dl->blend << DL_KEY_BLEND_SHIFT) |
+               (index << DL_KEY_INDEX_SHIFT);
+    cmd->color = color;
+    dl->keys[index] = cmd->key;
+    dl->sorted = 0;
+    return cmd;
+}
+
+int dl_push_rect(DisplayList *dl, int x1, int y1, int x2, int y2, uint32_t color)
+{
+    DlCmd *cmd = dl_alloc(dl, DL_PRIM_RECT, color);
+    if (!cmd) {
+        return 0;
+    }
+    cmd->v[0] = dl_coord(x1);
+    cmd->v[1] = dl_coord(y1);
+    cmd->v[2] = dl_coord(x2);
+    cmd->v[3] = dl_coord(y2);
+    cmd->v[4] = 0;
+    cmd->v[5] = 0;
+    return 1;
+}
+
+int dl_push_line(DisplayList *dl, int x1, int y1, int x2, int y2, uint32_t color)
+{
+    DlCmd *cmd = dl_alloc(dl, DL_PRIM_LINE, color);
+    if (!cmd) {
+        return 0;
+    }
+    cmd->v[0] = dl_coord(x1);
+    cmd->v[1] = dl_coord(y1);
+    cmd->v[2] = dl_coord(x2);
+    cmd->v[3] = dl_coord(y2);
+    cmd->v[4] = 0;
+    cmd->v[5] = 0;
+    return 1;
+}
+
+int dl_push_triangle(DisplayList *dl, int x1, int y1, int x2, int y2,
+                     int x3, int y3, uint32_t color)
+{
+    DlCmd *cmd = dl_alloc(dl, DL_PRIM_TRIANGLE, color);
+    if (!cmd) {
+        return 0;
+    }
+    cmd->v[0] = dl_coord(x1);
+    cmd->v[1] = dl_coord(y1);
+    cmd->v[2] = dl_coord(x2);
+    cmd->v[3] = dl_coord(y2);
+    cmd->v[4] = dl_coord(x3);
+    cmd->v[5] = dl_coord(y3);
+    return 1;
+}
+
+int dl_push_circle(DisplayList *dl, int cx, int cy, int rx, int ry,
+                   int segments, uint32_t color)
+{
+    DlCmd *cmd = dl_alloc(dl, DL_PRIM_CIRCLE, color);
+    if (!cmd) {
+        return 0;
+    }
+    cmd->v[0] = dl_coord(cx);
+    cmd->v[1] = dl_coord(cy);
+    cmd->v[2] = dl_coord(rx);
+    cmd->v[3] = dl_coord(ry);
+    cmd->v[4] = dl_coord(segments);
+    cmd->v[5] = 0;
+    return 1;
+}
+
+/* ============================================================
+ * Radix Sort
+ * ============================================================
+ * Keys are appended in index order, so one stable pass on the
+ * layer (8 bits, 256 buckets) yields (layer, index) order. The pass
+ * is skipped when all keys share a layer.
+ * ============================================================ */
+static int radix_pass(const uint32_t *src, uint32_t *dst, uint32_t n,
+                      uint32_t shift, uint32_t mask)
+{
+    uint32_t hist[256];
+    uint32_t i, sum;
+
+    memset(hist, 0, sizeof(uint32_t) * (mask + 1));
+    for (i = 0; i < n; i++) {
+        hist[(src[i] >> shift) & mask]++;
+    }
+
+    /* All keys share this digit: order is unchanged */
+    if (hist[(src[0] >> shift) & mask] == n) {
+        return 0;
+    }
+
+    sum = 0;
+    for (i = 0; i <= mask; i++) {
+        uint32_t c = hist[i];
+        hist[i] = sum;
+        sum += c;
+    }
+
+    for (i = 0; i < n; i++) {
+        uint32_t key = src[i];
+        dst[hist[(key >> shift) & mask]++] = key;
+    }
+    return 1;
+}
+
+/* ============================================================
+ * Batch Merge
+ * ============================================================
+ * Walks one layer's keys in append order. Open batches live in a
+ * ring of DL_MERGE_WINDOW; the oldest is written to scratch[] when
+ * a new one needs its slot, so batches come out in the order they
+ * were opened, each with its members in append order.
+ * ============================================================ */
+#define DL_MERGE_END  0xFFFFu
+
+static int imin(int a, int b) { return a < b ? a : b; }
+static int imax(int a, int b) { return a > b ? a : b; }
+
+void dl_cmd_bounds(const DlCmd *cmd, int box[4])
+{
+    const int16_t *v = cmd->v;
+    int rx, ry;
+
+    switch (DL_KEY_PRIM(cmd->key)) {
+        case DL_PRIM_RECT:
+            box[0] = imin(v[0], v[2]);
+            box[1] = imin(v[1], v[3]);
+            box[2] = imax(v[0], v[2]);
+            box[3] = imax(v[1], v[3]);
+            break;
+        case DL_PRIM_LINE:
+            box[0] = imin(v[0], v[2]);
+            box[1] = imin(v[1], v[3]);
+            box[2] = imax(v[0], v[2]) + 1;
+            box[3] = imax(v[1], v[3]) + 1;
+            break;
+        case DL_PRIM_TRIANGLE:
+            box[0] = imin(v[0], imin(v[2], v[4]));
+            box[1] = imin(v[1], imin(v[3], v[5]));
+            box[2] = imax(v[0], imax(v[2], v[4])) + 1;
+            box[3] = imax(v[1], imax(v[3], v[5])) + 1;
+            break;
+        default:
+            rx = v[2] < 0 ? -v[2] : v[2];
+            ry = v[3] < 0 ? -v[3] : v[3];
+            box[0] = v[0] - rx;
+            box[1] = v[1] - ry;
+            box[2] = v[0] + rx + 1;
+            box[3] = v[1] + ry + 1;
+            break;
+    }
+}
+
+/* Pixel -> grid cell, clamped to the edge cells */
+static int merge_cell(int v)
+{
+    if (v < 0) return 0;
+    v >>= DL_MERGE_CELL_SHIFT;
+    if (v >= DL_MERGE_GRID) return DL_MERGE_GRID - 1;
+    return v;
+}
+
+/* Cells covered by a command: rows [r0, r1], column bits cols */
+typedef struct {
+    int      r0, r1;
+    uint32_t cols;
+} MergeArea;
+
+static void merge_area(const DlCmd *cmd, MergeArea *a)
+{
+    int box[4];
+    int c0, c1;
+
+    dl_cmd_bounds(cmd, box);
+    c0 = merge_cell(box[0]);
+    c1 = merge_cell(imax(box[0], box[2] - 1));
+    a->r0 = merge_cell(box[1]);
+    a->r1 = merge_cell(imax(box[1], box[3] - 1));
+    a->cols = (c1 == DL_MERGE_GRID - 1 ? 0xFFFFFFFFu : ((1u << (c1 + 1)) - 1u)) & ~((1u << c0) - 1u);
+}
+
+static int merge_overlaps(const DlMergeBatch *b, const MergeArea *a)
+{
+    int r;
+
+    if (a->r1 < b->row_lo || a->r0 > b->row_hi) {
+        return 0;
+    }
+    for (r = imax(a->r0, b->row_lo); r <= imin(a->r1, b->row_hi); r++) {
+        if (b->rows[r] & a->cols) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void merge_add(DlMergeBatch *b, const MergeArea *a)
+{
+    int r;
+
+    for (r = a->r0; r <= a->r1; r++) {
+        b->rows[r] |= a->cols;
+    }
+    if (a->r0 < b->row_lo) b->row_lo = (uint8_t)a->r0;
+    if (a->r1 > b->row_hi) b->row_hi = (uint8_t)a->r1;
+}
+
+static uint32_t merge_emit(DisplayList *dl, const DlMergeBatch *b, uint32_t out)
+{
+    uint32_t p;
+
+    for (p = b->head; p != DL_MERGE_END; p = dl->next[p]) {
+        dl->scratch[out++] = dl->keys[p];
+    }
+    return out;
+}
+
+/* Merge keys[start, end) (one layer) into scratch[start, end) */
+static void merge_layer(DisplayList *dl, uint32_t start, uint32_t end)
+{
+    DlMergeBatch *ring = dl->merge;
+    DlMergeBatch *last = NULL;
+    MergeArea last_area;
+    uint8_t last_state = 0;
+    uint32_t first = 0, open = 0;
+    uint32_t out = start;
+    uint32_t i;
+
+    last_area.r0 = last_area.r1 = -1;
+    last_area.cols = 0;
+
+    for (i = start; i < end; i++) {
+        uint32_t key = dl->keys[i];
+        uint8_t state = (uint8_t)DL_KEY_STATE(key);
+        DlMergeBatch *join = NULL;
+        MergeArea area;
+        uint32_t k;
+
+        merge_area(&dl->cmds[DL_KEY_INDEX(key)], &area);
+        dl->next[i] = DL_MERGE_END;
+
+        /* Same cells and state as the previous command (text pixels):
+         * nothing after its batch overlaps, and the batch itself now
+         * does, so the search below would stop there */
+        if (last && state == last_state && area.r0 == last_area.r0 &&
+            area.r1 == last_area.r1 && area.cols == last_area.cols) {
+            dl->next[last->tail] = (uint16_t)i;
+            last->tail = (uint16_t)i;
+            continue;
+        }
+
+        /* Newest to oldest: the oldest same-state batch before the
+         * first overlap (or that overlapping batch, if it matches) */
+        for (k = open; k-- > 0;) {
+            DlMergeBatch *b = &ring[(first + k) % DL_MERGE_WINDOW];
+            int hit = merge_overlaps(b, &area);
+
+            if (b->state == state) {
+                join = b;
+            }
+            if (hit) {
+                break;
+            }
+        }
+
+        if (!join) {
+            if (open == DL_MERGE_WINDOW) {
+                out = merge_emit(dl, &ring[first], out);
+                first = (first + 1) % DL_MERGE_WINDOW;
+                open--;
+            }
+            join = &ring[(first + open) % DL_MERGE_WINDOW];
+            open++;
+            memset(join->rows, 0, sizeof(join->rows));
+            join->row_lo = (uint8_t)area.r0;
+            join->row_hi = (uint8_t)area.r1;
+            join->state = state;
+            join->head = (uint16_t)i;
+        } else {
+            dl->next[join->tail] = (uint16_t)i;
+        }
+        join->tail = (uint16_t)i;
+        merge_add(join, &area);
+        last = join;
+        last_area = area;
+        last_state = state;
+    }
+
+    while (open > 0) {
+        out = merge_emit(dl, &ring[first], out);
+        first = (first + 1) % DL_MERGE_WINDOW;
+        open--;
+    }
+}
+
+void dl_sort(DisplayList *dl)
+{
+    uint32_t start, end;
+
+    if (!dl || dl->sorted || dl->count == 0) {
+        if (dl) {
+            dl->sorted = 1;
+        }
+        return;
+    }
+
+    if (radix_pass(dl->keys, dl->scratch, dl->count, DL_KEY_LAYER_SHIFT, 0xFFu)) {
+        memcpy(dl->keys, dl->scratch, dl->count * sizeof(uint32_t));
+    }
+
+    for (start = 0; start < dl->count; start = end) {
+        uint32_t layer = DL_KEY_LAYER(dl->keys[start]);
+        end = start + 1;
+        while (end < dl->count && DL_KEY_LAYER(dl->keys[end]) == layer) {
+            end++;
+        }
+        merge_layer(dl, start, end);
+    }
+    memcpy(dl->keys, dl->scratch, dl->count * sizeof(uint32_t));
+    dl->sorted = 1;
+}
+
+/* ============================================================
+ * Submit
+ * ============================================================ */
+uint32_t dl_submit(DisplayList *dl, const DlBackend *backend)
+{
+    uint32_t start, end;
+    uint32_t batches = 0;
+
+    if (!dl || !backend || !backend->draw_batch || dl->count == 0) {
+        return 0;
+    }
+
+    dl_sort(dl);
+
+    /* Batch runs of consecutive commands with identical prim+blend
+     * (may span layers) */
+    for (start = 0; start < dl->count; start = end) {
+        uint32_t state = DL_KEY_STATE(dl->keys[start]);
+        end = start + 1;
+        while (end < dl->count && DL_KEY_STATE(dl->keys[end]) == state) {
+            end++;
+        }
+        backend->draw_batch(backend->user, DL_KEY_PRIM(dl->keys[start]),
+                            DL_KEY_BLEND(dl->keys[start]),
+                            dl->cmds, &dl->keys[start], end - start);
+        batches++;
+    }
+
+    dl->stat_cmds += dl->count;
+    dl->stat_batches += batches;
+    return batches;
+}
+
+void dl_flush(DisplayList *dl)
+{
+    if (!dl) {
+        return;
+    }
+    if (dl->backend) {
+        dl_submit(dl, dl->backend);
+    }
+    dl->stat_flushes++;
+    dl_reset(dl);
+}
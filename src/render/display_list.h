@@ -0,0 +1,185 @@
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include <stdint.h>
+
+/* ============================================================
+ * Display List
+ * ============================================================
+ * Frame-level list of draw commands between the app and the GS.
+ * Commands are appended as compact records, radix-sorted by layer,
+ * merged into batches of identical primitive/blend state and
+ * submitted to a backend batch by batch.
+ *
+ * Ordering: layers draw back to front. Within a layer, a command
+ * may move ahead of earlier commands only if their pixel bounds
+ * cannot overlap (see Batch Merge below), so the image is the same
+ * as drawing in append order whatever the mix of kinds.
+ *
+ * Portable C: no gsKit dependency. Render backends (render_gs.c,
+ * render_soft.c) draw the batches; host tools can also use a
+ * recording backend (dl_record.h).
+ *
+ * Memory usage:
+ *   DisplayList: DL_MAX_CMDS * (20 + 2 * 4 + 2)
+ *              + DL_MERGE_WINDOW * 136 = ~482KB
+ * ============================================================ */
+
+/* Max commands per flush (index must fit DL_KEY_INDEX_BITS).
+ * A full list is flushed early, which only affects ordering
+ * between commands on either side of the flush. */
+#define DL_MAX_CMDS         16384
+
+/* ============================================================
+ * Layers (back to front)
+ * ============================================================ */
+#define DL_LAYER_SCENE       16   /* Graph output (default) */
+#define DL_LAYER_PARTICLES   24   /* Particle pools */
+#define DL_LAYER_UI_BG       32   /* Editor canvas background */
+#define DL_LAYER_UI_WIRES    40   /* Editor wires */
+#define DL_LAYER_UI_NODES    48   /* Editor node boxes, labels, ports */
+#define DL_LAYER_UI_OVERLAY  56   /* Menus, banner, cursor, editor HUD */
+#define DL_LAYER_PALETTE     64   /* Command palette */
+#define DL_LAYER_HUD         72   /* App HUD and error banners */
+
+/* ============================================================
+ * Primitive and Blend State
+ * ============================================================ */
+typedef enum {
+    DL_PRIM_RECT = 0,   /* v: x1, y1, x2, y2 (x2/y2 exclusive) */
+    DL_PRIM_LINE,       /* v: x1, y1, x2, y2 */
+    DL_PRIM_TRIANGLE,   /* v: x1, y1, x2, y2, x3, y3 */
+    DL_PRIM_CIRCLE,     /* v: cx, cy, rx, ry, segments (filled) */
+    DL_PRIM_COUNT
+} DlPrim;
+
+typedef enum {
+    DL_BLEND_OPAQUE = 0,  /* Alpha ignored */
+    DL_BLEND_ALPHA,       /* Source-over using color alpha (0x80 = 1.0) */
+    DL_BLEND_COUNT
+} DlBlend;
+
+/* ============================================================
+ * Sort Key
+ * ============================================================
+ * bits  0-1:  blend      } batch state (DL_KEY_STATE), grouped
+ * bits  2-4:  primitive  } by the merge, not by the sort
+ * bits  5-18: append index (orders commands within a layer)
+ * bits 19-26: layer
+ * ============================================================ */
+#define DL_KEY_INDEX_BITS   14
+#define DL_KEY_BLEND_SHIFT  0
+#define DL_KEY_PRIM_SHIFT   2
+#define DL_KEY_INDEX_SHIFT  5
+#define DL_KEY_LAYER_SHIFT  19
+#define DL_KEY_INDEX(key)   (((key) >> DL_KEY_INDEX_SHIFT) & ((1u << DL_KEY_INDEX_BITS) - 1u))
+#define DL_KEY_BLEND(key)   ((DlBlend)(((key) >> DL_KEY_BLEND_SHIFT) & 0x3u))
+#define DL_KEY_PRIM(key)    ((DlPrim)(((key) >> DL_KEY_PRIM_SHIFT) & 0x7u))
+#define DL_KEY_LAYER(key)   ((uint8_t)(((key) >> DL_KEY_LAYER_SHIFT) & 0xFFu))
+#define DL_KEY_STATE(key)   ((key) & 0x1Fu)
+
+/* ============================================================
+ * Batch Merge
+ * ============================================================
+ * Within a layer each command joins the oldest open batch of its
+ * state that it can reach without passing a batch it may overlap;
+ * otherwise it opens a new batch. Footprints are kept on a grid of
+ * 32 pixel cells, one 32-bit row mask per grid row (coordinates
+ * outside the grid share its edge cells, which only makes the test
+ * more cautious). Only the last DL_MERGE_WINDOW batches stay open.
+ * ============================================================ */
+#define DL_MERGE_WINDOW     16
+#define DL_MERGE_CELL_SHIFT 5    /* 32 pixel cells */
+#define DL_MERGE_GRID       32   /* Cells per side (1024 pixels); bits per row mask */
+
+typedef struct {
+    uint32_t rows[DL_MERGE_GRID];  /* Occupied cells, bit per column */
+    uint8_t  row_lo, row_hi;       /* Rows with any bit set */
+    uint8_t  state;                /* DL_KEY_STATE */
+    uint8_t  _pad[1];
+    uint16_t head, tail;           /* Member chain through next[] */
+} DlMergeBatch;
+
+/* ============================================================
+ * Command Record (20 bytes)
+ * ============================================================ */
+typedef struct {
+    uint32_t key;       /* Sort key (see above) */
+    int16_t  v[6];      /* Screen coordinates, meaning per DlPrim */
+    uint32_t color;     /* RGBA8: bits 0-7 R ... 24-31 A */
+} DlCmd;
+
+/* ============================================================
+ * Backend
+ * ============================================================
+ * draw_batch receives n commands sharing prim and blend, in draw
+ * order: cmds[DL_KEY_INDEX(order[i])] for i in [0, n). Consecutive
+ * batches may share state (a merge window filled up).
+ * ============================================================ */
+typedef struct {
+    void (*draw_batch)(void *user, DlPrim prim, DlBlend blend,
+                       const DlCmd *cmds, const uint32_t *order, uint32_t n);
+    void *user;
+} DlBackend;
+
+typedef struct {
+    DlCmd     cmds[DL_MAX_CMDS];
+    uint32_t  keys[DL_MAX_CMDS];     /* Append order, then sorted */
+    uint32_t  scratch[DL_MAX_CMDS];  /* Radix sort / merge output */
+    uint16_t  next[DL_MAX_CMDS];     /* Merge: next member of a batch */
+    DlMergeBatch merge[DL_MERGE_WINDOW];
+    uint32_t  count;
+    uint8_t   layer;                 /* Layer for appended commands */
+    uint8_t   blend;                 /* DlBlend for appended commands */
+    uint8_t   sorted;                /* keys[] is sorted */
+    uint8_t   _pad[1];
+    const DlBackend *backend;        /* Target of dl_flush (may be NULL) */
+
+    /* Stats (reset by dl_stats_reset) */
+    uint32_t  stat_cmds;             /* Commands submitted */
+    uint32_t  stat_batches;          /* draw_batch calls */
+    uint32_t  stat_flushes;          /* Flushes (including early ones) */
+} DisplayList;
+
+/* ============================================================
+ * Display List API
+ * ============================================================ */
+
+/* Initialize an empty list bound to a backend (may be NULL) */
+void dl_init(DisplayList *dl, const DlBackend *backend);
+
+/* Drop all commands (layer/blend state is kept) */
+void dl_reset(DisplayList *dl);
+
+/* Set layer/blend for subsequently appended commands */
+void dl_set_layer(DisplayList *dl, uint8_t layer);
+void dl_set_blend(DisplayList *dl, DlBlend blend);
+
+/* Append commands (screen coordinates). A full list is flushed
+ * to the backend first; without a backend the command is dropped.
+ * Returns 1 if appended. */
+int dl_push_rect(DisplayList *dl, int x1, int y1, int x2, int y2, uint32_t color);
+int dl_push_line(DisplayList *dl, int x1, int y1, int x2, int y2, uint32_t color);
+int dl_push_triangle(DisplayList *dl, int x1, int y1, int x2, int y2,
+                     int x3, int y3, uint32_t color);
+int dl_push_circle(DisplayList *dl, int cx, int cy, int rx, int ry,
+                   int segments, uint32_t color);
+
+/* Sort keys by layer and merge each layer into batches (see Batch
+ * Merge); overlapping commands keep their append order */
+void dl_sort(DisplayList *dl);
+
+/* Pixel bounds [x0, x1) x [y0, y1) a command can touch */
+void dl_cmd_bounds(const DlCmd *cmd, int box[4]);
+
+/* Sort if needed and submit all commands in batches.
+ * Returns the number of batches. Does not reset the list. */
+uint32_t dl_submit(DisplayList *dl, const DlBackend *backend);
+
+/* Submit to the bound backend and reset */
+void dl_flush(DisplayList *dl);
+
+/* Clear per-frame stats */
+void dl_stats_reset(DisplayList *dl);
+
+#endif /* DISPLAY_LIST_H */
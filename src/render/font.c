@@ -109,6 +109,65 @@ static const uint8_t s_font_data[FONT_CHAR_COUNT][FONT_CHAR_HEIGHT] = {
     /* 126 '~' */ {0x76, 0xDC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}
 };
 
+/* ============================================================
+ * Compiled Glyphs
+ * ============================================================
+ * At init each glyph is compiled into rects: horizontal runs of set
+ * pixels, merged downward while the row below has the same run.
+ * A glyph draws as a handful of sprites instead of one per pixel
+ * ('I' is 3 rects instead of 22).
+ *
+ * Memory usage:
+ *   s_glyph_rects: FONT_MAX_GLYPH_RECTS * 4 = 4KB
+ *   s_cache_rects: FONT_CACHE_RECTS * 8     = 32KB
+ *   s_cache:       FONT_CACHE_ENTRIES * 64 = 4KB
+ * ============================================================ */
+typedef struct {
+    uint8_t x, y, w, h;         /* In font pixels */
+} FontRect;
+
+/* The embedded font compiles to ~500 rects */
+#define FONT_MAX_GLYPH_RECTS 1024
+
+static FontRect s_glyph_rects[FONT_MAX_GLYPH_RECTS];
+static uint16_t s_glyph_first[FONT_CHAR_COUNT + 1];  /* Rect range per glyph */
+static uint8_t  s_glyph_pixels[FONT_CHAR_COUNT];     /* Set pixels (stats) */
+
+/* ============================================================
+ * String Cache
+ * ============================================================
+ * Strings drawn every frame (labels, HUD) keep their rects, laid
+ * out and scaled relative to the string origin. Geometry depends
+ * only on text and scale, so color is applied at draw time and
+ * one entry serves every color. Entries are replaced least
+ * recently used; the rect pool is recycled whole when it fills.
+ * ============================================================ */
+#define FONT_CACHE_ENTRIES  64
+#define FONT_CACHE_TEXT_MAX 48      /* Longer strings bypass the cache */
+#define FONT_CACHE_RECTS    4096
+
+typedef struct {
+    int16_t x, y, w, h;         /* Screen pixels from string origin */
+} FontCacheRect;
+
+typedef struct {
+    uint32_t hash;              /* 0 = empty */
+    uint32_t last_used;
+    uint16_t first;             /* Range in s_cache_rects */
+    uint16_t count;
+    uint16_t chars;             /* Glyphs (stats) */
+    uint16_t pixels;            /* Set pixels (stats) */
+    uint8_t  scale;
+    char     text[FONT_CACHE_TEXT_MAX];
+} FontCacheEntry;
+
+static FontCacheEntry s_cache[FONT_CACHE_ENTRIES];
+static FontCacheRect  s_cache_rects[FONT_CACHE_RECTS];
+static uint16_t       s_cache_used = 0;
+static uint32_t       s_cache_clock = 0;
+
+static FontStats s_stats;
+
 /* Static state */
 static int s_initialized = 0;
 
@@ -116,6 +175,198 @@ static int s_initialized = 0;
 #define FONT_PRINTF_BUFFER_SIZE 256
 static char s_printf_buffer[FONT_PRINTF_BUFFER_SIZE];
 
+/* ============================================================
+ * Compile Glyphs into Merged Spans
+ * ============================================================ */
+static void compile_glyphs(void)
+{
+    uint16_t count = 0;
+    int ch, row, col;
+
+    for (ch = 0; ch < FONT_CHAR_COUNT; ch++) {
+        const uint8_t *glyph = s_font_data[ch];
+        uint16_t first = count;
+        int pixels = 0;
+
+        s_glyph_first[ch] = first;
+
+        for (row = 0; row < FONT_CHAR_HEIGHT; row++) {
+            col = 0;
+            while (col < FONT_CHAR_WIDTH) {
+                int start, len;
+                uint16_t r;
+
+                if (!(glyph[row] & (0x80 >> col))) {
+                    col++;
+                    continue;
+                }
+                start = col;
+                while (col < FONT_CHAR_WIDTH && (glyph[row] & (0x80 >> col))) {
+                    col++;
+                }
+                len = col - start;
+                pixels += len;
+
+                /* Extend a rect ending on the row above with the same run */
+                for (r = first; r < count; r++) {
+                    FontRect *fr = &s_glyph_rects[r];
+                    if (fr->x == start && fr->w == len && fr->y + fr->h == row) {
+                        fr->h++;
+                        break;
+                    }
+                }
+                if (r == count && count < FONT_MAX_GLYPH_RECTS) {
+                    s_glyph_rects[count].x = (uint8_t)start;
+                    s_glyph_rects[count].y = (uint8_t)row;
+                    s_glyph_rects[count].w = (uint8_t)len;
+                    s_glyph_rects[count].h = 1;
+                    count++;
+                }
+            }
+        }
+        s_glyph_pixels[ch] = (uint8_t)pixels;
+    }
+    s_glyph_first[FONT_CHAR_COUNT] = count;
+}
+
+/* ============================================================
+ * Glyph Index (invalid characters draw as '?')
+ * ============================================================ */
+static int glyph_index(char c)
+{
+    if (c < FONT_FIRST_CHAR || c > FONT_LAST_CHAR) {
+        c = '?';
+    }
+    return c - FONT_FIRST_CHAR;
+}
+
+/* ============================================================
+ * Clear String Cache
+ * ============================================================ */
+void font_cache_clear(void)
+{
+    memset(s_cache, 0, sizeof(s_cache));
+    s_cache_used = 0;
+}
+
+/* ============================================================
+ * Stats
+ * ============================================================ */
+void font_stats_reset(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void font_get_stats(FontStats *out)
+{
+    if (out) {
+        *out = s_stats;
+    }
+}
+
+/* ============================================================
+ * Hash String (FNV-1a over text and scale; never 0)
+ * ============================================================ */
+static uint32_t hash_string(const char *str, int scale, int *out_len)
+{
+    uint32_t h = 2166136261u;
+    int len = 0;
+
+    while (str[len]) {
+        h = (h ^ (uint8_t)str[len]) * 16777619u;
+        len++;
+    }
+    h = (h ^ (uint32_t)scale) * 16777619u;
+    *out_len = len;
+    return h ? h : 1u;
+}
+
+/* ============================================================
+ * Build Cache Entry (lay out a string's rects)
+ * ============================================================
+ * Returns NULL if the rect pool cannot hold the string even
+ * after recycling it.
+ * ============================================================ */
+static FontCacheEntry *cache_build(const char *str, int len, int scale, uint32_t hash)
+{
+    FontCacheEntry *entry;
+    uint16_t needed = 0;
+    int i, cx, cy;
+
+    for (i = 0; i < len; i++) {
+        if (str[i] != '\n') {
+            int g = glyph_index(str[i]);
+            needed += (uint16_t)(s_glyph_first[g + 1] - s_glyph_first[g]);
+        }
+    }
+    if (needed > FONT_CACHE_RECTS) {
+        return NULL;
+    }
+    if (s_cache_used + needed > FONT_CACHE_RECTS) {
+        font_cache_clear();
+    }
+
+    /* Least recently used (or empty) slot */
+    entry = &s_cache[0];
+    for (i = 1; i < FONT_CACHE_ENTRIES && entry->hash != 0; i++) {
+        if (s_cache[i].hash == 0 || s_cache[i].last_used < entry->last_used) {
+            entry = &s_cache[i];
+        }
+    }
+
+    entry->hash = hash;
+    entry->scale = (uint8_t)scale;
+    entry->first = s_cache_used;
+    entry->count = needed;
+    entry->chars = 0;
+    entry->pixels = 0;
+    memcpy(entry->text, str, (size_t)len + 1);
+
+    cx = 0;
+    cy = 0;
+    for (i = 0; i < len; i++) {
+        uint16_t r;
+        int g;
+
+        if (str[i] == '\n') {
+            cx = 0;
+            cy += FONT_CHAR_HEIGHT * scale;
+            continue;
+        }
+        g = glyph_index(str[i]);
+        for (r = s_glyph_first[g]; r < s_glyph_first[g + 1]; r++) {
+            const FontRect *fr = &s_glyph_rects[r];
+            FontCacheRect *cr = &s_cache_rects[s_cache_used++];
+            cr->x = (int16_t)(cx + fr->x * scale);
+            cr->y = (int16_t)(cy + fr->y * scale);
+            cr->w = (int16_t)(fr->w * scale);
+            cr->h = (int16_t)(fr->h * scale);
+        }
+        entry->chars++;
+        entry->pixels += s_glyph_pixels[g];
+        cx += FONT_CHAR_WIDTH * scale;
+    }
+
+    return entry;
+}
+
+/* ============================================================
+ * Find Cache Entry
+ * ============================================================ */
+static FontCacheEntry *cache_find(const char *str, int len, int scale, uint32_t hash)
+{
+    int i;
+
+    for (i = 0; i < FONT_CACHE_ENTRIES; i++) {
+        FontCacheEntry *e = &s_cache[i];
+        if (e->hash == hash && e->scale == scale &&
+            memcmp(e->text, str, (size_t)len + 1) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
 /* ============================================================
  * Initialize Font Subsystem
  * ============================================================ */
@@ -130,6 +381,10 @@ int font_init(void)
         return -1;
     }
 
+    compile_glyphs();
+    font_cache_clear();
+    font_stats_reset();
+
     s_initialized = 1;
     return 0;
 }
@@ -156,11 +411,7 @@ int font_is_initialized(void)
 void font_draw_char_screen(char c, int x, int y, uint64_t color, int scale)
 {
     int char_index;
-    const uint8_t *glyph;
-    int row, col;
-    uint8_t row_data;
-    int px, py;
-    int pixel_size;
+    uint16_t r;
 
     if (!s_initialized) {
         return;
@@ -170,27 +421,16 @@ void font_draw_char_screen(char c, int x, int y, uint64_t color, int scale)
     if (scale < 1) scale = 1;
     if (scale > 8) scale = 8;
 
-    /* Validate character range */
-    if (c < FONT_FIRST_CHAR || c > FONT_LAST_CHAR) {
-        c = '?';  /* Replace invalid chars with ? */
+    char_index = glyph_index(c);
+    for (r = s_glyph_first[char_index]; r < s_glyph_first[char_index + 1]; r++) {
+        const FontRect *fr = &s_glyph_rects[r];
+        render_rect_screen(x + fr->x * scale, y + fr->y * scale,
+                           fr->w * scale, fr->h * scale, color);
     }
 
-    char_index = c - FONT_FIRST_CHAR;
-    glyph = s_font_data[char_index];
-    pixel_size = scale;
-
-    for (row = 0; row < FONT_CHAR_HEIGHT; row++) {
-        row_data = glyph[row];
-        py = y + row * scale;
-
-        for (col = 0; col < FONT_CHAR_WIDTH; col++) {
-            /* Check if pixel is set (MSB first) */
-            if (row_data & (0x80 >> col)) {
-                px = x + col * scale;
-                render_rect_screen(px, py, pixel_size, pixel_size, color);
-            }
-        }
-    }
+    s_stats.chars++;
+    s_stats.prims += (uint32_t)(s_glyph_first[char_index + 1] - s_glyph_first[char_index]);
+    s_stats.pixel_prims += s_glyph_pixels[char_index];
 }
 
 /* ============================================================
@@ -200,6 +440,8 @@ void font_draw_string_screen(const char *str, int x, int y, uint64_t color, int
 {
     int cursor_x;
     int char_width;
+    uint32_t hash;
+    int len;
 
     if (!s_initialized || !str) {
         return;
@@ -208,6 +450,33 @@ void font_draw_string_screen(const char *str, int x, int y, uint64_t color, int
     if (scale < 1) scale = 1;
     if (scale > 8) scale = 8;
 
+    /* Cached path: one lookup, then the string's prebuilt rects */
+    hash = hash_string(str, scale, &len);
+    if (len < FONT_CACHE_TEXT_MAX) {
+        FontCacheEntry *entry = cache_find(str, len, scale, hash);
+
+        if (entry) {
+            s_stats.cache_hits++;
+        } else {
+            s_stats.cache_misses++;
+            entry = cache_build(str, len, scale, hash);
+        }
+
+        if (entry) {
+            const FontCacheRect *cr = &s_cache_rects[entry->first];
+            uint16_t r;
+
+            entry->last_used = ++s_cache_clock;
+            for (r = 0; r < entry->count; r++, cr++) {
+                render_rect_screen(x + cr->x, y + cr->y, cr->w, cr->h, color);
+            }
+            s_stats.chars += entry->chars;
+            s_stats.prims += entry->count;
+            s_stats.pixel_prims += entry->pixels;
+            return;
+        }
+    }
+
     cursor_x = x;
     char_width = FONT_CHAR_WIDTH * scale;
 
@@ -8,6 +8,10 @@
  * ============================================================
  * Minimal bitmap font renderer for ASCII 32..126.
  * Uses an embedded 8x8 monospace bitmap font.
+ *
+ * Glyphs are compiled at init into merged pixel spans, so each
+ * character is a few sprites rather than one per set pixel.
+ * Strings are laid out once and cached by text and scale.
  * ============================================================ */
 
 /* Font dimensions */
@@ -17,6 +21,17 @@
 #define FONT_LAST_CHAR    126
 #define FONT_CHAR_COUNT   (FONT_LAST_CHAR - FONT_FIRST_CHAR + 1)
 
+/* ============================================================
+ * Font Stats (primitive counts, accumulated until reset)
+ * ============================================================ */
+typedef struct {
+    uint32_t chars;             /* Glyphs drawn */
+    uint32_t prims;             /* Sprites emitted */
+    uint32_t pixel_prims;       /* Sprites one-per-pixel drawing would emit */
+    uint32_t cache_hits;        /* Strings drawn from the string cache */
+    uint32_t cache_misses;      /* Strings laid out into the cache */
+} FontStats;
+
 /* ============================================================
  * Font API
  * ============================================================ */
@@ -82,4 +97,11 @@ int font_string_height(int scale);
 /* Check if font subsystem is initialized. */
 int font_is_initialized(void);
 
+/* Drop all cached string layouts. */
+void font_cache_clear(void);
+
+/* Read / clear primitive counts. */
+void font_get_stats(FontStats *out);
+void font_stats_reset(void);
+
 #endif /* FONT_H */
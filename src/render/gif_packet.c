@@ -0,0 +1,655 @@
+#include "gif_packet.h"
+#include "circle_lut.h"
+#include <stddef.h>
+
+/* PACKED A+D tag and its PRIM write */
+#define GIF_PRIM_QWORDS       2
+
+/* Smallest arena that holds the largest single write (one circle) */
+#define GIF_ARENA_MIN_QWORDS  (GIF_PRIM_QWORDS + 4 + (CIRCLE_LUT_MAX_SEGMENTS + 2) / 2)
+
+/* ============================================================
+ * Helpers
+ * ============================================================ */
+static uint64_t gif_tag(uint32_t nloop, int flg, int nreg)
+{
+    return (uint64_t)(nloop & GIF_NLOOP_MAX) |
+           ((uint64_t)1 << 15) |                        /* EOP */
+           ((uint64_t)(flg & 0x3) << 58) |
+           ((uint64_t)(nreg & 0xF) << 60);
+}
+
+/* Set PRIM ahead of a REGLIST run. The GS only honours a tag's PRE
+ * bit in PACKED mode, so PRIM goes through an A+D write. */
+static uint64_t *gif_put_prim(uint64_t *w, uint32_t prim_reg)
+{
+    *w++ = gif_tag(1, GIF_FLG_PACKED, 1);
+    *w++ = GIF_REG_AD;
+    *w++ = (uint64_t)(prim_reg & 0x7FFu);
+    *w++ = GIF_REG_PRIM;
+    return w;
+}
+
+/* 12.4 window coordinate, clamped to the 16-bit register field */
+static uint64_t gif_coord(int px, int offset)
+{
+    int v = px * 16 + offset;
+
+    if (v < 0) v = 0;
+    if (v > 0xFFFF) v = 0xFFFF;
+    return (uint64_t)v;
+}
+
+static uint64_t gif_xyz2(const GifPacket *gp, int x, int y)
+{
+    return gif_coord(x, gp->offset_x) | (gif_coord(y, gp->offset_y) << 16);
+}
+
+static uint64_t gif_rgbaq(uint32_t color, uint8_t alpha)
+{
+    return (uint64_t)((color & 0x00FFFFFFu) | ((uint32_t)alpha << 24));
+}
+
+/* Make room for qwc qwords, kicking the current arena if needed */
+static uint64_t *gif_reserve(GifPacket *gp, uint32_t qwc)
+{
+    if (gp->count + qwc > gp->capacity) {
+        gif_packet_kick(gp);
+    }
+    return gp->qw[gp->current] + (size_t)gp->count * 2;
+}
+
+/* Qwords used by a tag with n 64-bit REGLIST words (padded) */
+static uint32_t reglist_qwords(uint32_t words)
+{
+    return 1 + (words + 1) / 2;
+}
+
+/* ============================================================
+ * Init
+ * ============================================================ */
+int gif_packet_init(GifPacket *gp, uint64_t *arena0, uint64_t *arena1,
+                    uint32_t capacity, int offset_x, int offset_y,
+                    GifKick kick, void *user)
+{
+    if (!gp || !arena0 || !arena1 || capacity < GIF_ARENA_MIN_QWORDS) {
+        return -1;
+    }
+
+    gp->qw[0] = arena0;
+    gp->qw[1] = arena1;
+    gp->capacity = capacity;
+    gp->count = 0;
+    gp->current = 0;
+    gp->offset_x = offset_x;
+    gp->offset_y = offset_y;
+    gp->kick = kick;
+    gp->user = user;
+    gif_packet_stats_reset(gp);
+    return 0;
+}
+
+void gif_packet_stats_reset(GifPacket *gp)
+{
+    if (!gp) {
+        return;
+    }
+    gp->stat_kicks = 0;
+    gp->stat_qwords = 0;
+    gp->stat_tags = 0;
+    gp->stat_prims = 0;
+}
+
+/* ============================================================
+ * Kick
+ * ============================================================ */
+void gif_packet_kick(GifPacket *gp)
+{
+    if (!gp || gp->count == 0) {
+        return;
+    }
+    if (gp->kick) {
+        gp->kick(gp->user, gp->qw[gp->current], gp->count);
+    }
+    gp->stat_kicks++;
+    gp->stat_qwords += gp->count;
+    gp->current ^= 1;
+    gp->count = 0;
+}
+
+/* ============================================================
+ * Register Writes (PACKED A+D)
+ * ============================================================ */
+void gif_packet_set_reg(GifPacket *gp, uint8_t reg, uint64_t value)
+{
+    uint64_t *w;
+
+    if (!gp) {
+        return;
+    }
+    w = gif_reserve(gp, 2);
+    w[0] = gif_tag(1, GIF_FLG_PACKED, 1);
+    w[1] = GIF_REG_AD;
+    w[2] = value;
+    w[3] = reg;
+    gp->count += 2;
+    gp->stat_tags++;
+}
+
+/* ============================================================
+ * Primitive Runs (REGLIST)
+ * ============================================================
+ * PRIM (A+D), then one tag per run of sprites, lines or triangles:
+ * RGBAQ then the vertices of each primitive. Runs are split at NLOOP_MAX and at
+ * the end of an arena.
+ * ============================================================ */
+static void gif_run(GifPacket *gp, DlPrim prim, uint32_t prim_reg, uint8_t opaque_alpha,
+                    const DlCmd *cmds, const uint32_t *order, uint32_t n)
+{
+    int verts = (prim == DL_PRIM_TRIANGLE) ? 3 : 2;
+    uint32_t words = (uint32_t)verts + 1;
+    uint64_t regs = GIF_REG_RGBAQ | ((uint64_t)GIF_REG_XYZ2 << 4) |
+                    ((uint64_t)GIF_REG_XYZ2 << 8) |
+                    (verts == 3 ? ((uint64_t)GIF_REG_XYZ2 << 12) : 0);
+
+    while (n > 0) {
+        uint32_t avail = gp->capacity - gp->count;
+        uint32_t run, i;
+        uint64_t *w;
+
+        if (avail < GIF_PRIM_QWORDS + reglist_qwords(words)) {
+            gif_packet_kick(gp);
+            continue;
+        }
+        run = ((avail - GIF_PRIM_QWORDS - 1) * 2) / words;
+        if (run > n) run = n;
+        if (run > GIF_NLOOP_MAX) run = GIF_NLOOP_MAX;
+
+        w = gp->qw[gp->current] + (size_t)gp->count * 2;
+        w = gif_put_prim(w, prim_reg);
+        *w++ = gif_tag(run, GIF_FLG_REGLIST, (int)words);
+        *w++ = regs;
+
+        for (i = 0; i < run; i++) {
+            const DlCmd *cmd = &cmds[DL_KEY_INDEX(order[i])];
+            uint8_t a = opaque_alpha ? opaque_alpha : (uint8_t)(cmd->color >> 24);
+
+            *w++ = gif_rgbaq(cmd->color, a);
+            *w++ = gif_xyz2(gp, cmd->v[0], cmd->v[1]);
+            *w++ = gif_xyz2(gp, cmd->v[2], cmd->v[3]);
+            if (verts == 3) {
+                *w++ = gif_xyz2(gp, cmd->v[4], cmd->v[5]);
+            }
+        }
+        if ((run * words) & 1) {
+            *w++ = 0;                   /* Pad to a qword */
+        }
+
+        gp->count += GIF_PRIM_QWORDS + reglist_qwords(run * words);
+        gp->stat_tags += 2;
+        gp->stat_prims += run;
+        order += run;
+        n -= run;
+    }
+}
+
+/* ============================================================
+ * Circles (TRI_FAN)
+ * ============================================================
+ * PRIM (A+D), tag 1 writes RGBAQ + center, tag 2 carries the rim,
+ * segments + 1 vertices from angle 0 around to angle 0.
+ * ============================================================ */
+static void gif_circle(GifPacket *gp, uint32_t prim_reg, const DlCmd *cmd, uint8_t alpha)
+{
+    int scx = cmd->v[0];
+    int scy = cmd->v[1];
+    float rx = (float)cmd->v[2];
+    float ry = (float)cmd->v[3];
+    int segments = circle_lut_clamp(cmd->v[4]);
+    const float *cs = circle_lut_cos(segments);
+    const float *sn = circle_lut_sin(segments);
+    uint32_t rim = (uint32_t)segments + 1;
+    uint64_t *w;
+    int i;
+
+    w = gif_reserve(gp, GIF_PRIM_QWORDS + 2 + reglist_qwords(rim));
+    w = gif_put_prim(w, prim_reg);
+    *w++ = gif_tag(1, GIF_FLG_REGLIST, 2);
+    *w++ = GIF_REG_RGBAQ | ((uint64_t)GIF_REG_XYZ2 << 4);
+    *w++ = gif_rgbaq(cmd->color, alpha);
+    *w++ = gif_xyz2(gp, scx, scy);
+
+    *w++ = gif_tag(rim, GIF_FLG_REGLIST, 1);
+    *w++ = GIF_REG_XYZ2;
+    *w++ = gif_xyz2(gp, scx + cmd->v[2], scy);
+    for (i = 1; i <= segments; i++) {
+        *w++ = gif_xyz2(gp, scx + (int)(rx * cs[i]), scy + (int)(ry * sn[i]));
+    }
+    if (rim & 1) {
+        *w++ = 0;
+    }
+
+    gp->count += GIF_PRIM_QWORDS + 2 + reglist_qwords(rim);
+    gp->stat_tags += 3;
+    gp->stat_prims += (uint32_t)segments;
+}
+
+/* ============================================================
+ * Batches
+ * ============================================================ */
+void gif_packet_draw_batch(void *user, DlPrim prim, DlBlend blend,
+                           const DlCmd *cmds, const uint32_t *order, uint32_t n)
+{
+    GifPacket *gp = (GifPacket *)user;
+    uint32_t abe = (blend == DL_BLEND_ALPHA) ? GIF_PRIM_ABE : 0;
+    uint8_t opaque_alpha = (blend == DL_BLEND_ALPHA) ? 0 : 0x80;
+    uint32_t i;
+
+    if (!gp || !cmds || !order) {
+        return;
+    }
+
+    switch (prim) {
+        case DL_PRIM_RECT:
+            gif_run(gp, prim, GIF_PRIM_SPRITE | abe, opaque_alpha, cmds, order, n);
+            break;
+        case DL_PRIM_LINE:
+            gif_run(gp, prim, GIF_PRIM_LINE | abe, opaque_alpha, cmds, order, n);
+            break;
+        case DL_PRIM_TRIANGLE:
+            gif_run(gp, prim, GIF_PRIM_TRIANGLE | abe, opaque_alpha, cmds, order, n);
+            break;
+        case DL_PRIM_CIRCLE:
+            for (i = 0; i < n; i++) {
+                const DlCmd *cmd = &cmds[DL_KEY_INDEX(order[i])];
+                gif_circle(gp, GIF_PRIM_TRI_FAN | abe, cmd,
+                           opaque_alpha ? opaque_alpha : (uint8_t)(cmd->color >> 24));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void gif_packet_clear(GifPacket *gp, int width, int height, uint32_t color)
+{
+    int x = 0;
+
+    if (!gp || width <= 0 || height <= 0) {
+        return;
+    }
+
+    /* PRIM (A+D); tag 1: RGBAQ (padded); tag 2: strips as XYZ2 pairs */
+    while (x < width) {
+        uint32_t strips = (uint32_t)((width - x + GIF_CLEAR_STRIP - 1) / GIF_CLEAR_STRIP);
+        uint32_t room;
+        uint64_t *w;
+        uint32_t i;
+
+        if (gp->capacity - gp->count < GIF_PRIM_QWORDS + 4) {
+            gif_packet_kick(gp);
+        }
+        room = gp->capacity - gp->count - GIF_PRIM_QWORDS - 3;
+        if (strips > room) strips = room;
+
+        w = gp->qw[gp->current] + (size_t)gp->count * 2;
+        w = gif_put_prim(w, GIF_PRIM_SPRITE);
+        *w++ = gif_tag(1, GIF_FLG_REGLIST, 1);
+        *w++ = GIF_REG_RGBAQ;
+        *w++ = gif_rgbaq(color, 0x80);
+        *w++ = 0;
+        *w++ = gif_tag(strips, GIF_FLG_REGLIST, 2);
+        *w++ = GIF_REG_XYZ2 | ((uint64_t)GIF_REG_XYZ2 << 4);
+        for (i = 0; i < strips; i++, x += GIF_CLEAR_STRIP) {
+            int x2 = x + GIF_CLEAR_STRIP < width ? x + GIF_CLEAR_STRIP : width;
+            *w++ = gif_xyz2(gp, x, 0);
+            *w++ = gif_xyz2(gp, x2, height);
+        }
+
+        gp->count += GIF_PRIM_QWORDS + 3 + strips;
+        gp->stat_tags += 3;
+        gp->stat_prims += strips;
+    }
+}
+
+/* ============================================================
+ * Upscale Blit (textured SPRITE)
+ * ============================================================
+ * TEXFLUSH, TEX0/TEX1/CLAMP and PRIM (A+D), then one REGLIST tag
+ * of UV XYZ2 UV XYZ2 per GIF_CLEAR_STRIP wide strip (narrow strips
+ * keep the GS texture cache hitting). UVs map destination pixel
+ * edges onto the source region in 1/16 texels.
+ * ============================================================ */
+static uint64_t gif_log2_ceil(int v)
+{
+    uint64_t n = 0;
+
+    while ((1 << n) < v && n < 10) {
+        n++;
+    }
+    return n;
+}
+
+static uint64_t gif_uv(int u16, int v16)
+{
+    return (uint64_t)(u16 & 0x3FFF) | ((uint64_t)(v16 & 0x3FFF) << 16);
+}
+
+void gif_packet_blit(GifPacket *gp, const GifBlitSource *src,
+                     int width, int height, int bilinear)
+{
+    uint64_t filter = bilinear ? 1 : 0;
+    int sw, sh;
+    int x = 0;
+
+    if (!gp || !src || src->width <= 0 || src->height <= 0 ||
+        src->width > 1024 || src->height > 1024 || width <= 0 || height <= 0) {
+        return;
+    }
+    sw = src->width;
+    sh = src->height;
+
+    /* TEX0: RGB from the texture (TCC 0), TFX DECAL */
+    gif_packet_set_reg(gp, GIF_REG_TEXFLUSH, 0);
+    gif_packet_set_reg(gp, GIF_REG_TEX0_1,
+                       (uint64_t)(src->tbp & 0x3FFFu) |
+                       ((uint64_t)(src->tbw & 0x3Fu) << 14) |
+                       ((uint64_t)(src->psm & 0x3Fu) << 20) |
+                       (gif_log2_ceil(sw) << 26) |
+                       (gif_log2_ceil(sh) << 30) |
+                       ((uint64_t)1 << 35));
+    /* TEX1: fixed LOD 0 (LCM 1, K 0); MMAG/MMIN nearest or linear */
+    gif_packet_set_reg(gp, GIF_REG_TEX1_1, 1u | (filter << 5) | (filter << 6));
+    /* CLAMP: REGION_CLAMP to [0, sw - 1] x [0, sh - 1] */
+    gif_packet_set_reg(gp, GIF_REG_CLAMP_1,
+                       2u | (2u << 2) | ((uint64_t)(sw - 1) << 14) |
+                       ((uint64_t)(sh - 1) << 34));
+
+    while (x < width) {
+        uint32_t strips = (uint32_t)((width - x + GIF_CLEAR_STRIP - 1) / GIF_CLEAR_STRIP);
+        uint32_t room;
+        uint64_t *w;
+        uint32_t i;
+
+        if (gp->capacity - gp->count < GIF_PRIM_QWORDS + 3) {
+            gif_packet_kick(gp);
+        }
+        room = (gp->capacity - gp->count - GIF_PRIM_QWORDS - 1) / 2;
+        if (strips > room) strips = room;
+
+        w = gp->qw[gp->current] + (size_t)gp->count * 2;
+        w = gif_put_prim(w, GIF_PRIM_SPRITE | GIF_PRIM_TME | GIF_PRIM_FST);
+        *w++ = gif_tag(strips, GIF_FLG_REGLIST, 4);
+        *w++ = GIF_REG_UV | ((uint64_t)GIF_REG_XYZ2 << 4) |
+               ((uint64_t)GIF_REG_UV << 8) | ((uint64_t)GIF_REG_XYZ2 << 12);
+        for (i = 0; i < strips; i++, x += GIF_CLEAR_STRIP) {
+            int x2 = x + GIF_CLEAR_STRIP < width ? x + GIF_CLEAR_STRIP : width;
+            *w++ = gif_uv(x * 16 * sw / width, 0);
+            *w++ = gif_xyz2(gp, x, 0);
+            *w++ = gif_uv(x2 * 16 * sw / width, sh * 16);
+            *w++ = gif_xyz2(gp, x2, height);
+        }
+
+        gp->count += GIF_PRIM_QWORDS + 1 + strips * 2;
+        gp->stat_tags += 2;
+        gp->stat_prims += strips;
+    }
+}
+
+/* ============================================================
+ * Decoder
+ * ============================================================ */
+void gif_decoder_init(GifDecoder *dec, int offset_x, int offset_y,
+                      GifPrimFn fn, void *user)
+{
+    if (!dec) {
+        return;
+    }
+    dec->prim = 0;
+    dec->rgba = 0;
+    dec->uv = 0;
+    dec->alpha1 = 0;
+    dec->frame1 = 0;
+    dec->scissor1 = 0;
+    dec->tex0 = 0;
+    dec->tex1 = 0;
+    dec->clamp1 = 0;
+    dec->texflushes = 0;
+    dec->queued = 0;
+    dec->offset_x = offset_x;
+    dec->offset_y = offset_y;
+    dec->fn = fn;
+    dec->user = user;
+    dec->tags = 0;
+    dec->prims = 0;
+}
+
+static void dec_emit(GifDecoder *dec, uint8_t type, int a, int b, int c, int verts)
+{
+    GifPrim p;
+    int idx[3];
+    int i;
+
+    idx[0] = a;
+    idx[1] = b;
+    idx[2] = c;
+    p.type = type;
+    p.abe = (dec->prim & GIF_PRIM_ABE) ? 1 : 0;
+    p.verts = (uint8_t)verts;
+    p.tme = (dec->prim & GIF_PRIM_TME) ? 1 : 0;
+    p.rgba = dec->qc[idx[verts - 1]];
+    for (i = 0; i < 3; i++) {
+        p.x[i] = i < verts ? dec->qx[idx[i]] : 0;
+        p.y[i] = i < verts ? dec->qy[idx[i]] : 0;
+        p.u[i] = (i < verts && p.tme) ? dec->qu[idx[i]] : 0;
+        p.v[i] = (i < verts && p.tme) ? dec->qv[idx[i]] : 0;
+    }
+    dec->prims++;
+    if (dec->fn) {
+        dec->fn(dec->user, &p);
+    }
+}
+
+/* Move queued vertex from into slot to */
+static void dec_move(GifDecoder *dec, int to, int from)
+{
+    dec->qx[to] = dec->qx[from];
+    dec->qy[to] = dec->qy[from];
+    dec->qu[to] = dec->qu[from];
+    dec->qv[to] = dec->qv[from];
+    dec->qc[to] = dec->qc[from];
+}
+
+/* XYZ2: queue a vertex and draw when the primitive is complete */
+static void dec_vertex(GifDecoder *dec, int32_t x, int32_t y)
+{
+    int type = (int)(dec->prim & 0x7u);
+    int n = dec->queued;
+
+    if (n > 2) {
+        n = 2;                          /* Strips/fans keep two */
+    }
+    dec->qx[n] = x - dec->offset_x;
+    dec->qy[n] = y - dec->offset_y;
+    dec->qu[n] = (int32_t)(dec->uv & 0x3FFFu);
+    dec->qv[n] = (int32_t)((dec->uv >> 16) & 0x3FFFu);
+    dec->qc[n] = dec->rgba;
+    n++;
+
+    switch (type) {
+        case GIF_PRIM_POINT:
+            dec_emit(dec, GIF_PRIM_POINT, 0, 0, 0, 1);
+            n = 0;
+            break;
+        case GIF_PRIM_LINE:
+        case GIF_PRIM_SPRITE:
+            if (n == 2) {
+                dec_emit(dec, (uint8_t)type, 0, 1, 0, 2);
+                n = 0;
+            }
+            break;
+        case GIF_PRIM_LINE_STRIP:
+            if (n == 2) {
+                dec_emit(dec, GIF_PRIM_LINE, 0, 1, 0, 2);
+                dec_move(dec, 0, 1);
+                n = 1;
+            }
+            break;
+        case GIF_PRIM_TRIANGLE:
+            if (n == 3) {
+                dec_emit(dec, GIF_PRIM_TRIANGLE, 0, 1, 2, 3);
+                n = 0;
+            }
+            break;
+        case GIF_PRIM_TRI_STRIP:
+        case GIF_PRIM_TRI_FAN:
+            if (n == 3) {
+                dec_emit(dec, GIF_PRIM_TRIANGLE, 0, 1, 2, 3);
+                if (type == GIF_PRIM_TRI_STRIP) {
+                    dec_move(dec, 0, 1);
+                }
+                dec_move(dec, 1, 2);
+                n = 2;
+            }
+            break;
+        default:
+            n = 0;                      /* Reserved type: nothing drawn */
+            break;
+    }
+    dec->queued = n;
+}
+
+/* Register write (REGLIST data or A+D). Returns -1 if unsupported. */
+static int dec_reg(GifDecoder *dec, uint32_t reg, uint64_t v)
+{
+    switch (reg) {
+        case GIF_REG_PRIM:
+            dec->prim = (uint32_t)(v & 0x7FFu);
+            dec->queued = 0;
+            return 0;
+        case GIF_REG_RGBAQ:
+            dec->rgba = (uint32_t)v;
+            return 0;
+        case GIF_REG_UV:
+            dec->uv = (uint32_t)v;
+            return 0;
+        case GIF_REG_XYZ2:
+            dec_vertex(dec, (int32_t)(v & 0xFFFF), (int32_t)((v >> 16) & 0xFFFF));
+            return 0;
+        case GIF_REG_ALPHA_1:
+            dec->alpha1 = v;
+            return 0;
+        case GIF_REG_FRAME_1:
+            dec->frame1 = v;
+            return 0;
+        case GIF_REG_SCISSOR_1:
+            dec->scissor1 = v;
+            return 0;
+        case GIF_REG_TEX0_1:
+            dec->tex0 = v;
+            return 0;
+        case GIF_REG_TEX1_1:
+            dec->tex1 = v;
+            return 0;
+        case GIF_REG_CLAMP_1:
+            dec->clamp1 = v;
+            return 0;
+        case GIF_REG_TEXFLUSH:
+            dec->texflushes++;
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+int gif_decode(GifDecoder *dec, const uint64_t *qwords, uint32_t qwc)
+{
+    uint32_t q = 0;
+
+    if (!dec || (!qwords && qwc)) {
+        return -1;
+    }
+
+    while (q < qwc) {
+        uint64_t lo = qwords[(size_t)q * 2];
+        uint64_t regs = qwords[(size_t)q * 2 + 1];
+        uint32_t nloop = (uint32_t)(lo & GIF_NLOOP_MAX);
+        int flg = (int)((lo >> 58) & 0x3);
+        int nreg = (int)((lo >> 60) & 0xF);
+        uint32_t loop;
+        int r;
+
+        if (nreg == 0) {
+            nreg = 16;
+        }
+        q++;
+        dec->tags++;
+
+        if (flg == GIF_FLG_PACKED) {
+            /* PRE is ignored by the GS outside PACKED mode */
+            if ((lo >> 46) & 1) {
+                dec_reg(dec, GIF_REG_PRIM, (lo >> 47) & 0x7FF);
+            }
+            if ((uint64_t)q + (uint64_t)nloop * (uint64_t)nreg > qwc) {
+                return -1;
+            }
+            for (loop = 0; loop < nloop; loop++) {
+                for (r = 0; r < nreg; r++) {
+                    uint32_t desc = (uint32_t)((regs >> (r * 4)) & 0xF);
+                    uint64_t d0 = qwords[(size_t)q * 2];
+                    uint64_t d1 = qwords[(size_t)q * 2 + 1];
+                    int rc = 0;
+
+                    switch (desc) {
+                        case GIF_REG_PRIM:
+                            rc = dec_reg(dec, GIF_REG_PRIM, d0);
+                            break;
+                        case GIF_REG_RGBAQ:
+                            rc = dec_reg(dec, GIF_REG_RGBAQ,
+                                         (d0 & 0xFF) | (((d0 >> 32) & 0xFF) << 8) |
+                                         ((d1 & 0xFF) << 16) | (((d1 >> 32) & 0xFF) << 24));
+                            break;
+                        case GIF_REG_XYZ2:
+                            rc = dec_reg(dec, GIF_REG_XYZ2,
+                                         (d0 & 0xFFFF) | (((d0 >> 32) & 0xFFFF) << 16));
+                            break;
+                        case GIF_REG_AD:
+                            rc = dec_reg(dec, (uint32_t)(d1 & 0xFF), d0);
+                            break;
+                        case GIF_REG_NOP:
+                            break;
+                        default:
+                            rc = -1;
+                            break;
+                    }
+                    if (rc != 0) {
+                        return -1;
+                    }
+                    q++;
+                }
+            }
+        } else if (flg == GIF_FLG_REGLIST) {
+            uint64_t words = (uint64_t)nloop * (uint64_t)nreg;
+            const uint64_t *w = qwords + (size_t)q * 2;
+
+            if ((uint64_t)q + (words + 1) / 2 > qwc) {
+                return -1;
+            }
+            for (loop = 0; loop < nloop; loop++) {
+                for (r = 0; r < nreg; r++) {
+                    uint32_t desc = (uint32_t)((regs >> (r * 4)) & 0xF);
+
+                    if (desc == GIF_REG_AD || (desc != GIF_REG_NOP &&
+                                               dec_reg(dec, desc, *w) != 0)) {
+                        return -1;
+                    }
+                    w++;
+                }
+            }
+            q += (uint32_t)((words + 1) / 2);
+        } else {
+            return -1;                  /* IMAGE/disabled: not produced here */
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+#ifndef GIF_PACKET_H
+#define GIF_PACKET_H
+
+#include <stdint.h>
+#include "display_list.h"
+
+/* ============================================================
+ * GIF Packet Encoder
+ * ============================================================
+ * Writes display list batches as GS primitive packets for the GIF
+ * (PATH3), so the gsKit backend sends one DMA transfer per frame
+ * instead of one gsKit_prim_* call per primitive.
+ *
+ * Each batch is a PACKED A+D write of PRIM (type + ABE) and one
+ * REGLIST tag whose payload is RGBAQ followed by the XYZ2 vertices,
+ * 64 bits per register (PRE only takes effect in PACKED mode, so a
+ * REGLIST tag cannot set PRIM itself):
+ *   rect      SPRITE    RGBAQ XYZ2 XYZ2        (1.5 qwords)
+ *   line      LINE      RGBAQ XYZ2 XYZ2        (1.5 qwords)
+ *   triangle  TRIANGLE  RGBAQ XYZ2 XYZ2 XYZ2   (2 qwords)
+ *   circle    TRI_FAN   two tags per circle, segments + 2 vertices
+ * Other register writes (ALPHA_1, FRAME_1, SCISSOR_1) use the same
+ * PACKED A+D tag. Vertices are 12.4 window coordinates: pixel * 16
+ * plus the context offset (gsKit's OffsetX/OffsetY); Z is 0.
+ *
+ * gif_packet_blit() stretches a region of one VRAM buffer over the
+ * drawing area as textured sprites (reduced internal resolution):
+ * texture registers through A+D, then UV/XYZ2 pairs per strip.
+ *
+ * Packets go into two arenas of 16-byte aligned qwords. When the
+ * current arena cannot hold the next tag it is kicked early and
+ * encoding continues in the other one; the kick callback must not
+ * return until the previous kick has finished reading its arena.
+ *
+ * The decoder replays packets through a model of the GS vertex
+ * queue and reports the primitives drawn, so host tools can check
+ * the encoder against the display list (tools/gif_packet_check.c).
+ *
+ * Portable C: no gsKit dependency.
+ *
+ * Memory usage:
+ *   Arenas are caller-owned (render_gs.c: 2 * GIF_ARENA_QWORDS * 16
+ *   = 256KB)
+ * ============================================================ */
+
+#define GIF_ARENA_QWORDS   8192
+#define GIF_PACKET_ARENAS  2
+
+/* GIF tag NLOOP limit */
+#define GIF_NLOOP_MAX      0x7FFF
+
+/* ============================================================
+ * GS Registers and Primitive Types
+ * ============================================================ */
+#define GIF_REG_PRIM       0x00
+#define GIF_REG_RGBAQ      0x01
+#define GIF_REG_UV         0x03
+#define GIF_REG_XYZ2       0x05
+#define GIF_REG_TEX0_1     0x06
+#define GIF_REG_CLAMP_1    0x08
+#define GIF_REG_AD         0x0E   /* PACKED descriptor: address + data */
+#define GIF_REG_NOP        0x0F
+#define GIF_REG_TEX1_1     0x14
+#define GIF_REG_TEXFLUSH   0x3F
+#define GIF_REG_SCISSOR_1  0x40
+#define GIF_REG_ALPHA_1    0x42
+#define GIF_REG_FRAME_1    0x4C
+
+#define GIF_FLG_PACKED     0
+#define GIF_FLG_REGLIST    1
+#define GIF_FLG_IMAGE      2
+
+#define GIF_PRIM_POINT     0
+#define GIF_PRIM_LINE      1
+#define GIF_PRIM_LINE_STRIP 2
+#define GIF_PRIM_TRIANGLE  3
+#define GIF_PRIM_TRI_STRIP 4
+#define GIF_PRIM_TRI_FAN   5
+#define GIF_PRIM_SPRITE    6
+#define GIF_PRIM_TME       (1u << 4)   /* Texture mapping enable */
+#define GIF_PRIM_ABE       (1u << 6)   /* Alpha blending enable */
+#define GIF_PRIM_FST       (1u << 8)   /* Texture coordinates are UV */
+
+#define GIF_PSM_CT32       0x00
+
+/* Sprite width used by gif_packet_clear (GS page friendly) */
+#define GIF_CLEAR_STRIP    64
+
+/* ============================================================
+ * Encoder
+ * ============================================================ */
+
+/* Send qwc qwords at qwords (16-byte aligned). Returns once the
+ * arena of the previous call may be overwritten. */
+typedef void (*GifKick)(void *user, const uint64_t *qwords, uint32_t qwc);
+
+typedef struct {
+    uint64_t *qw[GIF_PACKET_ARENAS];   /* 2 uint64_t per qword */
+    uint32_t  capacity;                /* Qwords per arena */
+    uint32_t  count;                   /* Qwords in the current arena */
+    int       current;
+    int       offset_x;                /* 12.4, added to every vertex */
+    int       offset_y;
+    GifKick   kick;
+    void     *user;
+
+    /* Stats (reset by gif_packet_stats_reset) */
+    uint32_t  stat_kicks;
+    uint32_t  stat_qwords;
+    uint32_t  stat_tags;
+    uint32_t  stat_prims;
+} GifPacket;
+
+/* Bind two arenas of capacity qwords each (16-byte aligned).
+ * offset_x/offset_y are the 12.4 window offset. Returns 0 on
+ * success, -1 if an arena is missing or too small. */
+int gif_packet_init(GifPacket *gp, uint64_t *arena0, uint64_t *arena1,
+                    uint32_t capacity, int offset_x, int offset_y,
+                    GifKick kick, void *user);
+
+/* Write one GS register through a PACKED A+D tag */
+void gif_packet_set_reg(GifPacket *gp, uint8_t reg, uint64_t value);
+
+/* Fill [0, width) x [0, height) with an opaque color (RGBA8, alpha
+ * forced to 0x80) as GIF_CLEAR_STRIP wide sprites */
+void gif_packet_clear(GifPacket *gp, int width, int height, uint32_t color);
+
+/* DlBackend.draw_batch: user is the GifPacket. Opaque batches draw
+ * with alpha 0x80 and ABE off; alpha batches use the color alpha
+ * and ABE on (ALPHA_1 is set by the caller). */
+void gif_packet_draw_batch(void *user, DlPrim prim, DlBlend blend,
+                           const DlCmd *cmds, const uint32_t *order, uint32_t n);
+
+/* Source of gif_packet_blit: [0, width) x [0, height) of a buffer */
+typedef struct {
+    uint32_t tbp;           /* VRAM address / 256 */
+    uint32_t tbw;           /* Buffer width / 64 */
+    uint32_t psm;           /* GIF_PSM_* */
+    int      width;         /* Region drawn, at most 1024 x 1024 */
+    int      height;
+} GifBlitSource;
+
+/* Stretch src over [0, width) x [0, height) of the current FRAME_1
+ * (set by the caller), sampling nearest or bilinear (TEX1 MMAG/MMIN)
+ * with the edges clamped to the region. Flushes the texture cache
+ * first, so src may have been drawn earlier in the same packet. */
+void gif_packet_blit(GifPacket *gp, const GifBlitSource *src,
+                     int width, int height, int bilinear);
+
+/* Kick the current arena (if not empty) and switch arenas */
+void gif_packet_kick(GifPacket *gp);
+
+/* Clear stats */
+void gif_packet_stats_reset(GifPacket *gp);
+
+/* ============================================================
+ * Decoder
+ * ============================================================ */
+
+/* Primitive rebuilt from a packet. Strips and fans are expanded
+ * into LINE/TRIANGLE; coordinates are 1/16 pixel with the window
+ * offset removed. Color is the last vertex's (flat shading).
+ * Textured primitives (PRIM.TME with FST) also carry each vertex's
+ * UV in 1/16 texel. */
+typedef struct {
+    uint8_t  type;          /* GIF_PRIM_POINT/LINE/TRIANGLE/SPRITE */
+    uint8_t  abe;           /* PRIM.ABE when drawn */
+    uint8_t  verts;
+    uint8_t  tme;           /* PRIM.TME when drawn */
+    uint32_t rgba;          /* RGBA8: bits 0-7 R ... 24-31 A */
+    int32_t  x[3];
+    int32_t  y[3];
+    int32_t  u[3];          /* 0 unless tme */
+    int32_t  v[3];
+} GifPrim;
+
+typedef void (*GifPrimFn)(void *user, const GifPrim *prim);
+
+typedef struct {
+    /* GS state (persists across gif_decode calls) */
+    uint32_t  prim;         /* PRIM register */
+    uint32_t  rgba;         /* RGBAQ register, color bits */
+    uint32_t  uv;           /* UV register */
+    uint64_t  alpha1;       /* Last ALPHA_1 write */
+    uint64_t  frame1;       /* Last FRAME_1 write */
+    uint64_t  scissor1;     /* Last SCISSOR_1 write */
+    uint64_t  tex0;         /* Last TEX0_1 write */
+    uint64_t  tex1;         /* Last TEX1_1 write */
+    uint64_t  clamp1;       /* Last CLAMP_1 write */
+    uint32_t  texflushes;   /* TEXFLUSH writes */
+    int       queued;       /* Vertices in the queue */
+    int32_t   qx[3], qy[3];
+    int32_t   qu[3], qv[3];
+    uint32_t  qc[3];
+
+    int       offset_x;
+    int       offset_y;
+    GifPrimFn fn;
+    void     *user;
+
+    uint32_t  tags;
+    uint32_t  prims;
+} GifDecoder;
+
+void gif_decoder_init(GifDecoder *dec, int offset_x, int offset_y,
+                      GifPrimFn fn, void *user);
+
+/* Replay qwc qwords. Returns 0, or -1 on a malformed or unsupported
+ * packet (IMAGE tags, registers other than PRIM/RGBAQ/UV/XYZ2 and the
+ * A+D registers above, data running past qwc). */
+int gif_decode(GifDecoder *dec, const uint64_t *qwords, uint32_t qwc);
+
+#endif /* GIF_PACKET_H */
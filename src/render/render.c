@@ -1,69 +1,152 @@
 #include "render.h"
-#include <gsKit.h>
-#include <dmaKit.h>
-#include <gsToolkit.h>
-#include <math.h>
-#include <kernel.h>
-
-/* PI constant for circle calculations */
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-#define RENDER_PI ((float)M_PI)
+#include "render_backend.h"
+#include "circle_lut.h"
+#include <stddef.h>
 
 /* ============================================================
  * Static State
  * ============================================================
- * gsKit context allocated once at init time.
- * NOTE: gsKit_init_global() uses malloc internally. This is
- * acceptable as it happens only at init time, not per-frame.
+ * The backend (render_backend.h) owns the target surface; this
+ * file records into the frame display list and hands sorted
+ * batches to it.
  * ============================================================ */
-static GSGLOBAL *s_gs = NULL;
+#ifdef _EE
+#define RENDER_DEFAULT_BACKEND render_backend_gs
+#else
+#define RENDER_DEFAULT_BACKEND render_backend_soft
+#endif
+
+static const RenderBackend *s_backend = NULL;
 static int s_initialized = 0;
 
+/* Target size, fixed between render_init and render_shutdown */
+static int s_width = RENDER_SCREEN_WIDTH;
+static int s_height = RENDER_SCREEN_HEIGHT;
+
+/* Internal resolution: primitives are recorded at draw size
+ * (target / s_scale, rounded up) and the backend upscales. Requests
+ * are pending until the next frame boundary. */
+static int s_scale = 1;
+static RenderFilter s_filter = RENDER_FILTER_NEAREST;
+static int s_pending_scale = 1;
+static RenderFilter s_pending_filter = RENDER_FILTER_NEAREST;
+static int s_draw_width = RENDER_SCREEN_WIDTH;
+static int s_draw_height = RENDER_SCREEN_HEIGHT;
+
+/* Frame display list: primitives are recorded, then sorted and
+ * submitted in render_end_frame (or early when full). */
+static DisplayList s_dl;
+
+/* ============================================================
+ * Backend Selection
+ * ============================================================ */
+int render_set_backend(const RenderBackend *backend)
+{
+    if (s_initialized || !backend) {
+        return -1;
+    }
+    s_backend = backend;
+    return 0;
+}
+
+int render_set_resolution(int width, int height)
+{
+    if (s_initialized || width < 1 || height < 1 ||
+        width > RENDER_MAX_DIMENSION || height > RENDER_MAX_DIMENSION) {
+        return -1;
+    }
+    s_width = width;
+    s_height = height;
+    return 0;
+}
+
+const RenderBackend *render_get_backend(void)
+{
+    if (!s_backend) {
+        s_backend = RENDER_DEFAULT_BACKEND();
+    }
+    return s_backend;
+}
+
+/* ============================================================
+ * Internal Resolution
+ * ============================================================ */
+int render_set_scale(int divisor, RenderFilter filter)
+{
+    if (divisor < 1 || divisor > RENDER_SCALE_MAX || filter >= RENDER_FILTER_COUNT) {
+        return -1;
+    }
+    if (divisor > 1 && !render_get_backend()->set_scale) {
+        return -1;
+    }
+    s_pending_scale = divisor;
+    s_pending_filter = filter;
+    return 0;
+}
+
+int render_get_scale(void)
+{
+    return s_scale;
+}
+
+RenderFilter render_get_scale_filter(void)
+{
+    return s_filter;
+}
+
+/* Switch to the pending scale; keeps the current one if the
+ * backend refuses */
+static void apply_scale(void)
+{
+    if (s_pending_scale == s_scale && s_pending_filter == s_filter) {
+        return;
+    }
+    if (!s_backend->set_scale ||
+        s_backend->set_scale(s_pending_scale, s_pending_filter) != 0) {
+        s_pending_scale = s_scale;
+        s_pending_filter = s_filter;
+        return;
+    }
+    s_scale = s_pending_scale;
+    s_filter = s_pending_filter;
+    s_draw_width = (s_width + s_scale - 1) / s_scale;
+    s_draw_height = (s_height + s_scale - 1) / s_scale;
+}
+
+/* Target pixel -> draw pixel (floor) */
+static int to_draw(int v)
+{
+    if (s_scale == 1) {
+        return v;
+    }
+    return v >= 0 ? v / s_scale : -((-v + s_scale - 1) / s_scale);
+}
+
 /* ============================================================
  * Initialize Rendering
  * ============================================================ */
 int render_init(void)
 {
+    const RenderBackend *backend;
+
     if (s_initialized) {
         return 0;
     }
 
-    /* Initialize DMA - required before gsKit */
-    dmaKit_init(D_CTRL_RELE_OFF, D_CTRL_MFD_OFF, D_CTRL_STS_UNSPEC,
-                D_CTRL_STD_OFF, D_CTRL_RCYC_8, 1 << DMA_CHANNEL_GIF);
-    dmaKit_chan_init(DMA_CHANNEL_GIF);
-
-    /* Allocate gsKit global context */
-    s_gs = gsKit_init_global();
-    if (!s_gs) {
+    backend = render_get_backend();
+    if (backend->init(s_width, s_height) != 0) {
         return -1;
     }
 
-    /* Configure display mode: 640x480 interlaced NTSC */
-    s_gs->Mode = GS_MODE_NTSC;
-    s_gs->Interlace = GS_INTERLACED;
-    s_gs->Field = GS_FIELD;
-    s_gs->Width = RENDER_SCREEN_WIDTH;
-    s_gs->Height = RENDER_SCREEN_HEIGHT;
-    s_gs->PSM = GS_PSM_CT32;     /* 32-bit for proper alpha support */
-    s_gs->PSMZ = GS_PSMZ_16S;
-    s_gs->DoubleBuffering = GS_SETTING_ON;
-    s_gs->ZBuffering = GS_SETTING_OFF;
-    s_gs->PrimAlphaEnable = GS_SETTING_OFF;  /* Disable alpha blending for now */
-
-    /* Initialize screen - this sets up the GS hardware */
-    gsKit_init_screen(s_gs);
-
-    /* Use ONESHOT mode for manual queue control */
-    gsKit_mode_switch(s_gs, GS_ONESHOT);
-
-    /* Do an initial frame to ensure display is active */
-    gsKit_queue_reset(s_gs->Os_Queue);
-    gsKit_clear(s_gs, GS_SETREG_RGBAQ(0x40, 0x00, 0x00, 0x80, 0x00)); /* Red to confirm rendering */
-    gsKit_queue_exec(s_gs);
-    gsKit_sync_flip(s_gs);
+    dl_init(&s_dl, &backend->draw);
+    circle_lut_init();
+
+    /* Backends start at full size */
+    s_scale = 1;
+    s_filter = RENDER_FILTER_NEAREST;
+    s_draw_width = s_width;
+    s_draw_height = s_height;
+    apply_scale();
 
     s_initialized = 1;
     return 0;
@@ -78,10 +161,7 @@ void render_shutdown(void)
         return;
     }
 
-    if (s_gs) {
-        gsKit_deinit_global(s_gs);
-        s_gs = NULL;
-    }
+    s_backend->shutdown();
 
     s_initialized = 0;
 }
@@ -91,11 +171,17 @@ void render_shutdown(void)
  * ============================================================ */
 void render_begin_frame(void)
 {
-    if (!s_initialized || !s_gs) {
+    if (!s_initialized) {
         return;
     }
 
-    gsKit_queue_reset(s_gs->Os_Queue);
+    apply_scale();
+    s_backend->begin_frame();
+
+    dl_reset(&s_dl);
+    dl_stats_reset(&s_dl);
+    dl_set_layer(&s_dl, DL_LAYER_SCENE);
+    dl_set_blend(&s_dl, DL_BLEND_OPAQUE);
 }
 
 /* ============================================================
@@ -103,12 +189,31 @@ void render_begin_frame(void)
  * ============================================================ */
 void render_end_frame(void)
 {
-    if (!s_initialized || !s_gs) {
+    if (!s_initialized) {
         return;
     }
 
-    gsKit_queue_exec(s_gs);
-    gsKit_sync_flip(s_gs);
+    dl_flush(&s_dl);
+
+    s_backend->end_frame();
+}
+
+/* ============================================================
+ * Display List State
+ * ============================================================ */
+void render_set_layer(uint8_t layer)
+{
+    dl_set_layer(&s_dl, layer);
+}
+
+void render_set_blend(DlBlend blend)
+{
+    dl_set_blend(&s_dl, blend);
+}
+
+const DisplayList *render_get_display_list(void)
+{
+    return &s_dl;
 }
 
 /* ============================================================
@@ -116,18 +221,12 @@ void render_end_frame(void)
  * ============================================================ */
 void render_clear(uint64_t color)
 {
-    uint8_t r, g, b;
-
-    if (!s_initialized || !s_gs) {
+    if (!s_initialized) {
         return;
     }
 
-    r = (uint8_t)(color & 0xFF);
-    g = (uint8_t)((color >> 8) & 0xFF);
-    b = (uint8_t)((color >> 16) & 0xFF);
-
-    /* Use 0x80 alpha for opaque clear */
-    gsKit_clear(s_gs, GS_SETREG_RGBAQ(r, g, b, 0x80, 0x00));
+    /* Backends clear opaque (alpha 0x80) */
+    s_backend->clear((uint32_t)color);
 }
 
 /* ============================================================
@@ -135,38 +234,38 @@ void render_clear(uint64_t color)
  * ============================================================ */
 int render_norm_to_screen_x(float nx)
 {
-    int sx = (int)(nx * (float)RENDER_SCREEN_WIDTH);
+    int sx = (int)(nx * (float)s_width);
     if (sx < 0) sx = 0;
-    if (sx >= RENDER_SCREEN_WIDTH) sx = RENDER_SCREEN_WIDTH - 1;
+    if (sx >= s_width) sx = s_width - 1;
     return sx;
 }
 
 int render_norm_to_screen_y(float ny)
 {
-    int sy = (int)(ny * (float)RENDER_SCREEN_HEIGHT);
+    int sy = (int)(ny * (float)s_height);
     if (sy < 0) sy = 0;
-    if (sy >= RENDER_SCREEN_HEIGHT) sy = RENDER_SCREEN_HEIGHT - 1;
+    if (sy >= s_height) sy = s_height - 1;
     return sy;
 }
 
 float render_screen_to_norm_x(int sx)
 {
-    return (float)sx / (float)RENDER_SCREEN_WIDTH;
+    return (float)sx / (float)s_width;
 }
 
 float render_screen_to_norm_y(int sy)
 {
-    return (float)sy / (float)RENDER_SCREEN_HEIGHT;
+    return (float)sy / (float)s_height;
 }
 
 int render_get_width(void)
 {
-    return RENDER_SCREEN_WIDTH;
+    return s_width;
 }
 
 int render_get_height(void)
 {
-    return RENDER_SCREEN_HEIGHT;
+    return s_height;
 }
 
 /* ============================================================
@@ -174,10 +273,9 @@ int render_get_height(void)
  * ============================================================ */
 void render_rect_screen(int x, int y, int w, int h, uint64_t color)
 {
-    uint8_t r, g, b;
     int x2, y2;
 
-    if (!s_initialized || !s_gs) {
+    if (!s_initialized) {
         return;
     }
 
@@ -186,18 +284,19 @@ void render_rect_screen(int x, int y, int w, int h, uint64_t color)
     if (y < 0) { h += y; y = 0; }
     x2 = x + w;
     y2 = y + h;
-    if (x2 > RENDER_SCREEN_WIDTH) x2 = RENDER_SCREEN_WIDTH;
-    if (y2 > RENDER_SCREEN_HEIGHT) y2 = RENDER_SCREEN_HEIGHT;
+    if (x2 > s_width) x2 = s_width;
+    if (y2 > s_height) y2 = s_height;
     if (x >= x2 || y >= y2) return;
 
-    r = (uint8_t)(color & 0xFF);
-    g = (uint8_t)((color >> 8) & 0xFF);
-    b = (uint8_t)((color >> 16) & 0xFF);
-    /* Alpha disabled - just use 0x80 for all primitives */
+    /* Thin rects keep at least one draw pixel */
+    x = to_draw(x);
+    y = to_draw(y);
+    x2 = to_draw(x2);
+    y2 = to_draw(y2);
+    if (x2 <= x) x2 = x + 1;
+    if (y2 <= y) y2 = y + 1;
 
-    gsKit_prim_sprite(s_gs, (float)x, (float)y,
-                      (float)x2, (float)y2,
-                      0, GS_SETREG_RGBAQ(r, g, b, 0x80, 0x00));
+    dl_push_rect(&s_dl, x, y, x2, y2, (uint32_t)color);
 }
 
 /* ============================================================
@@ -209,8 +308,8 @@ void render_rect(float x, float y, float w, float h, uint64_t color)
 
     sx = render_norm_to_screen_x(x);
     sy = render_norm_to_screen_y(y);
-    sw = (int)(w * (float)RENDER_SCREEN_WIDTH);
-    sh = (int)(h * (float)RENDER_SCREEN_HEIGHT);
+    sw = (int)(w * (float)s_width);
+    sh = (int)(h * (float)s_height);
 
     if (sw < 1) sw = 1;
     if (sh < 1) sh = 1;
@@ -223,29 +322,35 @@ void render_rect(float x, float y, float w, float h, uint64_t color)
  * ============================================================ */
 void render_line_screen(int x1, int y1, int x2, int y2, uint64_t color)
 {
-    uint8_t r, g, b;
-
-    if (!s_initialized || !s_gs) {
+    if (!s_initialized) {
         return;
     }
 
     /* Clamp endpoints to screen bounds */
     if (x1 < 0) x1 = 0;
-    if (x1 >= RENDER_SCREEN_WIDTH) x1 = RENDER_SCREEN_WIDTH - 1;
+    if (x1 >= s_width) x1 = s_width - 1;
     if (y1 < 0) y1 = 0;
-    if (y1 >= RENDER_SCREEN_HEIGHT) y1 = RENDER_SCREEN_HEIGHT - 1;
+    if (y1 >= s_height) y1 = s_height - 1;
     if (x2 < 0) x2 = 0;
-    if (x2 >= RENDER_SCREEN_WIDTH) x2 = RENDER_SCREEN_WIDTH - 1;
+    if (x2 >= s_width) x2 = s_width - 1;
     if (y2 < 0) y2 = 0;
-    if (y2 >= RENDER_SCREEN_HEIGHT) y2 = RENDER_SCREEN_HEIGHT - 1;
+    if (y2 >= s_height) y2 = s_height - 1;
 
-    r = (uint8_t)(color & 0xFF);
-    g = (uint8_t)((color >> 8) & 0xFF);
-    b = (uint8_t)((color >> 16) & 0xFF);
-    /* Alpha disabled - just use 0x80 for all primitives */
+    dl_push_line(&s_dl, to_draw(x1), to_draw(y1), to_draw(x2), to_draw(y2),
+                 (uint32_t)color);
+}
 
-    gsKit_prim_line(s_gs, (float)x1, (float)y1, (float)x2, (float)y2,
-                    0, GS_SETREG_RGBAQ(r, g, b, 0x80, 0x00));
+/* ============================================================
+ * Draw Filled Triangle (screen coords)
+ * ============================================================ */
+void render_triangle_screen(int x1, int y1, int x2, int y2, int x3, int y3, uint64_t color)
+{
+    if (!s_initialized) {
+        return;
+    }
+
+    dl_push_triangle(&s_dl, to_draw(x1), to_draw(y1), to_draw(x2), to_draw(y2),
+                     to_draw(x3), to_draw(y3), (uint32_t)color);
 }
 
 /* ============================================================
@@ -304,32 +409,33 @@ void render_rect_outline_screen(int x, int y, int w, int h, uint64_t color)
  * ============================================================ */
 void render_circle(float cx, float cy, float r, uint64_t color, int segments)
 {
-    float angle_step;
-    float angle;
+    const float *cs;
+    const float *sn;
     float x1, y1, x2, y2;
     float rx, ry;
     int i;
 
-    if (!s_initialized || !s_gs) {
+    if (!s_initialized) {
         return;
     }
 
-    if (segments < 3) segments = 3;
-    if (segments > 64) segments = 64;
-
-    angle_step = (2.0f * RENDER_PI) / (float)segments;
+    if (segments <= RENDER_CIRCLE_SEGMENTS_AUTO) {
+        segments = circle_auto_segments(r * (float)s_draw_width);
+    }
+    segments = circle_lut_clamp(segments);
+    cs = circle_lut_cos(segments);
+    sn = circle_lut_sin(segments);
 
     /* Adjust radius for aspect ratio */
     rx = r;
-    ry = r * ((float)RENDER_SCREEN_WIDTH / (float)RENDER_SCREEN_HEIGHT);
+    ry = r * ((float)s_width / (float)s_height);
 
     x1 = cx + rx;
     y1 = cy;
 
     for (i = 1; i <= segments; i++) {
-        angle = (float)i * angle_step;
-        x2 = cx + rx * cosf(angle);
-        y2 = cy + ry * sinf(angle);
+        x2 = cx + rx * cs[i];
+        y2 = cy + ry * sn[i];
         render_line(x1, y1, x2, y2, color);
         x1 = x2;
         y1 = y2;
@@ -341,57 +447,32 @@ void render_circle(float cx, float cy, float r, uint64_t color, int segments)
  * ============================================================ */
 void render_circle_filled(float cx, float cy, float r, uint64_t color, int segments)
 {
-    int i;
-    uint8_t cr, cg, cb, ca;
     int scx, scy;
     int screen_rx, screen_ry;
-    float angle_step, angle;
-    int prev_x, prev_y, cur_x, cur_y;
 
-    if (!s_initialized || !s_gs) {
+    if (!s_initialized) {
         return;
     }
 
-    if (segments < 3) segments = 3;
-    if (segments > 64) segments = 64;
-
-    cr = (uint8_t)(color & 0xFF);
-    cg = (uint8_t)((color >> 8) & 0xFF);
-    cb = (uint8_t)((color >> 16) & 0xFF);
-    ca = (uint8_t)((color >> 24) & 0xFF);
-
-    /* Convert center to screen coords */
-    scx = render_norm_to_screen_x(cx);
-    scy = render_norm_to_screen_y(cy);
-    
-    /* Convert radius to screen pixels (use X for circular appearance) */
-    screen_rx = (int)(r * (float)RENDER_SCREEN_WIDTH);
-    screen_ry = (int)(r * (float)RENDER_SCREEN_HEIGHT);
-    
+    /* Convert center to draw coords */
+    scx = to_draw(render_norm_to_screen_x(cx));
+    scy = to_draw(render_norm_to_screen_y(cy));
+
+    /* Convert radius to draw pixels (use X for circular appearance) */
+    screen_rx = (int)(r * (float)s_draw_width);
+    screen_ry = (int)(r * (float)s_draw_height);
+
     /* Ensure minimum size */
     if (screen_rx < 2) screen_rx = 2;
     if (screen_ry < 2) screen_ry = 2;
 
-    angle_step = (2.0f * RENDER_PI) / (float)segments;
-
-    /* First point on circle */
-    prev_x = scx + screen_rx;
-    prev_y = scy;
-
-    for (i = 1; i <= segments; i++) {
-        angle = (float)i * angle_step;
-        cur_x = scx + (int)(screen_rx * cosf(angle));
-        cur_y = scy + (int)(screen_ry * sinf(angle));
-
-        gsKit_prim_triangle(s_gs,
-                            (float)scx, (float)scy,
-                            (float)prev_x, (float)prev_y,
-                            (float)cur_x, (float)cur_y,
-                            0, GS_SETREG_RGBAQ(cr, cg, cb, ca, 0x00));
-
-        prev_x = cur_x;
-        prev_y = cur_y;
+    if (segments <= RENDER_CIRCLE_SEGMENTS_AUTO) {
+        segments = circle_auto_segments((float)(screen_rx > screen_ry ? screen_rx : screen_ry));
     }
+    segments = circle_lut_clamp(segments);
+
+    /* Expanded to a triangle fan by the backend */
+    dl_push_circle(&s_dl, scx, scy, screen_rx, screen_ry, segments, (uint32_t)color);
 }
 
 /* ============================================================
@@ -401,11 +482,3 @@ int render_is_initialized(void)
 {
     return s_initialized;
 }
-
-/* ============================================================
- * Get gsKit Context (for font/texture modules)
- * ============================================================ */
-GSGLOBAL *render_get_gs_context(void)
-{
-    return s_gs;
-}
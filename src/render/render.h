@@ -2,19 +2,28 @@
 #define RENDER_H
 
 #include <stdint.h>
+#include "display_list.h"
 
 /* ============================================================
  * Render Module
  * ============================================================
- * gsKit-based rendering with normalized coordinate system.
+ * Backend-selectable rendering (render_backend.h: gsKit on the
+ * PS2, a CPU rasterizer on hosts) with normalized coordinate system.
  * Coordinates: (0,0) = top-left, (1,1) = bottom-right
  * Colors: RGBA with 0-255 per component
+ * Drawing calls are recorded into a display list and submitted,
+ * sorted by layer and batched by state, in render_end_frame().
  * ============================================================ */
 
-/* Screen dimensions (NTSC 640x480) */
+/* Screen dimensions (NTSC 640x480): the PS2 output and the default
+ * target size. Use render_get_width()/render_get_height() for the
+ * active target. */
 #define RENDER_SCREEN_WIDTH   640
 #define RENDER_SCREEN_HEIGHT  480
 
+/* Largest target side (display list coordinates are int16) */
+#define RENDER_MAX_DIMENSION  8192
+
 /* Color helper macros
  * Format: bits 0-7 = R, 8-15 = G, 16-23 = B, 24-31 = A */
 #define RENDER_COLOR(r, g, b, a) \
@@ -46,6 +55,12 @@
  * Returns 0 on success, -1 on failure. */
 int render_init(void);
 
+/* Set the target size used by the next render_init() (default
+ * RENDER_SCREEN_WIDTH x RENDER_SCREEN_HEIGHT; the gsKit backend only
+ * supports the default). Returns 0 on success, -1 while initialized
+ * or if out of range. */
+int render_set_resolution(int width, int height);
+
 /* Shutdown rendering subsystem. */
 void render_shutdown(void);
 
@@ -58,6 +73,46 @@ void render_end_frame(void);
 /* Clear screen with specified color. */
 void render_clear(uint64_t color);
 
+/* Set layer (DL_LAYER_*) for subsequent drawing calls.
+ * Reset to DL_LAYER_SCENE by render_begin_frame(). */
+void render_set_layer(uint8_t layer);
+
+/* Set blend state for subsequent drawing calls.
+ * Reset to DL_BLEND_OPAQUE by render_begin_frame(). */
+void render_set_blend(DlBlend blend);
+
+/* Get the frame display list (for stats). */
+const DisplayList *render_get_display_list(void);
+
+/* ============================================================
+ * Internal Resolution
+ * ============================================================
+ * Frames can be drawn at 1/2 .. 1/RENDER_SCALE_MAX of the target
+ * size and upscaled in render_end_frame(). Drawing calls keep using
+ * target coordinates; they are scaled when recorded, so fine detail
+ * (text, 1-pixel lines) coarsens with the divisor.
+ * Only backends with a set_scale hook support divisors > 1: the
+ * software backend upscales on the CPU, gsKit draws into an
+ * offscreen VRAM buffer and stretches it with textured sprites.
+ * ============================================================ */
+#define RENDER_SCALE_MAX  4
+
+typedef enum {
+    RENDER_FILTER_NEAREST = 0,  /* Blocky, cheapest */
+    RENDER_FILTER_BILINEAR,     /* Smooth */
+    RENDER_FILTER_COUNT
+} RenderFilter;
+
+/* Draw at ceil(target / divisor) (1 = full size, the default) and
+ * upscale with filter. May be called at any time; takes effect at
+ * the next render_begin_frame() (or render_init()). Returns 0 on
+ * success, -1 if out of range or the backend cannot scale. */
+int render_set_scale(int divisor, RenderFilter filter);
+
+/* Active divisor and filter */
+int render_get_scale(void);
+RenderFilter render_get_scale_filter(void);
+
 /* ============================================================
  * Drawing Primitives (normalized coordinates 0.0-1.0)
  * ============================================================ */
@@ -80,6 +135,9 @@ void render_line(float x1, float y1, float x2, float y2, uint64_t color);
 /* Draw line with screen coordinates. */
 void render_line_screen(int x1, int y1, int x2, int y2, uint64_t color);
 
+/* Draw filled triangle with screen coordinates. */
+void render_triangle_screen(int x1, int y1, int x2, int y2, int x3, int y3, uint64_t color);
+
 /* Draw rectangle outline.
  * x, y: top-left corner (normalized)
  * w, h: width and height (normalized)
@@ -89,14 +147,19 @@ void render_rect_outline(float x, float y, float w, float h, uint64_t color);
 /* Draw rectangle outline with screen coordinates. */
 void render_rect_outline_screen(int x, int y, int w, int h, uint64_t color);
 
+/* Pass as segments to pick the count from the on-screen radius
+ * (6 for tiny circles up to 64 for large ones). */
+#define RENDER_CIRCLE_SEGMENTS_AUTO 0
+
 /* Draw circle (approximated with line segments).
  * cx, cy: center (normalized)
  * r: radius (normalized, relative to screen width)
  * color: RGBA color
- * segments: number of line segments (8-32 typical) */
+ * segments: number of line segments (3-64, 8-32 typical),
+ *           or RENDER_CIRCLE_SEGMENTS_AUTO */
 void render_circle(float cx, float cy, float r, uint64_t color, int segments);
 
-/* Draw filled circle. */
+/* Draw filled circle (segments as for render_circle). */
 void render_circle_filled(float cx, float cy, float r, uint64_t color, int segments);
 
 /* ============================================================
@@ -115,7 +178,8 @@ float render_screen_to_norm_x(int sx);
 /* Convert screen Y to normalized Y. */
 float render_screen_to_norm_y(int sy);
 
-/* Get screen dimensions. */
+/* Get screen dimensions (the target size; drawing coordinates
+ * are in this space whatever the internal resolution). */
 int render_get_width(void);
 int render_get_height(void);
 
@@ -123,7 +187,7 @@ int render_get_height(void);
 int render_is_initialized(void);
 
 /* Get gsKit context (for font/texture modules).
- * Returns NULL if not initialized. */
+ * gsKit backend only (render_gs.c); returns NULL if not initialized. */
 struct gsGlobal *render_get_gs_context(void);
 
 #endif /* RENDER_H */
@@ -0,0 +1,46 @@
+#ifndef RENDER_BACKEND_H
+#define RENDER_BACKEND_H
+
+#include <stdint.h>
+#include "display_list.h"
+#include "render.h"
+
+/* ============================================================
+ * Render Backends
+ * ============================================================
+ * render.c is the portable front end: coordinate conversion,
+ * clamping and display list recording. A backend owns the target
+ * surface and draws the sorted batches the display list submits.
+ *
+ *   render_gs.c    gsKit / GS hardware (PS2, default under _EE)
+ *   render_soft.c  CPU rasterizer into an RGBA framebuffer
+ *                  (default on hosts)
+ *
+ * Select with render_set_backend() before render_init().
+ * ============================================================ */
+
+typedef struct {
+    const char *name;
+    int  (*init)(int width, int height);  /* 0 on success, -1 on failure */
+    void (*shutdown)(void);
+    void (*begin_frame)(void);
+    void (*clear)(uint32_t color);      /* RENDER_COLOR layout, alpha ignored */
+    void (*end_frame)(void);            /* After the display list is flushed */
+    /* Draw at ceil(size / divisor) and upscale in end_frame; called
+     * between frames. NULL if the backend only draws at full size. */
+    int  (*set_scale)(int divisor, RenderFilter filter);
+    DlBackend draw;                     /* Batch submission */
+} RenderBackend;
+
+/* Built-in backends */
+const RenderBackend *render_backend_gs(void);
+const RenderBackend *render_backend_soft(void);
+
+/* Use a backend for the next render_init(). Ignored (returns -1)
+ * while initialized. */
+int render_set_backend(const RenderBackend *backend);
+
+/* Active (or next) backend */
+const RenderBackend *render_get_backend(void);
+
+#endif /* RENDER_BACKEND_H */
@@ -0,0 +1,115 @@
+#include "render_fragment.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * Pack
+ * ============================================================
+ * 0..1 channels -> RGBA8 (R bits 0-7), alpha 0x80. Rounds to
+ * nearest; a straight loop the compiler vectorizes.
+ * ============================================================ */
+static void pack_colors(uint32_t *restrict dst,
+                        const float *restrict r,
+                        const float *restrict g,
+                        const float *restrict b,
+                        uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        uint32_t cr = (uint32_t)(r[i] * 255.0f + 0.5f);
+        uint32_t cg = (uint32_t)(g[i] * 255.0f + 0.5f);
+        uint32_t cb = (uint32_t)(b[i] * 255.0f + 0.5f);
+        dst[i] = 0x80000000u | (cb << 16) | (cg << 8) | cr;
+    }
+}
+
+/* ============================================================
+ * Row Job
+ * ============================================================ */
+static void shade_row(void *user, int y, int thread)
+{
+    FragmentRenderer *fr = (FragmentRenderer *)user;
+    FragmentBank *bank = &fr->banks[thread];
+    uint32_t *row = fr->target.pixels + (long)y * fr->target.stride;
+    RuntimeContext ctx = fr->ctx;
+    int x;
+
+    ctx.frag_y = (uint16_t)y;
+
+    for (x = 0; x < fr->target.width; x += EVAL_BLOCK_SIZE) {
+        uint32_t n = (uint32_t)(fr->target.width - x);
+
+        if (n > EVAL_BLOCK_SIZE) {
+            n = EVAL_BLOCK_SIZE;
+        }
+        ctx.frag_x = (uint16_t)x;
+        graph_eval_fragment(fr->graph, fr->frag, fr->uniforms, bank, &ctx, n);
+        pack_colors(row + x,
+                    graph_eval_fragment_color(bank, fr->frag, 0),
+                    graph_eval_fragment_color(bank, fr->frag, 1),
+                    graph_eval_fragment_color(bank, fr->frag, 2), n);
+    }
+}
+
+/* ============================================================
+ * Init / Shutdown
+ * ============================================================ */
+int render_fragment_init(FragmentRenderer *fr, int threads)
+{
+    if (!fr) {
+        return -1;
+    }
+    memset(fr, 0, sizeof(*fr));
+
+    if (soft_pool_init(&fr->pool, threads) != 0) {
+        return -1;
+    }
+    fr->banks = (FragmentBank *)calloc((size_t)fr->pool.threads, sizeof(FragmentBank));
+    fr->uniforms = (FragmentUniforms *)calloc(1, sizeof(FragmentUniforms));
+    if (!fr->banks || !fr->uniforms) {
+        render_fragment_shutdown(fr);
+        return -1;
+    }
+    return 0;
+}
+
+void render_fragment_shutdown(FragmentRenderer *fr)
+{
+    if (!fr) {
+        return;
+    }
+    soft_pool_shutdown(&fr->pool);
+    free(fr->banks);
+    free(fr->uniforms);
+    fr->banks = NULL;
+    fr->uniforms = NULL;
+}
+
+/* ============================================================
+ * Render
+ * ============================================================ */
+void render_fragment(FragmentRenderer *fr,
+                     const Graph *graph,
+                     const FragmentPlan *frag,
+                     const OutputBank *bank,
+                     const RuntimeContext *ctx,
+                     const SoftTarget *target)
+{
+    if (!fr || !fr->banks || !graph || !frag || !bank || !ctx || !target ||
+        !target->pixels || target->width <= 0 || target->height <= 0 ||
+        target->width > 0xFFFF || target->height > 0xFFFF) {
+        return;
+    }
+
+    graph_fragment_load_uniforms(frag, bank, fr->uniforms);
+
+    fr->graph = graph;
+    fr->frag = frag;
+    fr->ctx = *ctx;
+    fr->ctx.frag_width = (uint16_t)target->width;
+    fr->ctx.frag_height = (uint16_t)target->height;
+    fr->target = *target;
+
+    soft_pool_run(&fr->pool, target->height, shade_row, fr);
+}
@@ -0,0 +1,56 @@
+#ifndef RENDER_FRAGMENT_H
+#define RENDER_FRAGMENT_H
+
+#include <stdint.h>
+#include "soft_raster.h"
+#include "soft_pool.h"
+#include "../graph/graph_eval_fragment.h"
+
+/* ============================================================
+ * Fragment Renderer (CPU procedural shading)
+ * ============================================================
+ * Fills a software target with a graph's FRAG_OUT color, one
+ * graph_eval_fragment block per EVAL_BLOCK_SIZE pixels. Scanlines
+ * are spread over a SoftPool; each thread owns a FragmentBank.
+ * Pixels are written opaque (alpha 0x80), so display-list sinks can
+ * be drawn over the image afterwards.
+ *
+ * Output does not depend on the thread count (varying nodes are
+ * stateless and rows are independent).
+ *
+ * Host only (POSIX threads); build with -pthread.
+ *
+ * Memory usage (heap, allocated at init):
+ *   256KB uniforms + 256KB FragmentBank per thread
+ * ============================================================ */
+
+typedef struct {
+    SoftPool          pool;
+    FragmentBank     *banks;        /* One per pool thread */
+    FragmentUniforms *uniforms;
+
+    /* Current frame (read by row jobs) */
+    const Graph        *graph;
+    const FragmentPlan *frag;
+    RuntimeContext      ctx;
+    SoftTarget          target;
+} FragmentRenderer;
+
+/* Allocate banks and start threads - 1 workers (1..SOFT_POOL_MAX_THREADS).
+ * Returns 0 on success, -1 on failure. */
+int render_fragment_init(FragmentRenderer *fr, int threads);
+
+/* Stop workers and free buffers */
+void render_fragment_shutdown(FragmentRenderer *fr);
+
+/* Shade every pixel of target. bank holds this frame's graph_eval
+ * outputs (uniforms); ctx supplies time and pad state. Targets up to
+ * 65535 pixels wide/high. */
+void render_fragment(FragmentRenderer *fr,
+                     const Graph *graph,
+                     const FragmentPlan *frag,
+                     const OutputBank *bank,
+                     const RuntimeContext *ctx,
+                     const SoftTarget *target);
+
+#endif /* RENDER_FRAGMENT_H */
@@ -0,0 +1,250 @@
+#include "render.h"
+#include "render_backend.h"
+#include "gif_packet.h"
+#include <gsKit.h>
+#include <dmaKit.h>
+#include <gsToolkit.h>
+#include <kernel.h>
+
+/* ============================================================
+ * gsKit Backend
+ * ============================================================
+ * gsKit context allocated once at init time.
+ * NOTE: gsKit_init_global() uses malloc internally. This is
+ * acceptable as it happens only at init time, not per-frame.
+ *
+ * gsKit sets up the display and flips; frames are drawn from GIF
+ * packets built in s_gif_arena (gif_packet.h) and sent over the GIF
+ * DMA channel, normally once per frame. Each frame's packet starts
+ * by pointing FRAME_1/SCISSOR_1 at the current draw buffer, and
+ * gsKit's own queue (the flip's register writes) is still reset and
+ * run around the flip.
+ *
+ * At a reduced internal resolution the frame is drawn into an
+ * offscreen buffer (s_scale_vram) and stretched over the draw
+ * buffer as textured sprites (gif_packet_blit) before the flip.
+ *
+ * Memory usage:
+ *   VRAM: 2 * 640 * 480 * 4 (display) + GS_SCALE_BYTES + 8KB
+ *         = ~2.7MB of 4MB
+ * ============================================================ */
+static GSGLOBAL *s_gs = NULL;
+
+/* Reduced frames are at most ceil(640/2) x ceil(480/2) */
+#define GS_SCALE_ALIGN   8192   /* FRAME_1 base is in 8KB pages */
+#define GS_SCALE_BYTES   ((RENDER_SCREEN_WIDTH / 2) * (RENDER_SCREEN_HEIGHT / 2) * 4)
+
+static uint32_t     s_scale_vram = 0;       /* 0: no offscreen buffer */
+static int          s_scale = 1;
+static RenderFilter s_scale_filter = RENDER_FILTER_NEAREST;
+static int          s_draw_w = RENDER_SCREEN_WIDTH;
+static int          s_draw_h = RENDER_SCREEN_HEIGHT;
+
+static GifPacket s_gif;
+static uint64_t  s_gif_arena[GIF_PACKET_ARENAS][GIF_ARENA_QWORDS * 2]
+                 __attribute__((aligned(64)));
+
+static int  gs_init(int width, int height);
+static void gs_shutdown(void);
+static void gs_begin_frame(void);
+static void gs_clear(uint32_t color);
+static void gs_end_frame(void);
+static int  gs_set_scale(int divisor, RenderFilter filter);
+
+static const RenderBackend s_backend = {
+    "gs",
+    gs_init,
+    gs_shutdown,
+    gs_begin_frame,
+    gs_clear,
+    gs_end_frame,
+    gs_set_scale,
+    { gif_packet_draw_batch, &s_gif }
+};
+
+const RenderBackend *render_backend_gs(void)
+{
+    return &s_backend;
+}
+
+/* ============================================================
+ * GIF Kick
+ * ============================================================
+ * Waits for the previous transfer (which read the other arena)
+ * before sending, so the encoder may refill that arena on return.
+ * ============================================================ */
+static void gs_kick(void *user, const uint64_t *qwords, uint32_t qwc)
+{
+    (void)user;
+
+    dmaKit_wait(DMA_CHANNEL_GIF, 0);
+    FlushCache(0);
+    dmaKit_send(DMA_CHANNEL_GIF, (void *)qwords, qwc);
+}
+
+/* ============================================================
+ * Initialize
+ * ============================================================ */
+static int gs_init(int width, int height)
+{
+    uint32_t vram;
+
+    /* The display mode below is fixed */
+    if (width != RENDER_SCREEN_WIDTH || height != RENDER_SCREEN_HEIGHT) {
+        return -1;
+    }
+
+    /* Initialize DMA - required before gsKit */
+    dmaKit_init(D_CTRL_RELE_OFF, D_CTRL_MFD_OFF, D_CTRL_STS_UNSPEC,
+                D_CTRL_STD_OFF, D_CTRL_RCYC_8, 1 << DMA_CHANNEL_GIF);
+    dmaKit_chan_init(DMA_CHANNEL_GIF);
+
+    /* Allocate gsKit global context */
+    s_gs = gsKit_init_global();
+    if (!s_gs) {
+        return -1;
+    }
+
+    /* Configure display mode: 640x480 interlaced NTSC */
+    s_gs->Mode = GS_MODE_NTSC;
+    s_gs->Interlace = GS_INTERLACED;
+    s_gs->Field = GS_FIELD;
+    s_gs->Width = RENDER_SCREEN_WIDTH;
+    s_gs->Height = RENDER_SCREEN_HEIGHT;
+    s_gs->PSM = GS_PSM_CT32;     /* 32-bit for proper alpha support */
+    s_gs->PSMZ = GS_PSMZ_16S;
+    s_gs->DoubleBuffering = GS_SETTING_ON;
+    s_gs->ZBuffering = GS_SETTING_OFF;
+    s_gs->PrimAlphaEnable = GS_SETTING_OFF;  /* Disable alpha blending for now */
+
+    /* Initialize screen - this sets up the GS hardware */
+    gsKit_init_screen(s_gs);
+
+    /* Offscreen buffer for reduced internal resolution, 8KB aligned.
+     * Without it the backend only draws at full size. */
+    vram = gsKit_vram_alloc(s_gs, GS_SCALE_BYTES + GS_SCALE_ALIGN, GSKIT_ALLOC_USERBUFFER);
+    s_scale_vram = (vram == GSKIT_ALLOC_ERROR) ? 0 :
+                   (vram + GS_SCALE_ALIGN - 1) & ~(uint32_t)(GS_SCALE_ALIGN - 1);
+    s_scale = 1;
+    s_scale_filter = RENDER_FILTER_NEAREST;
+    s_draw_w = RENDER_SCREEN_WIDTH;
+    s_draw_h = RENDER_SCREEN_HEIGHT;
+
+    /* Use ONESHOT mode for manual queue control */
+    gsKit_mode_switch(s_gs, GS_ONESHOT);
+
+    /* Do an initial frame to ensure display is active */
+    gsKit_queue_reset(s_gs->Os_Queue);
+    gsKit_clear(s_gs, GS_SETREG_RGBAQ(0x40, 0x00, 0x00, 0x80, 0x00)); /* Red to confirm rendering */
+    gsKit_queue_exec(s_gs);
+    gsKit_sync_flip(s_gs);
+
+    if (gif_packet_init(&s_gif, s_gif_arena[0], s_gif_arena[1], GIF_ARENA_QWORDS,
+                        s_gs->OffsetX, s_gs->OffsetY, gs_kick, NULL) != 0) {
+        gs_shutdown();
+        return -1;
+    }
+
+    return 0;
+}
+
+/* ============================================================
+ * Shutdown
+ * ============================================================ */
+static void gs_shutdown(void)
+{
+    if (s_gs) {
+        gsKit_deinit_global(s_gs);
+        s_gs = NULL;
+    }
+}
+
+/* ============================================================
+ * Frame
+ * ============================================================
+ * Alpha batches use source-over blending: ALPHA_1 is written once
+ * per frame and each batch's PRIM enables ABE as needed.
+ * ============================================================ */
+
+/* gsKit_sync_flip() toggles ActiveBuffer; the buffer it selects is
+ * the one drawn next. Written here too so the frame never depends
+ * on a queued gsKit_setactive() having run. */
+static void gs_set_draw_buffer(void)
+{
+    gif_packet_set_reg(&s_gif, GIF_REG_FRAME_1,
+                       GS_SETREG_FRAME_1(s_gs->ScreenBuffer[s_gs->ActiveBuffer & 1] / 8192,
+                                         s_gs->Width / 64, s_gs->PSM, 0));
+    gif_packet_set_reg(&s_gif, GIF_REG_SCISSOR_1,
+                       GS_SETREG_SCISSOR_1(0, s_gs->Width - 1, 0, s_gs->Height - 1));
+}
+
+/* Offscreen buffer width in 64-pixel units (FRAME FBW, TEX0 TBW) */
+static uint32_t gs_scale_bw(void)
+{
+    return (uint32_t)(s_draw_w + 63) / 64;
+}
+
+static void gs_begin_frame(void)
+{
+    gsKit_queue_reset(s_gs->Os_Queue);
+    gif_packet_stats_reset(&s_gif);
+    if (s_scale > 1) {
+        gif_packet_set_reg(&s_gif, GIF_REG_FRAME_1,
+                           GS_SETREG_FRAME_1(s_scale_vram / 8192, gs_scale_bw(), s_gs->PSM, 0));
+        gif_packet_set_reg(&s_gif, GIF_REG_SCISSOR_1,
+                           GS_SETREG_SCISSOR_1(0, s_draw_w - 1, 0, s_draw_h - 1));
+    } else {
+        gs_set_draw_buffer();
+    }
+    gif_packet_set_reg(&s_gif, GIF_REG_ALPHA_1, GS_SETREG_ALPHA(0, 1, 0, 1, 0));
+}
+
+static void gs_end_frame(void)
+{
+    /* Stretch the reduced frame over the draw buffer */
+    if (s_scale > 1) {
+        GifBlitSource src;
+
+        src.tbp = s_scale_vram / 256;
+        src.tbw = gs_scale_bw();
+        src.psm = GIF_PSM_CT32;
+        src.width = s_draw_w;
+        src.height = s_draw_h;
+        gs_set_draw_buffer();
+        gif_packet_blit(&s_gif, &src, s_gs->Width, s_gs->Height,
+                        s_scale_filter == RENDER_FILTER_BILINEAR);
+    }
+
+    gif_packet_kick(&s_gif);
+    dmaKit_wait(DMA_CHANNEL_GIF, 0);
+    gsKit_queue_exec(s_gs);
+    gsKit_sync_flip(s_gs);
+}
+
+static void gs_clear(uint32_t color)
+{
+    gif_packet_clear(&s_gif, s_draw_w, s_draw_h, color);
+}
+
+/* ============================================================
+ * Internal Resolution
+ * ============================================================ */
+static int gs_set_scale(int divisor, RenderFilter filter)
+{
+    if (!s_gs || divisor < 1 || (divisor > 1 && !s_scale_vram)) {
+        return -1;
+    }
+    s_scale = divisor;
+    s_scale_filter = filter;
+    s_draw_w = (RENDER_SCREEN_WIDTH + divisor - 1) / divisor;
+    s_draw_h = (RENDER_SCREEN_HEIGHT + divisor - 1) / divisor;
+    return 0;
+}
+
+/* ============================================================
+ * Get gsKit Context (for font/texture modules)
+ * ============================================================ */
+GSGLOBAL *render_get_gs_context(void)
+{
+    return s_gs;
+}
@@ -0,0 +1,122 @@
+#include "render_sinks.h"
+#include "render.h"
+#include "../nodes/node_particles.h"
+
+/* ============================================================
+ * Sink Render Pass
+ * ============================================================
+ * Reads only the plan's sink list and the bank; no per-frame node
+ * scan and no walking of input connections.
+ * ============================================================ */
+
+/* ============================================================
+ * Draw Shape Sink (RECT / CIRCLE / LINE)
+ * ============================================================ */
+static void draw_shape(const PlanSink *sink, const OutputBank *bank)
+{
+    const float *out = bank->out[sink->node];
+    uint64_t color = bank->sink_color[sink->node];
+
+    switch (sink->kind) {
+        case SINK_KIND_RECT:
+            /* Skip if dimensions are too small (node not properly set up) */
+            if (out[2] < 0.001f || out[3] < 0.001f) {
+                return;
+            }
+            render_rect(out[0], out[1], out[2], out[3], color);
+            break;
+
+        case SINK_KIND_CIRCLE:
+            if (out[2] < 0.001f) {
+                return;
+            }
+            render_circle_filled(out[0], out[1], out[2], color,
+                                 RENDER_CIRCLE_SEGMENTS_AUTO);
+            break;
+
+        case SINK_KIND_LINE:
+            render_line(out[0], out[1], out[2], out[3], color);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* ============================================================
+ * Draw Particle Pool
+ * ============================================================
+ * Particles are small rects faded by remaining life; size is a
+ * normalized width with height corrected for the 4:3 screen.
+ * ============================================================ */
+static void draw_particles(const Node *node)
+{
+    const ParticlePool *pool = particles_get_pool(node);
+    float w, h;
+    uint32_t p;
+
+    if (!pool || pool->count == 0) {
+        return;
+    }
+
+    w = node->params[6];
+    h = w * ((float)render_get_width() / (float)render_get_height());
+
+    for (p = 0; p < pool->count; p++) {
+        uint32_t c = pool->color[p];
+        float fade = 1.0f - pool->age[p] / pool->life[p];
+        uint8_t a = (uint8_t)(LGS_CLAMP(fade, 0.0f, 1.0f) * (float)(c >> 24));
+
+        render_rect(pool->pos_x[p] - w * 0.5f, pool->pos_y[p] - h * 0.5f, w, h,
+                    RENDER_COLOR(c & 0xFF, (c >> 8) & 0xFF, (c >> 16) & 0xFF, a));
+    }
+}
+
+/* ============================================================
+ * Render Sinks
+ * ============================================================ */
+void render_sinks(const Graph *graph, const EvalPlan *plan, const OutputBank *bank)
+{
+    uint16_t i;
+    uint16_t count;
+    uint16_t particle_sinks = 0;
+
+    if (!graph || !plan || !bank) {
+        return;
+    }
+
+    count = (plan->sink_count <= MAX_NODES) ? plan->sink_count : MAX_NODES;
+
+    /* Shapes draw opaque in the scene layer */
+    render_set_layer(DL_LAYER_SCENE);
+    render_set_blend(DL_BLEND_OPAQUE);
+    for (i = 0; i < count; i++) {
+        const PlanSink *sink = &plan->sinks[i];
+
+        if (sink->node >= MAX_NODES ||
+            graph->nodes[sink->node].type == NODE_TYPE_NONE) {
+            continue;
+        }
+        if (sink->kind == SINK_KIND_PARTICLES) {
+            particle_sinks++;
+            continue;
+        }
+        draw_shape(sink, bank);
+    }
+
+    /* Particles fade out through their alpha, over the shapes */
+    render_set_layer(DL_LAYER_PARTICLES);
+    if (particle_sinks == 0) {
+        return;
+    }
+    render_set_blend(DL_BLEND_ALPHA);
+    for (i = 0; i < count; i++) {
+        const PlanSink *sink = &plan->sinks[i];
+
+        if (sink->kind == SINK_KIND_PARTICLES && sink->node < MAX_NODES &&
+            graph->nodes[sink->node].type == NODE_TYPE_PARTICLES) {
+            draw_particles(&graph->nodes[sink->node]);
+        }
+    }
+    render_set_blend(DL_BLEND_OPAQUE);
+}
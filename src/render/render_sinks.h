@@ -0,0 +1,20 @@
+#ifndef RENDER_SINKS_H
+#define RENDER_SINKS_H
+
+#include "../graph/graph_types.h"
+
+/* ============================================================
+ * Sink Render Pass
+ * ============================================================
+ * Draws every sink in plan->sinks[] from an evaluated OutputBank:
+ *   RECT      out x, y, w, h        (normalized, DL_LAYER_SCENE)
+ *   CIRCLE    out x, y, radius      (normalized, DL_LAYER_SCENE)
+ *   LINE      out x1, y1, x2, y2    (normalized, DL_LAYER_SCENE)
+ *   PARTICLES the node's pool       (DL_LAYER_PARTICLES, alpha)
+ * Colors come from bank->sink_color (packed during evaluation).
+ * Leaves the layer at DL_LAYER_PARTICLES and the blend opaque.
+ * ============================================================ */
+
+void render_sinks(const Graph *graph, const EvalPlan *plan, const OutputBank *bank);
+
+#endif /* RENDER_SINKS_H */
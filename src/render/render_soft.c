@@ -0,0 +1,236 @@
+#include "render_soft.h"
+#include "render.h"
+#include "render_backend.h"
+#include "soft_tiles.h"
+#include "soft_scale.h"
+#include <stddef.h>
+#include <stdlib.h>
+
+/* ============================================================
+ * Static State
+ * ============================================================ */
+static SoftTarget s_target = { NULL, 0, 0, 0 };
+static uint32_t   s_frames = 0;
+
+/* Draw target: s_target itself at scale 1, otherwise a smaller
+ * buffer upscaled into s_target at end of frame */
+static SoftTarget s_draw = { NULL, 0, 0, 0 };
+static SoftScale  s_scale;
+static int        s_scaled = 0;
+
+/* Tile-binned path (threads > 1): batches are recorded and drawn
+ * in parallel at end of frame */
+static int        s_threads = 1;
+static int        s_tiled = 0;
+static SoftTiles  s_tiles;
+
+static int  soft_init(int width, int height);
+static void soft_shutdown(void);
+static void soft_begin_frame(void);
+static void soft_clear_target(uint32_t color);
+static void soft_end_frame(void);
+static int  soft_set_scale(int divisor, RenderFilter filter);
+static void soft_backend_draw_batch(void *user, DlPrim prim, DlBlend blend,
+                                    const DlCmd *cmds, const uint32_t *order, uint32_t n);
+
+static const RenderBackend s_backend = {
+    "soft",
+    soft_init,
+    soft_shutdown,
+    soft_begin_frame,
+    soft_clear_target,
+    soft_end_frame,
+    soft_set_scale,
+    { soft_backend_draw_batch, NULL }
+};
+
+const RenderBackend *render_backend_soft(void)
+{
+    return &s_backend;
+}
+
+/* ============================================================
+ * Backend Callbacks
+ * ============================================================ */
+static int soft_init(int width, int height)
+{
+    SoftClip full;
+
+    /* Framebuffer allocated once at init time (host only) */
+    s_target.pixels = (uint32_t *)malloc((size_t)width * (size_t)height * sizeof(uint32_t));
+    if (!s_target.pixels) {
+        return -1;
+    }
+    s_target.width = width;
+    s_target.height = height;
+    s_target.stride = width;
+
+    full = soft_clip_full(&s_target);
+    soft_clear(&s_target, &full, 0);
+    s_frames = 0;
+    s_draw = s_target;
+    s_scaled = 0;
+
+    s_tiled = 0;
+    if (s_threads > 1) {
+        if (soft_tiles_init(&s_tiles, &s_target, s_threads) != 0) {
+            soft_shutdown();
+            return -1;
+        }
+        s_tiled = 1;
+    }
+    return 0;
+}
+
+static void soft_shutdown(void)
+{
+    if (s_tiled) {
+        soft_tiles_shutdown(&s_tiles);
+        s_tiled = 0;
+    }
+    if (s_scaled) {
+        soft_scale_shutdown(&s_scale);
+        free(s_draw.pixels);
+        s_scaled = 0;
+    }
+    s_draw.pixels = NULL;
+    free(s_target.pixels);
+    s_target.pixels = NULL;
+    s_target.width = 0;
+    s_target.height = 0;
+    s_target.stride = 0;
+}
+
+static void soft_begin_frame(void)
+{
+}
+
+static void soft_clear_target(uint32_t color)
+{
+    SoftClip full;
+
+    if (s_tiled) {
+        soft_tiles_clear(&s_tiles, color);
+        return;
+    }
+    full = soft_clip_full(&s_draw);
+    soft_clear(&s_draw, &full, color);
+}
+
+static void upscale_rows(void *user, int band, int thread)
+{
+    int y0 = band * SOFT_TILE_SIZE;
+    (void)user;
+    (void)thread;
+
+    soft_scale_rows(&s_scale, &s_draw, &s_target, y0, y0 + SOFT_TILE_SIZE);
+}
+
+static void soft_end_frame(void)
+{
+    if (s_tiled) {
+        soft_tiles_execute(&s_tiles);
+    }
+    if (s_scaled) {
+        if (s_tiled) {
+            soft_pool_run(&s_tiles.pool, (s_target.height + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE,
+                          upscale_rows, NULL);
+        } else {
+            soft_scale_rows(&s_scale, &s_draw, &s_target, 0, s_target.height);
+        }
+    }
+    s_frames++;
+}
+
+/* Rebind drawing to the output or a 1/divisor buffer. Called by
+ * render.c between frames; the tile binner is rebuilt for the new
+ * draw target. */
+static int soft_set_scale(int divisor, RenderFilter filter)
+{
+    SoftTarget draw = s_target;
+    SoftScale scale;
+    SoftClip full;
+
+    if (!s_target.pixels || divisor < 1) {
+        return -1;
+    }
+
+    if (divisor > 1) {
+        if (soft_scale_init(&scale, s_target.width, s_target.height, divisor,
+                            filter == RENDER_FILTER_BILINEAR ? SOFT_FILTER_BILINEAR
+                                                             : SOFT_FILTER_NEAREST) != 0) {
+            return -1;
+        }
+        draw.width = scale.src_width;
+        draw.height = scale.src_height;
+        draw.stride = scale.src_width;
+        draw.pixels = (uint32_t *)malloc((size_t)draw.width * (size_t)draw.height *
+                                         sizeof(uint32_t));
+        if (!draw.pixels) {
+            soft_scale_shutdown(&scale);
+            return -1;
+        }
+        full = soft_clip_full(&draw);
+        soft_clear(&draw, &full, 0);
+    }
+
+    if (s_tiled) {
+        soft_tiles_shutdown(&s_tiles);
+        s_tiled = 0;
+        if (soft_tiles_init(&s_tiles, &draw, s_threads) == 0) {
+            s_tiled = 1;
+        }
+    }
+    if (s_scaled) {
+        soft_scale_shutdown(&s_scale);
+        free(s_draw.pixels);
+    }
+
+    s_draw = draw;
+    s_scaled = divisor > 1;
+    if (s_scaled) {
+        s_scale = scale;
+    }
+    return 0;
+}
+
+static void soft_backend_draw_batch(void *user, DlPrim prim, DlBlend blend,
+                                    const DlCmd *cmds, const uint32_t *order, uint32_t n)
+{
+    SoftClip full;
+    (void)user;
+
+    if (s_tiled) {
+        soft_tiles_draw_batch(&s_tiles, prim, blend, cmds, order, n);
+        return;
+    }
+    full = soft_clip_full(&s_draw);
+    soft_draw_batch(&s_draw, &full, prim, blend, cmds, order, n);
+}
+
+/* ============================================================
+ * Configuration / Accessors
+ * ============================================================ */
+int render_soft_set_threads(int threads)
+{
+    if (threads < 1 || threads > SOFT_TILES_MAX_THREADS) {
+        return -1;
+    }
+    s_threads = threads;
+    return 0;
+}
+
+const SoftTarget *render_soft_target(void)
+{
+    return &s_target;
+}
+
+const SoftTarget *render_soft_draw_target(void)
+{
+    return &s_draw;
+}
+
+uint32_t render_soft_frame_count(void)
+{
+    return s_frames;
+}
@@ -0,0 +1,44 @@
+#ifndef RENDER_SOFT_H
+#define RENDER_SOFT_H
+
+#include "soft_raster.h"
+
+/* ============================================================
+ * Software Render Backend
+ * ============================================================
+ * render.h on the CPU: batches are rasterized with soft_raster
+ * into an RGBA framebuffer of the render_set_resolution() size,
+ * which stays readable after render_end_frame() (checksums, image
+ * dumps, offline rendering).
+ *
+ * With more than one thread, batches are recorded and rasterized
+ * tile-parallel at render_end_frame() (soft_tiles.h); output is
+ * identical either way.
+ *
+ * With render_set_scale() > 1, batches are drawn into a smaller
+ * buffer that render_end_frame() upscales into the framebuffer
+ * (soft_scale.h, row bands in parallel when threaded).
+ *
+ * Portable C: no gsKit dependency. Host builds only (-pthread).
+ *
+ * Memory usage (heap, allocated in render_init):
+ *   framebuffer: width * height * 4 (640x480: 1.2MB, 1080p: 8.3MB)
+ *   draw buffer: framebuffer / divisor^2 while scaled (set_scale)
+ * ============================================================ */
+
+/* Rasterizer threads (1..SOFT_TILES_MAX_THREADS, default 1).
+ * Call before render_init(). Returns 0 on success, -1 if out of range. */
+int render_soft_set_threads(int threads);
+
+/* Framebuffer of the software backend (pixels NULL until init) */
+const SoftTarget *render_soft_target(void);
+
+/* Target primitives are drawn into: the framebuffer at scale 1,
+ * otherwise the internal buffer upscaled at end of frame. Valid
+ * between render_begin_frame() and render_end_frame(). */
+const SoftTarget *render_soft_draw_target(void);
+
+/* Frames completed since init */
+uint32_t render_soft_frame_count(void);
+
+#endif /* RENDER_SOFT_H */
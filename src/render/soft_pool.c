@@ -0,0 +1,197 @@
+#include "soft_pool.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* ============================================================
+ * Pool State
+ * ============================================================
+ * Workers sleep on start_cv until the run generation changes,
+ * then pull job indices from a shared counter alongside the
+ * calling thread. The mutex only guards the counter and the
+ * generation handshake.
+ * ============================================================ */
+typedef struct {
+    struct SoftPoolState *state;
+    int                   thread;
+} SoftPoolWorker;
+
+struct SoftPoolState {
+    pthread_t       workers[SOFT_POOL_MAX_THREADS];
+    SoftPoolWorker  args[SOFT_POOL_MAX_THREADS];
+    int             worker_count;
+    pthread_mutex_t lock;
+    pthread_cond_t  start_cv;
+    pthread_cond_t  done_cv;
+    uint32_t        generation;
+    int             next_job;
+    int             busy;           /* Workers still in this run */
+    int             quit;
+
+    /* Current run */
+    int             count;
+    SoftPoolJob     job;
+    void           *user;
+};
+
+static int next_job(struct SoftPoolState *s)
+{
+    int index;
+
+    pthread_mutex_lock(&s->lock);
+    index = s->next_job++;
+    pthread_mutex_unlock(&s->lock);
+    return index;
+}
+
+static void run_jobs(struct SoftPoolState *s, int thread)
+{
+    int index;
+
+    while ((index = next_job(s)) < s->count) {
+        s->job(s->user, index, thread);
+    }
+}
+
+static void *worker_main(void *arg)
+{
+    SoftPoolWorker *w = (SoftPoolWorker *)arg;
+    struct SoftPoolState *s = w->state;
+    uint32_t seen = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&s->lock);
+        while (!s->quit && s->generation == seen) {
+            pthread_cond_wait(&s->start_cv, &s->lock);
+        }
+        if (s->quit) {
+            pthread_mutex_unlock(&s->lock);
+            return NULL;
+        }
+        seen = s->generation;
+        pthread_mutex_unlock(&s->lock);
+
+        run_jobs(s, w->thread);
+
+        pthread_mutex_lock(&s->lock);
+        if (--s->busy == 0) {
+            pthread_cond_signal(&s->done_cv);
+        }
+        pthread_mutex_unlock(&s->lock);
+    }
+}
+
+static void state_stop(struct SoftPoolState *s)
+{
+    int i;
+
+    pthread_mutex_lock(&s->lock);
+    s->quit = 1;
+    pthread_cond_broadcast(&s->start_cv);
+    pthread_mutex_unlock(&s->lock);
+
+    for (i = 0; i < s->worker_count; i++) {
+        pthread_join(s->workers[i], NULL);
+    }
+    pthread_cond_destroy(&s->done_cv);
+    pthread_cond_destroy(&s->start_cv);
+    pthread_mutex_destroy(&s->lock);
+    free(s);
+}
+
+/* ============================================================
+ * Init / Shutdown
+ * ============================================================ */
+int soft_pool_init(SoftPool *pool, int threads)
+{
+    struct SoftPoolState *s;
+    int workers, i;
+
+    if (!pool) {
+        return -1;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > SOFT_POOL_MAX_THREADS) threads = SOFT_POOL_MAX_THREADS;
+
+    pool->threads = threads;
+    pool->state = NULL;
+    workers = threads - 1;
+    if (workers == 0) {
+        return 0;
+    }
+
+    s = (struct SoftPoolState *)calloc(1, sizeof(*s));
+    if (!s) {
+        return -1;
+    }
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->start_cv, NULL);
+    pthread_cond_init(&s->done_cv, NULL);
+
+    for (i = 0; i < workers; i++) {
+        s->args[i].state = s;
+        s->args[i].thread = i + 1;
+        if (pthread_create(&s->workers[i], NULL, worker_main, &s->args[i]) != 0) {
+            break;
+        }
+        s->worker_count++;
+    }
+    if (s->worker_count != workers) {
+        state_stop(s);
+        return -1;
+    }
+
+    pool->state = s;
+    return 0;
+}
+
+void soft_pool_shutdown(SoftPool *pool)
+{
+    if (!pool) {
+        return;
+    }
+    if (pool->state) {
+        state_stop(pool->state);
+        pool->state = NULL;
+    }
+    pool->threads = 1;
+}
+
+/* ============================================================
+ * Run
+ * ============================================================ */
+void soft_pool_run(SoftPool *pool, int count, SoftPoolJob job, void *user)
+{
+    struct SoftPoolState *s;
+    int i;
+
+    if (!pool || !job || count <= 0) {
+        return;
+    }
+
+    s = pool->state;
+    if (!s) {
+        for (i = 0; i < count; i++) {
+            job(user, i, 0);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&s->lock);
+    s->count = count;
+    s->job = job;
+    s->user = user;
+    s->next_job = 0;
+    s->busy = s->worker_count;
+    s->generation++;
+    pthread_cond_broadcast(&s->start_cv);
+    pthread_mutex_unlock(&s->lock);
+
+    run_jobs(s, 0);
+
+    pthread_mutex_lock(&s->lock);
+    while (s->busy > 0) {
+        pthread_cond_wait(&s->done_cv, &s->lock);
+    }
+    pthread_mutex_unlock(&s->lock);
+}
@@ -0,0 +1,40 @@
+#ifndef SOFT_POOL_H
+#define SOFT_POOL_H
+
+/* ============================================================
+ * Software Renderer Worker Pool
+ * ============================================================
+ * Persistent threads for the host software renderers. A run hands
+ * out job indices 0..count-1 from a shared counter; the calling
+ * thread works alongside the workers and the run returns once every
+ * job has finished. Jobs of one run must not depend on each other.
+ *
+ * Each job also receives the index of the thread running it
+ * (0 = caller, 1..threads-1 = workers) so callers can keep
+ * per-thread scratch without locking.
+ *
+ * Host only (POSIX threads); build with -pthread.
+ * ============================================================ */
+
+#define SOFT_POOL_MAX_THREADS  64
+
+typedef void (*SoftPoolJob)(void *user, int index, int thread);
+
+struct SoftPoolState;
+
+typedef struct {
+    int                   threads;  /* Including the calling thread */
+    struct SoftPoolState *state;    /* Workers (NULL if threads == 1) */
+} SoftPool;
+
+/* Start threads - 1 workers (1..SOFT_POOL_MAX_THREADS).
+ * Returns 0 on success, -1 on failure. */
+int soft_pool_init(SoftPool *pool, int threads);
+
+/* Stop and join workers */
+void soft_pool_shutdown(SoftPool *pool);
+
+/* Run job(user, i, thread) for every i in 0..count-1 and wait */
+void soft_pool_run(SoftPool *pool, int count, SoftPoolJob job, void *user);
+
+#endif /* SOFT_POOL_H */
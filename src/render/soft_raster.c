@@ -0,0 +1,395 @@
+#include "soft_raster.h"
+#include "circle_lut.h"
+
+#if defined(__SSE2__) && !defined(SOFT_RASTER_NO_SIMD)
+#include <emmintrin.h>
+#define SOFT_RASTER_SSE2 1
+#endif
+
+/* ============================================================
+ * Software Rasterizer
+ * ============================================================
+ * All primitives reduce to horizontal spans; a span is filled
+ * (opaque) or blended (alpha) four pixels at a time with SSE2,
+ * falling back to the same integer math per pixel.
+ * ============================================================ */
+
+#define SOFT_OPAQUE_ALPHA 0x80u
+
+/* ============================================================
+ * Pixel Helpers
+ * ============================================================ */
+static uint32_t opaque_pixel(uint32_t color)
+{
+    return (color & 0x00FFFFFFu) | (SOFT_OPAQUE_ALPHA << 24);
+}
+
+static uint32_t source_alpha(uint32_t color)
+{
+    uint32_t a = color >> 24;
+    return a > SOFT_OPAQUE_ALPHA ? SOFT_OPAQUE_ALPHA : a;
+}
+
+/* d + floor((s - d) * a / 128), without shifting a negative value */
+static uint32_t blend_channel(uint32_t s, uint32_t d, uint32_t a)
+{
+    int32_t diff = ((int32_t)s - (int32_t)d) * (int32_t)a;
+    return (uint32_t)((int32_t)d + (((diff + 32768) >> 7) - 256));
+}
+
+static uint32_t blend_pixel(uint32_t src, uint32_t dst, uint32_t a)
+{
+    uint32_t r = blend_channel(src & 0xFF, dst & 0xFF, a);
+    uint32_t g = blend_channel((src >> 8) & 0xFF, (dst >> 8) & 0xFF, a);
+    uint32_t b = blend_channel((src >> 16) & 0xFF, (dst >> 16) & 0xFF, a);
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+/* ============================================================
+ * Span Fill / Blend
+ * ============================================================ */
+static void span_fill(uint32_t *p, int n, uint32_t pixel)
+{
+    int i = 0;
+
+#ifdef SOFT_RASTER_SSE2
+    __m128i v = _mm_set1_epi32((int)pixel);
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_si128((__m128i *)(p + i), v);
+    }
+#endif
+    for (; i < n; i++) {
+        p[i] = pixel;
+    }
+}
+
+static void span_blend(uint32_t *p, int n, uint32_t color, uint32_t a)
+{
+    int i = 0;
+
+#ifdef SOFT_RASTER_SSE2
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+        const __m128i alpha = _mm_set1_epi16((short)a);
+        const __m128i rgb_mask = _mm_set1_epi32(0x00FFFFFF);
+        const __m128i a_bits = _mm_set1_epi32((int)(a << 24));
+
+        for (; i + 4 <= n; i += 4) {
+            __m128i d = _mm_loadu_si128((const __m128i *)(p + i));
+            __m128i lo = _mm_unpacklo_epi8(d, zero);
+            __m128i hi = _mm_unpackhi_epi8(d, zero);
+
+            /* (s - d) * a fits int16 since a <= 128; srai is floor */
+            lo = _mm_add_epi16(lo, _mm_srai_epi16(
+                     _mm_mullo_epi16(_mm_sub_epi16(src, lo), alpha), 7));
+            hi = _mm_add_epi16(hi, _mm_srai_epi16(
+                     _mm_mullo_epi16(_mm_sub_epi16(src, hi), alpha), 7));
+
+            d = _mm_packus_epi16(lo, hi);
+            d = _mm_or_si128(_mm_and_si128(d, rgb_mask), a_bits);
+            _mm_storeu_si128((__m128i *)(p + i), d);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        p[i] = blend_pixel(color, p[i], a);
+    }
+}
+
+/* Fill or blend [x0, x1) of row y (already clipped) */
+static void draw_span(const SoftTarget *t, int y, int x0, int x1,
+                      uint32_t color, DlBlend blend)
+{
+    uint32_t *row = t->pixels + (long)y * t->stride;
+
+    if (x1 <= x0) {
+        return;
+    }
+    if (blend == DL_BLEND_ALPHA) {
+        span_blend(row + x0, x1 - x0, color, source_alpha(color));
+    } else {
+        span_fill(row + x0, x1 - x0, opaque_pixel(color));
+    }
+}
+
+/* ============================================================
+ * Clip
+ * ============================================================ */
+SoftClip soft_clip_full(const SoftTarget *target)
+{
+    SoftClip c;
+
+    c.x0 = 0;
+    c.y0 = 0;
+    c.x1 = target ? target->width : 0;
+    c.y1 = target ? target->height : 0;
+    return c;
+}
+
+/* ============================================================
+ * Clear
+ * ============================================================ */
+void soft_clear(const SoftTarget *target, const SoftClip *clip, uint32_t color)
+{
+    int y;
+
+    if (!target || !clip) {
+        return;
+    }
+    for (y = clip->y0; y < clip->y1; y++) {
+        draw_span(target, y, clip->x0, clip->x1, color, DL_BLEND_OPAQUE);
+    }
+}
+
+/* ============================================================
+ * Rectangle
+ * ============================================================ */
+void soft_fill_rect(const SoftTarget *target, const SoftClip *clip,
+                    int x1, int y1, int x2, int y2, uint32_t color, DlBlend blend)
+{
+    int y;
+
+    if (!target || !clip) {
+        return;
+    }
+    if (x1 < clip->x0) x1 = clip->x0;
+    if (y1 < clip->y0) y1 = clip->y0;
+    if (x2 > clip->x1) x2 = clip->x1;
+    if (y2 > clip->y1) y2 = clip->y1;
+
+    for (y = y1; y < y2; y++) {
+        draw_span(target, y, x1, x2, color, blend);
+    }
+}
+
+/* ============================================================
+ * Line (Bresenham, endpoints inclusive)
+ * ============================================================ */
+void soft_line(const SoftTarget *target, const SoftClip *clip,
+               int x1, int y1, int x2, int y2, uint32_t color, DlBlend blend)
+{
+    int dx, dy, sx, sy, err;
+    uint32_t pixel, a;
+
+    if (!target || !clip) {
+        return;
+    }
+
+    /* Axis-aligned lines are single spans (editor outlines, wires) */
+    if (y1 == y2) {
+        int lo = x1 < x2 ? x1 : x2;
+        int hi = (x1 < x2 ? x2 : x1) + 1;
+        if (y1 >= clip->y0 && y1 < clip->y1) {
+            if (lo < clip->x0) lo = clip->x0;
+            if (hi > clip->x1) hi = clip->x1;
+            draw_span(target, y1, lo, hi, color, blend);
+        }
+        return;
+    }
+
+    pixel = opaque_pixel(color);
+    a = source_alpha(color);
+    dx = x2 > x1 ? x2 - x1 : x1 - x2;
+    dy = y2 > y1 ? y1 - y2 : y2 - y1;   /* -|dy| */
+    sx = x1 < x2 ? 1 : -1;
+    sy = y1 < y2 ? 1 : -1;
+    err = dx + dy;
+
+    for (;;) {
+        if (x1 >= clip->x0 && x1 < clip->x1 && y1 >= clip->y0 && y1 < clip->y1) {
+            uint32_t *p = target->pixels + (long)y1 * target->stride + x1;
+            *p = (blend == DL_BLEND_ALPHA) ? blend_pixel(color, *p, a) : pixel;
+        }
+        if (x1 == x2 && y1 == y2) {
+            break;
+        }
+        {
+            int e2 = 2 * err;
+            if (e2 >= dy) {
+                err += dy;
+                x1 += sx;
+            }
+            if (e2 <= dx) {
+                err += dx;
+                y1 += sy;
+            }
+        }
+    }
+}
+
+/* ============================================================
+ * Triangle
+ * ============================================================
+ * Edge functions in doubled coordinates so pixel centers
+ * (x + 0.5, y + 0.5) are integers. Each row's covered span is
+ * solved per edge, then filled as one span.
+ * ============================================================ */
+typedef struct {
+    int64_t a, b, c;    /* E(px, py) = a*px + b*py + c, inside when >= bias */
+    int64_t bias;       /* 0 for owned (top-left) edges, 1 otherwise */
+} SoftEdge;
+
+static void edge_setup(SoftEdge *e, int ax, int ay, int bx, int by)
+{
+    int64_t dx = 2 * (int64_t)(bx - ax);
+    int64_t dy = 2 * (int64_t)(by - ay);
+
+    e->a = -dy;
+    e->b = dx;
+    e->c = dy * 2 * ax - dx * 2 * ay;
+    e->bias = (dy < 0 || (dy == 0 && dx > 0)) ? 0 : 1;
+}
+
+static int64_t floor_div(int64_t n, int64_t d)
+{
+    int64_t q = n / d;
+    if ((n % d != 0) && ((n < 0) != (d < 0))) {
+        q--;
+    }
+    return q;
+}
+
+static int64_t ceil_div(int64_t n, int64_t d)
+{
+    return -floor_div(-n, d);
+}
+
+void soft_triangle(const SoftTarget *target, const SoftClip *clip,
+                   int x1, int y1, int x2, int y2, int x3, int y3,
+                   uint32_t color, DlBlend blend)
+{
+    SoftEdge e[3];
+    int64_t area;
+    int min_y, max_y, min_x, max_x;
+    int y, i;
+
+    if (!target || !clip) {
+        return;
+    }
+
+    area = (int64_t)(x2 - x1) * (y3 - y1) - (int64_t)(y2 - y1) * (x3 - x1);
+    if (area == 0) {
+        return;
+    }
+    if (area < 0) {
+        int tx = x2, ty = y2;
+        x2 = x3; y2 = y3;
+        x3 = tx; y3 = ty;
+    }
+
+    edge_setup(&e[0], x1, y1, x2, y2);
+    edge_setup(&e[1], x2, y2, x3, y3);
+    edge_setup(&e[2], x3, y3, x1, y1);
+
+    /* Rows whose centers lie within the vertex span */
+    min_y = y1 < y2 ? (y1 < y3 ? y1 : y3) : (y2 < y3 ? y2 : y3);
+    max_y = y1 > y2 ? (y1 > y3 ? y1 : y3) : (y2 > y3 ? y2 : y3);
+    min_x = x1 < x2 ? (x1 < x3 ? x1 : x3) : (x2 < x3 ? x2 : x3);
+    max_x = x1 > x2 ? (x1 > x3 ? x1 : x3) : (x2 > x3 ? x2 : x3);
+    if (min_y < clip->y0) min_y = clip->y0;
+    if (max_y > clip->y1) max_y = clip->y1;
+    if (min_x < clip->x0) min_x = clip->x0;
+    if (max_x > clip->x1) max_x = clip->x1;
+    if (min_x >= max_x) {
+        return;
+    }
+
+    for (y = min_y; y < max_y; y++) {
+        int64_t py = 2 * (int64_t)y + 1;
+        int64_t lo = min_x;
+        int64_t hi = max_x;     /* Exclusive */
+
+        for (i = 0; i < 3; i++) {
+            /* a*(2x+1) + k >= bias  <=>  2a*x >= bias - k - a */
+            int64_t k = e[i].b * py + e[i].c;
+            int64_t rhs = e[i].bias - k - e[i].a;
+
+            if (e[i].a > 0) {
+                int64_t x = ceil_div(rhs, 2 * e[i].a);
+                if (x > lo) lo = x;
+            } else if (e[i].a < 0) {
+                int64_t x = floor_div(rhs, 2 * e[i].a) + 1;
+                if (x < hi) hi = x;
+            } else if (k < e[i].bias) {
+                hi = lo;    /* Horizontal edge excludes this row */
+            }
+        }
+        if (lo < hi) {
+            draw_span(target, y, (int)lo, (int)hi, color, blend);
+        }
+    }
+}
+
+/* ============================================================
+ * Circle (triangle fan)
+ * ============================================================ */
+void soft_circle(const SoftTarget *target, const SoftClip *clip,
+                 int cx, int cy, int rx, int ry, int segments,
+                 uint32_t color, DlBlend blend)
+{
+    const float *cs;
+    const float *sn;
+    int prev_x, prev_y;
+    int i;
+
+    segments = circle_lut_clamp(segments);
+    cs = circle_lut_cos(segments);
+    sn = circle_lut_sin(segments);
+
+    /* Skip fans entirely outside the clip */
+    if (!clip || cx + rx < clip->x0 || cx - rx >= clip->x1 ||
+        cy + ry < clip->y0 || cy - ry >= clip->y1) {
+        return;
+    }
+
+    prev_x = cx + rx;
+    prev_y = cy;
+    for (i = 1; i <= segments; i++) {
+        int cur_x = cx + (int)((float)rx * cs[i]);
+        int cur_y = cy + (int)((float)ry * sn[i]);
+
+        soft_triangle(target, clip, cx, cy, prev_x, prev_y, cur_x, cur_y, color, blend);
+        prev_x = cur_x;
+        prev_y = cur_y;
+    }
+}
+
+/* ============================================================
+ * Display List Commands
+ * ============================================================ */
+void soft_draw_cmd(const SoftTarget *target, const SoftClip *clip,
+                   DlPrim prim, DlBlend blend, const DlCmd *cmd)
+{
+    switch (prim) {
+        case DL_PRIM_RECT:
+            soft_fill_rect(target, clip, cmd->v[0], cmd->v[1], cmd->v[2], cmd->v[3],
+                           cmd->color, blend);
+            break;
+        case DL_PRIM_LINE:
+            soft_line(target, clip, cmd->v[0], cmd->v[1], cmd->v[2], cmd->v[3],
+                      cmd->color, blend);
+            break;
+        case DL_PRIM_TRIANGLE:
+            soft_triangle(target, clip, cmd->v[0], cmd->v[1], cmd->v[2], cmd->v[3],
+                          cmd->v[4], cmd->v[5], cmd->color, blend);
+            break;
+        case DL_PRIM_CIRCLE:
+            soft_circle(target, clip, cmd->v[0], cmd->v[1], cmd->v[2], cmd->v[3],
+                        cmd->v[4], cmd->color, blend);
+            break;
+        default:
+            break;
+    }
+}
+
+void soft_draw_batch(const SoftTarget *target, const SoftClip *clip,
+                     DlPrim prim, DlBlend blend,
+                     const DlCmd *cmds, const uint32_t *order, uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        soft_draw_cmd(target, clip, prim, blend, &cmds[DL_KEY_INDEX(order[i])]);
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef SOFT_RASTER_H
+#define SOFT_RASTER_H
+
+#include <stdint.h>
+#include "display_list.h"
+
+/* ============================================================
+ * Software Rasterizer
+ * ============================================================
+ * CPU implementation of the display list primitives, used by the
+ * software render backend (render_soft.c) on hosts without a GS.
+ *
+ * Pixels are RGBA8 in RENDER_COLOR layout (R bits 0-7 ... A bits
+ * 24-31) with the GS alpha convention: 0x80 = opaque.
+ *
+ * Rules (deterministic, pixel-exact across builds):
+ *   rect      covers [x1, x2) x [y1, y2)
+ *   line      Bresenham, both endpoints included
+ *   triangle  pixel centers, top-left fill rule (shared edges of a
+ *             fan are drawn once, so alpha fans do not double-blend)
+ *   circle    triangle fan from the circle_lut tables, same vertex
+ *             rounding as the gsKit backend
+ *   opaque    writes the color with alpha 0x80
+ *   alpha     d + ((s - d) * As >> 7) per channel, As clamped to
+ *             0..128; the written alpha is As (as the GS does)
+ *
+ * Every call takes a clip rect, so a caller can split the target
+ * into tiles and rasterize each independently.
+ *
+ * Span fills use SSE2 when available; define SOFT_RASTER_NO_SIMD to
+ * force the scalar path (results are identical).
+ * ============================================================ */
+
+typedef struct {
+    uint32_t *pixels;
+    int       width;
+    int       height;
+    int       stride;           /* Pixels per row */
+} SoftTarget;
+
+/* Clip rect: [x0, x1) x [y0, y1), must lie inside the target */
+typedef struct {
+    int x0, y0, x1, y1;
+} SoftClip;
+
+/* Full-target clip */
+SoftClip soft_clip_full(const SoftTarget *target);
+
+/* Fill the clip area with an opaque color */
+void soft_clear(const SoftTarget *target, const SoftClip *clip, uint32_t color);
+
+/* Primitives (screen pixels) */
+void soft_fill_rect(const SoftTarget *target, const SoftClip *clip,
+                    int x1, int y1, int x2, int y2, uint32_t color, DlBlend blend);
+void soft_line(const SoftTarget *target, const SoftClip *clip,
+               int x1, int y1, int x2, int y2, uint32_t color, DlBlend blend);
+void soft_triangle(const SoftTarget *target, const SoftClip *clip,
+                   int x1, int y1, int x2, int y2, int x3, int y3,
+                   uint32_t color, DlBlend blend);
+void soft_circle(const SoftTarget *target, const SoftClip *clip,
+                 int cx, int cy, int rx, int ry, int segments,
+                 uint32_t color, DlBlend blend);
+
+/* Draw one display list command */
+void soft_draw_cmd(const SoftTarget *target, const SoftClip *clip,
+                   DlPrim prim, DlBlend blend, const DlCmd *cmd);
+
+/* Draw one display list batch (DlBackend.draw_batch shape) */
+void soft_draw_batch(const SoftTarget *target, const SoftClip *clip,
+                     DlPrim prim, DlBlend blend,
+                     const DlCmd *cmds, const uint32_t *order, uint32_t n);
+
+#endif /* SOFT_RASTER_H */
@@ -0,0 +1,139 @@
+#include "soft_scale.h"
+#include <stdlib.h>
+
+/* ============================================================
+ * Helpers
+ * ============================================================ */
+static int floor_div(int a, int b)
+{
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/* Source tap of output coordinate x: left pixel and 8-bit weight
+ * of the pixel after it */
+static void source_tap(int x, int divisor, int src_size, int *tap, int *weight)
+{
+    int pos = floor_div((2 * x + 1 - divisor) * 128, divisor);   /* 1/256 px */
+    int i = pos >> 8;
+
+    if (pos < 0) {
+        *tap = 0;
+        *weight = 0;
+    } else if (i >= src_size - 1) {
+        *tap = src_size - 1;
+        *weight = 0;
+    } else {
+        *tap = i;
+        *weight = pos & 0xFF;
+    }
+}
+
+/* a + (b - a) * w / 256 on all four channels */
+static uint32_t lerp_pixel(uint32_t a, uint32_t b, uint32_t w)
+{
+    uint32_t iw = 256u - w;
+    uint32_t rb = (((a & 0x00FF00FFu) * iw + (b & 0x00FF00FFu) * w) >> 8) & 0x00FF00FFu;
+    uint32_t ga = ((((a >> 8) & 0x00FF00FFu) * iw + ((b >> 8) & 0x00FF00FFu) * w) >> 8) & 0x00FF00FFu;
+    return rb | (ga << 8);
+}
+
+/* ============================================================
+ * Init / Shutdown
+ * ============================================================ */
+int soft_scale_src_size(int dst_size, int divisor)
+{
+    if (divisor < 1) {
+        divisor = 1;
+    }
+    return (dst_size + divisor - 1) / divisor;
+}
+
+int soft_scale_init(SoftScale *sc, int dst_width, int dst_height,
+                    int divisor, SoftFilter filter)
+{
+    int x;
+
+    if (!sc || dst_width <= 0 || dst_height <= 0 || divisor < 1 || dst_width > 0xFFFF) {
+        return -1;
+    }
+
+    sc->divisor = divisor;
+    sc->filter = filter;
+    sc->dst_width = dst_width;
+    sc->dst_height = dst_height;
+    sc->src_width = soft_scale_src_size(dst_width, divisor);
+    sc->src_height = soft_scale_src_size(dst_height, divisor);
+    sc->col = (uint16_t *)malloc((size_t)dst_width * sizeof(uint16_t));
+    sc->col_w = (uint8_t *)malloc((size_t)dst_width);
+    if (!sc->col || !sc->col_w) {
+        soft_scale_shutdown(sc);
+        return -1;
+    }
+
+    for (x = 0; x < dst_width; x++) {
+        int tap, weight;
+
+        if (filter == SOFT_FILTER_BILINEAR) {
+            source_tap(x, divisor, sc->src_width, &tap, &weight);
+        } else {
+            tap = x / divisor;
+            weight = 0;
+        }
+        sc->col[x] = (uint16_t)tap;
+        sc->col_w[x] = (uint8_t)weight;
+    }
+    return 0;
+}
+
+void soft_scale_shutdown(SoftScale *sc)
+{
+    if (!sc) {
+        return;
+    }
+    free(sc->col);
+    free(sc->col_w);
+    sc->col = NULL;
+    sc->col_w = NULL;
+}
+
+/* ============================================================
+ * Scale Rows
+ * ============================================================ */
+void soft_scale_rows(const SoftScale *sc, const SoftTarget *src,
+                     const SoftTarget *dst, int y0, int y1)
+{
+    const uint16_t *col = sc->col;
+    const uint8_t *col_w = sc->col_w;
+    int width = sc->dst_width;
+    int x, y;
+
+    if (y0 < 0) y0 = 0;
+    if (y1 > sc->dst_height) y1 = sc->dst_height;
+
+    for (y = y0; y < y1; y++) {
+        uint32_t *out = dst->pixels + (long)y * dst->stride;
+
+        if (sc->filter == SOFT_FILTER_BILINEAR) {
+            const uint32_t *r0, *r1;
+            int tap, wy;
+
+            source_tap(y, sc->divisor, sc->src_height, &tap, &wy);
+            r0 = src->pixels + (long)tap * src->stride;
+            r1 = wy ? r0 + src->stride : r0;
+
+            for (x = 0; x < width; x++) {
+                int c = col[x];
+                int c1 = col_w[x] ? c + 1 : c;
+                uint32_t top = lerp_pixel(r0[c], r0[c1], col_w[x]);
+                uint32_t bot = lerp_pixel(r1[c], r1[c1], col_w[x]);
+                out[x] = lerp_pixel(top, bot, (uint32_t)wy);
+            }
+        } else {
+            const uint32_t *row = src->pixels + (long)(y / sc->divisor) * src->stride;
+
+            for (x = 0; x < width; x++) {
+                out[x] = row[col[x]];
+            }
+        }
+    }
+}
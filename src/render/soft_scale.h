@@ -0,0 +1,54 @@
+#ifndef SOFT_SCALE_H
+#define SOFT_SCALE_H
+
+#include <stdint.h>
+#include "soft_raster.h"
+
+/* ============================================================
+ * Software Upscaler
+ * ============================================================
+ * Enlarges a target rendered at 1/divisor of the output size back
+ * to the output. Output pixel centres map to source positions
+ * (x + 0.5) / divisor - 0.5; nearest takes the covering source
+ * pixel, bilinear blends the four around it with 8-bit weights
+ * (integer math, bit-exact on every host). Edges clamp.
+ *
+ * Column taps are precomputed once per size; rows can be scaled in
+ * any order and from several threads.
+ *
+ * Memory usage (heap, allocated by soft_scale_init):
+ *   3 bytes per output column
+ * ============================================================ */
+
+typedef enum {
+    SOFT_FILTER_NEAREST = 0,
+    SOFT_FILTER_BILINEAR
+} SoftFilter;
+
+typedef struct {
+    int        divisor;
+    SoftFilter filter;
+    int        src_width;
+    int        src_height;
+    int        dst_width;
+    int        dst_height;
+    uint16_t  *col;             /* Left source column per output column */
+    uint8_t   *col_w;           /* Weight of col + 1 (0..255) */
+} SoftScale;
+
+/* Source size for an output size and divisor (rounded up) */
+int soft_scale_src_size(int dst_size, int divisor);
+
+/* Build column taps for dst_width x dst_height from a source of
+ * soft_scale_src_size(). Returns 0 on success, -1 on failure. */
+int soft_scale_init(SoftScale *sc, int dst_width, int dst_height,
+                    int divisor, SoftFilter filter);
+
+/* Free column taps */
+void soft_scale_shutdown(SoftScale *sc);
+
+/* Scale output rows [y0, y1) from src into dst */
+void soft_scale_rows(const SoftScale *sc, const SoftTarget *src,
+                     const SoftTarget *dst, int y0, int y1);
+
+#endif /* SOFT_SCALE_H */
@@ -0,0 +1,306 @@
+#include "soft_tiles.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SOFT_TILES_INITIAL_CMDS   4096
+#define SOFT_TILES_INITIAL_ITEMS  16384
+
+/* ============================================================
+ * Tile Rasterization
+ * ============================================================ */
+static void draw_tile(const SoftTiles *st, int tile)
+{
+    int tx = tile % st->tiles_x;
+    int ty = tile / st->tiles_x;
+    uint32_t i = st->bin_start[tile];
+    uint32_t end = st->bin_start[tile + 1];
+    SoftClip clip;
+
+    clip.x0 = tx * SOFT_TILE_SIZE;
+    clip.y0 = ty * SOFT_TILE_SIZE;
+    clip.x1 = clip.x0 + SOFT_TILE_SIZE;
+    clip.y1 = clip.y0 + SOFT_TILE_SIZE;
+    if (clip.x1 > st->target.width) clip.x1 = st->target.width;
+    if (clip.y1 > st->target.height) clip.y1 = st->target.height;
+
+    for (; i < end; i++) {
+        const SoftTileCmd *c = &st->cmds[st->bin_items[i]];
+
+        if (c->prim == SOFT_TILES_PRIM_CLEAR) {
+            soft_clear(&st->target, &clip, c->cmd.color);
+        } else {
+            soft_draw_cmd(&st->target, &clip, (DlPrim)c->prim, (DlBlend)c->blend, &c->cmd);
+        }
+    }
+}
+
+static void draw_tile_job(void *user, int tile, int thread)
+{
+    (void)thread;
+    draw_tile((const SoftTiles *)user, tile);
+}
+
+/* ============================================================
+ * Init / Shutdown
+ * ============================================================ */
+int soft_tiles_init(SoftTiles *st, const SoftTarget *target, int threads)
+{
+    int tiles;
+
+    if (!st || !target || !target->pixels || target->width <= 0 || target->height <= 0) {
+        return -1;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > SOFT_TILES_MAX_THREADS) threads = SOFT_TILES_MAX_THREADS;
+
+    memset(st, 0, sizeof(*st));
+    st->target = *target;
+    st->tiles_x = (target->width + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    st->tiles_y = (target->height + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    st->threads = threads;
+    tiles = st->tiles_x * st->tiles_y;
+
+    st->cmd_cap = SOFT_TILES_INITIAL_CMDS;
+    st->item_cap = SOFT_TILES_INITIAL_ITEMS;
+    st->cmds = (SoftTileCmd *)malloc(st->cmd_cap * sizeof(SoftTileCmd));
+    st->bin_start = (uint32_t *)malloc(((size_t)tiles + 1) * sizeof(uint32_t));
+    st->bin_items = (uint32_t *)malloc(st->item_cap * sizeof(uint32_t));
+    if (!st->cmds || !st->bin_start || !st->bin_items) {
+        soft_tiles_shutdown(st);
+        return -1;
+    }
+
+    if (soft_pool_init(&st->pool, threads) != 0) {
+        soft_tiles_shutdown(st);
+        return -1;
+    }
+    return 0;
+}
+
+void soft_tiles_shutdown(SoftTiles *st)
+{
+    if (!st) {
+        return;
+    }
+    soft_pool_shutdown(&st->pool);
+    free(st->cmds);
+    free(st->bin_start);
+    free(st->bin_items);
+    st->cmds = NULL;
+    st->bin_start = NULL;
+    st->bin_items = NULL;
+    st->cmd_count = 0;
+    st->cmd_cap = 0;
+    st->item_cap = 0;
+}
+
+/* ============================================================
+ * Recording
+ * ============================================================ */
+
+/* Reserve a command; executes early if the buffer cannot grow
+ * (ordering is unaffected since all earlier commands are drawn). */
+static SoftTileCmd *alloc_cmd(SoftTiles *st)
+{
+    if (!st->cmds) {
+        return NULL;
+    }
+    if (st->cmd_count >= st->cmd_cap) {
+        SoftTileCmd *grown = (SoftTileCmd *)realloc(st->cmds,
+                                                    2 * st->cmd_cap * sizeof(SoftTileCmd));
+        if (grown) {
+            st->cmds = grown;
+            st->cmd_cap *= 2;
+        } else {
+            soft_tiles_execute(st);
+        }
+    }
+    return &st->cmds[st->cmd_count++];
+}
+
+/* Pixel bounds -> tile range; returns 0 if nothing is on screen */
+static int set_tile_range(const SoftTiles *st, SoftTileCmd *c,
+                          int x0, int y0, int x1, int y1)
+{
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= st->target.width) x1 = st->target.width - 1;
+    if (y1 >= st->target.height) y1 = st->target.height - 1;
+    if (x0 > x1 || y0 > y1) {
+        return 0;
+    }
+    c->tx0 = (uint16_t)(x0 / SOFT_TILE_SIZE);
+    c->ty0 = (uint16_t)(y0 / SOFT_TILE_SIZE);
+    c->tx1 = (uint16_t)(x1 / SOFT_TILE_SIZE);
+    c->ty1 = (uint16_t)(y1 / SOFT_TILE_SIZE);
+    return 1;
+}
+
+static int min3(int a, int b, int c)
+{
+    int m = a < b ? a : b;
+    return m < c ? m : c;
+}
+
+static int max3(int a, int b, int c)
+{
+    int m = a > b ? a : b;
+    return m > c ? m : c;
+}
+
+/* Conservative inclusive pixel bounds of a command */
+static int bin_bounds(const SoftTiles *st, SoftTileCmd *c)
+{
+    const int16_t *v = c->cmd.v;
+
+    switch ((DlPrim)c->prim) {
+        case DL_PRIM_RECT:
+            return set_tile_range(st, c, v[0], v[1], v[2] - 1, v[3] - 1);
+        case DL_PRIM_LINE:
+            return set_tile_range(st, c, v[0] < v[2] ? v[0] : v[2], v[1] < v[3] ? v[1] : v[3],
+                                  v[0] > v[2] ? v[0] : v[2], v[1] > v[3] ? v[1] : v[3]);
+        case DL_PRIM_TRIANGLE:
+            return set_tile_range(st, c, min3(v[0], v[2], v[4]), min3(v[1], v[3], v[5]),
+                                  max3(v[0], v[2], v[4]), max3(v[1], v[3], v[5]));
+        case DL_PRIM_CIRCLE: {
+            int rx = v[2] < 0 ? -v[2] : v[2];
+            int ry = v[3] < 0 ? -v[3] : v[3];
+            return set_tile_range(st, c, v[0] - rx, v[1] - ry, v[0] + rx, v[1] + ry);
+        }
+        default:
+            return 0;
+    }
+}
+
+void soft_tiles_clear(SoftTiles *st, uint32_t color)
+{
+    SoftTileCmd *c;
+
+    if (!st || !(c = alloc_cmd(st))) {
+        return;
+    }
+    memset(c, 0, sizeof(*c));
+    c->prim = SOFT_TILES_PRIM_CLEAR;
+    c->cmd.color = color;
+    c->tx1 = (uint16_t)(st->tiles_x - 1);
+    c->ty1 = (uint16_t)(st->tiles_y - 1);
+}
+
+void soft_tiles_draw_batch(SoftTiles *st, DlPrim prim, DlBlend blend,
+                           const DlCmd *cmds, const uint32_t *order, uint32_t n)
+{
+    uint32_t i;
+
+    if (!st) {
+        return;
+    }
+
+    for (i = 0; i < n; i++) {
+        SoftTileCmd *c = alloc_cmd(st);
+
+        if (!c) {
+            return;
+        }
+        c->cmd = cmds[DL_KEY_INDEX(order[i])];
+        c->prim = (uint8_t)prim;
+        c->blend = (uint8_t)blend;
+        if (!bin_bounds(st, c)) {
+            st->cmd_count--;    /* Fully off screen */
+        }
+    }
+}
+
+/* ============================================================
+ * Binning
+ * ============================================================
+ * Counting sort by tile: count covered tiles per command, prefix
+ * sum into bin_start, then scatter command indices. Commands are
+ * visited in draw order, so every bin keeps draw order.
+ * ============================================================ */
+static int build_bins(SoftTiles *st)
+{
+    int tiles = st->tiles_x * st->tiles_y;
+    uint32_t total = 0;
+    uint32_t i;
+    int t, x, y;
+
+    memset(st->bin_start, 0, ((size_t)tiles + 1) * sizeof(uint32_t));
+
+    for (i = 0; i < st->cmd_count; i++) {
+        const SoftTileCmd *c = &st->cmds[i];
+        for (y = c->ty0; y <= c->ty1; y++) {
+            for (x = c->tx0; x <= c->tx1; x++) {
+                st->bin_start[y * st->tiles_x + x + 1]++;
+            }
+        }
+    }
+    for (t = 0; t < tiles; t++) {
+        st->bin_start[t + 1] += st->bin_start[t];
+    }
+    total = st->bin_start[tiles];
+
+    if (total > st->item_cap) {
+        uint32_t cap = st->item_cap;
+        uint32_t *grown;
+
+        while (cap < total) {
+            cap *= 2;
+        }
+        grown = (uint32_t *)realloc(st->bin_items, cap * sizeof(uint32_t));
+        if (!grown) {
+            return -1;
+        }
+        st->bin_items = grown;
+        st->item_cap = cap;
+    }
+
+    /* Scatter, using bin_start[t] as the write cursor of tile t */
+    for (i = 0; i < st->cmd_count; i++) {
+        const SoftTileCmd *c = &st->cmds[i];
+        for (y = c->ty0; y <= c->ty1; y++) {
+            for (x = c->tx0; x <= c->tx1; x++) {
+                st->bin_items[st->bin_start[y * st->tiles_x + x]++] = i;
+            }
+        }
+    }
+    /* Cursors now hold bin ends; shift back to starts */
+    for (t = tiles; t > 0; t--) {
+        st->bin_start[t] = st->bin_start[t - 1];
+    }
+    st->bin_start[0] = 0;
+
+    st->stat_bin_items = total;
+    return 0;
+}
+
+/* ============================================================
+ * Execute
+ * ============================================================ */
+void soft_tiles_execute(SoftTiles *st)
+{
+    if (!st || !st->cmds) {
+        return;
+    }
+
+    st->stat_cmds = st->cmd_count;
+    if (build_bins(st) != 0) {
+        /* Out of memory for bins: draw in order on this thread */
+        SoftClip full = soft_clip_full(&st->target);
+        uint32_t i;
+
+        for (i = 0; i < st->cmd_count; i++) {
+            const SoftTileCmd *c = &st->cmds[i];
+            if (c->prim == SOFT_TILES_PRIM_CLEAR) {
+                soft_clear(&st->target, &full, c->cmd.color);
+            } else {
+                soft_draw_cmd(&st->target, &full, (DlPrim)c->prim, (DlBlend)c->blend, &c->cmd);
+            }
+        }
+        st->cmd_count = 0;
+        return;
+    }
+
+    soft_pool_run(&st->pool, st->tiles_x * st->tiles_y, draw_tile_job, st);
+
+    st->cmd_count = 0;
+}
@@ -0,0 +1,82 @@
+#ifndef SOFT_TILES_H
+#define SOFT_TILES_H
+
+#include <stdint.h>
+#include "soft_raster.h"
+#include "soft_pool.h"
+
+/* ============================================================
+ * Tile-Binned Software Rasterizer
+ * ============================================================
+ * Deferred, multi-threaded front end for soft_raster. Commands of
+ * a frame are recorded in draw order, binned into SOFT_TILE_SIZE
+ * square screen tiles by bounding box, and tiles are rasterized in
+ * parallel: each tile is drawn by one thread, clipped to its own
+ * framebuffer region, so no locking touches pixels.
+ *
+ * Output is identical to drawing the same commands in order with
+ * soft_raster on one thread: every pixel sees the same sequence of
+ * writes (soft_raster results do not depend on the clip rect).
+ *
+ * Host only (POSIX threads); build with -pthread.
+ *
+ * Memory usage (heap, allocated at init, grown on demand):
+ *   cmds:  32 bytes per recorded command
+ *   bins:  4 bytes per (command, covered tile) pair
+ * ============================================================ */
+
+#define SOFT_TILE_SIZE          64
+#define SOFT_TILES_MAX_THREADS  SOFT_POOL_MAX_THREADS
+
+/* Recorded command (32 bytes) */
+typedef struct {
+    DlCmd    cmd;
+    uint8_t  prim;              /* DlPrim, or SOFT_TILES_PRIM_CLEAR */
+    uint8_t  blend;             /* DlBlend */
+    uint16_t tx0, ty0;          /* Covered tiles, inclusive */
+    uint16_t tx1, ty1;
+    uint8_t  _pad[2];
+} SoftTileCmd;
+
+#define SOFT_TILES_PRIM_CLEAR  DL_PRIM_COUNT
+
+typedef struct {
+    SoftTarget   target;
+    int          tiles_x;
+    int          tiles_y;
+    int          threads;       /* Including the calling thread */
+
+    SoftTileCmd *cmds;          /* Frame commands in draw order */
+    uint32_t     cmd_count;
+    uint32_t     cmd_cap;
+
+    uint32_t    *bin_start;     /* tiles + 1 offsets into bin_items */
+    uint32_t    *bin_items;     /* Command indices, grouped by tile */
+    uint32_t     item_cap;
+
+    SoftPool     pool;          /* Worker threads */
+
+    /* Stats (last execute) */
+    uint32_t     stat_cmds;
+    uint32_t     stat_bin_items;
+} SoftTiles;
+
+/* Bind to a target and start threads - 1 workers (1..SOFT_TILES_MAX_THREADS).
+ * Returns 0 on success, -1 on failure. */
+int soft_tiles_init(SoftTiles *st, const SoftTarget *target, int threads);
+
+/* Stop workers and free buffers */
+void soft_tiles_shutdown(SoftTiles *st);
+
+/* Record an opaque clear of the whole target */
+void soft_tiles_clear(SoftTiles *st, uint32_t color);
+
+/* Record a display list batch (DlBackend.draw_batch shape) */
+void soft_tiles_draw_batch(SoftTiles *st, DlPrim prim, DlBlend blend,
+                           const DlCmd *cmds, const uint32_t *order, uint32_t n);
+
+/* Bin and rasterize everything recorded, then start a new frame.
+ * Returns once the target is complete. */
+void soft_tiles_execute(SoftTiles *st);
+
+#endif /* SOFT_TILES_H */
@@ -0,0 +1,240 @@
+#include "text_fmt.h"
+#include <string.h>
+
+/* ============================================================
+ * Text Formatting
+ * ============================================================
+ * Integer digits are produced with one divide per digit into a
+ * small stack buffer; fixed-point floats are rounded to a scaled
+ * integer once, then printed as integer and fraction parts.
+ * ============================================================ */
+
+static const uint32_t s_pow10[TEXT_FMT_MAX_DECIMALS + 1] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u
+};
+
+/* Rounded value classes for text_fmt_fixed / fixed labels */
+#define FIXED_FINITE   0
+#define FIXED_NAN      1
+#define FIXED_INF      2
+#define FIXED_OVERFLOW 3
+
+/* ============================================================
+ * Append String / Character
+ * ============================================================ */
+int text_fmt_str(char *buf, int cap, int pos, const char *s)
+{
+    if (!buf || cap <= 0) {
+        return 0;
+    }
+    if (pos < 0 || pos >= cap) {
+        pos = cap - 1;
+    }
+    if (s) {
+        while (*s && pos < cap - 1) {
+            buf[pos++] = *s++;
+        }
+    }
+    buf[pos] = '\0';
+    return pos;
+}
+
+int text_fmt_char(char *buf, int cap, int pos, char c)
+{
+    char s[2];
+
+    s[0] = c;
+    s[1] = '\0';
+    return text_fmt_str(buf, cap, pos, s);
+}
+
+/* ============================================================
+ * Append Integer
+ * ============================================================ */
+int text_fmt_u32(char *buf, int cap, int pos, uint32_t v)
+{
+    char digits[11];
+    int n = 10;
+
+    digits[10] = '\0';
+    do {
+        digits[--n] = (char)('0' + v % 10u);
+        v /= 10u;
+    } while (v != 0);
+
+    return text_fmt_str(buf, cap, pos, &digits[n]);
+}
+
+int text_fmt_i32(char *buf, int cap, int pos, int32_t v)
+{
+    if (v < 0) {
+        pos = text_fmt_char(buf, cap, pos, '-');
+        /* Negate in unsigned so INT32_MIN works */
+        return text_fmt_u32(buf, cap, pos, 0u - (uint32_t)v);
+    }
+    return text_fmt_u32(buf, cap, pos, (uint32_t)v);
+}
+
+/* ============================================================
+ * Quantize Float (scaled magnitude at a decimal count)
+ * ============================================================ */
+static int fixed_quantize(float v, int decimals, uint32_t *mag, int *neg)
+{
+    float a;
+    float scaled;
+    uint32_t ip;
+
+    *mag = 0;
+    *neg = 0;
+
+    if (v != v) {
+        return FIXED_NAN;
+    }
+    *neg = v < 0.0f;
+    a = *neg ? -v : v;
+    if (a - a != 0.0f) {
+        return FIXED_INF;
+    }
+
+    /* Scale only the fraction: a * 10^d would round in float first */
+    if (a >= 4294967040.0f) {       /* Largest float below 2^32 */
+        return FIXED_OVERFLOW;
+    }
+    ip = (uint32_t)a;
+    if (ip > (0xFFFFFFFFu - s_pow10[decimals]) / s_pow10[decimals]) {
+        return FIXED_OVERFLOW;
+    }
+    scaled = (a - (float)ip) * (float)s_pow10[decimals] + 0.5f;
+    *mag = ip * s_pow10[decimals] + (uint32_t)scaled;
+    return FIXED_FINITE;
+}
+
+/* ============================================================
+ * Append Fixed-Precision Float
+ * ============================================================ */
+static int fmt_quantized(char *buf, int cap, int pos, int cls,
+                         uint32_t mag, int neg, int decimals)
+{
+    char frac[TEXT_FMT_MAX_DECIMALS + 1];
+    uint32_t f;
+    int i;
+
+    switch (cls) {
+        case FIXED_NAN:
+            return text_fmt_str(buf, cap, pos, "nan");
+        case FIXED_INF:
+            return text_fmt_str(buf, cap, pos, neg ? "-inf" : "inf");
+        case FIXED_OVERFLOW:
+            return text_fmt_str(buf, cap, pos, "#");
+        default:
+            break;
+    }
+
+    if (neg) {
+        pos = text_fmt_char(buf, cap, pos, '-');
+    }
+    pos = text_fmt_u32(buf, cap, pos, mag / s_pow10[decimals]);
+    if (decimals == 0) {
+        return pos;
+    }
+
+    f = mag % s_pow10[decimals];
+    for (i = decimals - 1; i >= 0; i--) {
+        frac[i] = (char)('0' + f % 10u);
+        f /= 10u;
+    }
+    frac[decimals] = '\0';
+
+    pos = text_fmt_char(buf, cap, pos, '.');
+    return text_fmt_str(buf, cap, pos, frac);
+}
+
+int text_fmt_fixed(char *buf, int cap, int pos, float v, int decimals)
+{
+    uint32_t mag;
+    int neg;
+    int cls;
+
+    if (decimals < 0) decimals = 0;
+    if (decimals > TEXT_FMT_MAX_DECIMALS) decimals = TEXT_FMT_MAX_DECIMALS;
+
+    cls = fixed_quantize(v, decimals, &mag, &neg);
+    return fmt_quantized(buf, cap, pos, cls, mag, neg, decimals);
+}
+
+/* ============================================================
+ * Retained Text Label
+ * ============================================================ */
+void text_label_init(TextLabel *label, const char *prefix,
+                     TextLabelKind kind, int decimals)
+{
+    if (!label) {
+        return;
+    }
+
+    memset(label, 0, sizeof(*label));
+    label->kind = (uint8_t)((kind < TEXT_LABEL_KIND_COUNT) ? kind : TEXT_LABEL_U32);
+    if (decimals < 0) decimals = 0;
+    if (decimals > TEXT_FMT_MAX_DECIMALS) decimals = TEXT_FMT_MAX_DECIMALS;
+    label->decimals = (uint8_t)decimals;
+    label->prefix_len = (uint8_t)text_fmt_str(label->text, TEXT_LABEL_MAX, 0, prefix);
+}
+
+/* Returns 1 if bound differs from the label's current values */
+static int label_changed(TextLabel *label, uint32_t a, uint32_t b)
+{
+    if (label->valid && label->bound[0] == a && label->bound[1] == b) {
+        return 0;
+    }
+    label->bound[0] = a;
+    label->bound[1] = b;
+    label->valid = 1;
+    return 1;
+}
+
+int text_label_u32(TextLabel *label, uint32_t v)
+{
+    if (!label || !label_changed(label, v, 0)) {
+        return 0;
+    }
+    text_fmt_u32(label->text, TEXT_LABEL_MAX, label->prefix_len, v);
+    return 1;
+}
+
+int text_label_u32_pair(TextLabel *label, uint32_t a, uint32_t b)
+{
+    int pos;
+
+    if (!label || !label_changed(label, a, b)) {
+        return 0;
+    }
+    pos = text_fmt_u32(label->text, TEXT_LABEL_MAX, label->prefix_len, a);
+    pos = text_fmt_char(label->text, TEXT_LABEL_MAX, pos, '/');
+    text_fmt_u32(label->text, TEXT_LABEL_MAX, pos, b);
+    return 1;
+}
+
+int text_label_fixed(TextLabel *label, float v)
+{
+    uint32_t mag;
+    int neg;
+    int cls;
+
+    if (!label) {
+        return 0;
+    }
+
+    /* Compare the rounded value, not the float bits */
+    cls = fixed_quantize(v, label->decimals, &mag, &neg);
+    if (!label_changed(label, mag, (uint32_t)(cls << 1) | (uint32_t)neg)) {
+        return 0;
+    }
+    fmt_quantized(label->text, TEXT_LABEL_MAX, label->prefix_len,
+                  cls, mag, neg, label->decimals);
+    return 1;
+}
+
+const char *text_label_str(const TextLabel *label)
+{
+    return label ? label->text : "";
+}
@@ -0,0 +1,82 @@
+#ifndef TEXT_FMT_H
+#define TEXT_FMT_H
+
+#include <stdint.h>
+
+/* ============================================================
+ * Text Formatting
+ * ============================================================
+ * Small number-to-ASCII routines for per-frame text (HUD, editor
+ * status), replacing vsnprintf on hot paths.
+ *
+ * Append style: each call writes at buf[pos], always NUL-terminates
+ * within cap, truncates instead of overflowing and returns the new
+ * end position. Calls chain:
+ *   pos = text_fmt_str(buf, sizeof(buf), 0, "dt: ");
+ *   pos = text_fmt_fixed(buf, sizeof(buf), pos, dt, 3);
+ *
+ * Portable C: no gsKit dependency.
+ * ============================================================ */
+
+/* Largest decimals accepted by text_fmt_fixed */
+#define TEXT_FMT_MAX_DECIMALS 6
+
+/* Append a string */
+int text_fmt_str(char *buf, int cap, int pos, const char *s);
+
+/* Append a single character */
+int text_fmt_char(char *buf, int cap, int pos, char c);
+
+/* Append an unsigned / signed decimal integer */
+int text_fmt_u32(char *buf, int cap, int pos, uint32_t v);
+int text_fmt_i32(char *buf, int cap, int pos, int32_t v);
+
+/* Append a float with a fixed number of decimals (0..6), rounded
+ * half away from zero. Matches "%.Nf" except that the last digit may
+ * differ by one past float precision (~7 significant digits). Prints
+ * "nan"/"inf" for non-finite values and "#" when the scaled value
+ * does not fit 32 bits. */
+int text_fmt_fixed(char *buf, int cap, int pos, float v, int decimals);
+
+/* ============================================================
+ * Retained Text Label
+ * ============================================================
+ * A prefix plus one bound value, kept formatted. Setting the value
+ * re-formats only when the displayed text would change (for fixed
+ * labels: when the rounded value changes), so a steady HUD line
+ * costs a compare per frame.
+ *
+ * Memory usage:
+ *   TextLabel: TEXT_LABEL_MAX + 12 = 44 bytes
+ * ============================================================ */
+#define TEXT_LABEL_MAX 32
+
+typedef enum {
+    TEXT_LABEL_U32 = 0,     /* prefix + u */
+    TEXT_LABEL_U32_PAIR,    /* prefix + a "/" b */
+    TEXT_LABEL_FIXED,       /* prefix + v with N decimals */
+    TEXT_LABEL_KIND_COUNT
+} TextLabelKind;
+
+typedef struct {
+    char     text[TEXT_LABEL_MAX];
+    uint32_t bound[2];          /* Displayed value(s); fixed: scaled integer */
+    uint8_t  prefix_len;
+    uint8_t  kind;              /* TextLabelKind */
+    uint8_t  decimals;          /* TEXT_LABEL_FIXED */
+    uint8_t  valid;             /* text matches bound */
+} TextLabel;
+
+/* Set prefix and kind; the label shows just the prefix until set */
+void text_label_init(TextLabel *label, const char *prefix,
+                     TextLabelKind kind, int decimals);
+
+/* Bind a value. Returns 1 if the text was re-formatted, 0 if unchanged. */
+int text_label_u32(TextLabel *label, uint32_t v);
+int text_label_u32_pair(TextLabel *label, uint32_t a, uint32_t b);
+int text_label_fixed(TextLabel *label, float v);
+
+/* Current text (always NUL-terminated) */
+const char *text_label_str(const TextLabel *label);
+
+#endif /* TEXT_FMT_H */
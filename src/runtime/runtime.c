@@ -57,6 +57,14 @@ void runtime_init(RuntimeContext *ctx)
     ctx->dt = 0.0f;
     ctx->frame = 0;
 
+    ctx->sample_dt = 0.0f;
+    ctx->block_size = 0;
+
+    ctx->frag_x = 0;
+    ctx->frag_y = 0;
+    ctx->frag_width = 0;
+    ctx->frag_height = 0;
+
     ctx->pad_lx = 0.0f;
     ctx->pad_ly = 0.0f;
     ctx->pad_rx = 0.0f;
@@ -105,6 +113,50 @@ void runtime_update_timing(RuntimeContext *ctx, float dt)
     ctx->frame++;
 }
 
+/* ============================================================
+ * Fixed-Step Clock
+ * ============================================================ */
+void runtime_stepper_init(RuntimeStepper *st, uint16_t rate_hz, uint16_t max_steps)
+{
+    if (st == NULL) {
+        return;
+    }
+
+    st->step_dt = 1.0f / (float)(rate_hz > 0 ? rate_hz : 1);
+    st->accum = 0.0f;
+    st->alpha = 0.0f;
+    st->max_steps = max_steps > 0 ? max_steps : 1;
+    st->steps = 0;
+    st->dropped = 0;
+}
+
+uint16_t runtime_stepper_advance(RuntimeStepper *st, float frame_dt)
+{
+    uint16_t steps = 0;
+
+    if (st == NULL) {
+        return 0;
+    }
+
+    if (frame_dt > 0.0f) {
+        st->accum += frame_dt;
+    }
+    while (st->accum >= st->step_dt && steps < st->max_steps) {
+        st->accum -= st->step_dt;
+        steps++;
+    }
+
+    /* Over the catch-up limit: keep only the part of a step */
+    while (st->accum >= st->step_dt) {
+        st->accum -= st->step_dt;
+        st->dropped++;
+    }
+
+    st->steps = steps;
+    st->alpha = st->accum / st->step_dt;
+    return steps;
+}
+
 /* ============================================================
  * Update Pad State
  * ============================================================ */
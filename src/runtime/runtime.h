@@ -41,6 +41,18 @@ typedef struct {
     float    dt;             /* Delta time since last frame (seconds) */
     uint32_t frame;          /* Frame counter */
 
+    /* Block evaluation (graph_eval_block); zero in frame mode.
+     * Sample i of a block is at time + i * sample_dt. */
+    float    sample_dt;      /* Seconds per sample */
+    uint16_t block_size;     /* Samples in the current block */
+
+    /* Fragment evaluation (graph_eval_fragment); zero otherwise.
+     * Lane i of a block is pixel (frag_x + i, frag_y). */
+    uint16_t frag_x;         /* Pixel column of lane 0 */
+    uint16_t frag_y;         /* Pixel row */
+    uint16_t frag_width;     /* Image size in pixels */
+    uint16_t frag_height;
+
     /* Controller (normalized values) */
     float    pad_lx;         /* Left stick X: -1.0 to 1.0 */
     float    pad_ly;         /* Left stick Y: -1.0 to 1.0 */
@@ -55,6 +67,25 @@ typedef struct {
     uint16_t buttons_released;/* Just released this frame (bitmask) */
 } RuntimeContext;
 
+/* ============================================================
+ * Fixed-Step Clock
+ * ============================================================
+ * Accumulates measured frame time and hands it out in whole steps
+ * of step_dt, so a simulation advances the same way at any frame
+ * rate. At most max_steps run per frame; time beyond that is
+ * dropped (the simulation slows down instead of spiralling).
+ * alpha is how far the clock is past the last step, in steps, for
+ * interpolating between the last two results.
+ * ============================================================ */
+typedef struct {
+    float    step_dt;        /* Seconds per step */
+    float    accum;          /* Time not yet stepped (< step_dt after advance) */
+    float    alpha;          /* accum / step_dt after the last advance */
+    uint16_t max_steps;      /* Catch-up limit per frame */
+    uint16_t steps;          /* Steps due from the last advance */
+    uint32_t dropped;        /* Steps dropped at the catch-up limit */
+} RuntimeStepper;
+
 /* ============================================================
  * Runtime API
  * ============================================================ */
@@ -79,6 +110,12 @@ void runtime_update_pad(RuntimeContext *ctx,
                         uint8_t l2, uint8_t r2,
                         uint16_t buttons);
 
+/* Set the step rate (Hz, > 0) and catch-up limit; clears the clock */
+void runtime_stepper_init(RuntimeStepper *st, uint16_t rate_hz, uint16_t max_steps);
+
+/* Add one frame's dt; returns the steps to run this frame */
+uint16_t runtime_stepper_advance(RuntimeStepper *st, float frame_dt);
+
 /* Helper: check if button is currently held */
 int runtime_button_held(const RuntimeContext *ctx, uint16_t btn);
 
@@ -0,0 +1,56 @@
+#ifndef CYCLES_H
+#define CYCLES_H
+
+#include <stdint.h>
+
+/* ============================================================
+ * Cycle Counter
+ * ============================================================
+ * Free-running counter for measuring short intervals.
+ * EE: COP0 Count register (CPU clock, 294.912 MHz, wraps ~14.5s).
+ * Host: CLOCK_MONOTONIC in microseconds, deliberately wrapped to
+ * 32 bits (~71min). Host translation units define _POSIX_C_SOURCE
+ * 199309L before their first system header.
+ * Always subtract as uint32_t so wraparound cancels out.
+ * ============================================================ */
+#ifdef _EE
+
+#define LGS_CYCLES_PER_SEC  294912000u
+
+static inline uint32_t lgs_cycles_now(void)
+{
+    uint32_t count;
+    __asm__ __volatile__("mfc0 %0, $9" : "=r"(count));
+    return count;
+}
+
+#else
+
+#include <time.h>
+
+#define LGS_CYCLES_PER_SEC  1000000u
+
+static inline uint32_t lgs_cycles_now(void)
+{
+    struct timespec ts;
+    uint64_t us;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    us = (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+    return (uint32_t)(us & 0xFFFFFFFFu);
+}
+
+#endif
+
+/* Convert between microseconds and counter ticks */
+static inline uint32_t lgs_cycles_from_us(uint32_t us)
+{
+    return (uint32_t)(((uint64_t)us * LGS_CYCLES_PER_SEC) / 1000000u);
+}
+
+static inline uint32_t lgs_cycles_to_us(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000000u) / LGS_CYCLES_PER_SEC);
+}
+
+#endif /* CYCLES_H */
@@ -0,0 +1,310 @@
+/* Host builds read CLOCK_MONOTONIC (cycles.h); must precede any system header */
+#if !defined(_EE) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "profiler.h"
+
+#ifdef LGS_FRAME_PROFILER
+
+#include <stdio.h>
+#include <string.h>
+#include "cycles.h"
+
+#define PROF_TICKS_PER_US   ((double)LGS_CYCLES_PER_SEC / 1000000.0)
+
+#ifdef _EE
+#define PROF_TLS                        /* One EE thread is profiled */
+#else
+#define PROF_TLS            __thread
+#endif
+
+#define PROF_RING_MASK      (PROF_RING_EVENTS - 1)
+#define PROF_EXPORT_PATH_MAX 64
+
+/* ============================================================
+ * Static State
+ * ============================================================ */
+typedef struct {
+    uint64_t start;             /* Ticks */
+    uint32_t dur;               /* Ticks, saturated */
+    uint16_t frame;             /* Low bits of the frame it closed in */
+    uint8_t  zone;
+    uint8_t  depth;
+} ProfEvent;
+
+typedef struct {
+    uint64_t start;
+    uint64_t child;             /* Ticks spent in nested zones */
+    uint8_t  zone;
+} ProfOpen;
+
+typedef struct {
+    ProfEvent         events[PROF_RING_EVENTS];
+    volatile uint32_t head;     /* Events written; only the owner stores */
+    ProfOpen          open[PROF_STACK_MAX];
+    uint8_t           depth;
+    uint64_t          self[PROF_ZONE_COUNT];    /* This frame, main thread */
+    char              name[PROF_NAME_MAX];
+} ProfThread;
+
+static ProfThread s_threads[PROF_MAX_THREADS];
+static volatile uint32_t s_thread_count = 0;
+static PROF_TLS ProfThread *t_prof = NULL;
+
+static volatile uint32_t s_frame = 0;
+static volatile uint64_t s_clock_last = 0;
+static uint64_t s_base = 0;
+static ProfHistory s_history;
+
+static char s_export_path[PROF_EXPORT_PATH_MAX];
+static uint32_t s_export_frames = 0;
+static int s_export_pending = 0;
+static int s_export_status = 0;
+
+static const char *s_zone_names[PROF_ZONE_COUNT] = {
+    "FRAME", "TIMING", "PAD", "EDITOR", "EVAL", "RENDER",
+    "SINKS", "UI", "FLIP", "QUEUE", "WRITE"
+};
+
+/* ============================================================
+ * Clock
+ * ============================================================
+ * Widens lgs_cycles_now() against the latest reading of any thread,
+ * so readings taken out of order on different threads still land
+ * on one 64-bit timeline. Correct while the main thread reads it
+ * (every frame) more often than every half wrap.
+ * ============================================================ */
+static uint64_t prof_now(void)
+{
+    uint64_t last = s_clock_last;
+    uint32_t delta = lgs_cycles_now() - (uint32_t)last;
+    uint64_t now = last + (uint64_t)(int64_t)(int32_t)delta;
+
+    if (now > last) {
+        s_clock_last = now;
+    }
+    return now;
+}
+
+static float prof_ticks_to_ms(uint64_t ticks)
+{
+    return (float)((double)ticks / (PROF_TICKS_PER_US * 1000.0));
+}
+
+/* ============================================================
+ * Init
+ * ============================================================ */
+void profiler_init(void)
+{
+    memset(s_threads, 0, sizeof(s_threads));
+    memset(&s_history, 0, sizeof(s_history));
+    s_thread_count = 0;
+    s_frame = 0;
+    s_export_pending = 0;
+    s_export_status = 0;
+    s_clock_last = lgs_cycles_now();
+    s_base = prof_now();
+    profiler_register_thread("main");
+}
+
+int profiler_register_thread(const char *name)
+{
+    uint32_t slot = __sync_fetch_and_add(&s_thread_count, 1u);
+    ProfThread *t;
+
+    if (slot >= PROF_MAX_THREADS) {
+        return -1;
+    }
+    t = &s_threads[slot];
+    t->head = 0;
+    t->depth = 0;
+    strncpy(t->name, name ? name : "thread", PROF_NAME_MAX - 1);
+    t->name[PROF_NAME_MAX - 1] = '\0';
+    t_prof = t;
+    return 0;
+}
+
+/* ============================================================
+ * Zones
+ * ============================================================ */
+void profiler_begin(ProfZone zone)
+{
+    ProfThread *t = t_prof;
+    ProfOpen *o;
+
+    if (!t || t->depth >= PROF_STACK_MAX) {
+        return;
+    }
+    o = &t->open[t->depth++];
+    o->zone = (uint8_t)zone;
+    o->child = 0;
+    o->start = prof_now();
+}
+
+void profiler_end(ProfZone zone)
+{
+    ProfThread *t = t_prof;
+    ProfOpen *o;
+    ProfEvent *ev;
+    uint64_t now, dur;
+    uint32_t head;
+
+    if (!t || t->depth == 0 || t->open[t->depth - 1].zone != (uint8_t)zone) {
+        return;     /* Unregistered, or ends a zone it did not open */
+    }
+    now = prof_now();
+    o = &t->open[--t->depth];
+    dur = now - o->start;
+    t->self[zone] += dur - o->child;
+    if (t->depth > 0) {
+        t->open[t->depth - 1].child += dur;
+    }
+
+    /* Fill the slot, then publish it */
+    head = t->head;
+    ev = &t->events[head & PROF_RING_MASK];
+    ev->start = o->start;
+    ev->dur = dur > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)dur;
+    ev->frame = (uint16_t)s_frame;
+    ev->zone = (uint8_t)zone;
+    ev->depth = t->depth;
+    __sync_synchronize();
+    t->head = head + 1;
+}
+
+/* ============================================================
+ * Frames
+ * ============================================================ */
+void profiler_frame_begin(void)
+{
+    profiler_begin(PROF_ZONE_FRAME);
+}
+
+void profiler_frame_end(void)
+{
+    ProfThread *t = &s_threads[0];
+    float *ms = s_history.ms[s_history.head];
+    float total = 0.0f;
+    int z;
+
+    profiler_end(PROF_ZONE_FRAME);
+
+    for (z = 0; z < PROF_ZONE_COUNT; z++) {
+        ms[z] = prof_ticks_to_ms(t->self[z]);
+        total += ms[z];
+        t->self[z] = 0;
+    }
+    s_history.frame_ms[s_history.head] = total;
+    s_history.head = (uint16_t)((s_history.head + 1) % PROF_HISTORY);
+    if (s_history.count < PROF_HISTORY) {
+        s_history.count++;
+    }
+    s_frame++;
+
+    if (s_export_pending) {
+        s_export_pending = 0;
+        s_export_status = profiler_export_chrome(s_export_path, s_export_frames) == 0 ? 1 : -1;
+    }
+}
+
+uint32_t profiler_frame(void)
+{
+    return s_frame;
+}
+
+const ProfHistory *profiler_history(void)
+{
+    return &s_history;
+}
+
+const char *profiler_zone_name(ProfZone zone)
+{
+    return (unsigned)zone < PROF_ZONE_COUNT ? s_zone_names[zone] : "?";
+}
+
+/* ============================================================
+ * Chrome Trace Export
+ * ============================================================
+ * One "X" (complete) event per zone, "M" events naming the
+ * threads. Events are read oldest first; any the owner overwrote
+ * while being copied are dropped.
+ * ============================================================ */
+int profiler_export_chrome(const char *path, uint32_t frames)
+{
+    uint32_t count = s_thread_count;
+    uint16_t now_frame = (uint16_t)s_frame;
+    const char *sep = "";
+    uint32_t tid;
+    FILE *f;
+    int ok;
+
+    if (!path) {
+        return -1;
+    }
+    f = fopen(path, "w");
+    if (!f) {
+        return -1;
+    }
+    if (count > PROF_MAX_THREADS) {
+        count = PROF_MAX_THREADS;
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (tid = 0; tid < count; tid++) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                   "\"args\":{\"name\":\"%s\"}}",
+                sep, (unsigned)tid, s_threads[tid].name);
+        sep = ",\n";
+    }
+
+    for (tid = 0; tid < count; tid++) {
+        const ProfThread *t = &s_threads[tid];
+        uint32_t head = t->head;
+        uint32_t i = head > PROF_RING_EVENTS ? head - PROF_RING_EVENTS : 0;
+
+        __sync_synchronize();
+        for (; i != head; i++) {
+            ProfEvent ev = t->events[i & PROF_RING_MASK];
+
+            __sync_synchronize();
+            if (t->head - i >= PROF_RING_EVENTS) {
+                continue;   /* Lapped while copying */
+            }
+            if ((uint16_t)(now_frame - ev.frame) > frames || ev.zone >= PROF_ZONE_COUNT) {
+                continue;
+            }
+            fprintf(f, "%s{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,"
+                       "\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u}}",
+                    sep, s_zone_names[ev.zone], (unsigned)tid,
+                    (double)(ev.start - s_base) / PROF_TICKS_PER_US,
+                    (double)ev.dur / PROF_TICKS_PER_US, (unsigned)ev.frame);
+        }
+    }
+    fprintf(f, "\n]}\n");
+
+    ok = !ferror(f);
+    if (fclose(f) != 0) {
+        ok = 0;
+    }
+    return ok ? 0 : -1;
+}
+
+void profiler_request_export(const char *path, uint32_t frames)
+{
+    if (!path) {
+        return;
+    }
+    strncpy(s_export_path, path, sizeof(s_export_path) - 1);
+    s_export_path[sizeof(s_export_path) - 1] = '\0';
+    s_export_frames = frames;
+    s_export_status = 0;
+    s_export_pending = 1;
+}
+
+int profiler_export_status(void)
+{
+    return s_export_status;
+}
+
+#endif /* LGS_FRAME_PROFILER */
@@ -0,0 +1,116 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+/* ============================================================
+ * Frame Profiler (LGS_FRAME_PROFILER builds only)
+ * ============================================================
+ * Scoped zones around the stages of a frame. Each thread that
+ * registers owns a ring of completed zones (start, duration, frame
+ * number); only that thread writes it, and a reader copies events
+ * without locking and drops any the writer may have lapped while it
+ * read. The main thread is registered by profiler_init().
+ *
+ * profiler_frame_end() also folds the main thread's zones into a
+ * history of per-stage self time (a zone's time minus the zones
+ * nested in it), so a frame's stages stack up to its full length.
+ * The untimed rest of the frame is counted against PROF_ZONE_FRAME.
+ *
+ * profiler_export_chrome() writes the last frames of every ring as
+ * Chrome trace-event JSON (chrome://tracing, Perfetto). A requested
+ * export runs at the next profiler_frame_end(), after that frame's
+ * zones are closed.
+ *
+ * Times are lgs_cycles_now() ticks (COP0 cycles on the EE,
+ * microseconds on hosts) widened to 64 bits and converted to
+ * microseconds only when reported.
+ *
+ * Without LGS_FRAME_PROFILER the zone macros expand to nothing and
+ * this header declares nothing else.
+ *
+ * Memory usage:
+ *   Rings: PROF_MAX_THREADS * PROF_RING_EVENTS * 16 = 128KB
+ *   History: PROF_HISTORY * (PROF_ZONE_COUNT + 1) * 4 = ~6KB
+ * ============================================================ */
+#ifdef LGS_FRAME_PROFILER
+
+#define PROF_MAX_THREADS    4
+#define PROF_RING_EVENTS    2048    /* Per thread, power of two */
+#define PROF_STACK_MAX      8       /* Nested zones per thread */
+#define PROF_HISTORY        128     /* Frames in the on-screen graph */
+#define PROF_NAME_MAX       16
+#define PROF_EXPORT_FRAMES  120     /* Frames the editor's export writes */
+
+typedef enum {
+    PROF_ZONE_FRAME = 0,    /* Whole frame; self time is the untimed rest */
+    PROF_ZONE_TIMING,       /* timing_update */
+    PROF_ZONE_PAD,          /* pad_update */
+    PROF_ZONE_EDITOR,       /* editor_update and plan rebuild */
+    PROF_ZONE_EVAL,         /* graph_eval / slicer step */
+    PROF_ZONE_RENDER,       /* Display list build, HUD */
+    PROF_ZONE_SINKS,        /* render_sinks */
+    PROF_ZONE_UI,           /* editor_draw */
+    PROF_ZONE_FLIP,         /* render_end_frame: flush, kick, vsync */
+    PROF_ZONE_QUEUE,        /* Waiting on a full frame queue (host tools) */
+    PROF_ZONE_WRITE,        /* Encoding and writing a frame (host tools) */
+    PROF_ZONE_COUNT
+} ProfZone;
+
+typedef struct {
+    float    ms[PROF_HISTORY][PROF_ZONE_COUNT]; /* Self time per stage */
+    float    frame_ms[PROF_HISTORY];            /* Whole frame */
+    uint16_t head;                              /* Next frame written */
+    uint16_t count;                             /* Valid frames */
+} ProfHistory;
+
+#define LGS_PROF_BEGIN(zone)    profiler_begin(zone)
+#define LGS_PROF_END(zone)      profiler_end(zone)
+#define LGS_PROF_FRAME_BEGIN()  profiler_frame_begin()
+#define LGS_PROF_FRAME_END()    profiler_frame_end()
+
+/* Clear every ring and the history, register the caller as "main" */
+void profiler_init(void);
+
+/* Give the calling thread a ring; returns 0, or -1 if all are taken */
+int profiler_register_thread(const char *name);
+
+/* Open and close a zone on the calling thread (no-op if unregistered) */
+void profiler_begin(ProfZone zone);
+void profiler_end(ProfZone zone);
+
+/* Bracket one frame of the main thread */
+void profiler_frame_begin(void);
+void profiler_frame_end(void);
+
+/* Frames completed so far */
+uint32_t profiler_frame(void);
+
+/* Per-stage history of the main thread */
+const ProfHistory *profiler_history(void);
+
+/* Display name of a zone */
+const char *profiler_zone_name(ProfZone zone);
+
+/* Write the zones of the last frames frames (and any closed since)
+ * from every thread's ring as trace-event JSON. Returns 0, or -1 if
+ * the file could not be written. The write is charged to whatever
+ * zone is open; profiler_request_export() defers it to frame end. */
+int profiler_export_chrome(const char *path, uint32_t frames);
+
+/* Export at the end of the current frame (path is copied) */
+void profiler_request_export(const char *path, uint32_t frames);
+
+/* Result of the last requested export: 1 written, -1 failed, 0 none yet */
+int profiler_export_status(void);
+
+#else
+
+#define LGS_PROF_BEGIN(zone)    ((void)0)
+#define LGS_PROF_END(zone)      ((void)0)
+#define LGS_PROF_FRAME_BEGIN()  ((void)0)
+#define LGS_PROF_FRAME_END()    ((void)0)
+
+#endif /* LGS_FRAME_PROFILER */
+
+#endif /* PROFILER_H */
@@ -1,11 +1,21 @@
+/* Host builds read CLOCK_MONOTONIC (cycles.h); must precede any system header */
+#if !defined(_EE) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include "timing.h"
+
+#include "cycles.h"
+
+#ifdef _EE
 #include <kernel.h>
 #include <graph.h>
+#endif
 
 /* ============================================================
  * Static State
  * ============================================================
- * Memory usage: ~32 bytes
+ * Memory usage: ~0.6KB (frame time window)
  * ============================================================ */
 static TimingMode s_mode = TIMING_MODE_NTSC;
 static float s_dt = 0.0f;
@@ -16,6 +26,79 @@ static float s_dt_max = TIMING_DT_MAX;
 static int s_target_fps = TIMING_TARGET_FPS_NTSC;
 static int s_initialized = 0;
 
+static uint32_t s_last_ticks = 0;
+static int s_have_last = 0;                 /* s_last_ticks is valid */
+static uint32_t s_period_us = 1000000u / TIMING_TARGET_FPS_NTSC;
+
+static uint32_t s_frame_us[TIMING_STATS_FRAMES];
+static uint16_t s_stats_head = 0;
+static uint16_t s_stats_count = 0;
+static uint16_t s_jitter[TIMING_JITTER_BINS];
+static uint32_t s_missed = 0;
+
+/* ============================================================
+ * Clock
+ * ============================================================
+ * Ticks are only ever subtracted, so the 32-bit wrap (~14.5s of
+ * COP0 cycles, ~71min of host microseconds) cancels out.
+ * ============================================================ */
+static uint32_t timing_ticks(void)
+{
+    return lgs_cycles_now();
+}
+
+static uint32_t timing_ticks_to_us(uint32_t ticks)
+{
+    return lgs_cycles_to_us(ticks);
+}
+
+/* ============================================================
+ * Statistics
+ * ============================================================ */
+static int timing_jitter_bin(uint32_t us)
+{
+    uint32_t dev = us > s_period_us ? us - s_period_us : s_period_us - us;
+    uint32_t edge = TIMING_JITTER_FIRST_US;
+    int bin = 0;
+
+    while (bin < TIMING_JITTER_BINS - 1 && dev >= edge) {
+        edge <<= 1;
+        bin++;
+    }
+    return bin;
+}
+
+static void timing_stats_clear(void)
+{
+    int i;
+
+    s_stats_head = 0;
+    s_stats_count = 0;
+    s_missed = 0;
+    for (i = 0; i < TIMING_JITTER_BINS; i++) {
+        s_jitter[i] = 0;
+    }
+}
+
+static void timing_stats_record(uint32_t us)
+{
+    if (s_stats_count == TIMING_STATS_FRAMES) {
+        s_jitter[timing_jitter_bin(s_frame_us[s_stats_head])]--;
+    } else {
+        s_stats_count++;
+    }
+    s_frame_us[s_stats_head] = us;
+    s_jitter[timing_jitter_bin(us)]++;
+    if (++s_stats_head == TIMING_STATS_FRAMES) {
+        s_stats_head = 0;
+    }
+
+    /* Vsyncs missed: periods the frame overran, rounded */
+    if (us > s_period_us + s_period_us / 2) {
+        s_missed += (us + s_period_us / 2) / s_period_us - 1;
+    }
+}
+
 /* ============================================================
  * Initialize Timing
  * ============================================================ */
@@ -33,6 +116,9 @@ void timing_init(TimingMode mode)
     } else {
         s_target_fps = TIMING_TARGET_FPS_NTSC;
     }
+    s_period_us = 1000000u / (uint32_t)s_target_fps;
+    s_have_last = 0;
+    timing_stats_clear();
 
     s_initialized = 1;
 }
@@ -40,23 +126,30 @@ void timing_init(TimingMode mode)
 /* ============================================================
  * Update Timing
  * ============================================================
- * Calculates dt based on target framerate.
- * VSync is handled by gsKit (gsKit_sync_flip), so we don't
- * call graph_wait_vsync here to avoid double-waiting.
+ * Measures the time since the previous call. VSync is handled by
+ * gsKit (gsKit_sync_flip), so we don't call graph_wait_vsync here
+ * to avoid double-waiting; the wait is part of the measured frame.
  * ============================================================ */
 float timing_update(void)
 {
     float frame_time;
+    uint32_t now;
 
     if (!s_initialized) {
         timing_init(TIMING_MODE_NTSC);
     }
 
-    /* Note: VSync wait is handled by gsKit_sync_flip in render_end_frame */
-    /* We just calculate dt based on target fps */
-
-    /* Each frame should be 1/fps */
-    frame_time = 1.0f / (float)s_target_fps;
+    now = timing_ticks();
+    if (s_have_last) {
+        uint32_t us = timing_ticks_to_us(now - s_last_ticks);
+        timing_stats_record(us);
+        frame_time = (float)us * 1e-6f;
+    } else {
+        /* First frame: nothing to measure yet */
+        frame_time = 1.0f / (float)s_target_fps;
+    }
+    s_last_ticks = now;
+    s_have_last = 1;
 
     /* Clamp dt to prevent physics explosions */
     if (frame_time < s_dt_min) {
@@ -126,4 +219,73 @@ void timing_set_dt_bounds(float dt_min, float dt_max)
 void timing_reset(void)
 {
     s_dt = 1.0f / (float)s_target_fps;
+    s_have_last = 0;
+    timing_stats_clear();
+}
+
+/* ============================================================
+ * Get Statistics
+ * ============================================================
+ * p99 is the k-th longest frame of the window, k = 1% rounded up,
+ * found with a short sorted list instead of sorting the window.
+ * ============================================================ */
+#define TIMING_P99_MAX  (TIMING_STATS_FRAMES / 100 + 1)
+
+void timing_get_stats(TimingStats *out)
+{
+    uint32_t top[TIMING_P99_MAX];
+    uint32_t lo = 0xFFFFFFFFu, hi = 0;
+    uint64_t sum = 0;
+    int k, kept = 0;
+    int i;
+
+    if (!out) {
+        return;
+    }
+
+    out->frames = s_stats_count;
+    out->missed_vsyncs = s_missed;
+    for (i = 0; i < TIMING_JITTER_BINS; i++) {
+        out->jitter[i] = s_jitter[i];
+    }
+    if (s_stats_count == 0) {
+        out->min_ms = out->avg_ms = out->max_ms = out->p99_ms = 0.0f;
+        out->fps = 0.0f;
+        return;
+    }
+
+    k = (s_stats_count + 99) / 100;
+    for (i = 0; i < s_stats_count; i++) {
+        uint32_t us = s_frame_us[i];
+        int pos;
+
+        sum += us;
+        lo = us < lo ? us : lo;
+        hi = us > hi ? us : hi;
+
+        /* Keep the k longest, longest first */
+        if (kept == k && us <= top[k - 1]) {
+            continue;
+        }
+        pos = kept < k ? kept++ : k - 1;
+        while (pos > 0 && us > top[pos - 1]) {
+            top[pos] = top[pos - 1];
+            pos--;
+        }
+        top[pos] = us;
+    }
+
+    out->min_ms = (float)lo * 0.001f;
+    out->max_ms = (float)hi * 0.001f;
+    out->avg_ms = (float)sum * 0.001f / (float)s_stats_count;
+    out->p99_ms = (float)top[k - 1] * 0.001f;
+    out->fps = 1000.0f / out->avg_ms;
+}
+
+uint32_t timing_jitter_edge_us(int bin)
+{
+    if (bin < 0 || bin >= TIMING_JITTER_BINS - 1) {
+        return 0;
+    }
+    return (uint32_t)TIMING_JITTER_FIRST_US << bin;
 }
@@ -1,12 +1,23 @@
 #ifndef TIMING_H
 #define TIMING_H
 
+#include <stdint.h>
+
 /* ============================================================
  * Timing Module
  * ============================================================
- * VBlank-based timing for consistent frame pacing.
- * Provides delta time calculation with clamping to prevent
- * physics explosions from large dt spikes.
+ * Measured frame timing. timing_update() is called once per frame
+ * and times the whole previous frame, including the vsync wait in
+ * render_end_frame, with the COP0 Count register on the EE and the
+ * monotonic clock on hosts. dt is clamped to prevent physics
+ * explosions from large spikes.
+ *
+ * The last TIMING_STATS_FRAMES frame times are kept for pacing
+ * statistics: min/avg/max, the 99th percentile, and a histogram of
+ * each frame's distance from the target period (jitter). Frames that
+ * ran past half a period late count the vsyncs they missed.
+ *
+ * Memory usage: TIMING_STATS_FRAMES * 4 + ~80 bytes = ~0.6KB
  * ============================================================ */
 
 /* Default timing constants */
@@ -15,12 +26,28 @@
 #define TIMING_DT_MIN           0.001f    /* 1ms minimum */
 #define TIMING_DT_MAX           0.1f      /* 100ms maximum (10 FPS floor) */
 
+/* Pacing statistics */
+#define TIMING_STATS_FRAMES     128       /* Rolling window */
+#define TIMING_JITTER_BINS      8
+#define TIMING_JITTER_FIRST_US  250       /* Bin edges double from here */
+
 /* Video mode enumeration */
 typedef enum {
     TIMING_MODE_NTSC = 0,
     TIMING_MODE_PAL
 } TimingMode;
 
+typedef struct {
+    float    min_ms;                        /* Over the window */
+    float    avg_ms;
+    float    max_ms;
+    float    p99_ms;
+    float    fps;                           /* 1000 / avg_ms, 0 if no frames */
+    uint32_t frames;                        /* Frames in the window */
+    uint32_t missed_vsyncs;                 /* Since init or reset */
+    uint16_t jitter[TIMING_JITTER_BINS];    /* Frames per |time - period| bin */
+} TimingStats;
+
 /* ============================================================
  * Timing API
  * ============================================================ */
@@ -29,8 +56,9 @@ typedef enum {
  * mode: NTSC (60Hz) or PAL (50Hz) */
 void timing_init(TimingMode mode);
 
-/* Wait for next VBlank and update timing.
- * Returns delta time in seconds (clamped). */
+/* Time the frame since the previous call (vsync is waited for in
+ * render_end_frame). Returns delta time in seconds (clamped); the
+ * first call after init or reset returns one target period. */
 float timing_update(void);
 
 /* Get current delta time (from last update) */
@@ -48,7 +76,14 @@ int timing_get_target_fps(void);
 /* Set dt clamping bounds */
 void timing_set_dt_bounds(float dt_min, float dt_max);
 
-/* Reset timing (e.g., after pause/unpause) */
+/* Reset timing (e.g., after pause/unpause): the next frame is not
+ * measured and the statistics start over */
 void timing_reset(void);
 
+/* Statistics over the last TIMING_STATS_FRAMES measured frames */
+void timing_get_stats(TimingStats *out);
+
+/* Upper edge of a jitter bin in microseconds (0 for the last, open bin) */
+uint32_t timing_jitter_edge_us(int bin);
+
 #endif /* TIMING_H */
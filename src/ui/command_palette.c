@@ -3,8 +3,12 @@
 #include "../graph/graph_core.h"
 #include "../graph/graph_validate.h"
 #include "../graph/graph_publish.h"
+#include "../graph/graph_eval.h"
+#include "../graph/graph_eval_fixed.h"
 #include "../io/graph_io.h"
 #include "../nodes/node_registry.h"
+#include "../render/render.h"
+#include "../system/profiler.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -47,6 +51,16 @@ static void cmd_validate(CmdPaletteContext *ctx);
 static void cmd_save_graph(CmdPaletteContext *ctx);
 static void cmd_load_graph(CmdPaletteContext *ctx);
 static void cmd_clear_selection(CmdPaletteContext *ctx);
+static void cmd_cycle_rate(CmdPaletteContext *ctx);
+static void cmd_branch_policy(CmdPaletteContext *ctx);
+static void cmd_sim_rate(CmdPaletteContext *ctx);
+static void cmd_resolution(CmdPaletteContext *ctx);
+#ifdef LGS_NODE_PROFILER
+static void cmd_node_profiler(CmdPaletteContext *ctx);
+#endif
+#ifdef LGS_FRAME_PROFILER
+static void cmd_export_trace(CmdPaletteContext *ctx);
+#endif
 
 /* ============================================================
  * Static Command Table
@@ -61,11 +75,21 @@ static const CommandDef s_commands[] = {
     { "Delete Node",      cmd_has_selection,               cmd_delete_node },
     { "Duplicate Node",   cmd_has_selection,               cmd_duplicate_node },
     { "Clear Selection",  cmd_has_selection,               cmd_clear_selection },
+    { "Update Rate",      cmd_has_selection,               cmd_cycle_rate },
 
     /* Graph Operations */
     { "Commit Edits",     cmd_always_enabled,              cmd_commit },
     { "Revert Edits",     cmd_has_active_graph,            cmd_revert },
     { "Validate Graph",   cmd_always_enabled,              cmd_validate },
+    { "Branch Policy",    cmd_always_enabled,              cmd_branch_policy },
+    { "Sim Rate",         cmd_always_enabled,              cmd_sim_rate },
+    { "Resolution",       cmd_always_enabled,              cmd_resolution },
+#ifdef LGS_NODE_PROFILER
+    { "Node Profiler",    cmd_always_enabled,              cmd_node_profiler },
+#endif
+#ifdef LGS_FRAME_PROFILER
+    { "Export Trace",     cmd_always_enabled,              cmd_export_trace },
+#endif
 
     /* Session */
     { "Save Graph",       cmd_always_enabled,              cmd_save_graph },
@@ -180,10 +204,12 @@ static void cmd_duplicate_node(CmdPaletteContext *ctx)
 
     dst = &state->edit_graph.nodes[new_id];
 
-    /* Copy parameters (but not connections) */
+    /* Copy parameters and update rate (but not connections) */
     for (i = 0; i < MAX_PARAMS; i++) {
         dst->params[i] = src->params[i];
     }
+    dst->rate_mode = src->rate_mode;
+    dst->rate_div = src->rate_div;
 
     /* Position offset from source */
     state->ui_meta.meta[new_id].x = state->ui_meta.meta[src_id].x + 30.0f;
@@ -204,6 +230,197 @@ static void cmd_clear_selection(CmdPaletteContext *ctx)
     ctx->state->ui.selected_node = INVALID_NODE_ID;
 }
 
+/* ============================================================
+ * cmd_cycle_rate: every frame -> 1/2 -> 1/4 -> 1/8 -> 1/16
+ *                 -> on change -> every frame
+ * ============================================================ */
+static void cmd_cycle_rate(CmdPaletteContext *ctx)
+{
+    EditorState *state;
+    Node *node;
+
+    if (!ctx || !ctx->state) return;
+    state = ctx->state;
+    if (!cmd_has_selection(ctx)) return;
+
+    node = &state->edit_graph.nodes[state->ui.selected_node];
+
+    if (node->rate_mode == NODE_RATE_EVERY_FRAME) {
+        node->rate_mode = NODE_RATE_DIVIDED;
+        node->rate_div = 2;
+    } else if (node->rate_mode == NODE_RATE_DIVIDED && node->rate_div < 16) {
+        node->rate_div = (uint8_t)(node->rate_div < 2 ? 2 : node->rate_div * 2);
+    } else if (node->rate_mode == NODE_RATE_DIVIDED) {
+        node->rate_mode = NODE_RATE_ON_CHANGE;
+        node->rate_div = 1;
+    } else {
+        node->rate_mode = NODE_RATE_EVERY_FRAME;
+        node->rate_div = 1;
+    }
+    state->ui.edit_dirty = 1;
+
+    if (node->rate_mode == NODE_RATE_DIVIDED) {
+        snprintf(state->ui.banner_text, sizeof(state->ui.banner_text),
+                 "RATE: EVERY %u FRAMES", (unsigned)node->rate_div);
+    } else if (node->rate_mode == NODE_RATE_ON_CHANGE) {
+        snprintf(state->ui.banner_text, sizeof(state->ui.banner_text), "RATE: ON CHANGE");
+    } else {
+        snprintf(state->ui.banner_text, sizeof(state->ui.banner_text), "RATE: EVERY FRAME");
+    }
+    state->ui.banner_timer = BANNER_TIMEOUT_SEC;
+    state->ui.banner_error = 0;
+}
+
+/* ============================================================
+ * cmd_branch_policy: Toggle freeze/tick for stateful nodes in
+ *                    unselected SELECT/GATE branches
+ * ============================================================ */
+static void cmd_branch_policy(CmdPaletteContext *ctx)
+{
+    EditorState *state;
+    BranchPolicy policy;
+
+    if (!ctx || !ctx->state) return;
+    state = ctx->state;
+
+    policy = (graph_eval_get_branch_policy() == BRANCH_POLICY_FREEZE) ?
+             BRANCH_POLICY_TICK : BRANCH_POLICY_FREEZE;
+    graph_eval_set_branch_policy(policy);
+
+    snprintf(state->ui.banner_text, sizeof(state->ui.banner_text), "BRANCHES: %s",
+             policy == BRANCH_POLICY_TICK ? "TICK STATEFUL" : "FREEZE");
+    state->ui.banner_timer = BANNER_TIMEOUT_SEC;
+    state->ui.banner_error = 0;
+}
+
+/* ============================================================
+ * cmd_sim_rate: Cycle the fixed simulation rate
+ * ============================================================ */
+static const uint16_t s_sim_rates[] = {
+    EVAL_STEP_RATE_FRAME, 30, 60, 120, 240
+};
+
+static void cmd_sim_rate(CmdPaletteContext *ctx)
+{
+    EditorState *state;
+    uint16_t rate = graph_eval_get_sim_rate();
+    size_t i, count = sizeof(s_sim_rates) / sizeof(s_sim_rates[0]);
+
+    if (!ctx || !ctx->state) return;
+    state = ctx->state;
+
+    for (i = 0; i < count; i++) {
+        if (s_sim_rates[i] == rate) {
+            break;
+        }
+    }
+    rate = s_sim_rates[(i + 1) % count];
+    graph_eval_set_sim_rate(rate);
+
+    if (rate == EVAL_STEP_RATE_FRAME) {
+        snprintf(state->ui.banner_text, sizeof(state->ui.banner_text), "SIM RATE: PER FRAME");
+    } else {
+        snprintf(state->ui.banner_text, sizeof(state->ui.banner_text), "SIM RATE: %u HZ",
+                 (unsigned)rate);
+    }
+    state->ui.banner_timer = BANNER_TIMEOUT_SEC;
+    state->ui.banner_error = 0;
+}
+
+/* ============================================================
+ * cmd_resolution: Cycle internal resolution and upscale filter
+ * ============================================================ */
+static const struct {
+    uint8_t divisor;
+    uint8_t filter;     /* RenderFilter */
+} s_resolutions[] = {
+    { 1, RENDER_FILTER_NEAREST },
+    { 2, RENDER_FILTER_BILINEAR },
+    { 2, RENDER_FILTER_NEAREST },
+    { 3, RENDER_FILTER_BILINEAR },
+    { 3, RENDER_FILTER_NEAREST },
+    { 4, RENDER_FILTER_BILINEAR },
+    { 4, RENDER_FILTER_NEAREST },
+};
+
+static void cmd_resolution(CmdPaletteContext *ctx)
+{
+    EditorState *state;
+    int divisor = render_get_scale();
+    RenderFilter filter = render_get_scale_filter();
+    size_t i, count = sizeof(s_resolutions) / sizeof(s_resolutions[0]);
+
+    if (!ctx || !ctx->state) return;
+    state = ctx->state;
+
+    for (i = 0; i < count; i++) {
+        if (s_resolutions[i].divisor == divisor &&
+            (divisor == 1 || s_resolutions[i].filter == filter)) {
+            break;
+        }
+    }
+    i = (i + 1) % count;
+    divisor = s_resolutions[i].divisor;
+    filter = (RenderFilter)s_resolutions[i].filter;
+
+    if (render_set_scale(divisor, filter) != 0) {
+        snprintf(state->ui.banner_text, sizeof(state->ui.banner_text),
+                 "RESOLUTION: NOT SUPPORTED");
+        state->ui.banner_error = 1;
+    } else if (divisor == 1) {
+        snprintf(state->ui.banner_text, sizeof(state->ui.banner_text), "RESOLUTION: FULL");
+        state->ui.banner_error = 0;
+    } else {
+        snprintf(state->ui.banner_text, sizeof(state->ui.banner_text), "RESOLUTION: 1/%d %s",
+                 divisor, filter == RENDER_FILTER_BILINEAR ? "BILINEAR" : "NEAREST");
+        state->ui.banner_error = 0;
+    }
+    state->ui.banner_timer = BANNER_TIMEOUT_SEC;
+}
+
+#ifdef LGS_NODE_PROFILER
+/* ============================================================
+ * cmd_node_profiler: Show/hide node cost tints and top list
+ * ============================================================ */
+static void cmd_node_profiler(CmdPaletteContext *ctx)
+{
+    EditorState *state;
+    int shown;
+
+    if (!ctx || !ctx->state) return;
+    state = ctx->state;
+
+    shown = ui_editor_toggle_profile();
+
+    snprintf(state->ui.banner_text, sizeof(state->ui.banner_text), "PROFILER: %s",
+             shown ? "ON" : "OFF");
+    state->ui.banner_timer = BANNER_TIMEOUT_SEC;
+    state->ui.banner_error = 0;
+}
+#endif
+
+#ifdef LGS_FRAME_PROFILER
+/* ============================================================
+ * cmd_export_trace: Write recent frame zones as Chrome trace JSON
+ * ============================================================
+ * The file is written at the end of this frame; a failure shows in
+ * the frame graph.
+ * ============================================================ */
+static void cmd_export_trace(CmdPaletteContext *ctx)
+{
+    EditorState *state;
+
+    if (!ctx || !ctx->state) return;
+    state = ctx->state;
+
+    profiler_request_export("host:trace.json", PROF_EXPORT_FRAMES);
+
+    snprintf(state->ui.banner_text, sizeof(state->ui.banner_text), "TRACE: host:trace.json");
+    state->ui.banner_timer = BANNER_TIMEOUT_SEC;
+    state->ui.banner_error = 0;
+}
+#endif
+
 /* ============================================================
  * cmd_commit: Uses CommitApi if available, else graph_publish directly
  * ============================================================ */
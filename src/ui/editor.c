@@ -1,11 +1,14 @@
 #include "editor.h"
 #include "command_palette.h"
+#include "node_grid.h"
 #include "../graph/graph_core.h"
+#include "../graph/graph_validate.h"
 #include "../graph/graph_publish.h"
 #include "../nodes/node_registry.h"
 #include "../runtime/runtime.h"
 #include "../render/render.h"
 #include "../render/font.h"
+#include "../render/text_fmt.h"
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
@@ -29,6 +32,9 @@
 #define UI_COLOR_BANNER_ERR   0x80FF4040u
 #define UI_COLOR_MENU_BG      0x80404040u
 #define UI_COLOR_MENU_SEL     0x806060C0u
+#define UI_COLOR_MINIMAP_BG   0x80101010u
+#define UI_COLOR_MINIMAP_VIEW 0x80FFFF00u
+#define UI_COLOR_PLOT_BG      0x80101018u
 
 #define CURSOR_HALF 6
 
@@ -107,6 +113,10 @@ static const char *ui_node_type_to_string(NodeType type)
         case NODE_TYPE_RENDER_CIRCLE: return "RENDER_CIRCLE";
         case NODE_TYPE_RENDER_LINE: return "RENDER_LINE";
         case NODE_TYPE_DEBUG: return "DEBUG";
+        case NODE_TYPE_PARTICLES: return "PARTICLES";
+        case NODE_TYPE_UV: return "UV";
+        case NODE_TYPE_PIXEL: return "PIXEL";
+        case NODE_TYPE_FRAG_OUT: return "FRAG_OUT";
         default: return "NODE";
     }
 }
@@ -122,18 +132,40 @@ static int ui_node_valid(const Graph *g, NodeId id)
     return g->nodes[id].type != NODE_TYPE_NONE;
 }
 
+static float ui_zoom(const UiEditor *ui)
+{
+    return (ui->zoom > 0.0f) ? ui->zoom : 1.0f;
+}
+
+/* Canvas point under screen point (sx, sy) */
+static void ui_screen_to_canvas(const UiEditor *ui, float sx, float sy,
+                                float *out_x, float *out_y)
+{
+    float zoom = ui_zoom(ui);
+    *out_x = (sx - (SCREEN_W / 2.0f)) / zoom + ui->pan_x;
+    *out_y = (sy - (CANVAS_Y1 / 2.0f)) / zoom + ui->pan_y;
+}
+
 static void ui_node_screen_pos(const UiEditor *ui, const GraphUi *edit_ui,
                                NodeId id, int *out_x, int *out_y)
 {
     if (!ui || !edit_ui || !out_x || !out_y || id >= MAX_NODES) {
         return;
     }
-    float sx = edit_ui->meta[id].x - ui->pan_x + (SCREEN_W / 2.0f);
-    float sy = edit_ui->meta[id].y - ui->pan_y + (CANVAS_Y1 / 2.0f);
+    float zoom = ui_zoom(ui);
+    float sx = (edit_ui->meta[id].x - ui->pan_x) * zoom + (SCREEN_W / 2.0f);
+    float sy = (edit_ui->meta[id].y - ui->pan_y) * zoom + (CANVAS_Y1 / 2.0f);
     *out_x = (int)(sx + 0.5f);
     *out_y = (int)(sy + 0.5f);
 }
 
+/* Canvas length in screen pixels (at least 1) */
+static int ui_scaled(const UiEditor *ui, int len)
+{
+    int v = (int)((float)len * ui_zoom(ui) + 0.5f);
+    return (v > 0) ? v : 1;
+}
+
 static void ui_port_center(const UiEditor *ui, const GraphUi *edit_ui,
                            NodeId id, int is_output, uint8_t port,
                            int *out_x, int *out_y)
@@ -143,30 +175,183 @@ static void ui_port_center(const UiEditor *ui, const GraphUi *edit_ui,
     ui_node_screen_pos(ui, edit_ui, id, &node_x, &node_y);
 
     if (out_x) {
-        *out_x = is_output ? (node_x + NODE_W) : node_x;
+        *out_x = is_output ? (node_x + ui_scaled(ui, NODE_W)) : node_x;
     }
     if (out_y) {
-        *out_y = node_y + PORT_TOP_Y + (int)port * PORT_GAP_Y;
+        *out_y = node_y + ui_scaled(ui, PORT_TOP_Y + (int)port * PORT_GAP_Y);
     }
 }
 
-static NodeId ui_node_hit_test(const UiEditor *ui, const Graph *g, const GraphUi *edit_ui)
+/* ============================================================
+ * Node Grid and Minimap
+ * ============================================================
+ * Spatial index of edit_ui positions for hit tests and culling,
+ * and the minimap's low-res picture of all nodes. Both are synced
+ * when layout_serial changes: every edit that adds, moves or
+ * deletes a node goes through ui_editor_invalidate.
+ *
+ * Memory usage:
+ *   s_grid: ~15KB, s_grid_hits: MAX_NODES * 2, s_grid_mask: MAX_NODES / 8
+ *   s_minimap: ~1.4KB
+ * ============================================================ */
+#define UI_GRID_MARGIN (PORT_HIT_R + 2)     /* Ports, hit radius, rounding */
+
+static NodeGrid        s_grid;
+static NodeId          s_grid_hits[MAX_NODES];
+static uint32_t        s_grid_mask[NODE_GRID_MASK_WORDS];
+static int             s_grid_valid = 0;
+static const UiEditor *s_grid_owner;
+static const Graph    *s_grid_edit;
+static const GraphUi  *s_grid_ui;
+static uint32_t        s_grid_serial;
+static Minimap         s_minimap;
+
+static void ui_grid_sync(const UiEditor *ui, const Graph *g, const GraphUi *edit_ui)
+{
+    if (!s_grid_valid || s_grid_owner != ui || s_grid_edit != g || s_grid_ui != edit_ui) {
+        node_grid_init(&s_grid, NODE_W, NODE_H, UI_GRID_MARGIN);
+        s_grid_valid = 1;
+        s_grid_owner = ui;
+        s_grid_edit = g;
+        s_grid_ui = edit_ui;
+    } else if (s_grid_serial == ui->layout_serial) {
+        return;
+    }
+    node_grid_sync(&s_grid, g, edit_ui);
+    minimap_build(&s_minimap, g, edit_ui, NODE_W, NODE_H);
+    s_grid_serial = ui->layout_serial;
+}
+
+/* Cursor over the minimap (shown once there are nodes) */
+static int ui_minimap_hit(const UiEditor *ui, const Graph *g, const GraphUi *edit_ui)
+{
+    ui_grid_sync(ui, g, edit_ui);
+    return s_minimap.node_count > 0 &&
+           ui->cursor_x >= UI_MINIMAP_X && ui->cursor_x < UI_MINIMAP_X + MINIMAP_W &&
+           ui->cursor_y >= UI_MINIMAP_Y && ui->cursor_y < UI_MINIMAP_Y + MINIMAP_H;
+}
+
+/* Centre the view on the canvas point under the cursor */
+static void ui_minimap_jump(UiEditor *ui)
+{
+    minimap_to_canvas(&s_minimap, ui->cursor_x - UI_MINIMAP_X, ui->cursor_y - UI_MINIMAP_Y,
+                      &ui->pan_x, &ui->pan_y);
+}
+
+/* Cached runs, the view rectangle and the selected node */
+static void ui_minimap_draw(const UiEditor *ui, const Graph *edit, const GraphUi *edit_ui,
+                            const RenderApi *r)
+{
+    float vx0, vy0, vx1, vy1;
+    int x0, y0, x1, y1;
+    int i;
+
+    r->rect_filled(UI_MINIMAP_X, UI_MINIMAP_Y, MINIMAP_W, MINIMAP_H, UI_COLOR_MINIMAP_BG);
+    for (i = 0; i < s_minimap.run_count; ++i) {
+        const MinimapRun *run = &s_minimap.runs[i];
+        r->rect_filled(UI_MINIMAP_X + run->col * MINIMAP_CELL, UI_MINIMAP_Y + run->row * MINIMAP_CELL,
+                       run->len * MINIMAP_CELL, MINIMAP_CELL, UI_COLOR_NODE_HDR);
+    }
+
+    if (ui_node_valid(edit, ui->selected_node)) {
+        float px, py;
+        minimap_from_canvas(&s_minimap, edit_ui->meta[ui->selected_node].x,
+                            edit_ui->meta[ui->selected_node].y, &px, &py);
+        if (px >= 0.0f && px < MINIMAP_W - 2 && py >= 0.0f && py < MINIMAP_H - 2) {
+            r->rect_filled(UI_MINIMAP_X + (int)px, UI_MINIMAP_Y + (int)py, 3, 3, UI_COLOR_NODE_SEL);
+        }
+    }
+
+    /* Visible canvas, clipped to the minimap */
+    ui_screen_to_canvas(ui, 0.0f, 0.0f, &vx0, &vy0);
+    ui_screen_to_canvas(ui, (float)SCREEN_W, (float)(CANVAS_Y1 + 1), &vx1, &vy1);
+    minimap_from_canvas(&s_minimap, vx0, vy0, &vx0, &vy0);
+    minimap_from_canvas(&s_minimap, vx1, vy1, &vx1, &vy1);
+    x0 = (int)LGS_CLAMP(vx0, 0.0f, (float)(MINIMAP_W - 1));
+    y0 = (int)LGS_CLAMP(vy0, 0.0f, (float)(MINIMAP_H - 1));
+    x1 = (int)LGS_CLAMP(vx1, 0.0f, (float)(MINIMAP_W - 1));
+    y1 = (int)LGS_CLAMP(vy1, 0.0f, (float)(MINIMAP_H - 1));
+    r->rect_outline(UI_MINIMAP_X + x0, UI_MINIMAP_Y + y0,
+                    LGS_MAX(x1 - x0, 1) + 1, LGS_MAX(y1 - y0, 1) + 1, UI_COLOR_MINIMAP_VIEW);
+    r->rect_outline(UI_MINIMAP_X - 1, UI_MINIMAP_Y - 1, MINIMAP_W + 2, MINIMAP_H + 2,
+                    UI_COLOR_NODE_BORDER);
+}
+
+/* Next node at or after i marked in s_grid_mask, MAX_NODES if none */
+static int ui_grid_next(int i)
+{
+    while (i < MAX_NODES) {
+        uint32_t bits = s_grid_mask[i >> 5] >> (i & 31);
+        if (bits == 0) {
+            i = (i | 31) + 1;
+            continue;
+        }
+        while (!(bits & 1u)) {
+            bits >>= 1;
+            i++;
+        }
+        return i;
+    }
+    return MAX_NODES;
+}
+
+/* Candidates within port reach of the cursor, topmost first */
+static uint32_t ui_grid_cursor_hits(const UiEditor *ui, const Graph *g, const GraphUi *edit_ui)
 {
+    float reach = (float)(PORT_HIT_R + 1) / ui_zoom(ui);
+    float gx, gy;
+    uint32_t n = 0;
     int i;
+
+    ui_grid_sync(ui, g, edit_ui);
+    ui_screen_to_canvas(ui, ui->cursor_x, ui->cursor_y, &gx, &gy);
+    memset(s_grid_mask, 0, sizeof(s_grid_mask));
+    node_grid_query_rect(&s_grid, gx - reach, gy - reach, gx + reach, gy + reach, s_grid_mask);
+
+    for (i = ui_grid_next(0); i < MAX_NODES; i = ui_grid_next(i + 1)) {
+        s_grid_hits[n++] = (NodeId)i;
+    }
+    /* Highest id first */
+    for (i = 0; i < (int)n / 2; ++i) {
+        NodeId t = s_grid_hits[i];
+        s_grid_hits[i] = s_grid_hits[n - 1 - i];
+        s_grid_hits[n - 1 - i] = t;
+    }
+    return n;
+}
+
+/* Mark nodes in cells overlapping the screen (plus port squares and
+ * rounding, which the grid margin does not cover when zoomed out) */
+static void ui_grid_visible(const UiEditor *ui, const Graph *g, const GraphUi *edit_ui)
+{
+    float pad = (float)(PORT_R + 1);
+    float x0, y0, x1, y1;
+
+    ui_grid_sync(ui, g, edit_ui);
+    ui_screen_to_canvas(ui, -pad, -pad, &x0, &y0);
+    ui_screen_to_canvas(ui, (float)SCREEN_W + pad, (float)SCREEN_H + pad, &x1, &y1);
+    memset(s_grid_mask, 0, sizeof(s_grid_mask));
+    node_grid_query_rect(&s_grid, x0, y0, x1, y1, s_grid_mask);
+}
+
+static NodeId ui_node_hit_test(const UiEditor *ui, const Graph *g, const GraphUi *edit_ui)
+{
+    uint32_t i, n;
     if (!ui || !g || !edit_ui) {
         return INVALID_NODE_ID;
     }
 
-    for (i = MAX_NODES - 1; i >= 0; --i) {
-        NodeId id = (NodeId)i;
+    n = ui_grid_cursor_hits(ui, g, edit_ui);
+    for (i = 0; i < n; ++i) {
+        NodeId id = s_grid_hits[i];
         int node_x = 0;
         int node_y = 0;
         if (!ui_node_valid(g, id)) {
             continue;
         }
         ui_node_screen_pos(ui, edit_ui, id, &node_x, &node_y);
-        if (ui->cursor_x >= node_x && ui->cursor_x < node_x + NODE_W &&
-            ui->cursor_y >= node_y && ui->cursor_y < node_y + NODE_H) {
+        if (ui->cursor_x >= node_x && ui->cursor_x < node_x + ui_scaled(ui, NODE_W) &&
+            ui->cursor_y >= node_y && ui->cursor_y < node_y + ui_scaled(ui, NODE_H)) {
             return id;
         }
     }
@@ -177,13 +362,14 @@ static NodeId ui_node_hit_test(const UiEditor *ui, const Graph *g, const GraphUi
 static int ui_port_hit_test(const UiEditor *ui, const Graph *g, const GraphUi *edit_ui,
                             NodeId *out_node, int *out_is_output, uint8_t *out_port)
 {
-    int i;
+    uint32_t i, n;
     if (!ui || !g || !edit_ui) {
         return 0;
     }
 
-    for (i = MAX_NODES - 1; i >= 0; --i) {
-        NodeId id = (NodeId)i;
+    n = ui_grid_cursor_hits(ui, g, edit_ui);
+    for (i = 0; i < n; ++i) {
+        NodeId id = s_grid_hits[i];
         const NodeMeta *meta;
         int p;
 
@@ -349,6 +535,224 @@ static void editor_font_draw_text(int x, int y, uint32_t color, const char *text
     font_draw_string_screen(text, x, y, (uint64_t)color, 1);
 }
 
+static void editor_render_set_layer(uint8_t layer)
+{
+    render_set_layer(layer);
+}
+
+/* Draw-order layer for following calls (no-op without set_layer) */
+static void ui_set_layer(const RenderApi *r, uint8_t layer)
+{
+    if (r->set_layer) {
+        r->set_layer(layer);
+    }
+}
+
+/* ============================================================
+ * Retained Draw Cache
+ * ============================================================
+ * ui_draw_static() is recorded through a RenderApi/FontApi that
+ * stores the calls, then replayed every frame until the editor's
+ * draw_serial (or the editor/graph pointers) change. Replay skips
+ * wire routing, port layout, meta lookups and text formatting; a
+ * picture that does not fit is drawn immediately instead.
+ *
+ * Memory usage:
+ *   s_cache: UI_CACHE_MAX_OPS * 16 + UI_CACHE_TEXT_MAX = ~72KB
+ * ============================================================ */
+#define UI_CACHE_MAX_OPS   4096
+#define UI_CACHE_TEXT_MAX  8192
+
+typedef enum {
+    UI_OP_RECT = 0,
+    UI_OP_OUTLINE,
+    UI_OP_LINE,
+    UI_OP_TEXT,
+    UI_OP_LAYER
+} UiOpType;
+
+typedef struct {
+    uint8_t  op;                /* UiOpType */
+    uint8_t  layer;             /* UI_OP_LAYER */
+    uint16_t text;              /* UI_OP_TEXT: offset into text[] */
+    int16_t  v[4];              /* x, y, w/x2, h/y2 */
+    uint32_t color;
+} UiDrawOp;
+
+typedef struct {
+    UiDrawOp ops[UI_CACHE_MAX_OPS];
+    char     text[UI_CACHE_TEXT_MAX];
+    uint32_t count;             /* Ops stored */
+    uint32_t wanted;            /* Ops the picture needs (> count on overflow) */
+    uint32_t text_used;
+    int      valid;             /* Key below was recorded (maybe overflowed) */
+
+    /* Key */
+    const UiEditor *ui;
+    const Graph    *edit;
+    const GraphUi  *edit_ui;
+    uint32_t        serial;
+} UiDrawCache;
+
+static UiDrawCache       s_cache;
+static UiEditorDrawStats s_draw_stats;
+
+static int16_t ui_op_coord(int v)
+{
+    if (v < -32768) return -32768;
+    if (v > 32767) return 32767;
+    return (int16_t)v;
+}
+
+static UiDrawOp *ui_op_push(uint8_t op, int a, int b, int c, int d, uint32_t color)
+{
+    UiDrawOp *o;
+
+    s_cache.wanted++;
+    if (s_cache.count >= UI_CACHE_MAX_OPS) {
+        return NULL;
+    }
+    o = &s_cache.ops[s_cache.count++];
+    o->op = op;
+    o->layer = 0;
+    o->text = 0;
+    o->v[0] = ui_op_coord(a);
+    o->v[1] = ui_op_coord(b);
+    o->v[2] = ui_op_coord(c);
+    o->v[3] = ui_op_coord(d);
+    o->color = color;
+    return o;
+}
+
+static void rec_rect_filled(int x, int y, int w, int h, uint32_t color)
+{
+    ui_op_push(UI_OP_RECT, x, y, w, h, color);
+}
+
+static void rec_rect_outline(int x, int y, int w, int h, uint32_t color)
+{
+    ui_op_push(UI_OP_OUTLINE, x, y, w, h, color);
+}
+
+static void rec_line(int x1, int y1, int x2, int y2, uint32_t color)
+{
+    ui_op_push(UI_OP_LINE, x1, y1, x2, y2, color);
+}
+
+static void rec_set_layer(uint8_t layer)
+{
+    UiDrawOp *o = ui_op_push(UI_OP_LAYER, 0, 0, 0, 0, 0);
+
+    if (o) {
+        o->layer = layer;
+    }
+}
+
+static void rec_text(int x, int y, uint32_t color, const char *text)
+{
+    size_t len = strlen(text) + 1;
+    UiDrawOp *o;
+
+    if (s_cache.text_used + len > UI_CACHE_TEXT_MAX) {
+        s_cache.count = UI_CACHE_MAX_OPS;       /* Overflow: draw immediately */
+    }
+    o = ui_op_push(UI_OP_TEXT, x, y, 0, 0, color);
+    if (o) {
+        o->text = (uint16_t)s_cache.text_used;
+        memcpy(&s_cache.text[s_cache.text_used], text, len);
+        s_cache.text_used += (uint32_t)len;
+    }
+}
+
+static const RenderApi s_rec_render = {
+    rec_rect_filled, rec_rect_outline, rec_line, rec_set_layer
+};
+static const FontApi s_rec_font = { rec_text };
+
+static void ui_cache_replay(const RenderApi *r, const FontApi *f)
+{
+    const UiDrawOp *o = s_cache.ops;
+    uint32_t i;
+
+    for (i = 0; i < s_cache.count; i++, o++) {
+        switch (o->op) {
+            case UI_OP_RECT:
+                r->rect_filled(o->v[0], o->v[1], o->v[2], o->v[3], o->color);
+                break;
+            case UI_OP_OUTLINE:
+                r->rect_outline(o->v[0], o->v[1], o->v[2], o->v[3], o->color);
+                break;
+            case UI_OP_LINE:
+                r->line(o->v[0], o->v[1], o->v[2], o->v[3], o->color);
+                break;
+            case UI_OP_TEXT:
+                f->draw_text(o->v[0], o->v[1], o->color, &s_cache.text[o->text]);
+                break;
+            default:
+                ui_set_layer(r, o->layer);
+                break;
+        }
+    }
+}
+
+void ui_editor_invalidate(UiEditor *ui)
+{
+    if (ui) {
+        ui->draw_serial++;
+        ui->layout_serial++;
+    }
+}
+
+void ui_editor_get_draw_stats(UiEditorDrawStats *out)
+{
+    if (out) {
+        *out = s_draw_stats;
+    }
+}
+
+void ui_editor_draw_stats_reset(void)
+{
+    memset(&s_draw_stats, 0, sizeof(s_draw_stats));
+}
+
+/* ============================================================
+ * Draw Key
+ * ============================================================
+ * UiEditor fields the cached picture depends on. Cursor position
+ * and the wire source are drawn live and left out.
+ * ============================================================ */
+typedef struct {
+    UiEditorMode mode;
+    float pan_x;
+    float pan_y;
+    float zoom;
+    NodeId selected_node;
+    uint8_t selected_param;
+    uint8_t add_index;
+    uint8_t add_scroll;
+    int edit_dirty;
+    int banner_shown;
+    int banner_error;
+    char banner_text[64];
+} UiDrawKey;
+
+static void ui_draw_key(const UiEditor *ui, UiDrawKey *key)
+{
+    memset(key, 0, sizeof(*key));
+    key->mode = ui->mode;
+    key->pan_x = ui->pan_x;
+    key->pan_y = ui->pan_y;
+    key->zoom = ui->zoom;
+    key->selected_node = ui->selected_node;
+    key->selected_param = ui->selected_param;
+    key->add_index = ui->add_index;
+    key->add_scroll = ui->add_scroll;
+    key->edit_dirty = ui->edit_dirty;
+    key->banner_shown = ui->banner_timer > 0.0f && ui->banner_text[0] != '\0';
+    key->banner_error = ui->banner_error;
+    memcpy(key->banner_text, ui->banner_text, sizeof(key->banner_text));
+}
+
 /* ============================================================
  * Initialization
  * ============================================================ */
@@ -363,9 +767,14 @@ void ui_editor_init(UiEditor *ui)
     ui->cursor_y = CANVAS_Y1 / 2.0f;
     ui->pan_x = 0.0f;
     ui->pan_y = 0.0f;
+    ui->zoom = 1.0f;
     ui->selected_node = INVALID_NODE_ID;
     ui->wire_src_node = INVALID_NODE_ID;
     ui->banner_text[0] = '\0';
+
+    /* A new editor may reuse the cached one's address and serial */
+    s_cache.valid = 0;
+    s_grid_valid = 0;
 }
 
 /* ============================================================
@@ -384,12 +793,16 @@ void ui_editor_update(
     float frame_scale;
     float speed;
     int move_pan;
+    int cross;
+    UiDrawKey key_before;
+    UiDrawKey key_after;
 
     if (!ui || !now || !edit || !edit_ui) {
         return;
     }
 
     frame_scale = ui_frame_scale(dt_sec);
+    ui_draw_key(ui, &key_before);
 
     if (ui->banner_timer > 0.0f) {
         ui->banner_timer -= dt_sec;
@@ -424,8 +837,8 @@ void ui_editor_update(
     move_pan = ui_btn_held(now, BTN_L2);
 
     if (move_pan) {
-        ui->pan_x += now->lx * speed * frame_scale;
-        ui->pan_y += now->ly * speed * frame_scale;
+        ui->pan_x += now->lx * speed * frame_scale / ui_zoom(ui);
+        ui->pan_y += now->ly * speed * frame_scale / ui_zoom(ui);
     } else {
         ui->cursor_x += now->lx * speed * frame_scale;
         ui->cursor_y += now->ly * speed * frame_scale;
@@ -460,6 +873,17 @@ void ui_editor_update(
         ui->cursor_y = (float)CANVAS_Y1;
     }
 
+    /* Right stick Y zooms about the cursor (up = in) */
+    if (now->ry != 0.0f) {
+        float gx, gy;
+        float zoom = ui_zoom(ui) * powf(UI_ZOOM_RATE, -now->ry * frame_scale / 60.0f);
+
+        ui_screen_to_canvas(ui, ui->cursor_x, ui->cursor_y, &gx, &gy);
+        ui->zoom = LGS_CLAMP(zoom, UI_ZOOM_MIN, UI_ZOOM_MAX);
+        ui->pan_x = gx - (ui->cursor_x - (SCREEN_W / 2.0f)) / ui->zoom;
+        ui->pan_y = gy - (ui->cursor_y - (CANVAS_Y1 / 2.0f)) / ui->zoom;
+    }
+
     if (ui_btn_pressed(now, prev, BTN_CIRCLE)) {
         ui->mode = UI_EDITOR_MODE_NAV;
         ui->wire_src_node = INVALID_NODE_ID;
@@ -500,8 +924,16 @@ void ui_editor_update(
         }
     }
 
+    /* X on the minimap jumps the view there instead of selecting */
+    cross = ui_btn_pressed(now, prev, BTN_CROSS);
+    if (cross && (ui->mode == UI_EDITOR_MODE_NAV || ui->mode == UI_EDITOR_MODE_WIRE) &&
+        ui_minimap_hit(ui, edit, edit_ui)) {
+        ui_minimap_jump(ui);
+        cross = 0;
+    }
+
     if (ui->mode == UI_EDITOR_MODE_NAV) {
-        if (ui_btn_pressed(now, prev, BTN_CROSS)) {
+        if (cross) {
             NodeId hit = ui_node_hit_test(ui, edit, edit_ui);
             if (hit != INVALID_NODE_ID) {
                 ui->selected_node = hit;
@@ -510,7 +942,7 @@ void ui_editor_update(
     }
 
     if (ui->mode == UI_EDITOR_MODE_WIRE) {
-        if (ui_btn_pressed(now, prev, BTN_CROSS)) {
+        if (cross) {
             NodeId port_node = INVALID_NODE_ID;
             int is_output = 0;
             uint8_t port_idx = 0;
@@ -530,6 +962,7 @@ void ui_editor_update(
                             ui->wire_src_port < meta_src->num_outputs) {
                             graph_connect(edit, ui->wire_src_node, ui->wire_src_port, port_node, port_idx);
                             ui->edit_dirty = 1;
+                            ui_editor_invalidate(ui);
                         }
                         ui->wire_src_node = INVALID_NODE_ID;
                     }
@@ -562,12 +995,13 @@ void ui_editor_update(
             NodeId new_id = INVALID_NODE_ID;
             NodeType type = (NodeType)(ui->add_index + 1);
             if (graph_alloc_node(edit, type, &new_id) == STATUS_OK) {
-                float gx = (ui->cursor_x - (SCREEN_W / 2.0f)) + ui->pan_x;
-                float gy = (ui->cursor_y - (CANVAS_Y1 / 2.0f)) + ui->pan_y;
+                float gx, gy;
+                ui_screen_to_canvas(ui, ui->cursor_x, ui->cursor_y, &gx, &gy);
                 edit_ui->meta[new_id].x = gx;
                 edit_ui->meta[new_id].y = gy;
                 ui->selected_node = new_id;
                 ui->edit_dirty = 1;
+                ui_editor_invalidate(ui);
             }
             ui->mode = UI_EDITOR_MODE_NAV;
         }
@@ -599,36 +1033,54 @@ void ui_editor_update(
                     }
                     graph_set_param(edit, ui->selected_node, ui->selected_param, current);
                     ui->edit_dirty = 1;
+                    ui_editor_invalidate(ui);
                 }
             }
         }
     }
+
+    /* Pan, selection, mode, menu and banner changes (layout unchanged) */
+    ui_draw_key(ui, &key_after);
+    if (memcmp(&key_before, &key_after, sizeof(key_before)) != 0) {
+        ui->draw_serial++;
+    }
 }
 
 /* ============================================================
  * Draw
  * ============================================================ */
-void ui_editor_draw(
-    const UiEditor *ui,
-    const Graph *edit,
-    const GraphUi *edit_ui,
-    const Graph *active,
-    const GraphUi *active_ui,
-    const RenderApi *r,
-    const FontApi *f)
+UiLod ui_editor_lod(const UiEditor *ui)
 {
-    int i;
+    float zoom;
 
-    (void)active;
-    (void)active_ui;
-
-    if (!ui || !edit || !edit_ui || !r || !f ||
-        !r->rect_filled || !r->rect_outline || !r->line || !f->draw_text) {
-        return;
+    if (!ui) {
+        return UI_LOD_FULL;
+    }
+    zoom = ui_zoom(ui);
+    if (zoom < UI_LOD_BLOCK_ZOOM) {
+        return UI_LOD_BLOCK;
+    }
+    if (zoom < UI_LOD_HEADER_ZOOM) {
+        return UI_LOD_HEADER;
     }
+    return UI_LOD_FULL;
+}
+
+static void ui_draw_static(const UiEditor *ui, const Graph *edit, const GraphUi *edit_ui,
+                           const RenderApi *r, const FontApi *f)
+{
+    UiLod lod = ui_editor_lod(ui);
+    int node_w = ui_scaled(ui, NODE_W);
+    int node_h = ui_scaled(ui, NODE_H);
+    int header_h = ui_scaled(ui, NODE_HEADER_H);
+    int i;
 
+    ui_set_layer(r, DL_LAYER_UI_BG);
     r->rect_filled(0, 0, SCREEN_W, CANVAS_Y1 + 1, UI_COLOR_BG);
 
+    /* Wires are culled by their bounding box: one may cross the
+     * screen with both ends off it */
+    ui_set_layer(r, DL_LAYER_UI_WIRES);
     for (i = 0; i < MAX_NODES; ++i) {
         NodeId dst = (NodeId)i;
         const Node *dst_node;
@@ -657,6 +1109,14 @@ void ui_editor_draw(
 
             ui_port_center(ui, edit_ui, src, 1, src_port, &sx, &sy);
             ui_port_center(ui, edit_ui, dst, 0, (uint8_t)in_port, &dx, &dy);
+            if (LGS_MAX(sx, dx) < 0 || LGS_MIN(sx, dx) >= SCREEN_W ||
+                LGS_MAX(sy, dy) < 0 || LGS_MIN(sy, dy) >= SCREEN_H) {
+                continue;
+            }
+            if (lod == UI_LOD_BLOCK) {
+                r->line(sx, sy, dx, dy, UI_COLOR_WIRE);
+                continue;
+            }
             mx = (sx + dx) / 2;
             r->line(sx, sy, mx, sy, UI_COLOR_WIRE);
             r->line(mx, sy, mx, dy, UI_COLOR_WIRE);
@@ -664,9 +1124,12 @@ void ui_editor_draw(
         }
     }
 
-    for (i = 0; i < MAX_NODES; ++i) {
+    /* Nodes in grid cells on screen, in id order (later ids on top) */
+    ui_set_layer(r, DL_LAYER_UI_NODES);
+    ui_grid_visible(ui, edit, edit_ui);
+    for (i = ui_grid_next(0); i < MAX_NODES; i = ui_grid_next(i + 1)) {
         NodeId id = (NodeId)i;
-        int node_x, node_y;
+        int node_x = 0, node_y = 0;
         int p;
         const NodeMeta *meta;
         uint32_t fill = UI_COLOR_NODE;
@@ -677,15 +1140,42 @@ void ui_editor_draw(
         }
 
         ui_node_screen_pos(ui, edit_ui, id, &node_x, &node_y);
+        if (node_x + node_w + PORT_R <= 0 || node_x - PORT_R >= SCREEN_W ||
+            node_y + node_h <= 0 || node_y >= SCREEN_H) {
+            continue;
+        }
+
+        /* Far out: one block, selection still shown */
+        if (lod == UI_LOD_BLOCK) {
+            r->rect_filled(node_x, node_y, node_w, node_h,
+                           (id == ui->selected_node) ? UI_COLOR_NODE_SEL : UI_COLOR_NODE_HDR);
+            continue;
+        }
+
         if (id == ui->selected_node) {
             fill = UI_COLOR_NODE_SEL;
         }
-        r->rect_filled(node_x, node_y, NODE_W, NODE_H, fill);
-        r->rect_outline(node_x, node_y, NODE_W, NODE_H, UI_COLOR_NODE_BORDER);
-        r->rect_filled(node_x, node_y, NODE_W, NODE_HEADER_H, UI_COLOR_NODE_HDR);
+        r->rect_filled(node_x, node_y, node_w, node_h, fill);
+        r->rect_outline(node_x, node_y, node_w, node_h, UI_COLOR_NODE_BORDER);
+        r->rect_filled(node_x, node_y, node_w, header_h, UI_COLOR_NODE_HDR);
 
-        name = ui_node_type_to_string(edit->nodes[id].type);
-        f->draw_text(node_x + NODE_PAD_X, node_y + NODE_PAD_Y, UI_COLOR_TEXT, name);
+        if (lod == UI_LOD_FULL) {
+            name = ui_node_type_to_string(edit->nodes[id].type);
+            f->draw_text(node_x + NODE_PAD_X, node_y + NODE_PAD_Y, UI_COLOR_TEXT, name);
+        }
+
+        /* Update-rate tag in the node's bottom-right corner */
+        if (lod == UI_LOD_FULL && edit->nodes[id].rate_mode != NODE_RATE_EVERY_FRAME) {
+            char rate_buf[8];
+            if (edit->nodes[id].rate_mode == NODE_RATE_ON_CHANGE) {
+                text_fmt_str(rate_buf, sizeof(rate_buf), 0, "~");
+            } else {
+                int pos = text_fmt_char(rate_buf, sizeof(rate_buf), 0, '/');
+                text_fmt_u32(rate_buf, sizeof(rate_buf), pos, graph_node_rate_div(&edit->nodes[id]));
+            }
+            f->draw_text(node_x + node_w - NODE_PAD_X - (int)strlen(rate_buf) * FONT_CHAR_WIDTH,
+                         node_y + node_h - 10, UI_COLOR_TEXT, rate_buf);
+        }
 
         meta = node_registry_get_meta(edit->nodes[id].type);
         if (!meta) {
@@ -705,10 +1195,9 @@ void ui_editor_draw(
         }
     }
 
-    if (ui->mode == UI_EDITOR_MODE_WIRE && ui->wire_src_node != INVALID_NODE_ID) {
-        int sx, sy;
-        ui_port_center(ui, edit_ui, ui->wire_src_node, 1, ui->wire_src_port, &sx, &sy);
-        r->line(sx, sy, (int)ui->cursor_x, (int)ui->cursor_y, UI_COLOR_WIRE_PREVIEW);
+    ui_set_layer(r, DL_LAYER_UI_OVERLAY);
+    if (s_minimap.node_count > 0) {
+        ui_minimap_draw(ui, edit, edit_ui, r);
     }
 
     if (ui->mode == UI_EDITOR_MODE_ADD) {
@@ -747,9 +1236,6 @@ void ui_editor_draw(
         }
     }
 
-    r->rect_filled((int)ui->cursor_x - CURSOR_HALF, (int)ui->cursor_y, CURSOR_HALF * 2, 1, UI_COLOR_CURSOR);
-    r->rect_filled((int)ui->cursor_x, (int)ui->cursor_y - CURSOR_HALF, 1, CURSOR_HALF * 2, UI_COLOR_CURSOR);
-
     if (ui->banner_timer > 0.0f && ui->banner_text[0] != '\0') {
         uint32_t banner_color = ui->banner_error ? UI_COLOR_BANNER_ERR : UI_COLOR_BANNER_OK;
         r->rect_filled(UI_MARGIN_X, BANNER_Y, SCREEN_W - UI_MARGIN_X * 2, BANNER_H, banner_color);
@@ -763,7 +1249,7 @@ void ui_editor_draw(
         char line2[128];
         const char *mode_str = "NAV";
         const char *status_str = "LIVE";
-        char sel_buf[64];
+        int pos;
 
         if (ui->mode == UI_EDITOR_MODE_WIRE) {
             mode_str = "WIRE";
@@ -779,28 +1265,418 @@ void ui_editor_draw(
             status_str = "PENDING";
         }
 
+        /* "MODE <mode>  SEL #<id> <type>  <status>" (no printf per frame) */
+        pos = text_fmt_str(line1, sizeof(line1), 0, "MODE ");
+        pos = text_fmt_str(line1, sizeof(line1), pos, mode_str);
+        pos = text_fmt_str(line1, sizeof(line1), pos, "  SEL ");
         if (ui_node_valid(edit, ui->selected_node)) {
-            snprintf(sel_buf, sizeof(sel_buf), "#%u %s", (unsigned)ui->selected_node,
-                     ui_node_type_to_string(edit->nodes[ui->selected_node].type));
+            pos = text_fmt_char(line1, sizeof(line1), pos, '#');
+            pos = text_fmt_u32(line1, sizeof(line1), pos, ui->selected_node);
+            pos = text_fmt_char(line1, sizeof(line1), pos, ' ');
+            pos = text_fmt_str(line1, sizeof(line1), pos,
+                               ui_node_type_to_string(edit->nodes[ui->selected_node].type));
         } else {
-            snprintf(sel_buf, sizeof(sel_buf), "NONE");
+            pos = text_fmt_str(line1, sizeof(line1), pos, "NONE");
+        }
+        pos = text_fmt_str(line1, sizeof(line1), pos, "  ");
+        pos = text_fmt_str(line1, sizeof(line1), pos, status_str);
+        if (ui_zoom(ui) != 1.0f) {
+            pos = text_fmt_str(line1, sizeof(line1), pos, "  ZOOM ");
+            pos = text_fmt_u32(line1, sizeof(line1), pos, (uint32_t)(ui_zoom(ui) * 100.0f + 0.5f));
+            text_fmt_char(line1, sizeof(line1), pos, '%');
         }
-
-        snprintf(line1, sizeof(line1), "MODE %s  SEL %s  %s", mode_str, sel_buf, status_str);
         f->draw_text(UI_MARGIN_X, 404, UI_COLOR_TEXT, line1);
 
         if (ui->mode == UI_EDITOR_MODE_PARAM && ui_node_valid(edit, ui->selected_node)) {
             float val = 0.0f;
             graph_get_param(edit, ui->selected_node, ui->selected_param, &val);
-            snprintf(line2, sizeof(line2), "Param %u = %.3f  (L/R adjust)",
-                     (unsigned)ui->selected_param, (double)val);
+            pos = text_fmt_str(line2, sizeof(line2), 0, "Param ");
+            pos = text_fmt_u32(line2, sizeof(line2), pos, ui->selected_param);
+            pos = text_fmt_str(line2, sizeof(line2), pos, " = ");
+            pos = text_fmt_fixed(line2, sizeof(line2), pos, val, 3);
+            text_fmt_str(line2, sizeof(line2), pos, "  (L/R adjust)");
         } else {
-            snprintf(line2, sizeof(line2), "X select  O back  Square wire  Triangle add  Start commit");
+            text_fmt_str(line2, sizeof(line2), 0,
+                         "X select  O back  Square wire  Triangle add  Start commit");
         }
         f->draw_text(UI_MARGIN_X, 420, UI_COLOR_TEXT, line2);
     }
 }
 
+/* ============================================================
+ * Probe Plots
+ * ============================================================
+ * DEBUG nodes with recorded history (see graph_probe.h) get a plot
+ * under their box: one min/max bar per pixel column for each
+ * connected input, scaled to the range of all of them. Values move
+ * every frame, so plots are drawn live rather than cached; the cost
+ * is bounded by PROBE_SLOTS * PROBE_PORTS * plot width.
+ *
+ * Memory usage:
+ *   s_plot_min/max: 2 * PROBE_PORTS * UI_PLOT_MAX_COLS * 4 = ~5.4KB
+ * ============================================================ */
+#define UI_PLOT_H         24
+#define UI_PLOT_GAP       3
+#define UI_PLOT_MAX_COLS  (NODE_W * 2)  /* NODE_W at UI_ZOOM_MAX */
+#define UI_PLOT_LIMIT     1.0e30f       /* Larger (or NaN) samples are not plotted */
+
+static const ProbeBank *s_probes = NULL;
+static float s_plot_min[PROBE_PORTS][UI_PLOT_MAX_COLS];
+static float s_plot_max[PROBE_PORTS][UI_PLOT_MAX_COLS];
+static const uint32_t s_plot_colors[PROBE_PORTS] = {
+    0x8040FF40u, 0x80FFFF40u, 0x8040C0FFu, 0x80FF60FFu
+};
+
+void ui_editor_set_probes(const ProbeBank *probes)
+{
+    s_probes = probes;
+}
+
+static int ui_plot_sample_ok(float v)
+{
+    return v > -UI_PLOT_LIMIT && v < UI_PLOT_LIMIT;
+}
+
+/* Plot of one ring under its node. Returns primitives drawn. */
+static uint32_t ui_draw_probe(const UiEditor *ui, const Graph *edit, const GraphUi *edit_ui,
+                              const ProbeRing *ring, const RenderApi *r)
+{
+    const Node *node = &edit->nodes[ring->node];
+    uint32_t prims = 0;
+    uint16_t cols = 0;
+    float lo = 0.0f, hi = 0.0f, scale;
+    int have = 0;
+    int x, y, w, h, p, c;
+
+    ui_node_screen_pos(ui, edit_ui, ring->node, &x, &y);
+    y += ui_scaled(ui, NODE_H) + ui_scaled(ui, UI_PLOT_GAP);
+    w = LGS_MIN(ui_scaled(ui, NODE_W), UI_PLOT_MAX_COLS);
+    h = ui_scaled(ui, UI_PLOT_H);
+    if (x + w <= 0 || x >= SCREEN_W || y + h <= 0 || y >= CANVAS_Y1) {
+        return 0;
+    }
+
+    /* Decimate connected ports and find the common range */
+    for (p = 0; p < PROBE_PORTS; p++) {
+        if (node->inputs[p].src_node == INVALID_NODE_ID) {
+            continue;
+        }
+        cols = graph_probe_decimate(ring, (uint8_t)p, (uint16_t)w, s_plot_min[p], s_plot_max[p]);
+        for (c = 0; c < cols; c++) {
+            float vmin = s_plot_min[p][c];
+            float vmax = s_plot_max[p][c];
+            if (!ui_plot_sample_ok(vmin) || !ui_plot_sample_ok(vmax)) {
+                continue;
+            }
+            if (!have) {
+                lo = vmin;
+                hi = vmax;
+                have = 1;
+            } else {
+                lo = LGS_MIN(lo, vmin);
+                hi = LGS_MAX(hi, vmax);
+            }
+        }
+    }
+    if (!have) {
+        return 0;
+    }
+    if (hi - lo < 1.0e-6f) {
+        lo -= 0.5f;
+        hi += 0.5f;
+    }
+    scale = (float)(h - 1) / (hi - lo);
+
+    r->rect_filled(x, y, w, h, UI_COLOR_PLOT_BG);
+    prims++;
+    for (p = 0; p < PROBE_PORTS; p++) {
+        if (node->inputs[p].src_node == INVALID_NODE_ID) {
+            continue;
+        }
+        for (c = 0; c < cols; c++) {
+            float vmin = s_plot_min[p][c];
+            float vmax = s_plot_max[p][c];
+            int y0, y1;
+            if (!ui_plot_sample_ok(vmin) || !ui_plot_sample_ok(vmax)) {
+                continue;
+            }
+            y0 = y + h - 1 - (int)((vmax - lo) * scale + 0.5f);
+            y1 = y + h - 1 - (int)((vmin - lo) * scale + 0.5f);
+            r->rect_filled(x + c, y0, 1, y1 - y0 + 1, s_plot_colors[p]);
+            prims++;
+        }
+    }
+    return prims;
+}
+
+/* Plots of every probed DEBUG node (full and header detail only) */
+static uint32_t ui_draw_probes(const UiEditor *ui, const Graph *edit, const GraphUi *edit_ui,
+                               const RenderApi *r)
+{
+    uint32_t prims = 0;
+    int s;
+
+    if (!s_probes || ui_editor_lod(ui) == UI_LOD_BLOCK) {
+        return 0;
+    }
+
+    ui_set_layer(r, DL_LAYER_UI_NODES);
+    for (s = 0; s < PROBE_SLOTS; s++) {
+        const ProbeRing *ring = &s_probes->ring[s];
+        if (ring->count > 0 && ring->node < MAX_NODES &&
+            edit->nodes[ring->node].type == NODE_TYPE_DEBUG) {
+            prims += ui_draw_probe(ui, edit, edit_ui, ring, r);
+        }
+    }
+    return prims;
+}
+
+#ifdef LGS_NODE_PROFILER
+/* ============================================================
+ * Node Profiler Overlay
+ * ============================================================
+ * Tints each visible node by its share of the most expensive
+ * node's time and lists the NODE_PROFILE_TOP most expensive nodes
+ * and node types. Toggled from the command palette. The list is
+ * re-formatted every UI_PROFILE_REFRESH frames so it stays
+ * readable; tints follow every frame.
+ *
+ * Memory usage:
+ *   s_prof_lines: UI_PROFILE_LINES * UI_PROFILE_LINE_LEN = ~0.6KB
+ *   s_prof_sum:   ~0.3KB
+ * ============================================================ */
+#define UI_PROFILE_REFRESH   15
+#define UI_PROFILE_LINE_LEN  48
+#define UI_PROFILE_LINES     (NODE_PROFILE_TOP + 2)
+#define UI_PROFILE_TYPES     3         /* Types on the summary line */
+#define UI_PROFILE_X         UI_MARGIN_X
+#define UI_PROFILE_Y         (BANNER_Y + BANNER_H + 8)
+#define UI_PROFILE_W         (36 * FONT_CHAR_WIDTH + 8)
+#define UI_PROFILE_LINE_H    10
+#define UI_COLOR_PROFILE_BG  0x60101010u
+
+static const NodeProfile *s_profile = NULL;
+static int                s_profile_visible = 0;
+static uint32_t           s_prof_frame;
+static NodeProfileSummary s_prof_sum;
+static char               s_prof_lines[UI_PROFILE_LINES][UI_PROFILE_LINE_LEN];
+static int                s_prof_line_count;
+
+void ui_editor_set_profile(const NodeProfile *profile)
+{
+    s_profile = profile;
+}
+
+int ui_editor_toggle_profile(void)
+{
+    s_profile_visible = !s_profile_visible;
+    s_prof_frame = 0;
+    return s_profile_visible;
+}
+
+/* Blue (cheap) to red (most expensive), half transparent */
+static uint32_t ui_profile_heat(float share)
+{
+    uint32_t red = (uint32_t)(LGS_CLAMP(share, 0.0f, 1.0f) * 255.0f);
+    return 0x40000000u | (0x20u << 8) | ((255u - red) << 16) | red;
+}
+
+static int ui_profile_percent(char *buf, int pos, float part, float total)
+{
+    uint32_t pct = (total > 0.0f) ? (uint32_t)(part * 100.0f / total + 0.5f) : 0u;
+    pos = text_fmt_u32(buf, UI_PROFILE_LINE_LEN, pos, pct);
+    return text_fmt_char(buf, UI_PROFILE_LINE_LEN, pos, '%');
+}
+
+static int ui_profile_pad(char *buf, int pos, int col)
+{
+    while (pos < col) {
+        pos = text_fmt_char(buf, UI_PROFILE_LINE_LEN, pos, ' ');
+    }
+    return pos;
+}
+
+/* Summarize and format the list */
+static void ui_profile_refresh(void)
+{
+    uint8_t types[UI_PROFILE_TYPES];
+    int type_count = 0;
+    char *line;
+    int i, t, pos;
+
+    node_profile_summarize(s_profile, &s_prof_sum);
+    s_prof_line_count = 0;
+
+    line = s_prof_lines[s_prof_line_count++];
+    pos = text_fmt_str(line, UI_PROFILE_LINE_LEN, 0, "NODE  TYPE        TICKS/RUN  EVAL");
+
+    for (i = 0; i < s_prof_sum.top_count; i++) {
+        NodeId id = s_prof_sum.top[i];
+        float avg = s_profile->avg[id];
+
+        line = s_prof_lines[s_prof_line_count++];
+        pos = text_fmt_u32(line, UI_PROFILE_LINE_LEN, 0, id);
+        pos = ui_profile_pad(line, pos, 6);
+        pos = text_fmt_str(line, UI_PROFILE_LINE_LEN, pos,
+                           ui_node_type_to_string((NodeType)s_profile->type[id]));
+        pos = ui_profile_pad(line, pos, 18);
+        pos = text_fmt_u32(line, UI_PROFILE_LINE_LEN, pos, (uint32_t)(avg + 0.5f));
+        pos = ui_profile_pad(line, pos, 29);
+        ui_profile_percent(line, pos, avg, s_prof_sum.total);
+    }
+
+    /* Most expensive types, by total */
+    for (t = 1; t < NODE_TYPE_COUNT; t++) {
+        int k;
+        if (s_prof_sum.type_nodes[t] == 0) {
+            continue;
+        }
+        k = (type_count < UI_PROFILE_TYPES) ? type_count++ : UI_PROFILE_TYPES;
+        if (k == UI_PROFILE_TYPES) {
+            if (s_prof_sum.type_total[t] <= s_prof_sum.type_total[types[k - 1]]) {
+                continue;
+            }
+            k--;
+        }
+        while (k > 0 && s_prof_sum.type_total[t] > s_prof_sum.type_total[types[k - 1]]) {
+            types[k] = types[k - 1];
+            k--;
+        }
+        types[k] = (uint8_t)t;
+    }
+    if (type_count > 0) {
+        line = s_prof_lines[s_prof_line_count++];
+        pos = text_fmt_str(line, UI_PROFILE_LINE_LEN, 0, "TYPES");
+        for (i = 0; i < type_count; i++) {
+            pos = text_fmt_char(line, UI_PROFILE_LINE_LEN, pos, ' ');
+            pos = text_fmt_str(line, UI_PROFILE_LINE_LEN, pos,
+                               ui_node_type_to_string((NodeType)types[i]));
+            pos = text_fmt_char(line, UI_PROFILE_LINE_LEN, pos, ' ');
+            pos = ui_profile_percent(line, pos, s_prof_sum.type_total[types[i]], s_prof_sum.total);
+        }
+    }
+}
+
+/* Heat tints over visible nodes and the top list. Returns
+ * primitives drawn. */
+static uint32_t ui_draw_profile(const UiEditor *ui, const Graph *edit, const GraphUi *edit_ui,
+                                const RenderApi *r, const FontApi *f)
+{
+    uint32_t prims = 0;
+    int node_w, node_h, i;
+
+    if (!s_profile || !s_profile_visible) {
+        return 0;
+    }
+    if (s_prof_frame++ % UI_PROFILE_REFRESH == 0) {
+        ui_profile_refresh();
+    }
+
+    /* Tints: nodes the live graph ran with the same type */
+    if (s_prof_sum.max > 0.0f) {
+        node_w = ui_scaled(ui, NODE_W);
+        node_h = ui_scaled(ui, NODE_H);
+        ui_set_layer(r, DL_LAYER_UI_NODES);
+        ui_grid_visible(ui, edit, edit_ui);
+        for (i = ui_grid_next(0); i < MAX_NODES; i = ui_grid_next(i + 1)) {
+            int x, y;
+            if (edit->nodes[i].type == NODE_TYPE_NONE ||
+                s_profile->type[i] != (uint8_t)edit->nodes[i].type) {
+                continue;
+            }
+            ui_node_screen_pos(ui, edit_ui, (NodeId)i, &x, &y);
+            r->rect_filled(x, y, node_w, node_h,
+                           ui_profile_heat(s_profile->avg[i] / s_prof_sum.max));
+            prims++;
+        }
+    }
+
+    ui_set_layer(r, DL_LAYER_UI_OVERLAY);
+    r->rect_filled(UI_PROFILE_X, UI_PROFILE_Y, UI_PROFILE_W,
+                   s_prof_line_count * UI_PROFILE_LINE_H + 6, UI_COLOR_PROFILE_BG);
+    prims++;
+    for (i = 0; i < s_prof_line_count; i++) {
+        f->draw_text(UI_PROFILE_X + 4, UI_PROFILE_Y + 4 + i * UI_PROFILE_LINE_H, UI_COLOR_TEXT,
+                     s_prof_lines[i]);
+        prims++;
+    }
+    return prims;
+}
+#endif /* LGS_NODE_PROFILER */
+
+/* Probe plots, profiler overlay, cursor and wire preview: drawn
+ * every frame. Returns primitives drawn. */
+static uint32_t ui_draw_live(const UiEditor *ui, const Graph *edit, const GraphUi *edit_ui,
+                             const RenderApi *r, const FontApi *f)
+{
+    uint32_t prims = 2;
+
+    prims += ui_draw_probes(ui, edit, edit_ui, r);
+#ifdef LGS_NODE_PROFILER
+    prims += ui_draw_profile(ui, edit, edit_ui, r, f);
+#else
+    (void)f;
+#endif
+
+    ui_set_layer(r, DL_LAYER_UI_OVERLAY);
+    if (ui->mode == UI_EDITOR_MODE_WIRE && ui->wire_src_node != INVALID_NODE_ID) {
+        int sx, sy;
+        ui_port_center(ui, edit_ui, ui->wire_src_node, 1, ui->wire_src_port, &sx, &sy);
+        r->line(sx, sy, (int)ui->cursor_x, (int)ui->cursor_y, UI_COLOR_WIRE_PREVIEW);
+        prims++;
+    }
+
+    r->rect_filled((int)ui->cursor_x - CURSOR_HALF, (int)ui->cursor_y, CURSOR_HALF * 2, 1, UI_COLOR_CURSOR);
+    r->rect_filled((int)ui->cursor_x, (int)ui->cursor_y - CURSOR_HALF, 1, CURSOR_HALF * 2, UI_COLOR_CURSOR);
+    return prims;
+}
+
+void ui_editor_draw(
+    const UiEditor *ui,
+    const Graph *edit,
+    const GraphUi *edit_ui,
+    const Graph *active,
+    const GraphUi *active_ui,
+    const RenderApi *r,
+    const FontApi *f)
+{
+    (void)active;
+    (void)active_ui;
+
+    if (!ui || !edit || !edit_ui || !r || !f ||
+        !r->rect_filled || !r->rect_outline || !r->line || !f->draw_text) {
+        return;
+    }
+
+    if (!s_cache.valid || s_cache.ui != ui || s_cache.serial != ui->draw_serial ||
+        s_cache.edit != edit || s_cache.edit_ui != edit_ui) {
+        s_cache.count = 0;
+        s_cache.wanted = 0;
+        s_cache.text_used = 0;
+        ui_draw_static(ui, edit, edit_ui, &s_rec_render, &s_rec_font);
+
+        s_cache.valid = 1;
+        s_cache.ui = ui;
+        s_cache.edit = edit;
+        s_cache.edit_ui = edit_ui;
+        s_cache.serial = ui->draw_serial;
+        s_draw_stats.rebuilds++;
+        s_draw_stats.generated += s_cache.wanted;
+    } else if (s_cache.wanted == s_cache.count) {
+        s_draw_stats.replayed += s_cache.count;
+    } else {
+        s_draw_stats.generated += s_cache.wanted;
+    }
+
+    if (s_cache.wanted == s_cache.count) {
+        ui_cache_replay(r, f);
+    } else {
+        ui_draw_static(ui, edit, edit_ui, r, f);
+    }
+
+    s_draw_stats.generated += ui_draw_live(ui, edit, edit_ui, r, f);
+}
+
 /* ============================================================
  * Legacy Editor API
  * ============================================================ */
@@ -894,10 +1770,14 @@ Status editor_update(EditorState *state, const RuntimeContext *ctx, Graph *live_
                 state->ui.banner_timer = 0.0f;
                 state->ui.banner_error = 0;
                 state->ui.banner_text[0] = '\0';
+                ui_editor_invalidate(&state->ui);
             }
         }
 
-        cmd_palette_update(&s_cmdpal, &pal_ctx, &now, &prev);
+        /* Commands edit the graph and UI state directly */
+        if (cmd_palette_update(&s_cmdpal, &pal_ctx, &now, &prev)) {
+            ui_editor_invalidate(&state->ui);
+        }
         return STATUS_OK;
     }
 
@@ -925,6 +1805,7 @@ void editor_draw(const EditorState *state)
     r.rect_filled = editor_render_rect_filled;
     r.rect_outline = editor_render_rect_outline;
     r.line = editor_render_line;
+    r.set_layer = editor_render_set_layer;
 
     f.draw_text = editor_font_draw_text;
 
@@ -938,6 +1819,7 @@ void editor_draw(const EditorState *state)
 
     /* Command Palette: render overlay */
     if (cmd_palette_is_open(&s_cmdpal)) {
+        render_set_layer(DL_LAYER_PALETTE);
         cmd_palette_draw(&s_cmdpal, editor_render_rect_filled, editor_font_draw_text);
     }
 }
@@ -5,6 +5,9 @@
 #include "../graph/graph_types.h"
 #include "../system/pad.h"
 #include "../runtime/runtime.h"
+#include "minimap.h"
+#include "../graph/graph_probe.h"
+#include "../graph/graph_profile.h"
 #include <stdint.h>
 
 /* ============================================================
@@ -45,6 +48,19 @@
 #define PARAM_STEP_NORMAL 0.05f
 #define PARAM_STEP_COARSE 0.10f
 
+/* Canvas zoom (right stick Y, about the cursor) */
+#define UI_ZOOM_MIN 0.125f
+#define UI_ZOOM_MAX 2.0f
+#define UI_ZOOM_RATE 2.0f       /* Zoom factor per second at full stick */
+
+/* Level of detail: below these zooms labels, then node detail, go */
+#define UI_LOD_HEADER_ZOOM 0.75f
+#define UI_LOD_BLOCK_ZOOM 0.4f
+
+/* Minimap overlay, bottom right of the canvas */
+#define UI_MINIMAP_X (SCREEN_W - UI_MARGIN_X - MINIMAP_W)
+#define UI_MINIMAP_Y (CANVAS_Y1 - 8 - MINIMAP_H)
+
 #define BANNER_H 28
 #define BANNER_Y 12
 #define BANNER_TIMEOUT_SEC 2.0f
@@ -59,6 +75,7 @@ typedef struct RenderApi {
     void (*rect_filled)(int x, int y, int w, int h, uint32_t color);
     void (*rect_outline)(int x, int y, int w, int h, uint32_t color);
     void (*line)(int x1, int y1, int x2, int y2, uint32_t color);
+    void (*set_layer)(uint8_t layer);  /* Optional: draw-order layer (DL_LAYER_*) */
 } RenderApi;
 #endif
 
@@ -95,6 +112,15 @@ typedef enum {
     UI_EDITOR_MODE_ADD
 } UiEditorMode;
 
+/* ============================================================
+ * Level of Detail
+ * ============================================================ */
+typedef enum {
+    UI_LOD_FULL = 0,            /* Boxes, header, labels, ports, routed wires */
+    UI_LOD_HEADER,              /* Boxes, header and ports; no labels */
+    UI_LOD_BLOCK                /* One block per node, straight wires */
+} UiLod;
+
 /* ============================================================
  * UI State
  * ============================================================ */
@@ -106,6 +132,7 @@ typedef struct UiEditor {
 
     float pan_x;
     float pan_y;
+    float zoom;                 /* Screen pixels per canvas unit */
 
     NodeId selected_node;
     uint8_t selected_param;
@@ -121,8 +148,30 @@ typedef struct UiEditor {
     float banner_timer;
     int banner_error;
     char banner_text[64];
+
+    /* Bumped when the cached editor picture is stale (see
+     * ui_editor_invalidate) */
+    uint32_t draw_serial;
+
+    /* Bumped by ui_editor_invalidate only: nodes may have been
+     * added, moved or deleted (node grid resync) */
+    uint32_t layout_serial;
 } UiEditor;
 
+/* ============================================================
+ * Draw Stats (primitives per ui_editor_draw, accumulated until
+ * reset)
+ * ============================================================
+ * The static picture (canvas, wires, nodes, menus, banner, HUD) is
+ * recorded once per change and replayed from a cache; the cursor and
+ * wire preview are generated every frame.
+ * ============================================================ */
+typedef struct {
+    uint32_t generated;         /* Primitives built this frame (rebuilds + live) */
+    uint32_t replayed;          /* Primitives replayed from the cache */
+    uint32_t rebuilds;          /* Cache rebuilds */
+} UiEditorDrawStats;
+
 /* ============================================================
  * Legacy Editor API (compatibility layer)
  * ============================================================ */
@@ -167,6 +216,29 @@ void ui_editor_draw(
     const FontApi *f
 );
 
+/* Mark the cached picture and node grid stale. ui_editor_update
+ * does this itself; call it after changing the graph, node
+ * positions or UI state anywhere else. */
+void ui_editor_invalidate(UiEditor *ui);
+
+/* Plot DEBUG node history from probes under each DEBUG node
+ * (NULL = no plots, the default) */
+void ui_editor_set_probes(const ProbeBank *probes);
+
+#ifdef LGS_NODE_PROFILER
+/* Node costs for the profiler overlay (tints and top list) */
+void ui_editor_set_profile(const NodeProfile *profile);
+
+/* Show or hide the profiler overlay; returns 1 if now shown */
+int ui_editor_toggle_profile(void);
+#endif
+
+/* Detail tier for the editor's current zoom */
+UiLod ui_editor_lod(const UiEditor *ui);
+
+void ui_editor_get_draw_stats(UiEditorDrawStats *out);
+void ui_editor_draw_stats_reset(void);
+
 /* Legacy entry points expected by existing main.c */
 void editor_init(EditorState *state, const Graph *live_graph);
 Status editor_update(EditorState *state, const RuntimeContext *ctx, Graph *live_graph);
@@ -0,0 +1,127 @@
+#include "minimap.h"
+#include <string.h>
+
+/* ============================================================
+ * Helpers
+ * ============================================================ */
+static int minimap_cell(float px, int count)
+{
+    int c = (int)(px / (float)MINIMAP_CELL);
+    return LGS_CLAMP(c, 0, count - 1);
+}
+
+/* ============================================================
+ * Build
+ * ============================================================ */
+void minimap_build(Minimap *mm, const Graph *g, const UiMetaBank *ui,
+                   int box_w, int box_h)
+{
+    float min_x = 0.0f, min_y = 0.0f, max_x = 0.0f, max_y = 0.0f;
+    float bw, bh, sx, sy;
+    int i, row;
+
+    if (!mm) {
+        return;
+    }
+    memset(mm, 0, sizeof(*mm));
+    mm->scale = 1.0f;
+    if (!g || !ui) {
+        return;
+    }
+
+    /* Bounds of every node box */
+    for (i = 0; i < MAX_NODES; i++) {
+        float x, y;
+        if (g->nodes[i].type == NODE_TYPE_NONE) {
+            continue;
+        }
+        x = ui->meta[i].x;
+        y = ui->meta[i].y;
+        if (mm->node_count == 0) {
+            min_x = x;
+            min_y = y;
+            max_x = x + (float)box_w;
+            max_y = y + (float)box_h;
+        } else {
+            min_x = LGS_MIN(min_x, x);
+            min_y = LGS_MIN(min_y, y);
+            max_x = LGS_MAX(max_x, x + (float)box_w);
+            max_y = LGS_MAX(max_y, y + (float)box_h);
+        }
+        mm->node_count++;
+    }
+    if (mm->node_count == 0) {
+        return;
+    }
+
+    /* Uniform fit, centred */
+    bw = (max_x - min_x) + 2.0f * MINIMAP_PAD;
+    bh = (max_y - min_y) + 2.0f * MINIMAP_PAD;
+    sx = (float)MINIMAP_W / bw;
+    sy = (float)MINIMAP_H / bh;
+    mm->scale = LGS_MIN(sx, sy);
+    mm->origin_x = (min_x + max_x) * 0.5f - (float)MINIMAP_W * 0.5f / mm->scale;
+    mm->origin_y = (min_y + max_y) * 0.5f - (float)MINIMAP_H * 0.5f / mm->scale;
+
+    /* Mark cells */
+    for (i = 0; i < MAX_NODES; i++) {
+        float px0, py0, px1, py1;
+        int c0, c1, r0, r1, r;
+        uint32_t bits;
+
+        if (g->nodes[i].type == NODE_TYPE_NONE) {
+            continue;
+        }
+        minimap_from_canvas(mm, ui->meta[i].x, ui->meta[i].y, &px0, &py0);
+        minimap_from_canvas(mm, ui->meta[i].x + (float)box_w, ui->meta[i].y + (float)box_h,
+                            &px1, &py1);
+        c0 = minimap_cell(px0, MINIMAP_COLS);
+        c1 = minimap_cell(px1, MINIMAP_COLS);
+        r0 = minimap_cell(py0, MINIMAP_ROWS);
+        r1 = minimap_cell(py1, MINIMAP_ROWS);
+
+        bits = ((c1 - c0 + 1) >= 32) ? 0xFFFFFFFFu : (((1u << (c1 - c0 + 1)) - 1u) << c0);
+        for (r = r0; r <= r1; r++) {
+            mm->cells[r] |= bits;
+        }
+    }
+
+    /* Merge each row into runs */
+    for (row = 0; row < MINIMAP_ROWS; row++) {
+        uint32_t bits = mm->cells[row];
+        int col = 0;
+
+        while (col < MINIMAP_COLS) {
+            int start;
+            if (!(bits & (1u << col))) {
+                col++;
+                continue;
+            }
+            start = col;
+            while (col < MINIMAP_COLS && (bits & (1u << col))) {
+                col++;
+            }
+            if (mm->run_count < MINIMAP_MAX_RUNS) {
+                MinimapRun *run = &mm->runs[mm->run_count++];
+                run->row = (uint8_t)row;
+                run->col = (uint8_t)start;
+                run->len = (uint8_t)(col - start);
+            }
+        }
+    }
+}
+
+/* ============================================================
+ * Mapping
+ * ============================================================ */
+void minimap_to_canvas(const Minimap *mm, float px, float py, float *out_x, float *out_y)
+{
+    *out_x = mm->origin_x + px / mm->scale;
+    *out_y = mm->origin_y + py / mm->scale;
+}
+
+void minimap_from_canvas(const Minimap *mm, float x, float y, float *out_px, float *out_py)
+{
+    *out_px = (x - mm->origin_x) * mm->scale;
+    *out_py = (y - mm->origin_y) * mm->scale;
+}
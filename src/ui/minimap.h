@@ -0,0 +1,60 @@
+#ifndef UI_MINIMAP_H
+#define UI_MINIMAP_H
+
+#include "../common.h"
+#include "../graph/graph_types.h"
+#include <stdint.h>
+
+/* ============================================================
+ * Minimap
+ * ============================================================
+ * Low-res overview of every node on the canvas. The graph's bounds
+ * are fitted (uniform scale, centred) into MINIMAP_W x MINIMAP_H
+ * pixels, node boxes mark MINIMAP_CELL sized cells, and each row of
+ * marked cells is merged into runs. Drawing replays the runs, so
+ * the per-frame cost is bounded by MINIMAP_MAX_RUNS regardless of
+ * graph size; minimap_build() walks the nodes and only needs to run
+ * when the layout changes.
+ *
+ * Portable C: no ps2sdk dependency.
+ *
+ * Memory usage:
+ *   Minimap: MINIMAP_ROWS * 4 + MINIMAP_MAX_RUNS * 4 + 16 = ~1.4KB
+ * ============================================================ */
+
+#define MINIMAP_W          128
+#define MINIMAP_H          80
+#define MINIMAP_CELL       4        /* Pixels per cell side */
+#define MINIMAP_COLS       (MINIMAP_W / MINIMAP_CELL)
+#define MINIMAP_ROWS       (MINIMAP_H / MINIMAP_CELL)
+#define MINIMAP_MAX_RUNS   (MINIMAP_ROWS * ((MINIMAP_COLS + 1) / 2))
+#define MINIMAP_PAD        64.0f    /* Canvas units around the bounds */
+
+/* Marked cells [col, col + len) of one row */
+typedef struct {
+    uint8_t row;
+    uint8_t col;
+    uint8_t len;
+    uint8_t _pad;
+} MinimapRun;
+
+typedef struct {
+    float      origin_x;            /* Canvas point at minimap (0, 0) */
+    float      origin_y;
+    float      scale;               /* Minimap pixels per canvas unit */
+    uint32_t   cells[MINIMAP_ROWS]; /* Bit per column */
+    MinimapRun runs[MINIMAP_MAX_RUNS];
+    uint16_t   run_count;
+    uint16_t   node_count;
+} Minimap;
+
+/* Fit and rasterize the graph's live nodes, each box_w x box_h
+ * canvas units at its UiMeta position */
+void minimap_build(Minimap *mm, const Graph *g, const UiMetaBank *ui,
+                   int box_w, int box_h);
+
+/* Canvas point <-> minimap pixel (relative to the minimap corner) */
+void minimap_to_canvas(const Minimap *mm, float px, float py, float *out_x, float *out_y);
+void minimap_from_canvas(const Minimap *mm, float x, float y, float *out_px, float *out_py);
+
+#endif /* UI_MINIMAP_H */
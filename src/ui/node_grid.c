@@ -0,0 +1,239 @@
+#include "node_grid.h"
+#include <string.h>
+#include <math.h>
+
+#define NODE_GRID_CELL_LIMIT 32767
+
+/* ============================================================
+ * Helpers
+ * ============================================================ */
+static int16_t node_grid_cell(float v)
+{
+    float c;
+
+    if (!(v == v)) {
+        return 0;   /* NaN */
+    }
+    c = floorf(v / (float)NODE_GRID_CELL);
+    if (c < -(float)NODE_GRID_CELL_LIMIT) {
+        return -NODE_GRID_CELL_LIMIT;
+    }
+    if (c > (float)NODE_GRID_CELL_LIMIT) {
+        return NODE_GRID_CELL_LIMIT;
+    }
+    return (int16_t)c;
+}
+
+static uint32_t node_grid_hash(int cx, int cy)
+{
+    uint32_t h = (uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u;
+    return (h ^ (h >> 15)) & (NODE_GRID_BUCKETS - 1);
+}
+
+static void node_grid_link(NodeGrid *grid, NodeId id, int cx, int cy)
+{
+    uint32_t b = node_grid_hash(cx, cy);
+    uint16_t r = grid->free_ref;
+    NodeGridRef *ref;
+
+    if (r == NODE_GRID_NONE) {
+        return;     /* Cannot happen: at most 4 refs per node */
+    }
+    ref = &grid->refs[r];
+    grid->free_ref = ref->next;
+
+    ref->cx = (int16_t)cx;
+    ref->cy = (int16_t)cy;
+    ref->node = id;
+    ref->next = grid->bucket[b];
+    grid->bucket[b] = r;
+}
+
+static void node_grid_unlink(NodeGrid *grid, NodeId id, int cx, int cy)
+{
+    uint16_t *link = &grid->bucket[node_grid_hash(cx, cy)];
+
+    while (*link != NODE_GRID_NONE) {
+        NodeGridRef *ref = &grid->refs[*link];
+        if (ref->node == id && ref->cx == cx && ref->cy == cy) {
+            uint16_t r = *link;
+            *link = ref->next;
+            ref->next = grid->free_ref;
+            grid->free_ref = r;
+            return;
+        }
+        link = &ref->next;
+    }
+}
+
+static void node_grid_unlink_all(NodeGrid *grid, NodeId id)
+{
+    const NodeGridSlot *s = &grid->slots[id];
+    int cx, cy;
+
+    for (cy = s->cy0; cy <= s->cy1; cy++) {
+        for (cx = s->cx0; cx <= s->cx1; cx++) {
+            node_grid_unlink(grid, id, cx, cy);
+        }
+    }
+}
+
+/* ============================================================
+ * Init / Update
+ * ============================================================ */
+int node_grid_init(NodeGrid *grid, int box_w, int box_h, int margin)
+{
+    uint32_t i;
+
+    if (!grid || box_w < 0 || box_h < 0 || margin < 0 ||
+        box_w + 2 * margin > NODE_GRID_CELL || box_h + 2 * margin > NODE_GRID_CELL) {
+        return -1;
+    }
+
+    memset(grid->slots, 0, sizeof(grid->slots));
+    for (i = 0; i < NODE_GRID_BUCKETS; i++) {
+        grid->bucket[i] = NODE_GRID_NONE;
+    }
+    for (i = 0; i < NODE_GRID_MAX_REFS; i++) {
+        grid->refs[i].next = (i + 1 < NODE_GRID_MAX_REFS) ? (uint16_t)(i + 1) : NODE_GRID_NONE;
+    }
+    grid->free_ref = 0;
+    grid->box_w = box_w;
+    grid->box_h = box_h;
+    grid->margin = margin;
+    grid->count = 0;
+    return 0;
+}
+
+int node_grid_set(NodeGrid *grid, NodeId id, float x, float y)
+{
+    NodeGridSlot *s;
+    int16_t cx0, cy0, cx1, cy1;
+    int cx, cy;
+
+    if (!grid || id >= MAX_NODES) {
+        return 0;
+    }
+
+    s = &grid->slots[id];
+    if (s->present && s->x == x && s->y == y) {
+        return 0;
+    }
+
+    cx0 = node_grid_cell(x - (float)grid->margin);
+    cy0 = node_grid_cell(y - (float)grid->margin);
+    cx1 = node_grid_cell(x + (float)(grid->box_w + grid->margin));
+    cy1 = node_grid_cell(y + (float)(grid->box_h + grid->margin));
+
+    if (s->present) {
+        if (s->cx0 == cx0 && s->cy0 == cy0 && s->cx1 == cx1 && s->cy1 == cy1) {
+            s->x = x;
+            s->y = y;
+            return 1;
+        }
+        node_grid_unlink_all(grid, id);
+    } else {
+        grid->count++;
+    }
+
+    for (cy = cy0; cy <= cy1; cy++) {
+        for (cx = cx0; cx <= cx1; cx++) {
+            node_grid_link(grid, id, cx, cy);
+        }
+    }
+
+    s->x = x;
+    s->y = y;
+    s->cx0 = cx0;
+    s->cy0 = cy0;
+    s->cx1 = cx1;
+    s->cy1 = cy1;
+    s->present = 1;
+    return 1;
+}
+
+void node_grid_remove(NodeGrid *grid, NodeId id)
+{
+    if (!grid || id >= MAX_NODES || !grid->slots[id].present) {
+        return;
+    }
+    node_grid_unlink_all(grid, id);
+    grid->slots[id].present = 0;
+    grid->count--;
+}
+
+uint32_t node_grid_sync(NodeGrid *grid, const Graph *g, const UiMetaBank *ui)
+{
+    uint32_t changed = 0;
+    int i;
+
+    if (!grid || !g || !ui) {
+        return 0;
+    }
+
+    for (i = 0; i < MAX_NODES; i++) {
+        NodeId id = (NodeId)i;
+        if (g->nodes[i].type != NODE_TYPE_NONE) {
+            changed += (uint32_t)node_grid_set(grid, id, ui->meta[i].x, ui->meta[i].y);
+        } else if (grid->slots[i].present) {
+            node_grid_remove(grid, id);
+            changed++;
+        }
+    }
+    return changed;
+}
+
+/* ============================================================
+ * Queries
+ * ============================================================ */
+uint32_t node_grid_query_rect(const NodeGrid *grid, float x0, float y0,
+                              float x1, float y1, uint32_t *mask)
+{
+    int cx0, cy0, cx1, cy1, cx, cy;
+    uint32_t visited = 0;
+    long cells;
+
+    if (!grid || !mask || grid->count == 0) {
+        return 0;
+    }
+
+    cx0 = node_grid_cell(x0);
+    cy0 = node_grid_cell(y0);
+    cx1 = node_grid_cell(x1);
+    cy1 = node_grid_cell(y1);
+    if (cx1 < cx0 || cy1 < cy0) {
+        return 0;
+    }
+
+    cells = (long)(cx1 - cx0 + 1) * (long)(cy1 - cy0 + 1);
+    if (cells > NODE_GRID_BUCKETS) {
+        /* Wide view: walking every chain is cheaper than every cell */
+        uint32_t b;
+        for (b = 0; b < NODE_GRID_BUCKETS; b++) {
+            uint16_t r;
+            for (r = grid->bucket[b]; r != NODE_GRID_NONE; r = grid->refs[r].next) {
+                const NodeGridRef *ref = &grid->refs[r];
+                visited++;
+                if (ref->cx >= cx0 && ref->cx <= cx1 && ref->cy >= cy0 && ref->cy <= cy1) {
+                    mask[ref->node >> 5] |= 1u << (ref->node & 31);
+                }
+            }
+        }
+        return visited;
+    }
+
+    for (cy = cy0; cy <= cy1; cy++) {
+        for (cx = cx0; cx <= cx1; cx++) {
+            uint16_t r;
+            for (r = grid->bucket[node_grid_hash(cx, cy)]; r != NODE_GRID_NONE;
+                 r = grid->refs[r].next) {
+                const NodeGridRef *ref = &grid->refs[r];
+                visited++;
+                if (ref->cx == cx && ref->cy == cy) {
+                    mask[ref->node >> 5] |= 1u << (ref->node & 31);
+                }
+            }
+        }
+    }
+    return visited;
+}
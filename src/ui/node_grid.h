@@ -0,0 +1,84 @@
+#ifndef UI_NODE_GRID_H
+#define UI_NODE_GRID_H
+
+#include "../common.h"
+#include "../graph/graph_types.h"
+#include <stdint.h>
+
+/* ============================================================
+ * Node Grid
+ * ============================================================
+ * Uniform grid over UiMeta canvas positions, used by the editor
+ * for viewport culling and cursor hit tests. A node is stored in
+ * every cell its box (plus a margin for ports and rounding)
+ * overlaps; the padded box must fit in one cell, so that is at
+ * most 2 x 2 cells. The canvas is unbounded: cells hash into
+ * NODE_GRID_BUCKETS chains.
+ *
+ * node_grid_sync() compares every node with the position it was
+ * stored at and only moves, adds or removes the ones that changed.
+ * Queries return candidates; callers do the exact test.
+ *
+ * Portable C: no ps2sdk dependency.
+ *
+ * Memory usage:
+ *   NodeGrid: NODE_GRID_BUCKETS * 2 + NODE_GRID_MAX_REFS * 8
+ *             + MAX_NODES * 20 = ~15KB at MAX_NODES 256
+ * ============================================================ */
+
+#define NODE_GRID_CELL        128     /* Canvas units per cell side */
+#define NODE_GRID_BUCKETS     1024    /* Power of two */
+#define NODE_GRID_MAX_REFS    (MAX_NODES * 4)
+#define NODE_GRID_NONE        0xFFFF
+#define NODE_GRID_MASK_WORDS  ((MAX_NODES + 31) / 32)
+
+/* One node in one cell (chained per bucket) */
+typedef struct {
+    int16_t  cx;
+    int16_t  cy;
+    NodeId   node;
+    uint16_t next;              /* Next ref in the bucket or free list */
+} NodeGridRef;
+
+typedef struct {
+    float    x;                 /* Position stored */
+    float    y;
+    int16_t  cx0, cy0;          /* Cells covered (inclusive) */
+    int16_t  cx1, cy1;
+    uint8_t  present;
+    uint8_t  _pad[3];
+} NodeGridSlot;
+
+typedef struct {
+    uint16_t     bucket[NODE_GRID_BUCKETS];
+    NodeGridRef  refs[NODE_GRID_MAX_REFS];
+    NodeGridSlot slots[MAX_NODES];
+    uint16_t     free_ref;
+    int          box_w;
+    int          box_h;
+    int          margin;
+    uint32_t     count;         /* Nodes stored */
+} NodeGrid;
+
+/* Empty grid for boxes of box_w x box_h at each position, padded
+ * by margin on every side. Returns 0 on success, -1 if the padded
+ * box does not fit in a cell. */
+int node_grid_init(NodeGrid *grid, int box_w, int box_h, int margin);
+
+/* Add a node or move it to (x, y). Returns 1 if anything changed. */
+int node_grid_set(NodeGrid *grid, NodeId id, float x, float y);
+
+/* Remove a node (no-op if absent) */
+void node_grid_remove(NodeGrid *grid, NodeId id);
+
+/* Bring the grid in line with the graph's live nodes and their
+ * positions. Returns the number of nodes added, moved or removed. */
+uint32_t node_grid_sync(NodeGrid *grid, const Graph *g, const UiMetaBank *ui);
+
+/* Set the bit of every node stored in a cell overlapping the canvas
+ * rect [x0, x1] x [y0, y1] in mask (NODE_GRID_MASK_WORDS words, not
+ * cleared). Returns the number of refs visited. */
+uint32_t node_grid_query_rect(const NodeGrid *grid, float x0, float y0,
+                              float x1, float y1, uint32_t *mask);
+
+#endif /* UI_NODE_GRID_H */
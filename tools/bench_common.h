@@ -0,0 +1,28 @@
+/*
+ * PS2 Live Graph Studio - Host Benchmark Helpers
+ * bench_common.h - Shared timing helpers for tools/bench_*.c
+ *
+ * Host-only (POSIX). Include before any other system header.
+ */
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <time.h>
+
+/* Monotonic wall clock in seconds */
+static double bench_now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Keep the optimizer from discarding benchmark results */
+static volatile float g_bench_sink;
+
+#endif /* BENCH_COMMON_H */
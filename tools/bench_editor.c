@@ -0,0 +1,578 @@
+/*
+ * PS2 Live Graph Studio - Node Editor Benchmark (host)
+ * bench_editor.c - Cursor hit tests and picture rebuilds with
+ *                  thousands of nodes
+ *
+ * Scatters N nodes over a canvas (editor_init spacing, jittered)
+ * with one wire per node to a recent node and a few long ones,
+ * then at random pans and cursor positions:
+ *   - hit tests: the linear scan the editor used before the node
+ *     grid vs ui_editor_update() with X pressed (NAV: node, WIRE:
+ *     port), at zooms from 1.5 to 0.15; the results must match
+ *   - frames: the linear wire/node loops vs an invalidated
+ *     ui_editor_draw(), both drawn through render.h with the
+ *     software backend at 640x480 (display list, sort, raster);
+ *     nodes drawn must match the ones on screen
+ *   - minimap: rebuild time and the runs it draws every frame
+ *   - LOD: editor primitives, display list commands and ms per
+ *     frame at each zoom tier (full, header, block)
+ *
+ * Build (MAX_NODES raised for this tool only; .gph files written
+ * by such a build do not load in the app):
+ *   cc -O2 -std=c99 -Isrc -DMAX_NODES=4096 -o tools/bench_editor tools/bench_editor.c \
+ *      src/ui/editor.c src/ui/node_grid.c src/ui/minimap.c src/ui/command_palette.c \
+ *      src/render/render.c src/render/render_soft.c src/render/soft_raster.c \
+ *      src/render/soft_tiles.c src/render/soft_pool.c src/render/soft_scale.c \
+ *      src/render/display_list.c src/render/circle_lut.c src/render/font.c \
+ *      src/render/text_fmt.c src/graph/graph_core.c src/graph/graph_validate.c \
+ *      src/graph/graph_eval.c src/graph/graph_probe.c src/graph/graph_eval_fixed.c \
+ *      src/graph/graph_eval_block.c src/graph/graph_eval_fragment.c src/graph/graph_publish.c \
+ *      src/nodes/node_registry.c src/nodes/node_basic.c src/nodes/node_extended.c \
+ *      src/nodes/node_particles.c src/nodes/node_fragment.c src/nodes/node_block.c \
+ *      src/runtime/runtime.c src/io/graph_io.c -lm -pthread
+ */
+
+#include "bench_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ui/editor.h"
+#include "graph/graph_core.h"
+#include "nodes/node_registry.h"
+#include "render/render.h"
+#include "render/render_backend.h"
+#include "render/font.h"
+
+#define BENCH_SAMPLES    2000     /* Pans/cursors per node count */
+#define BENCH_FRAMES     200      /* Rendered frames per node count */
+#define BENCH_LONG_WIRES 16       /* Wires spanning the canvas */
+
+static Graph     s_graph;
+static GraphUi   s_meta;
+static UiEditor  s_ui;
+static uint32_t  s_prims;
+static uint32_t  s_node_rects;
+static uint8_t   s_layer;
+static uint32_t  s_seed = 12345u;
+
+typedef struct {
+    float pan_x, pan_y;
+    float cursor_x, cursor_y;
+    float zoom;
+} Sample;
+
+static Sample s_samples[BENCH_SAMPLES];
+
+static uint32_t bench_rand(void)
+{
+    s_seed = s_seed * 1103515245u + 12345u;
+    return s_seed >> 8;
+}
+
+/* Canvas length in pixels at the current zoom (as the editor) */
+static int scaled(int len)
+{
+    int v = (int)((float)len * s_ui.zoom + 0.5f);
+    return (v > 0) ? v : 1;
+}
+
+/* ============================================================
+ * Counting Render API
+ * ============================================================ */
+static void count_rect(int x, int y, int w, int h, uint32_t color)
+{
+    (void)x; (void)y; (void)color;
+    s_prims++;
+    if (s_layer == DL_LAYER_UI_NODES && w == scaled(NODE_W) && h == scaled(NODE_H)) {
+        s_node_rects++;
+    }
+}
+
+static void count_outline(int x, int y, int w, int h, uint32_t color)
+{
+    (void)x; (void)y; (void)w; (void)h; (void)color;
+    s_prims++;
+}
+
+static void count_line(int x1, int y1, int x2, int y2, uint32_t color)
+{
+    (void)x1; (void)y1; (void)x2; (void)y2; (void)color;
+    s_prims++;
+}
+
+static void count_text(int x, int y, uint32_t color, const char *text)
+{
+    (void)x; (void)y; (void)color; (void)text;
+    s_prims++;
+}
+
+static void count_layer(uint8_t layer)
+{
+    s_layer = layer;
+}
+
+static const RenderApi s_count_render = { count_rect, count_outline, count_line, count_layer };
+static const FontApi s_count_font = { count_text };
+
+/* ============================================================
+ * Render API (as editor_draw)
+ * ============================================================ */
+static void soft_rect(int x, int y, int w, int h, uint32_t color)
+{
+    render_rect_screen(x, y, w, h, (uint64_t)color);
+}
+
+static void soft_outline(int x, int y, int w, int h, uint32_t color)
+{
+    render_rect_outline_screen(x, y, w, h, (uint64_t)color);
+}
+
+static void soft_line(int x1, int y1, int x2, int y2, uint32_t color)
+{
+    render_line_screen(x1, y1, x2, y2, (uint64_t)color);
+}
+
+static void soft_layer(uint8_t layer)
+{
+    render_set_layer(layer);
+}
+
+static void soft_text(int x, int y, uint32_t color, const char *text)
+{
+    font_draw_string_screen(text, x, y, (uint64_t)color, 1);
+}
+
+static const RenderApi s_soft_render = { soft_rect, soft_outline, soft_line, soft_layer };
+static const FontApi s_soft_font = { soft_text };
+
+/* ============================================================
+ * Linear Reference (the editor before the node grid)
+ * ============================================================ */
+static void screen_pos(NodeId id, int *x, int *y)
+{
+    *x = (int)((s_meta.meta[id].x - s_ui.pan_x) * s_ui.zoom + (SCREEN_W / 2.0f) + 0.5f);
+    *y = (int)((s_meta.meta[id].y - s_ui.pan_y) * s_ui.zoom + (CANVAS_Y1 / 2.0f) + 0.5f);
+}
+
+static NodeId linear_node_hit(void)
+{
+    int i;
+    for (i = MAX_NODES - 1; i >= 0; --i) {
+        int x, y;
+        if (s_graph.nodes[i].type == NODE_TYPE_NONE) {
+            continue;
+        }
+        screen_pos((NodeId)i, &x, &y);
+        if (s_ui.cursor_x >= x && s_ui.cursor_x < x + scaled(NODE_W) &&
+            s_ui.cursor_y >= y && s_ui.cursor_y < y + scaled(NODE_H)) {
+            return (NodeId)i;
+        }
+    }
+    return INVALID_NODE_ID;
+}
+
+/* Topmost port under the cursor; sets *is_output */
+static NodeId linear_port_hit(int *is_output)
+{
+    int i, p, side;
+    for (i = MAX_NODES - 1; i >= 0; --i) {
+        const NodeMeta *meta;
+        int x, y;
+        if (s_graph.nodes[i].type == NODE_TYPE_NONE) {
+            continue;
+        }
+        meta = node_registry_get_meta(s_graph.nodes[i].type);
+        if (!meta) {
+            continue;
+        }
+        screen_pos((NodeId)i, &x, &y);
+        for (side = 0; side < 2; side++) {
+            int ports = side ? meta->num_outputs : meta->num_inputs;
+            for (p = ports - 1; p >= 0; --p) {
+                int dx = (int)(s_ui.cursor_x - (side ? x + scaled(NODE_W) : x));
+                int dy = (int)(s_ui.cursor_y - (y + scaled(PORT_TOP_Y + p * PORT_GAP_Y)));
+                if (dx * dx + dy * dy <= PORT_HIT_R * PORT_HIT_R) {
+                    *is_output = side;
+                    return (NodeId)i;
+                }
+            }
+        }
+    }
+    return INVALID_NODE_ID;
+}
+
+/* Wire and node primitives at zoom 1, every node, no culling */
+static void linear_draw(const RenderApi *r, const FontApi *f)
+{
+    int i, p;
+    for (i = 0; i < MAX_NODES; ++i) {
+        const Node *n = &s_graph.nodes[i];
+        const NodeMeta *meta;
+        if (n->type == NODE_TYPE_NONE || !(meta = node_registry_get_meta(n->type))) {
+            continue;
+        }
+        for (p = 0; p < (int)meta->num_inputs; ++p) {
+            NodeId src = n->inputs[p].src_node;
+            int sx, sy, dx, dy, mx;
+            if (src == INVALID_NODE_ID || s_graph.nodes[src].type == NODE_TYPE_NONE) {
+                continue;
+            }
+            screen_pos(src, &sx, &sy);
+            screen_pos((NodeId)i, &dx, &dy);
+            sx += NODE_W;
+            sy += PORT_TOP_Y + n->inputs[p].src_port * PORT_GAP_Y;
+            dy += PORT_TOP_Y + p * PORT_GAP_Y;
+            mx = (sx + dx) / 2;
+            r->line(sx, sy, mx, sy, 0x80C0C0C0u);
+            r->line(mx, sy, mx, dy, 0x80C0C0C0u);
+            r->line(mx, dy, dx, dy, 0x80C0C0C0u);
+        }
+    }
+    if (r->set_layer) {
+        r->set_layer(DL_LAYER_UI_NODES);
+    }
+    for (i = 0; i < MAX_NODES; ++i) {
+        const NodeMeta *meta;
+        int x, y;
+        if (s_graph.nodes[i].type == NODE_TYPE_NONE) {
+            continue;
+        }
+        screen_pos((NodeId)i, &x, &y);
+        r->rect_filled(x, y, NODE_W, NODE_H, 0x80404040u);
+        r->rect_outline(x, y, NODE_W, NODE_H, 0x80808080u);
+        r->rect_filled(x, y, NODE_W, NODE_HEADER_H, 0x80603020u);
+        f->draw_text(x + NODE_PAD_X, y + NODE_PAD_Y, 0x80FFFFFFu, "NODE");
+        meta = node_registry_get_meta(s_graph.nodes[i].type);
+        if (!meta) {
+            continue;
+        }
+        for (p = 0; p < (int)meta->num_inputs; ++p) {
+            r->rect_filled(x - PORT_R, y + PORT_TOP_Y + p * PORT_GAP_Y - PORT_R,
+                           PORT_R * 2, PORT_R * 2, 0x8000C0FFu);
+        }
+        for (p = 0; p < (int)meta->num_outputs; ++p) {
+            r->rect_filled(x + NODE_W - PORT_R, y + PORT_TOP_Y + p * PORT_GAP_Y - PORT_R,
+                           PORT_R * 2, PORT_R * 2, 0x80FFC000u);
+        }
+    }
+}
+
+/* Nodes with any part on screen */
+static uint32_t linear_visible(void)
+{
+    uint32_t visible = 0;
+    int i;
+    for (i = 0; i < MAX_NODES; ++i) {
+        int x, y;
+        if (s_graph.nodes[i].type == NODE_TYPE_NONE) {
+            continue;
+        }
+        screen_pos((NodeId)i, &x, &y);
+        if (x + scaled(NODE_W) + PORT_R > 0 && x - PORT_R < SCREEN_W &&
+            y + scaled(NODE_H) > 0 && y < SCREEN_H) {
+            visible++;
+        }
+    }
+    return visible;
+}
+
+/* ============================================================
+ * Setup
+ * ============================================================ */
+static void build_graph(int count, float *out_w, float *out_h)
+{
+    static const NodeType types[] = {
+        NODE_TYPE_TIME, NODE_TYPE_SIN, NODE_TYPE_ADD, NODE_TYPE_MUL, NODE_TYPE_LFO
+    };
+    int cols = 1;
+    int i;
+
+    while (cols * cols < count) {
+        cols++;
+    }
+
+    graph_init(&s_graph);
+    memset(&s_meta, 0, sizeof(s_meta));
+
+    for (i = 0; i < count; i++) {
+        NodeId id;
+        if (graph_alloc_node(&s_graph, types[i % 5], &id) != STATUS_OK) {
+            break;
+        }
+        s_meta.meta[id].x = (float)((i % cols) * 220 + (int)(bench_rand() % 60));
+        s_meta.meta[id].y = (float)((i / cols) * 140 + (int)(bench_rand() % 40));
+        if (i > 0 && (types[i % 5] != NODE_TYPE_TIME)) {
+            NodeId src = (NodeId)(i - 1 - (int)(bench_rand() % LGS_MIN(i, 8)));
+            if (i < BENCH_LONG_WIRES + 1) {
+                src = 0;
+            }
+            graph_connect(&s_graph, src, 0, id, 0);
+        }
+    }
+
+    *out_w = (float)(cols * 220);
+    *out_h = (float)(((count + cols - 1) / cols) * 140);
+}
+
+static void build_samples(float w, float h)
+{
+    static const float zooms[] = { 1.0f, 1.5f, 0.6f, 0.3f, 0.15f };
+    int i;
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        s_samples[i].zoom = zooms[bench_rand() % 5];
+        s_samples[i].pan_x = (float)(bench_rand() % (uint32_t)(w + 1.0f));
+        s_samples[i].pan_y = (float)(bench_rand() % (uint32_t)(h + 1.0f));
+        do {
+            /* X on the minimap jumps the view: keep hit tests off it */
+            s_samples[i].cursor_x = (float)(bench_rand() % SCREEN_W);
+            s_samples[i].cursor_y = (float)(bench_rand() % (CANVAS_Y1 + 1));
+        } while (s_samples[i].cursor_x >= UI_MINIMAP_X && s_samples[i].cursor_y >= UI_MINIMAP_Y &&
+                 s_samples[i].cursor_y < UI_MINIMAP_Y + MINIMAP_H);
+    }
+}
+
+static void apply_sample(const Sample *s)
+{
+    s_ui.pan_x = s->pan_x;
+    s_ui.pan_y = s->pan_y;
+    s_ui.cursor_x = s->cursor_x;
+    s_ui.cursor_y = s->cursor_y;
+    s_ui.zoom = s->zoom;
+}
+
+/* Render one editor frame; returns display list commands */
+static uint32_t render_editor_frame(void)
+{
+    render_begin_frame();
+    render_clear(0x80000000u);
+    ui_editor_invalidate(&s_ui);
+    ui_editor_draw(&s_ui, &s_graph, &s_meta, NULL, NULL, &s_soft_render, &s_soft_font);
+    render_end_frame();
+    return render_get_display_list()->stat_cmds;
+}
+
+/* ============================================================
+ * Runs
+ * ============================================================ */
+static const char *lod_name(UiLod lod)
+{
+    switch (lod) {
+        case UI_LOD_HEADER: return "header";
+        case UI_LOD_BLOCK:  return "block";
+        default:            return "full";
+    }
+}
+
+/* Minimap rebuild (layout changes only) vs its fixed draw cost */
+static void bench_minimap(void)
+{
+    static Minimap mm;
+    double t0, t;
+    int i;
+
+    t0 = bench_now_seconds();
+    for (i = 0; i < BENCH_FRAMES; i++) {
+        minimap_build(&mm, &s_graph, &s_meta, NODE_W, NODE_H);
+    }
+    t = bench_now_seconds() - t0;
+    printf("  minimap    build %8.2f us   %u runs drawn per frame\n",
+           t * 1e6 / BENCH_FRAMES, (unsigned)mm.run_count);
+}
+
+/* Primitives per frame by zoom tier (graph already built) */
+static void bench_lod(void)
+{
+    static const float zooms[] = { 1.0f, 0.6f, 0.3f, 0.15f };
+    uint32_t base;
+    int z, i;
+
+    /* Canvas + HUD alone: pan away from every node */
+    apply_sample(&s_samples[0]);
+    s_ui.pan_x = -1.0e6f;
+    base = render_editor_frame();
+
+    printf("  zoom  lod      nodes  calls  dl cmds  cmds/node  ms/frame\n");
+    for (z = 0; z < (int)(sizeof(zooms) / sizeof(zooms[0])); z++) {
+        uint32_t visible = 0, cmds = 0;
+        double t0, t;
+
+        s_prims = 0;
+        for (i = 0; i < BENCH_FRAMES; i++) {
+            apply_sample(&s_samples[i]);
+            s_ui.zoom = zooms[z];
+            visible += linear_visible();
+            ui_editor_invalidate(&s_ui);
+            ui_editor_draw(&s_ui, &s_graph, &s_meta, NULL, NULL, &s_count_render, &s_count_font);
+        }
+
+        t0 = bench_now_seconds();
+        for (i = 0; i < BENCH_FRAMES; i++) {
+            apply_sample(&s_samples[i]);
+            s_ui.zoom = zooms[z];
+            cmds += render_editor_frame();
+        }
+        t = bench_now_seconds() - t0;
+
+        printf("  %4.2f  %-7s %6u %6u %8u %10.1f %9.3f\n", (double)zooms[z],
+               lod_name(ui_editor_lod(&s_ui)), visible / BENCH_FRAMES,
+               s_prims / BENCH_FRAMES, cmds / BENCH_FRAMES,
+               visible ? (double)(cmds - base * BENCH_FRAMES) / visible : 0.0,
+               t * 1e3 / BENCH_FRAMES);
+    }
+}
+
+static void bench_count(int count)
+{
+    PadState up, press;
+    float w, h;
+    double t0, t_lin_hit, t_grid_hit, t_lin_draw, t_grid_draw;
+    uint32_t mismatches = 0;
+    uint32_t lin_prims = 0, grid_prims = 0, visible = 0, drawn = 0;
+    int i;
+
+    build_graph(count, &w, &h);
+    build_samples(w, h);
+    ui_editor_init(&s_ui);
+    memset(&up, 0, sizeof(up));
+    press = up;
+    press.held = BTN_CROSS;
+
+    /* Hit tests */
+    t0 = bench_now_seconds();
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        int is_output = 0;
+        apply_sample(&s_samples[i]);
+        g_bench_sink += (float)linear_node_hit();
+        g_bench_sink += (float)linear_port_hit(&is_output);
+    }
+    t_lin_hit = bench_now_seconds() - t0;
+
+    t0 = bench_now_seconds();
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        apply_sample(&s_samples[i]);
+        s_ui.mode = UI_EDITOR_MODE_NAV;
+        s_ui.selected_node = INVALID_NODE_ID;
+        ui_editor_update(&s_ui, &press, &up, &s_graph, &s_meta, NULL, NULL, 0.0f);
+        g_bench_sink += (float)s_ui.selected_node;
+
+        s_ui.mode = UI_EDITOR_MODE_WIRE;
+        s_ui.wire_src_node = INVALID_NODE_ID;
+        ui_editor_update(&s_ui, &press, &up, &s_graph, &s_meta, NULL, NULL, 0.0f);
+        g_bench_sink += (float)s_ui.wire_src_node;
+    }
+    t_grid_hit = bench_now_seconds() - t0;
+
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        int is_output = 0;
+        NodeId port;
+        apply_sample(&s_samples[i]);
+        s_ui.mode = UI_EDITOR_MODE_NAV;
+        s_ui.selected_node = INVALID_NODE_ID;
+        ui_editor_update(&s_ui, &press, &up, &s_graph, &s_meta, NULL, NULL, 0.0f);
+        if (s_ui.selected_node != linear_node_hit()) {
+            mismatches++;
+        }
+
+        s_ui.mode = UI_EDITOR_MODE_WIRE;
+        s_ui.wire_src_node = INVALID_NODE_ID;
+        ui_editor_update(&s_ui, &press, &up, &s_graph, &s_meta, NULL, NULL, 0.0f);
+        port = linear_port_hit(&is_output);
+        if (s_ui.wire_src_node != (is_output ? port : INVALID_NODE_ID)) {
+            mismatches++;
+        }
+    }
+
+    /* Frames at zoom 1: record, sort, rasterize */
+    s_ui.mode = UI_EDITOR_MODE_NAV;
+    s_ui.selected_node = INVALID_NODE_ID;
+    s_prims = 0;
+    for (i = 0; i < BENCH_FRAMES; i++) {
+        apply_sample(&s_samples[i]);
+        s_ui.zoom = 1.0f;
+        linear_draw(&s_count_render, &s_count_font);
+    }
+    lin_prims = s_prims;
+
+    t0 = bench_now_seconds();
+    for (i = 0; i < BENCH_FRAMES; i++) {
+        apply_sample(&s_samples[i]);
+        s_ui.zoom = 1.0f;
+        render_begin_frame();
+        render_clear(0x80000000u);
+        render_set_layer(DL_LAYER_UI_WIRES);
+        linear_draw(&s_soft_render, &s_soft_font);
+        render_end_frame();
+    }
+    t_lin_draw = bench_now_seconds() - t0;
+
+    s_prims = 0;
+    for (i = 0; i < BENCH_FRAMES; i++) {
+        apply_sample(&s_samples[i]);
+        s_ui.zoom = 1.0f;
+        ui_editor_invalidate(&s_ui);
+        ui_editor_draw(&s_ui, &s_graph, &s_meta, NULL, NULL, &s_count_render, &s_count_font);
+    }
+    grid_prims = s_prims;
+
+    t0 = bench_now_seconds();
+    for (i = 0; i < BENCH_FRAMES; i++) {
+        apply_sample(&s_samples[i]);
+        s_ui.zoom = 1.0f;
+        render_editor_frame();
+    }
+    t_grid_draw = bench_now_seconds() - t0;
+
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        apply_sample(&s_samples[i]);
+        s_node_rects = 0;
+        s_ui.draw_serial++;
+        ui_editor_draw(&s_ui, &s_graph, &s_meta, NULL, NULL, &s_count_render, &s_count_font);
+        visible += linear_visible();
+        drawn += s_node_rects;
+    }
+    if (drawn != visible) {
+        mismatches++;
+    }
+
+    printf("%5d nodes (%d x %d canvas, %u on screen per sample)\n",
+           count, (int)w, (int)h, visible / BENCH_SAMPLES);
+    printf("  hit test   linear %8.2f us   grid %8.2f us (%.1fx)\n",
+           t_lin_hit * 1e6 / BENCH_SAMPLES, t_grid_hit * 1e6 / BENCH_SAMPLES,
+           t_lin_hit / t_grid_hit);
+    printf("  frame      linear %8.2f ms   grid %8.2f ms (%.1fx)\n",
+           t_lin_draw * 1e3 / BENCH_FRAMES, t_grid_draw * 1e3 / BENCH_FRAMES,
+           t_lin_draw / t_grid_draw);
+    printf("  calls      linear %8u      grid %8u (grid incl. canvas + HUD)\n",
+           lin_prims / BENCH_FRAMES, grid_prims / BENCH_FRAMES);
+    printf("  check: %s (%u mismatches)\n", mismatches ? "FAIL" : "OK", mismatches);
+    bench_minimap();
+    bench_lod();
+    printf("\n");
+}
+
+int main(void)
+{
+    static const int counts[] = { 64, 256, 1024, 4096 };
+    int i;
+
+    node_registry_init();
+    if (render_set_resolution(SCREEN_W, SCREEN_H) != 0 ||
+        render_set_backend(render_backend_soft()) != 0 || render_init() != 0 ||
+        font_init() != 0) {
+        fprintf(stderr, "Render init failed\n");
+        return 1;
+    }
+    printf("MAX_NODES %d, %d hit test samples, %d frames per count\n\n",
+           MAX_NODES, BENCH_SAMPLES, BENCH_FRAMES);
+
+    for (i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) {
+        if (counts[i] <= MAX_NODES) {
+            bench_count(counts[i]);
+        }
+    }
+
+    font_shutdown();
+    render_shutdown();
+    return 0;
+}
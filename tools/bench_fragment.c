@@ -0,0 +1,273 @@
+/*
+ * PS2 Live Graph Studio - Fragment Shading Benchmark (host)
+ * bench_fragment.c - Per-pixel graph throughput in megapixels/second
+ *
+ * Builds a plasma shader graph (UV -> sin/cos/radial terms -> MAP ->
+ * FRAG_OUT, 16 per-pixel nodes) and shades it at 640x480 and
+ * 1920x1080: first with graph_eval once per pixel (the scalar
+ * frame-mode evaluator), then with render_fragment at 1, 2, 4, ...
+ * threads. Checks the fragment image is identical across thread
+ * counts and within 1/255 of the scalar one.
+ *
+ * Usage:
+ *   bench_fragment [max_threads]   (default 8)
+ *
+ * Build:
+ *   cc -O2 -std=c99 -Isrc -o tools/bench_fragment tools/bench_fragment.c \
+ *      src/render/render_fragment.c src/render/soft_pool.c \
+ *      src/graph/graph_core.c src/graph/graph_validate.c src/graph/graph_eval.c \
+ *      src/graph/graph_probe.c src/graph/graph_eval_block.c src/graph/graph_eval_fragment.c \
+ *      src/nodes/node_registry.c src/nodes/node_basic.c src/nodes/node_extended.c \
+ *      src/nodes/node_particles.c src/nodes/node_fragment.c src/nodes/node_block.c \
+ *      src/runtime/runtime.c -lm -pthread
+ */
+
+#include "bench_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/graph/graph_core.h"
+#include "../src/graph/graph_validate.h"
+#include "../src/graph/graph_eval.h"
+#include "../src/graph/graph_eval_fragment.h"
+#include "../src/nodes/node_registry.h"
+#include "../src/render/render_fragment.h"
+
+#define BENCH_MIN_TIME  0.5      /* Seconds per timed section */
+#define BENCH_TIME      1.25f    /* Shader clock */
+
+static const int s_sizes[][2] = { { 640, 480 }, { 1920, 1080 } };
+
+static Graph        s_graph;
+static EvalPlan     s_plan;
+static EvalPlan     s_frame_plan;       /* Frame pass that feeds the uniforms */
+static OutputBank   s_bank;
+static FragmentPlan s_frag;
+
+/* ============================================================
+ * Shader Graph
+ * ============================================================ */
+static NodeId add_node(NodeType type)
+{
+    NodeId id = INVALID_NODE_ID;
+
+    if (graph_alloc_node(&s_graph, type, &id) != STATUS_OK) {
+        fprintf(stderr, "graph full\n");
+        exit(2);
+    }
+    return id;
+}
+
+static NodeId add_op(NodeType type, NodeId a, uint8_t pa, NodeId b, uint8_t pb)
+{
+    NodeId id = add_node(type);
+
+    graph_connect(&s_graph, a, pa, id, 0);
+    if (b != INVALID_NODE_ID) {
+        graph_connect(&s_graph, b, pb, id, 1);
+    }
+    return id;
+}
+
+/* sin/cos with frequency param */
+static NodeId add_wave(NodeType type, NodeId src, float freq)
+{
+    NodeId id = add_op(type, src, 0, INVALID_NODE_ID, 0);
+
+    graph_set_param(&s_graph, id, 0, freq);
+    graph_set_param(&s_graph, id, 1, 1.0f);
+    return id;
+}
+
+/* -1..1 -> 0..1 */
+static NodeId add_unit(NodeId src)
+{
+    NodeId id = add_op(NODE_TYPE_MAP, src, 0, INVALID_NODE_ID, 0);
+
+    graph_set_param(&s_graph, id, 0, -1.0f);
+    graph_set_param(&s_graph, id, 1, 1.0f);
+    graph_set_param(&s_graph, id, 2, 0.0f);
+    graph_set_param(&s_graph, id, 3, 1.0f);
+    return id;
+}
+
+static void build_plasma(void)
+{
+    NodeId uv, t, a, b, r2, c, ab, out;
+
+    graph_init(&s_graph);
+    uv = add_node(NODE_TYPE_UV);
+    t = add_node(NODE_TYPE_TIME);
+
+    a = add_wave(NODE_TYPE_SIN, add_op(NODE_TYPE_ADD, uv, 2, t, 0), 5.0f);
+    b = add_wave(NODE_TYPE_COS, add_op(NODE_TYPE_SUB, uv, 3, t, 0), 4.0f);
+    r2 = add_op(NODE_TYPE_ADD,
+                add_op(NODE_TYPE_MUL, uv, 2, uv, 2), 0,
+                add_op(NODE_TYPE_MUL, uv, 3, uv, 3), 0);
+    c = add_wave(NODE_TYPE_SIN, add_op(NODE_TYPE_SUB, r2, 0, t, 0), 9.0f);
+    ab = add_wave(NODE_TYPE_COS, add_op(NODE_TYPE_ADD, a, 0, b, 0), 2.0f);
+
+    out = add_node(NODE_TYPE_FRAG_OUT);
+    graph_connect(&s_graph, add_unit(a), 0, out, 0);
+    graph_connect(&s_graph, add_unit(ab), 0, out, 1);
+    graph_connect(&s_graph, add_unit(c), 0, out, 2);
+}
+
+/* ============================================================
+ * Scalar Reference (graph_eval per pixel)
+ * ============================================================ */
+static void shade_scalar(uint32_t *pixels, int width, int height)
+{
+    RuntimeContext ctx;
+    int x, y, c;
+
+    runtime_init(&ctx);
+    ctx.time = BENCH_TIME;
+    ctx.frag_width = (uint16_t)width;
+    ctx.frag_height = (uint16_t)height;
+
+    for (y = 0; y < height; y++) {
+        ctx.frag_y = (uint16_t)y;
+        for (x = 0; x < width; x++) {
+            uint32_t p = 0x80000000u;
+
+            ctx.frag_x = (uint16_t)x;
+            graph_eval(&s_graph, &s_plan, &s_bank, &ctx);
+            for (c = 0; c < 3; c++) {
+                float v = graph_eval_get_output(&s_bank, s_frag.output, (uint8_t)c);
+                p |= (uint32_t)(v * 255.0f + 0.5f) << (c * 8);
+            }
+            pixels[(long)y * width + x] = p;
+        }
+    }
+}
+
+/* Largest per-channel difference between two images */
+static int max_channel_diff(const uint32_t *a, const uint32_t *b, long n)
+{
+    int worst = 0;
+    long i;
+    int c;
+
+    for (i = 0; i < n; i++) {
+        for (c = 0; c < 4; c++) {
+            int d = (int)((a[i] >> (c * 8)) & 0xFF) - (int)((b[i] >> (c * 8)) & 0xFF);
+            if (d < 0) d = -d;
+            if (d > worst) worst = d;
+        }
+    }
+    return worst;
+}
+
+/* ============================================================
+ * Main
+ * ============================================================ */
+int main(int argc, char **argv)
+{
+    int max_threads = argc > 1 ? atoi(argv[1]) : 8;
+    RuntimeContext ctx;
+    int failures = 0;
+    size_t s;
+
+    if (max_threads < 1) max_threads = 1;
+    if (max_threads > SOFT_POOL_MAX_THREADS) max_threads = SOFT_POOL_MAX_THREADS;
+
+    node_registry_init();
+    build_plasma();
+    if (graph_build_eval_plan(&s_graph, &s_plan) != STATUS_OK ||
+        graph_build_fragment_plan(&s_graph, &s_plan, &s_frag) != STATUS_OK) {
+        fprintf(stderr, "shader graph rejected\n");
+        return 2;
+    }
+    graph_fragment_uniform_plan(&s_frag, &s_plan, &s_frame_plan);
+    graph_eval_init_outputs(&s_bank);
+
+    /* Uniforms for the fragment runs (frame-mode pass) */
+    runtime_init(&ctx);
+    ctx.time = BENCH_TIME;
+    graph_eval(&s_graph, &s_frame_plan, &s_bank, &ctx);
+
+    printf("plasma shader: %u nodes, %u per pixel, %u uniforms\n",
+           (unsigned)s_plan.count, (unsigned)s_frag.count, (unsigned)s_frag.uniform_count);
+
+    for (s = 0; s < sizeof(s_sizes) / sizeof(s_sizes[0]); s++) {
+        int width = s_sizes[s][0];
+        int height = s_sizes[s][1];
+        long pixels = (long)width * height;
+        size_t bytes = (size_t)pixels * sizeof(uint32_t);
+        uint32_t *ref = (uint32_t *)malloc(bytes);
+        uint32_t *first = (uint32_t *)malloc(bytes);
+        uint32_t *out = (uint32_t *)malloc(bytes);
+        SoftTarget target;
+        double t0, mps, scalar_mps;
+        int frames, threads;
+
+        if (!ref || !first || !out) {
+            fprintf(stderr, "out of memory\n");
+            return 2;
+        }
+        target.pixels = out;
+        target.width = width;
+        target.height = height;
+        target.stride = width;
+
+        printf("\n%dx%d\n", width, height);
+
+        frames = 0;
+        t0 = bench_now_seconds();
+        do {
+            shade_scalar(ref, width, height);
+            frames++;
+        } while (bench_now_seconds() - t0 < BENCH_MIN_TIME);
+        scalar_mps = (double)pixels * frames / ((bench_now_seconds() - t0) * 1e6);
+        printf("  scalar graph_eval  %8.2f MP/s\n", scalar_mps);
+
+        /* Uniforms were evaluated at the reference context */
+        graph_eval(&s_graph, &s_frame_plan, &s_bank, &ctx);
+
+        for (threads = 1; threads <= max_threads; threads *= 2) {
+            FragmentRenderer fr;
+            int diff;
+
+            if (render_fragment_init(&fr, threads) != 0) {
+                fprintf(stderr, "render_fragment_init(%d) failed\n", threads);
+                return 2;
+            }
+
+            memset(out, 0, bytes);
+            render_fragment(&fr, &s_graph, &s_frag, &s_bank, &ctx, &target);
+            if (threads == 1) {
+                memcpy(first, out, bytes);
+            } else if (memcmp(first, out, bytes) != 0) {
+                failures++;
+            }
+            diff = max_channel_diff(ref, out, pixels);
+            if (diff > 1) {
+                failures++;
+            }
+
+            frames = 0;
+            t0 = bench_now_seconds();
+            do {
+                render_fragment(&fr, &s_graph, &s_frag, &s_bank, &ctx, &target);
+                frames++;
+            } while (bench_now_seconds() - t0 < BENCH_MIN_TIME);
+            mps = (double)pixels * frames / ((bench_now_seconds() - t0) * 1e6);
+
+            printf("  fragment %2d thread%s %8.2f MP/s  x%.2f  (%.2f ms/frame, max diff %d)\n",
+                   threads, threads == 1 ? " " : "s", mps, mps / scalar_mps,
+                   (double)pixels / (mps * 1e3), diff);
+            render_fragment_shutdown(&fr);
+        }
+
+        free(ref);
+        free(first);
+        free(out);
+    }
+
+    printf("\n%s: fragment output %s\n", failures ? "FAIL" : "OK",
+           failures ? "differs across threads or from scalar evaluation"
+                    : "matches across threads and scalar evaluation");
+    return failures ? 1 : 0;
+}
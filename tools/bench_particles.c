@@ -0,0 +1,91 @@
+/*
+ * PS2 Live Graph Studio - Particle Benchmark (host)
+ * bench_particles.c - Particles updated per millisecond at 1k/10k/100k
+ *
+ * Build:
+ *   cc -O2 -std=c99 -o tools/bench_particles tools/bench_particles.c \
+ *      src/nodes/node_particles.c -lm
+ */
+
+#include "bench_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/nodes/node_particles.h"
+
+#define BENCH_DT        (1.0f / 60.0f)
+#define BENCH_MIN_TIME  0.25   /* Seconds of timed updates per size */
+
+static const uint32_t s_sizes[] = { 1000, 10000, 100000 };
+
+/* Steady-state run: spawn rate matches deaths so count stays ~n.
+ * Returns particles updated per millisecond. */
+static double bench_pool(uint32_t n, uint32_t *out_count, uint32_t *out_iters)
+{
+    ParticlePool pool;
+    ParticleEmitter em;
+    float *floats = (float *)malloc(sizeof(float) * PARTICLE_POOL_FLOATS(n));
+    uint32_t *colors = (uint32_t *)malloc(sizeof(uint32_t) * n);
+    double t0, elapsed;
+    double updated = 0.0;
+    uint32_t iters = 0;
+    float rate;
+    int i;
+
+    if (!floats || !colors) {
+        free(floats);
+        free(colors);
+        return 0.0;
+    }
+
+    particle_pool_init(&pool, floats, colors, n);
+
+    em.x = 0.5f;
+    em.y = 0.8f;
+    em.speed = 0.4f;
+    em.spread = 1.0f;
+    em.life = 2.0f;
+    em.color = 0x80FFFFFFu;
+
+    /* Mean life is 0.875 * life; aim slightly under capacity */
+    rate = (float)n / (em.life * 0.875f) * 0.95f;
+
+    /* Warm up to steady state */
+    particle_pool_spawn(&pool, &em, n / 2);
+    for (i = 0; i < 240; i++) {
+        particle_pool_update(&pool, &em, rate, 0.0f, 0.3f, BENCH_DT);
+    }
+
+    t0 = bench_now_seconds();
+    do {
+        for (i = 0; i < 16; i++) {
+            updated += (double)pool.count;
+            particle_pool_update(&pool, &em, rate, 0.0f, 0.3f, BENCH_DT);
+        }
+        iters += 16;
+        elapsed = bench_now_seconds() - t0;
+    } while (elapsed < BENCH_MIN_TIME);
+
+    g_bench_sink = pool.pos_x[0] + pool.pos_y[pool.count ? pool.count - 1 : 0];
+    *out_count = pool.count;
+    *out_iters = iters;
+
+    free(floats);
+    free(colors);
+    return updated / (elapsed * 1000.0);
+}
+
+int main(void)
+{
+    size_t i;
+
+    printf("%-10s %-10s %-8s %16s\n", "pool", "live", "updates", "particles/ms");
+    for (i = 0; i < sizeof(s_sizes) / sizeof(s_sizes[0]); i++) {
+        uint32_t count = 0, iters = 0;
+        double rate = bench_pool(s_sizes[i], &count, &iters);
+        printf("%-10u %-10u %-8u %16.0f\n",
+               (unsigned)s_sizes[i], (unsigned)count, (unsigned)iters, rate);
+    }
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+/*
+ * PS2 Live Graph Studio - Tiled Rasterizer Benchmark (host)
+ * bench_soft_tiles.c - Software rasterizer scaling with thread count
+ *
+ * Rasterizes a heavy frame (full-screen clear, opaque rects and
+ * triangles, thousands of overlapping alpha circles, lines) at
+ * 1920x1080 with soft_raster on one thread, then with soft_tiles
+ * at 1, 2, 4, ... threads. Reports ms/frame and speedup and checks
+ * every tiled frame is byte-identical to the single-threaded one.
+ *
+ * Usage:
+ *   bench_soft_tiles [max_threads]   (default 8)
+ *
+ * Build:
+ *   cc -O2 -std=c99 -Isrc -o tools/bench_soft_tiles tools/bench_soft_tiles.c \
+ *      src/render/soft_raster.c src/render/soft_tiles.c src/render/soft_pool.c \
+ *      src/render/circle_lut.c -lm -pthread
+ */
+
+#include "bench_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/render/soft_raster.h"
+#include "../src/render/soft_tiles.h"
+#include "../src/render/circle_lut.h"
+
+#define BENCH_WIDTH      1920
+#define BENCH_HEIGHT     1080
+#define BENCH_RECTS      400
+#define BENCH_TRIANGLES  800
+#define BENCH_CIRCLES    6000
+#define BENCH_LINES      2000
+#define BENCH_MIN_TIME   0.5      /* Seconds per timed section */
+
+/* One batch as the display list would submit it */
+typedef struct {
+    DlPrim    prim;
+    DlBlend   blend;
+    DlCmd    *cmds;
+    uint32_t *order;
+    uint32_t  n;
+} BenchBatch;
+
+static BenchBatch s_batches[4];
+static int s_batch_count = 0;
+
+static uint32_t s_seed = 12345u;
+
+static int rnd(int n)
+{
+    s_seed = s_seed * 1103515245u + 12345u;
+    return (int)((s_seed >> 8) % (uint32_t)n);
+}
+
+static BenchBatch *add_batch(DlPrim prim, DlBlend blend, uint32_t n)
+{
+    BenchBatch *b = &s_batches[s_batch_count++];
+    uint32_t i;
+
+    b->prim = prim;
+    b->blend = blend;
+    b->n = n;
+    b->cmds = (DlCmd *)calloc(n, sizeof(DlCmd));
+    b->order = (uint32_t *)malloc(n * sizeof(uint32_t));
+    if (!b->cmds || !b->order) {
+        fprintf(stderr, "out of memory\n");
+        exit(2);
+    }
+    for (i = 0; i < n; i++) {
+        b->order[i] = i;
+    }
+    return b;
+}
+
+static void build_frame(void)
+{
+    BenchBatch *b;
+    uint32_t i;
+
+    b = add_batch(DL_PRIM_RECT, DL_BLEND_OPAQUE, BENCH_RECTS);
+    for (i = 0; i < b->n; i++) {
+        int x = rnd(BENCH_WIDTH), y = rnd(BENCH_HEIGHT);
+        b->cmds[i].v[0] = (int16_t)x;
+        b->cmds[i].v[1] = (int16_t)y;
+        b->cmds[i].v[2] = (int16_t)(x + 8 + rnd(200));
+        b->cmds[i].v[3] = (int16_t)(y + 8 + rnd(120));
+        b->cmds[i].color = 0x80000000u | (uint32_t)rnd(0xFFFFFF);
+    }
+
+    b = add_batch(DL_PRIM_TRIANGLE, DL_BLEND_OPAQUE, BENCH_TRIANGLES);
+    for (i = 0; i < b->n; i++) {
+        int x = rnd(BENCH_WIDTH), y = rnd(BENCH_HEIGHT), k;
+        for (k = 0; k < 3; k++) {
+            b->cmds[i].v[k * 2] = (int16_t)(x + rnd(160) - 80);
+            b->cmds[i].v[k * 2 + 1] = (int16_t)(y + rnd(160) - 80);
+        }
+        b->cmds[i].color = 0x80000000u | (uint32_t)rnd(0xFFFFFF);
+    }
+
+    b = add_batch(DL_PRIM_CIRCLE, DL_BLEND_ALPHA, BENCH_CIRCLES);
+    for (i = 0; i < b->n; i++) {
+        int r = 4 + rnd(60);
+        b->cmds[i].v[0] = (int16_t)rnd(BENCH_WIDTH);
+        b->cmds[i].v[1] = (int16_t)rnd(BENCH_HEIGHT);
+        b->cmds[i].v[2] = (int16_t)r;
+        b->cmds[i].v[3] = (int16_t)r;
+        b->cmds[i].v[4] = (int16_t)circle_auto_segments((float)r);
+        b->cmds[i].color = ((uint32_t)(8 + rnd(120)) << 24) | (uint32_t)rnd(0xFFFFFF);
+    }
+
+    b = add_batch(DL_PRIM_LINE, DL_BLEND_OPAQUE, BENCH_LINES);
+    for (i = 0; i < b->n; i++) {
+        b->cmds[i].v[0] = (int16_t)rnd(BENCH_WIDTH);
+        b->cmds[i].v[1] = (int16_t)rnd(BENCH_HEIGHT);
+        b->cmds[i].v[2] = (int16_t)(b->cmds[i].v[0] + rnd(400) - 200);
+        b->cmds[i].v[3] = (int16_t)(b->cmds[i].v[1] + rnd(400) - 200);
+        b->cmds[i].color = 0x80FFFFFFu;
+    }
+}
+
+/* ============================================================
+ * Frames
+ * ============================================================ */
+static void frame_single(const SoftTarget *t)
+{
+    SoftClip full = soft_clip_full(t);
+    int i;
+
+    soft_clear(t, &full, 0x00201010u);
+    for (i = 0; i < s_batch_count; i++) {
+        const BenchBatch *b = &s_batches[i];
+        soft_draw_batch(t, &full, b->prim, b->blend, b->cmds, b->order, b->n);
+    }
+}
+
+static void frame_tiled(SoftTiles *st)
+{
+    int i;
+
+    soft_tiles_clear(st, 0x00201010u);
+    for (i = 0; i < s_batch_count; i++) {
+        const BenchBatch *b = &s_batches[i];
+        soft_tiles_draw_batch(st, b->prim, b->blend, b->cmds, b->order, b->n);
+    }
+    soft_tiles_execute(st);
+}
+
+int main(int argc, char **argv)
+{
+    size_t bytes = (size_t)BENCH_WIDTH * BENCH_HEIGHT * sizeof(uint32_t);
+    uint32_t *ref = (uint32_t *)malloc(bytes);
+    uint32_t *out = (uint32_t *)malloc(bytes);
+    SoftTarget ref_t = { NULL, BENCH_WIDTH, BENCH_HEIGHT, BENCH_WIDTH };
+    SoftTarget out_t = { NULL, BENCH_WIDTH, BENCH_HEIGHT, BENCH_WIDTH };
+    int max_threads = argc > 1 ? atoi(argv[1]) : 8;
+    double single_ms;
+    double t0;
+    int frames, threads, mismatches = 0;
+
+    if (!ref || !out) {
+        fprintf(stderr, "out of memory\n");
+        return 2;
+    }
+    if (max_threads < 1) max_threads = 1;
+    if (max_threads > SOFT_TILES_MAX_THREADS) max_threads = SOFT_TILES_MAX_THREADS;
+    ref_t.pixels = ref;
+    out_t.pixels = out;
+
+    circle_lut_init();
+    build_frame();
+
+    printf("%dx%d: %d rects, %d triangles, %d alpha circles, %d lines\n\n",
+           BENCH_WIDTH, BENCH_HEIGHT, BENCH_RECTS, BENCH_TRIANGLES,
+           BENCH_CIRCLES, BENCH_LINES);
+
+    frames = 0;
+    t0 = bench_now_seconds();
+    do {
+        frame_single(&ref_t);
+        frames++;
+    } while (bench_now_seconds() - t0 < BENCH_MIN_TIME);
+    single_ms = (bench_now_seconds() - t0) * 1000.0 / frames;
+    printf("  single-threaded    %8.2f ms/frame\n", single_ms);
+
+    for (threads = 1; threads <= max_threads; threads *= 2) {
+        SoftTiles st;
+        double ms;
+
+        if (soft_tiles_init(&st, &out_t, threads) != 0) {
+            fprintf(stderr, "soft_tiles_init(%d) failed\n", threads);
+            return 2;
+        }
+
+        memset(out, 0, bytes);
+        frame_tiled(&st);
+        if (memcmp(ref, out, bytes) != 0) {
+            mismatches++;
+        }
+
+        frames = 0;
+        t0 = bench_now_seconds();
+        do {
+            frame_tiled(&st);
+            frames++;
+        } while (bench_now_seconds() - t0 < BENCH_MIN_TIME);
+        ms = (bench_now_seconds() - t0) * 1000.0 / frames;
+
+        printf("  tiled %2d thread%s  %8.2f ms/frame  x%.2f  (%u bin entries)\n",
+               threads, threads == 1 ? " " : "s", ms, single_ms / ms,
+               (unsigned)st.stat_bin_items);
+        soft_tiles_shutdown(&st);
+    }
+
+    printf("\n%s: tiled output %s single-threaded output\n",
+           mismatches ? "FAIL" : "OK", mismatches ? "differs from" : "identical to");
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,218 @@
+/*
+ * PS2 Live Graph Studio - Text Formatting Benchmark (host)
+ * bench_text_fmt.c - HUD + editor text formatting cost per frame
+ *
+ * Formats one frame of HUD lines (FPS, dt, F, N, B, E, T), the
+ * editor status lines and node rate tags, first with snprintf as
+ * the app used to, then with text_fmt chains and retained labels.
+ * Also checks text_fmt output against snprintf.
+ *
+ * Build:
+ *   cc -O2 -std=c99 -o tools/bench_text_fmt tools/bench_text_fmt.c \
+ *      src/render/text_fmt.c
+ */
+
+#include "bench_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/render/text_fmt.h"
+
+#define BENCH_FRAMES     20000
+#define BENCH_RATE_TAGS  8        /* Nodes with a rate tag on screen */
+#define BENCH_CHECKS     200000
+
+/* Per-frame inputs, as the app would see them */
+typedef struct {
+    unsigned fps;
+    float    dt;
+    unsigned frame;
+    unsigned evaluated, count;
+    unsigned branch;
+    unsigned latency;
+    unsigned prims, pixels;
+    unsigned sel_node;
+    unsigned sel_param;
+    float    param;
+} FrameValues;
+
+static FrameValues s_frames[BENCH_FRAMES];
+static char s_out[16][128];
+
+static void make_frames(void)
+{
+    int i;
+
+    srand(1234);
+    for (i = 0; i < BENCH_FRAMES; i++) {
+        FrameValues *v = &s_frames[i];
+        v->fps = 60;
+        v->dt = 1.0f / 60.0f + (float)(rand() % 5 - 2) * 0.0004f;  /* Jitter */
+        v->frame = (unsigned)i;
+        v->evaluated = 40 + (unsigned)(i / 240 % 3);
+        v->count = 42;
+        v->branch = (unsigned)(i / 120 % 2) * 2;
+        v->latency = 1;
+        v->prims = 900 + (unsigned)(i / 60 % 4);
+        v->pixels = 4100 + (unsigned)(i / 60 % 4) * 6;
+        v->sel_node = 7;
+        v->sel_param = 1;
+        v->param = 0.25f + (float)(i / 30) * 0.01f;       /* L/R held every 30 frames */
+    }
+}
+
+/* ============================================================
+ * Before: snprintf per line per frame
+ * ============================================================ */
+static void frame_snprintf(const FrameValues *v)
+{
+    int t;
+
+    snprintf(s_out[0], 128, "FPS: %d", (int)v->fps);
+    snprintf(s_out[1], 128, "dt: %.3f", (double)v->dt);
+    snprintf(s_out[2], 128, "F: %u", v->frame);
+    snprintf(s_out[3], 128, "N: %u/%u", v->evaluated, v->count);
+    snprintf(s_out[4], 128, "B: %u", v->branch);
+    snprintf(s_out[5], 128, "E: %u", v->latency);
+    snprintf(s_out[6], 128, "T: %u/%u", v->prims, v->pixels);
+    snprintf(s_out[7], 128, "#%u %s", v->sel_node, "SIN");
+    snprintf(s_out[8], 128, "MODE %s  SEL %.64s  %s", "PARAM", s_out[7], "PENDING");
+    snprintf(s_out[9], 128, "Param %u = %.3f  (L/R adjust)", v->sel_param, (double)v->param);
+    for (t = 0; t < BENCH_RATE_TAGS; t++) {
+        snprintf(s_out[10], 8, "/%u", (unsigned)(t + 2));
+    }
+}
+
+/* ============================================================
+ * After: retained labels + text_fmt chains
+ * ============================================================ */
+static TextLabel s_hud[7];
+
+static void frame_text_fmt(const FrameValues *v)
+{
+    char *l1 = s_out[8];
+    char *l2 = s_out[9];
+    int pos;
+    int t;
+
+    text_label_u32(&s_hud[0], v->fps);
+    text_label_fixed(&s_hud[1], v->dt);
+    text_label_u32(&s_hud[2], v->frame);
+    text_label_u32_pair(&s_hud[3], v->evaluated, v->count);
+    text_label_u32(&s_hud[4], v->branch);
+    text_label_u32(&s_hud[5], v->latency);
+    text_label_u32_pair(&s_hud[6], v->prims, v->pixels);
+
+    pos = text_fmt_str(l1, 128, 0, "MODE ");
+    pos = text_fmt_str(l1, 128, pos, "PARAM");
+    pos = text_fmt_str(l1, 128, pos, "  SEL ");
+    pos = text_fmt_char(l1, 128, pos, '#');
+    pos = text_fmt_u32(l1, 128, pos, v->sel_node);
+    pos = text_fmt_char(l1, 128, pos, ' ');
+    pos = text_fmt_str(l1, 128, pos, "SIN");
+    pos = text_fmt_str(l1, 128, pos, "  ");
+    text_fmt_str(l1, 128, pos, "PENDING");
+
+    pos = text_fmt_str(l2, 128, 0, "Param ");
+    pos = text_fmt_u32(l2, 128, pos, v->sel_param);
+    pos = text_fmt_str(l2, 128, pos, " = ");
+    pos = text_fmt_fixed(l2, 128, pos, v->param, 3);
+    text_fmt_str(l2, 128, pos, "  (L/R adjust)");
+
+    for (t = 0; t < BENCH_RATE_TAGS; t++) {
+        pos = text_fmt_char(s_out[10], 8, 0, '/');
+        text_fmt_u32(s_out[10], 8, pos, (uint32_t)(t + 2));
+    }
+}
+
+/* ============================================================
+ * Correctness vs snprintf
+ * ============================================================ */
+static void check_against_snprintf(void)
+{
+    char a[64], b[64];
+    unsigned int_bad = 0, fixed_bad = 0, fixed_last_digit = 0;
+    int i;
+
+    srand(99);
+    for (i = 0; i < BENCH_CHECKS; i++) {
+        uint32_t u = (uint32_t)rand() * 2654435761u;
+        int32_t s = (int32_t)u;
+        int dec = i % (TEXT_FMT_MAX_DECIMALS + 1);
+        float f = ((float)rand() / (float)RAND_MAX - 0.5f) * 2000.0f;
+
+        text_fmt_u32(a, sizeof(a), 0, u);
+        snprintf(b, sizeof(b), "%u", (unsigned)u);
+        int_bad += strcmp(a, b) != 0;
+
+        text_fmt_i32(a, sizeof(a), 0, s);
+        snprintf(b, sizeof(b), "%d", (int)s);
+        int_bad += strcmp(a, b) != 0;
+
+        /* Keep within float precision (~7 significant digits) */
+        if (dec > 3) {
+            f *= 0.001f;
+        }
+        text_fmt_fixed(a, sizeof(a), 0, f, dec);
+        snprintf(b, sizeof(b), "%.*f", dec, (double)f);
+        if (strcmp(a, b) != 0) {
+            double diff = atof(a) - atof(b);
+            double unit = 1.0;
+            int d;
+            for (d = 0; d < dec; d++) {
+                unit *= 0.1;
+            }
+            if (diff < 0.0) {
+                diff = -diff;
+            }
+            if (diff <= unit * 1.001) {
+                fixed_last_digit++;     /* Tie / float rounding in last digit */
+            } else {
+                fixed_bad++;
+            }
+        }
+    }
+
+    printf("check: %d values, int mismatches %u, fixed mismatches %u "
+           "(off by one in the last digit: %u)\n",
+           BENCH_CHECKS, int_bad, fixed_bad, fixed_last_digit);
+}
+
+int main(void)
+{
+    double t0, t_before, t_after;
+    int i;
+
+    check_against_snprintf();
+    make_frames();
+
+    text_label_init(&s_hud[0], "FPS: ", TEXT_LABEL_U32, 0);
+    text_label_init(&s_hud[1], "dt: ", TEXT_LABEL_FIXED, 3);
+    text_label_init(&s_hud[2], "F: ", TEXT_LABEL_U32, 0);
+    text_label_init(&s_hud[3], "N: ", TEXT_LABEL_U32_PAIR, 0);
+    text_label_init(&s_hud[4], "B: ", TEXT_LABEL_U32, 0);
+    text_label_init(&s_hud[5], "E: ", TEXT_LABEL_U32, 0);
+    text_label_init(&s_hud[6], "T: ", TEXT_LABEL_U32_PAIR, 0);
+
+    t0 = bench_now_seconds();
+    for (i = 0; i < BENCH_FRAMES; i++) {
+        frame_snprintf(&s_frames[i]);
+    }
+    t_before = bench_now_seconds() - t0;
+    g_bench_sink += (float)s_out[9][8];
+
+    t0 = bench_now_seconds();
+    for (i = 0; i < BENCH_FRAMES; i++) {
+        frame_text_fmt(&s_frames[i]);
+    }
+    t_after = bench_now_seconds() - t0;
+    g_bench_sink += (float)s_out[9][8] + (float)s_hud[1].text[4];
+
+    printf("frames: %d (7 HUD lines, 2 editor lines, %d rate tags)\n",
+           BENCH_FRAMES, BENCH_RATE_TAGS);
+    printf("snprintf:  %8.3f us/frame\n", t_before * 1e6 / BENCH_FRAMES);
+    printf("text_fmt:  %8.3f us/frame (%.1fx)\n", t_after * 1e6 / BENCH_FRAMES,
+           t_after > 0.0 ? t_before / t_after : 0.0);
+    return 0;
+}
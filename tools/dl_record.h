@@ -0,0 +1,137 @@
+/*
+ * PS2 Live Graph Studio - Recording Display List Backend (host)
+ * dl_record.h - Stand-in for the gsKit backend in render_gs.c
+ *
+ * Records every batch and command the display list submits, so
+ * submission order can be checked and benchmarked without a GS.
+ * dl_record_check_order() checks what the merge must preserve:
+ * layers back to front, and append order between any two commands
+ * of a layer whose bounds overlap.
+ */
+
+#ifndef DL_RECORD_H
+#define DL_RECORD_H
+
+#include <string.h>
+#include "../src/render/display_list.h"
+
+#define DL_RECORD_MAX_BATCHES 4096
+
+typedef struct {
+    uint8_t  prim;         /* DlPrim */
+    uint8_t  blend;        /* DlBlend */
+    uint8_t  first_layer;  /* Layer of the first command */
+    uint8_t  _pad[1];
+    uint32_t count;        /* Commands in batch */
+} DlRecordBatch;
+
+typedef struct {
+    DlBackend     backend;       /* Pass &rec->backend to dl_init/dl_submit */
+    DlRecordBatch batches[DL_RECORD_MAX_BATCHES];
+    uint32_t      batch_count;   /* May exceed DL_RECORD_MAX_BATCHES (not stored) */
+    uint32_t      cmd_count;
+    uint32_t      checksum;      /* FNV-1a over records in submission order */
+    uint32_t      order_errors;  /* Layer going back within a submit */
+    uint32_t      state_errors;  /* Commands not matching their batch state */
+    uint32_t      last_key;
+    int           has_last;
+    uint32_t      keys[DL_MAX_CMDS];        /* Submission order (first DL_MAX_CMDS) */
+    int           boxes[DL_MAX_CMDS][4];    /* dl_record_check_order scratch */
+} DlRecorder;
+
+static uint32_t dl_record_fnv(uint32_t h, const void *data, size_t n)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    size_t i;
+    for (i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void dl_record_batch(void *user, DlPrim prim, DlBlend blend,
+                            const DlCmd *cmds, const uint32_t *order, uint32_t n)
+{
+    DlRecorder *rec = (DlRecorder *)user;
+    uint32_t i;
+
+    if (rec->batch_count < DL_RECORD_MAX_BATCHES) {
+        DlRecordBatch *b = &rec->batches[rec->batch_count];
+        b->prim = (uint8_t)prim;
+        b->blend = (uint8_t)blend;
+        b->first_layer = n ? DL_KEY_LAYER(order[0]) : 0;
+        b->count = n;
+    }
+    rec->batch_count++;
+
+    for (i = 0; i < n; i++) {
+        const DlCmd *cmd = &cmds[DL_KEY_INDEX(order[i])];
+
+        if (rec->has_last && DL_KEY_LAYER(order[i]) < DL_KEY_LAYER(rec->last_key)) {
+            rec->order_errors++;
+        }
+        if (rec->cmd_count + i < DL_MAX_CMDS) {
+            rec->keys[rec->cmd_count + i] = order[i];
+        }
+        if (DL_KEY_PRIM(cmd->key) != prim || DL_KEY_BLEND(cmd->key) != blend ||
+            cmd->key != order[i]) {
+            rec->state_errors++;
+        }
+        rec->last_key = order[i];
+        rec->has_last = 1;
+        rec->checksum = dl_record_fnv(rec->checksum, cmd->v, sizeof(cmd->v));
+        rec->checksum = dl_record_fnv(rec->checksum, &cmd->color, sizeof(cmd->color));
+    }
+    rec->cmd_count += n;
+}
+
+/* Pairs of overlapping commands in one layer submitted out of
+ * append order, over the last submit (O(n^2); checks only) */
+static uint32_t dl_record_check_order(DlRecorder *rec, const DlCmd *cmds)
+{
+    uint32_t n = rec->cmd_count < DL_MAX_CMDS ? rec->cmd_count : DL_MAX_CMDS;
+    uint32_t i, j, errors = 0;
+
+    for (i = 0; i < n; i++) {
+        dl_cmd_bounds(&cmds[DL_KEY_INDEX(rec->keys[i])], rec->boxes[i]);
+    }
+    for (j = 1; j < n; j++) {
+        const int *b = rec->boxes[j];
+
+        for (i = j; i-- > 0;) {
+            const int *a = rec->boxes[i];
+
+            if (DL_KEY_LAYER(rec->keys[i]) != DL_KEY_LAYER(rec->keys[j])) {
+                break;
+            }
+            if (DL_KEY_INDEX(rec->keys[i]) > DL_KEY_INDEX(rec->keys[j]) &&
+                a[0] < b[2] && b[0] < a[2] && a[1] < b[3] && b[1] < a[3]) {
+                errors++;
+            }
+        }
+    }
+    return errors;
+}
+
+/* Clear the log (call before each dl_submit to check ordering) */
+static void dl_record_reset(DlRecorder *rec)
+{
+    rec->batch_count = 0;
+    rec->cmd_count = 0;
+    rec->checksum = 2166136261u;
+    rec->order_errors = 0;
+    rec->state_errors = 0;
+    rec->last_key = 0;
+    rec->has_last = 0;
+}
+
+static void dl_record_init(DlRecorder *rec)
+{
+    memset(rec, 0, sizeof(*rec));
+    rec->backend.draw_batch = dl_record_batch;
+    rec->backend.user = rec;
+    dl_record_reset(rec);
+}
+
+#endif /* DL_RECORD_H */
@@ -0,0 +1,428 @@
+/*
+ * PS2 Live Graph Studio - GIF Packet Check (host)
+ * gif_packet_check.c - Encode display lists to GS packets and decode
+ *                      them back
+ *
+ * Fills a display list with random rects, lines, triangles and
+ * circles (mixed layers, opaque and alpha), submits it to the GIF
+ * packet encoder used by the gsKit backend, and replays every kicked
+ * arena through the packet decoder. The decoded primitives must
+ * match the display list's batches one for one (circles as their
+ * triangle fans), and an arena must not change while its kick is
+ * "in flight" (until the next kick returns). Runs with the full
+ * arena and with a small one that forces early kicks, checks the
+ * upscale blit's strips and texture registers, then times encoding.
+ *
+ * Usage:
+ *   gif_packet_check [frames]   (default 64)
+ *
+ * Build:
+ *   cc -O2 -std=c99 -Isrc -o tools/gif_packet_check tools/gif_packet_check.c \
+ *      src/render/gif_packet.c src/render/display_list.c src/render/circle_lut.c -lm
+ */
+
+#include "bench_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/render/gif_packet.h"
+#include "../src/render/circle_lut.h"
+
+#define CHECK_OFFSET      (2048 << 4)    /* gsKit OffsetX/OffsetY */
+#define CHECK_SMALL_ARENA 64             /* Qwords; forces early kicks */
+#define CHECK_FRAME_1     0x000A0096ull          /* FBP 150, FBW 10: second 640x480 buffer */
+#define CHECK_SCISSOR_1   0x01DF0000027F0000ull  /* 0..639 x 0..479 */
+#define CHECK_MAX_PRIMS   (DL_MAX_CMDS * CIRCLE_LUT_MAX_SEGMENTS)
+#define CHECK_BLIT_WIDTH  640            /* Blit destination (PS2 output) */
+#define CHECK_BLIT_HEIGHT 480
+#define BENCH_MIN_TIME    0.25           /* Seconds per timed section */
+
+static DisplayList s_dl;
+static uint64_t    s_arena[GIF_PACKET_ARENAS][GIF_ARENA_QWORDS * 2];
+
+/* Expected primitives in submission order */
+static GifPrim   s_expect[CHECK_MAX_PRIMS];
+static uint32_t  s_expect_count;
+
+/* Decoder side */
+typedef struct {
+    GifDecoder dec;
+    uint32_t   matched;
+    uint32_t   mismatches;
+    uint32_t   overflows;      /* Kicks larger than the arena */
+    uint32_t   scribbles;      /* In-flight arena modified */
+    uint32_t   decode_errors;
+    uint32_t   capacity;
+    const uint64_t *inflight;  /* Last kicked arena */
+    uint32_t   inflight_qwc;
+    uint32_t   inflight_hash;
+} Checker;
+
+static uint32_t fnv(const void *data, size_t n)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t h = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h;
+}
+
+static uint32_t rng(uint32_t *s)
+{
+    *s = *s * 1664525u + 1013904223u;
+    return *s >> 8;
+}
+
+/* ============================================================
+ * Reference Expansion
+ * ============================================================ */
+static void expect_prim(uint8_t type, DlBlend blend, uint32_t color, int verts,
+                        int x0, int y0, int x1, int y1, int x2, int y2)
+{
+    GifPrim *p;
+    uint8_t a = (blend == DL_BLEND_ALPHA) ? (uint8_t)(color >> 24) : 0x80;
+
+    if (s_expect_count >= CHECK_MAX_PRIMS) {
+        return;
+    }
+    p = &s_expect[s_expect_count++];
+    memset(p, 0, sizeof(*p));
+    p->type = type;
+    p->abe = (blend == DL_BLEND_ALPHA) ? 1 : 0;
+    p->verts = (uint8_t)verts;
+    p->rgba = (color & 0x00FFFFFFu) | ((uint32_t)a << 24);
+    p->x[0] = x0 * 16;
+    p->y[0] = y0 * 16;
+    p->x[1] = x1 * 16;
+    p->y[1] = y1 * 16;
+    if (verts == 3) {
+        p->x[2] = x2 * 16;
+        p->y[2] = y2 * 16;
+    }
+}
+
+/* Same expansion the gsKit_prim_* backend used */
+static void expect_batch(void *user, DlPrim prim, DlBlend blend,
+                         const DlCmd *cmds, const uint32_t *order, uint32_t n)
+{
+    uint32_t i;
+    (void)user;
+
+    for (i = 0; i < n; i++) {
+        const DlCmd *c = &cmds[DL_KEY_INDEX(order[i])];
+        const int16_t *v = c->v;
+
+        switch (prim) {
+            case DL_PRIM_RECT:
+                expect_prim(GIF_PRIM_SPRITE, blend, c->color, 2, v[0], v[1], v[2], v[3], 0, 0);
+                break;
+            case DL_PRIM_LINE:
+                expect_prim(GIF_PRIM_LINE, blend, c->color, 2, v[0], v[1], v[2], v[3], 0, 0);
+                break;
+            case DL_PRIM_TRIANGLE:
+                expect_prim(GIF_PRIM_TRIANGLE, blend, c->color, 3,
+                            v[0], v[1], v[2], v[3], v[4], v[5]);
+                break;
+            case DL_PRIM_CIRCLE: {
+                int segments = circle_lut_clamp(v[4]);
+                const float *cs = circle_lut_cos(segments);
+                const float *sn = circle_lut_sin(segments);
+                int px = v[0] + v[2];
+                int py = v[1];
+                int k;
+
+                for (k = 1; k <= segments; k++) {
+                    int cx = v[0] + (int)((float)v[2] * cs[k]);
+                    int cy = v[1] + (int)((float)v[3] * sn[k]);
+
+                    expect_prim(GIF_PRIM_TRIANGLE, blend, c->color, 3,
+                                v[0], v[1], px, py, cx, cy);
+                    px = cx;
+                    py = cy;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+/* ============================================================
+ * Decode Side
+ * ============================================================ */
+static void on_prim(void *user, const GifPrim *p)
+{
+    Checker *ck = (Checker *)user;
+    const GifPrim *e;
+    int i;
+
+    if (ck->matched >= s_expect_count) {
+        ck->mismatches++;
+        return;
+    }
+    e = &s_expect[ck->matched++];
+    if (p->type != e->type || p->abe != e->abe || p->verts != e->verts ||
+        p->rgba != e->rgba) {
+        ck->mismatches++;
+        return;
+    }
+    for (i = 0; i < p->verts; i++) {
+        if (p->x[i] != e->x[i] || p->y[i] != e->y[i]) {
+            ck->mismatches++;
+            return;
+        }
+    }
+}
+
+static void on_kick(void *user, const uint64_t *qwords, uint32_t qwc)
+{
+    Checker *ck = (Checker *)user;
+
+    /* The previous arena was "in flight" until now */
+    if (ck->inflight && fnv(ck->inflight, (size_t)ck->inflight_qwc * 16) != ck->inflight_hash) {
+        ck->scribbles++;
+    }
+    if (qwc > ck->capacity) {
+        ck->overflows++;
+    }
+    if (gif_decode(&ck->dec, qwords, qwc) != 0) {
+        ck->decode_errors++;
+    }
+    ck->inflight = qwords;
+    ck->inflight_qwc = qwc;
+    ck->inflight_hash = fnv(qwords, (size_t)qwc * 16);
+}
+
+/* ============================================================
+ * Frames
+ * ============================================================ */
+static void build_frame(uint32_t seed)
+{
+    uint32_t n = 200 + rng(&seed) % 4000;
+    uint32_t i;
+
+    dl_reset(&s_dl);
+    for (i = 0; i < n; i++) {
+        int x = (int)(rng(&seed) % 900) - 130;
+        int y = (int)(rng(&seed) % 700) - 110;
+        uint32_t color = rng(&seed) | ((rng(&seed) & 0xFF) << 24);
+
+        dl_set_layer(&s_dl, (uint8_t)(DL_LAYER_SCENE + (rng(&seed) % 8) * 8));
+        dl_set_blend(&s_dl, (rng(&seed) & 1) ? DL_BLEND_ALPHA : DL_BLEND_OPAQUE);
+
+        switch (rng(&seed) % 4) {
+            case 0:
+                dl_push_rect(&s_dl, x, y, x + 1 + (int)(rng(&seed) % 200),
+                             y + 1 + (int)(rng(&seed) % 100), color);
+                break;
+            case 1:
+                dl_push_line(&s_dl, x, y, x + (int)(rng(&seed) % 300) - 150,
+                             y + (int)(rng(&seed) % 300) - 150, color);
+                break;
+            case 2:
+                dl_push_triangle(&s_dl, x, y, x + (int)(rng(&seed) % 200) - 100,
+                                 y + (int)(rng(&seed) % 200),
+                                 x + (int)(rng(&seed) % 200), y - 50, color);
+                break;
+            default:
+                dl_push_circle(&s_dl, x, y, 2 + (int)(rng(&seed) % 120),
+                               2 + (int)(rng(&seed) % 120),
+                               CIRCLE_LUT_MIN_SEGMENTS +
+                               (int)(rng(&seed) % (CIRCLE_LUT_MAX_SEGMENTS + 4)),
+                               color);
+                break;
+        }
+    }
+}
+
+/* Encode frames with a given arena size; returns failures */
+static int check_arena(uint32_t capacity, int frames, uint32_t *qwords, uint32_t *kicks)
+{
+    GifPacket gp;
+    Checker ck;
+    DlBackend expect = { expect_batch, NULL };
+    DlBackend encode;
+    int failures = 0;
+    int f;
+
+    *qwords = 0;
+    *kicks = 0;
+    for (f = 0; f < frames; f++) {
+        memset(&ck, 0, sizeof(ck));
+        ck.capacity = capacity;
+        gif_decoder_init(&ck.dec, CHECK_OFFSET, CHECK_OFFSET, on_prim, &ck);
+        if (gif_packet_init(&gp, s_arena[0], s_arena[1], capacity,
+                            CHECK_OFFSET, CHECK_OFFSET, on_kick, &ck) != 0) {
+            fprintf(stderr, "gif_packet_init(%u) failed\n", (unsigned)capacity);
+            return 1;
+        }
+        encode.draw_batch = gif_packet_draw_batch;
+        encode.user = &gp;
+
+        build_frame(0x9E3779B9u * (uint32_t)(f + 1));
+        s_expect_count = 0;
+        expect_prim(GIF_PRIM_SPRITE, DL_BLEND_OPAQUE, 0x00302010u, 2, 0, 0, 64, 480, 0, 0);
+        dl_submit(&s_dl, &expect);
+
+        /* Frame as render_gs.c sends it */
+        gif_packet_set_reg(&gp, GIF_REG_FRAME_1, CHECK_FRAME_1);
+        gif_packet_set_reg(&gp, GIF_REG_SCISSOR_1, CHECK_SCISSOR_1);
+        gif_packet_set_reg(&gp, GIF_REG_ALPHA_1, 0x44);
+        gif_packet_clear(&gp, 64, 480, 0x00302010u);
+        dl_submit(&s_dl, &encode);
+        gif_packet_kick(&gp);
+
+        if (ck.matched != s_expect_count || ck.mismatches || ck.overflows ||
+            ck.scribbles || ck.decode_errors || ck.dec.alpha1 != 0x44 ||
+            ck.dec.frame1 != CHECK_FRAME_1 || ck.dec.scissor1 != CHECK_SCISSOR_1 ||
+            gp.stat_prims != s_expect_count) {
+            fprintf(stderr, "frame %d (arena %u): %u/%u matched, %u mismatched, "
+                            "%u overflows, %u scribbles, %u decode errors\n",
+                    f, (unsigned)capacity, (unsigned)ck.matched, (unsigned)s_expect_count,
+                    (unsigned)ck.mismatches, (unsigned)ck.overflows,
+                    (unsigned)ck.scribbles, (unsigned)ck.decode_errors);
+            failures++;
+        }
+        *qwords += gp.stat_qwords;
+        *kicks += gp.stat_kicks;
+    }
+    return failures;
+}
+
+/* ============================================================
+ * Upscale Blit
+ * ============================================================
+ * The strips must tile the destination left to right and their UVs
+ * must run across the whole source region.
+ * ============================================================ */
+typedef struct {
+    int32_t  next_x;        /* 1/16 pixel */
+    int32_t  next_u;        /* 1/16 texel */
+    uint32_t strips;
+    uint32_t errors;
+    int      height;
+    int      src_height;
+} BlitChecker;
+
+static void on_blit_prim(void *user, const GifPrim *p)
+{
+    BlitChecker *bc = (BlitChecker *)user;
+
+    bc->strips++;
+    if (p->type != GIF_PRIM_SPRITE || !p->tme || p->abe || p->verts != 2 ||
+        p->x[0] != bc->next_x || p->y[0] != 0 || p->y[1] != bc->height * 16 ||
+        p->u[0] != bc->next_u || p->u[1] <= p->u[0] ||
+        p->v[0] != 0 || p->v[1] != bc->src_height * 16) {
+        bc->errors++;
+    }
+    bc->next_x = p->x[1];
+    bc->next_u = p->u[1];
+}
+
+static void on_blit_kick(void *user, const uint64_t *qwords, uint32_t qwc)
+{
+    GifDecoder *dec = (GifDecoder *)user;
+    BlitChecker *bc = (BlitChecker *)dec->user;
+
+    if (gif_decode(dec, qwords, qwc) != 0) {
+        bc->errors++;
+    }
+}
+
+static int check_blit(uint32_t capacity, int src_w, int src_h, int bilinear)
+{
+    GifBlitSource src = { 0x1200u, 5u, GIF_PSM_CT32, 0, 0 };
+    GifPacket gp;
+    GifDecoder dec;
+    BlitChecker bc;
+    uint64_t filter = bilinear ? 1 : 0;
+
+    src.width = src_w;
+    src.height = src_h;
+    memset(&bc, 0, sizeof(bc));
+    bc.height = CHECK_BLIT_HEIGHT;
+    bc.src_height = src_h;
+    gif_decoder_init(&dec, CHECK_OFFSET, CHECK_OFFSET, on_blit_prim, &bc);
+    gif_packet_init(&gp, s_arena[0], s_arena[1], capacity,
+                    CHECK_OFFSET, CHECK_OFFSET, on_blit_kick, &dec);
+
+    gif_packet_blit(&gp, &src, CHECK_BLIT_WIDTH, CHECK_BLIT_HEIGHT, bilinear);
+    gif_packet_kick(&gp);
+
+    if (bc.errors || bc.strips != gp.stat_prims ||
+        bc.next_x != CHECK_BLIT_WIDTH * 16 || bc.next_u != src_w * 16 ||
+        dec.texflushes != 1 || (dec.tex0 & 0x3FFFu) != src.tbp ||
+        ((dec.tex0 >> 14) & 0x3Fu) != src.tbw ||
+        (1 << ((dec.tex0 >> 26) & 0xFu)) < src_w || (1 << ((dec.tex0 >> 30) & 0xFu)) < src_h ||
+        dec.tex1 != (1u | (filter << 5) | (filter << 6)) ||
+        ((dec.clamp1 >> 14) & 0x3FFu) != (uint64_t)(src_w - 1) ||
+        ((dec.clamp1 >> 34) & 0x3FFu) != (uint64_t)(src_h - 1)) {
+        fprintf(stderr, "blit %dx%d %s (arena %u): %u strips, %u errors, ends at x %d u %d\n",
+                src_w, src_h, bilinear ? "bilinear" : "nearest", (unsigned)capacity,
+                (unsigned)bc.strips, (unsigned)bc.errors, (int)(bc.next_x / 16),
+                (int)(bc.next_u / 16));
+        return 1;
+    }
+    return 0;
+}
+
+/* ============================================================
+ * Main
+ * ============================================================ */
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 64;
+    int failures = 0;
+    uint32_t qwords, kicks;
+    GifPacket gp;
+    DlBackend encode;
+    double t0, elapsed;
+    int reps;
+
+    if (frames < 1) frames = 1;
+
+    circle_lut_init();
+    dl_init(&s_dl, NULL);
+
+    failures += check_arena(GIF_ARENA_QWORDS, frames, &qwords, &kicks);
+    printf("arena %5u qwords: %d frames, %.1f KB/frame, %.2f kicks/frame\n",
+           (unsigned)GIF_ARENA_QWORDS, frames, (double)qwords * 16.0 / 1024.0 / frames,
+           (double)kicks / frames);
+    failures += check_arena(CHECK_SMALL_ARENA, frames, &qwords, &kicks);
+    printf("arena %5u qwords: %d frames, %.1f KB/frame, %.2f kicks/frame\n",
+           (unsigned)CHECK_SMALL_ARENA, frames, (double)qwords * 16.0 / 1024.0 / frames,
+           (double)kicks / frames);
+
+    failures += check_blit(GIF_ARENA_QWORDS, 320, 240, 1);
+    failures += check_blit(GIF_ARENA_QWORDS, 214, 160, 0);
+    failures += check_blit(CHECK_SMALL_ARENA, 160, 120, 1);
+    printf("blit: 320x240, 214x160, 160x120 -> %dx%d\n",
+           CHECK_BLIT_WIDTH, CHECK_BLIT_HEIGHT);
+
+    /* Encode cost (no kick callback) */
+    build_frame(12345u);
+    gif_packet_init(&gp, s_arena[0], s_arena[1], GIF_ARENA_QWORDS,
+                    CHECK_OFFSET, CHECK_OFFSET, NULL, NULL);
+    encode.draw_batch = gif_packet_draw_batch;
+    encode.user = &gp;
+    reps = 0;
+    gif_packet_stats_reset(&gp);
+    t0 = bench_now_seconds();
+    do {
+        dl_submit(&s_dl, &encode);
+        gif_packet_kick(&gp);
+        reps++;
+    } while ((elapsed = bench_now_seconds() - t0) < BENCH_MIN_TIME);
+    printf("encode: %u cmds -> %u prims/frame, %.1f us/frame, %.1f ns/prim\n",
+           (unsigned)s_dl.count, (unsigned)(gp.stat_prims / reps),
+           elapsed * 1e6 / reps, elapsed * 1e9 / gp.stat_prims);
+
+    printf("%s: decoded packets %s\n", failures ? "FAIL" : "OK",
+           failures ? "differ from the display list" : "match the display list");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,331 @@
+/*
+ * PS2 Live Graph Studio - Headless Audio Runner (host)
+ * lgs_audio.c - Evaluate a graph at audio rate, write a WAV, report
+ *               samples/second for block vs per-sample evaluation
+ *
+ * Build:
+ *   cc -O2 -std=c99 -o tools/lgs_audio tools/lgs_audio.c \
+ *      src/graph/graph_core.c src/graph/graph_validate.c \
+ *      src/graph/graph_eval.c src/graph/graph_probe.c src/graph/graph_eval_block.c \
+ *      src/nodes/node_registry.c src/nodes/node_basic.c \
+ *      src/nodes/node_extended.c src/nodes/node_particles.c \
+ *      src/nodes/node_fragment.c src/nodes/node_block.c \
+ *      src/runtime/runtime.c src/io/graph_io.c -lm
+ *
+ * Usage:
+ *   lgs_audio [-g graph.gph] [-o out.wav] [-s seconds] [-r rate]
+ *             [-n node_id] [-p port]
+ *
+ * Without -g a built-in LFO/NOISE/SIN patch is used. The output is
+ * the first DEBUG node in plan order, else the last evaluated node,
+ * unless -n/-p select one explicitly.
+ */
+
+#include "bench_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/common.h"
+#include "../src/graph/graph_core.h"
+#include "../src/graph/graph_validate.h"
+#include "../src/graph/graph_eval.h"
+#include "../src/graph/graph_eval_block.h"
+#include "../src/nodes/node_registry.h"
+#include "../src/io/graph_io.h"
+
+#define AUDIO_TWO_PI 6.28318530718f
+
+static Graph     s_graph;
+static Graph     s_graph_scalar;   /* Separate copy: node state diverges */
+static EvalPlan  s_plan;
+static BlockBank s_block_bank;
+static OutputBank s_bank;
+
+/* ============================================================
+ * Built-in Patch
+ * ============================================================
+ * 220Hz sine * LFO tremolo + a little noise, clamped to [-1, 1].
+ * CLAMP has no block kernel, so the per-sample fallback is covered.
+ * ============================================================ */
+static NodeId build_default_patch(Graph *g)
+{
+    NodeId time_id, hz_id, phase_id, sin_id, lfo_id, trem_id;
+    NodeId noise_id, noise_amt_id, noise_mul_id, mix_id, gain_id, gain_mul_id, clamp_id;
+
+    graph_init(g);
+
+    graph_alloc_node(g, NODE_TYPE_TIME, &time_id);
+    graph_alloc_node(g, NODE_TYPE_CONST, &hz_id);
+    graph_set_param(g, hz_id, 0, AUDIO_TWO_PI * 220.0f);
+    graph_alloc_node(g, NODE_TYPE_MUL, &phase_id);
+    graph_connect(g, time_id, 0, phase_id, 0);
+    graph_connect(g, hz_id, 0, phase_id, 1);
+
+    graph_alloc_node(g, NODE_TYPE_SIN, &sin_id);
+    graph_set_param(g, sin_id, 0, 1.0f);
+    graph_set_param(g, sin_id, 1, 1.0f);
+    graph_connect(g, phase_id, 0, sin_id, 0);
+
+    graph_alloc_node(g, NODE_TYPE_LFO, &lfo_id);
+    graph_set_param(g, lfo_id, 0, 3.0f);
+    graph_alloc_node(g, NODE_TYPE_MUL, &trem_id);
+    graph_connect(g, sin_id, 0, trem_id, 0);
+    graph_connect(g, lfo_id, 1, trem_id, 1);
+
+    graph_alloc_node(g, NODE_TYPE_NOISE, &noise_id);
+    graph_set_param(g, noise_id, 0, 50.0f);
+    graph_alloc_node(g, NODE_TYPE_CONST, &noise_amt_id);
+    graph_set_param(g, noise_amt_id, 0, 0.05f);
+    graph_alloc_node(g, NODE_TYPE_MUL, &noise_mul_id);
+    graph_connect(g, noise_id, 2, noise_mul_id, 0);
+    graph_connect(g, noise_amt_id, 0, noise_mul_id, 1);
+
+    graph_alloc_node(g, NODE_TYPE_ADD, &mix_id);
+    graph_connect(g, trem_id, 0, mix_id, 0);
+    graph_connect(g, noise_mul_id, 0, mix_id, 1);
+
+    graph_alloc_node(g, NODE_TYPE_CONST, &gain_id);
+    graph_set_param(g, gain_id, 0, 0.5f);
+    graph_alloc_node(g, NODE_TYPE_MUL, &gain_mul_id);
+    graph_connect(g, mix_id, 0, gain_mul_id, 0);
+    graph_connect(g, gain_id, 0, gain_mul_id, 1);
+
+    graph_alloc_node(g, NODE_TYPE_CLAMP, &clamp_id);
+    graph_set_param(g, clamp_id, 0, -1.0f);
+    graph_set_param(g, clamp_id, 1, 1.0f);
+    graph_connect(g, gain_mul_id, 0, clamp_id, 0);
+
+    return clamp_id;
+}
+
+/* ============================================================
+ * WAV Writer (16-bit PCM mono, little-endian)
+ * ============================================================ */
+static void write_u32le(FILE *f, uint32_t v)
+{
+    fputc((int)(v & 0xFF), f);
+    fputc((int)((v >> 8) & 0xFF), f);
+    fputc((int)((v >> 16) & 0xFF), f);
+    fputc((int)((v >> 24) & 0xFF), f);
+}
+
+static void write_u16le(FILE *f, uint16_t v)
+{
+    fputc((int)(v & 0xFF), f);
+    fputc((int)((v >> 8) & 0xFF), f);
+}
+
+static int write_wav(const char *path, const int16_t *pcm, uint32_t count, uint32_t rate)
+{
+    FILE *f = fopen(path, "wb");
+    uint32_t data_bytes = count * 2u;
+    uint32_t i;
+
+    if (!f) {
+        return -1;
+    }
+
+    fwrite("RIFF", 1, 4, f);
+    write_u32le(f, 36u + data_bytes);
+    fwrite("WAVE", 1, 4, f);
+    fwrite("fmt ", 1, 4, f);
+    write_u32le(f, 16u);           /* fmt chunk size */
+    write_u16le(f, 1u);            /* PCM */
+    write_u16le(f, 1u);            /* Mono */
+    write_u32le(f, rate);
+    write_u32le(f, rate * 2u);     /* Byte rate */
+    write_u16le(f, 2u);            /* Block align */
+    write_u16le(f, 16u);           /* Bits per sample */
+    fwrite("data", 1, 4, f);
+    write_u32le(f, data_bytes);
+
+    for (i = 0; i < count; i++) {
+        write_u16le(f, (uint16_t)pcm[i]);
+    }
+
+    fclose(f);
+    return 0;
+}
+
+static int16_t to_pcm16(float v)
+{
+    v = LGS_CLAMP(v, -1.0f, 1.0f);
+    return (int16_t)(v * 32767.0f);
+}
+
+/* ============================================================
+ * Output Selection
+ * ============================================================ */
+static NodeId pick_output_node(const Graph *g, const EvalPlan *plan)
+{
+    uint16_t i;
+
+    for (i = 0; i < plan->count; i++) {
+        if (g->nodes[plan->order[i]].type == NODE_TYPE_DEBUG) {
+            return plan->order[i];
+        }
+    }
+    return plan->count > 0 ? plan->order[plan->count - 1] : INVALID_NODE_ID;
+}
+
+/* ============================================================
+ * Render Passes
+ * ============================================================ */
+static double run_block(int16_t *pcm, uint32_t total, uint32_t rate,
+                        NodeId out_node, uint8_t out_port)
+{
+    RuntimeContext ctx;
+    uint32_t pos = 0;
+    double t0;
+
+    runtime_init(&ctx);
+    ctx.sample_dt = 1.0f / (float)rate;
+    graph_eval_block_init(&s_block_bank);
+
+    t0 = bench_now_seconds();
+    while (pos < total) {
+        uint32_t n = total - pos;
+        const float *out;
+        uint32_t i;
+
+        if (n > EVAL_BLOCK_SIZE) n = EVAL_BLOCK_SIZE;
+
+        /* Block start time from the sample index (no drift) */
+        ctx.time = (float)((double)pos / (double)rate);
+        ctx.dt = ctx.sample_dt * (float)n;
+        graph_eval_block(&s_graph, &s_plan, &s_block_bank, &ctx, n);
+
+        out = graph_eval_block_get_output(&s_block_bank, out_node, out_port);
+        for (i = 0; i < n; i++) {
+            pcm[pos + i] = to_pcm16(out[i]);
+        }
+        ctx.frame++;
+        pos += n;
+    }
+    return bench_now_seconds() - t0;
+}
+
+static double run_scalar(uint32_t total, uint32_t rate,
+                         NodeId out_node, uint8_t out_port)
+{
+    RuntimeContext ctx;
+    uint32_t pos;
+    double t0;
+    float acc = 0.0f;
+
+    runtime_init(&ctx);
+    ctx.dt = 1.0f / (float)rate;
+    graph_eval_init_outputs(&s_bank);
+
+    t0 = bench_now_seconds();
+    for (pos = 0; pos < total; pos++) {
+        ctx.time = (float)((double)pos / (double)rate);
+        graph_eval(&s_graph_scalar, &s_plan, &s_bank, &ctx);
+        acc += graph_eval_get_output(&s_bank, out_node, out_port);
+        ctx.frame++;
+    }
+    g_bench_sink = acc;
+    return bench_now_seconds() - t0;
+}
+
+/* ============================================================
+ * Main
+ * ============================================================ */
+int main(int argc, char **argv)
+{
+    const char *graph_path = NULL;
+    const char *out_path = "lgs_audio.wav";
+    float seconds = 10.0f;
+    uint32_t rate = 48000;
+    int node_arg = -1;
+    int port_arg = 0;
+    NodeId out_node;
+    uint32_t total;
+    int16_t *pcm;
+    double t_block, t_scalar;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            graph_path = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seconds = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            rate = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            node_arg = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            port_arg = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [-g graph.gph] [-o out.wav] [-s seconds] "
+                            "[-r rate] [-n node_id] [-p port]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (seconds <= 0.0f || rate < 1000 || port_arg < 0 || port_arg >= MAX_OUT_PORTS) {
+        fprintf(stderr, "Invalid seconds/rate/port\n");
+        return 1;
+    }
+
+    node_registry_init();
+
+    if (graph_path) {
+        GraphIoResult r = graph_io_load(graph_path, &s_graph, NULL);
+        if (r != GRAPH_IO_OK) {
+            fprintf(stderr, "Failed to load %s: %s\n", graph_path, graph_io_result_str(r));
+            return 1;
+        }
+        out_node = INVALID_NODE_ID;
+    } else {
+        out_node = build_default_patch(&s_graph);
+    }
+
+    if (graph_build_eval_order(&s_graph, &s_plan) != STATUS_OK) {
+        fprintf(stderr, "Graph has a cycle or invalid connection\n");
+        return 1;
+    }
+
+    if (node_arg >= 0) {
+        out_node = (NodeId)node_arg;
+    } else if (out_node == INVALID_NODE_ID) {
+        out_node = pick_output_node(&s_graph, &s_plan);
+    }
+    if (!graph_node_is_valid(&s_graph, out_node)) {
+        fprintf(stderr, "No valid output node\n");
+        return 1;
+    }
+
+    graph_copy(&s_graph_scalar, &s_graph);
+
+    total = (uint32_t)(seconds * (float)rate);
+    pcm = (int16_t *)malloc(sizeof(int16_t) * total);
+    if (!pcm) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    t_block = run_block(pcm, total, rate, out_node, (uint8_t)port_arg);
+    t_scalar = run_scalar(total, rate, out_node, (uint8_t)port_arg);
+
+    if (write_wav(out_path, pcm, total, rate) != 0) {
+        fprintf(stderr, "Failed to write %s\n", out_path);
+        free(pcm);
+        return 1;
+    }
+
+    printf("graph:  %s (%u nodes, output node %u port %d)\n",
+           graph_path ? graph_path : "built-in", (unsigned)s_plan.count,
+           (unsigned)out_node, port_arg);
+    printf("wrote:  %s (%u samples @ %u Hz)\n", out_path, (unsigned)total, (unsigned)rate);
+    printf("block  (K=%d): %12.0f samples/s (%.1fx realtime)\n", EVAL_BLOCK_SIZE,
+           (double)total / t_block, (double)total / t_block / (double)rate);
+    printf("scalar (K=1):  %12.0f samples/s (%.1fx realtime)\n",
+           (double)total / t_scalar, (double)total / t_scalar / (double)rate);
+
+    free(pcm);
+    return 0;
+}
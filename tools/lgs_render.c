@@ -0,0 +1,782 @@
+/*
+ * PS2 Live Graph Studio - Offline Renderer (host)
+ * lgs_render.c - Render a graph headless at any resolution and
+ *                export the frames
+ *
+ * Loads a .gph, runs the runtime on a synthetic clock (fixed dt, no
+ * vsync) for N frames as fast as possible, drawing the graph's sinks
+ * through render.h with the software backend. A graph with a FRAG_OUT
+ * node is shaded per pixel first (render_fragment) and its other sinks
+ * are drawn on top of that image. Finished frames are
+ * copied into a bounded queue; a writer thread encodes them and does
+ * all disk I/O, so evaluation only waits when the queue is full.
+ *
+ * Build:
+ *   cc -O2 -std=c99 -Isrc -o tools/lgs_render tools/lgs_render.c \
+ *      src/render/render.c src/render/render_soft.c src/render/soft_raster.c \
+ *      src/render/soft_tiles.c src/render/soft_pool.c src/render/soft_scale.c \
+ *      src/render/display_list.c src/render/circle_lut.c src/render/font.c \
+ *      src/render/text_fmt.c src/render/render_sinks.c src/render/render_fragment.c \
+ *      src/graph/graph_core.c src/graph/graph_validate.c src/graph/graph_eval.c \
+ *      src/graph/graph_probe.c src/graph/graph_eval_block.c src/graph/graph_eval_fragment.c \
+ *      src/nodes/node_registry.c src/nodes/node_basic.c src/nodes/node_extended.c \
+ *      src/nodes/node_particles.c src/nodes/node_fragment.c src/nodes/node_block.c \
+ *      src/runtime/runtime.c src/io/graph_io.c src/system/profiler.c -lm -pthread
+ *
+ * Add -DLGS_FRAME_PROFILER for -T, which writes the stage zones of
+ * the render loop and writer thread as Chrome trace-event JSON.
+ *
+ * Usage:
+ *   lgs_render [-g graph.gph] [-n frames] [-W width] [-H height]
+ *              [-r fps] [-o output] [-q queue_depth] [-t threads]
+ *              [-s divisor] [-f nearest|bilinear] [-S] [-T trace.json]
+ *
+ * The output format follows the -o name:
+ *   out.y4m                 one YUV4MPEG2 stream (4:2:0, BT.601)
+ *   frames/f_%05d.ppm       numbered binary PPM files
+ *   frames/f_%05d.png       numbered PNG files (stored, uncompressed)
+ * Without -o frames are rendered and discarded (throughput only).
+ * -t sets software rasterizer threads (tile-binned when > 1) and
+ * fragment shading threads.
+ * -s draws (and shades) at 1/divisor of the output size and upscales
+ * with the -f filter in render_end_frame.
+ * -S sweeps the quality levels instead (full size, then 1/2 and 1/4
+ * with each filter), reports ms/frame for each and picks the sharpest
+ * level that fits the -r frame budget. Nothing is written.
+ */
+
+#include "bench_common.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/common.h"
+#include "../src/graph/graph_core.h"
+#include "../src/graph/graph_validate.h"
+#include "../src/graph/graph_eval.h"
+#include "../src/graph/graph_eval_fragment.h"
+#include "../src/nodes/node_registry.h"
+#include "../src/runtime/runtime.h"
+#include "../src/io/graph_io.h"
+#include "../src/render/render.h"
+#include "../src/render/render_backend.h"
+#include "../src/render/render_soft.h"
+#include "../src/render/render_sinks.h"
+#include "../src/render/render_fragment.h"
+#include "../src/system/profiler.h"
+
+#define RENDER_QUEUE_MAX    16
+#define RENDER_PATH_MAX     512
+
+typedef enum {
+    OUT_NONE = 0,
+    OUT_Y4M,
+    OUT_PPM,
+    OUT_PNG
+} OutFormat;
+
+static Graph      s_graph;
+static EvalPlan   s_plan;
+static EvalPlan   s_frame_plan;     /* s_plan for the frame pass (fragment guards dropped) */
+static OutputBank s_bank;
+static FragmentPlan s_frag;
+
+/* Quality levels for -S, sharpest first */
+static const struct {
+    int          divisor;
+    RenderFilter filter;
+} s_levels[] = {
+    { 1, RENDER_FILTER_NEAREST },
+    { 2, RENDER_FILTER_BILINEAR },
+    { 2, RENDER_FILTER_NEAREST },
+    { 4, RENDER_FILTER_BILINEAR },
+    { 4, RENDER_FILTER_NEAREST }
+};
+
+/* ============================================================
+ * Frame Queue (single producer, single consumer)
+ * ============================================================
+ * slots[] are preallocated frame copies. The renderer fills
+ * slots[tail] only while count < depth; the writer encodes
+ * slots[head] outside the lock and releases it afterwards.
+ * ============================================================ */
+typedef struct {
+    uint32_t       *slots[RENDER_QUEUE_MAX];
+    uint32_t        index[RENDER_QUEUE_MAX];    /* Frame number per slot */
+    int             depth;
+    int             head;
+    int             tail;
+    int             count;
+    int             closed;
+    pthread_mutex_t lock;
+    pthread_cond_t  not_empty;
+    pthread_cond_t  not_full;
+} FrameQueue;
+
+typedef struct {
+    FrameQueue  queue;
+    OutFormat   format;
+    const char *path;
+    int         width;
+    int         height;
+    int         fps;
+    FILE       *stream;         /* Y4M */
+    uint8_t    *scratch;        /* Encoded frame (YUV planes / RGB rows) */
+    uint64_t    bytes;
+    int         failed;
+} FrameWriter;
+
+/* ============================================================
+ * Encoders
+ * ============================================================ */
+
+/* BT.601 limited range, integer fixed point */
+static uint8_t rgb_to_y(int r, int g, int b)
+{
+    return (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+static uint8_t rgb_to_u(int r, int g, int b)
+{
+    return (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+static uint8_t rgb_to_v(int r, int g, int b)
+{
+    return (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+/* One Y4M frame: full-res Y, chroma averaged over 2x2 blocks */
+static size_t encode_yuv420(uint8_t *out, const uint32_t *px, int w, int h)
+{
+    int cw = (w + 1) / 2;
+    int ch = (h + 1) / 2;
+    uint8_t *yp = out;
+    uint8_t *up = out + (size_t)w * h;
+    uint8_t *vp = up + (size_t)cw * ch;
+    int x, y;
+
+    for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+            uint32_t c = px[(size_t)y * w + x];
+            yp[(size_t)y * w + x] = rgb_to_y((int)(c & 0xFF), (int)((c >> 8) & 0xFF),
+                                             (int)((c >> 16) & 0xFF));
+        }
+    }
+
+    for (y = 0; y < ch; y++) {
+        for (x = 0; x < cw; x++) {
+            int r = 0, g = 0, b = 0, n = 0;
+            int dx, dy;
+            for (dy = 0; dy < 2; dy++) {
+                for (dx = 0; dx < 2; dx++) {
+                    int sx = x * 2 + dx, sy = y * 2 + dy;
+                    if (sx < w && sy < h) {
+                        uint32_t c = px[(size_t)sy * w + sx];
+                        r += (int)(c & 0xFF);
+                        g += (int)((c >> 8) & 0xFF);
+                        b += (int)((c >> 16) & 0xFF);
+                        n++;
+                    }
+                }
+            }
+            r /= n;
+            g /= n;
+            b /= n;
+            up[(size_t)y * cw + x] = rgb_to_u(r, g, b);
+            vp[(size_t)y * cw + x] = rgb_to_v(r, g, b);
+        }
+    }
+    return (size_t)w * h + 2 * (size_t)cw * ch;
+}
+
+/* Packed RGB rows; with png_filter each row gets a leading 0 byte */
+static size_t encode_rgb(uint8_t *out, const uint32_t *px, int w, int h, int png_filter)
+{
+    uint8_t *p = out;
+    int x, y;
+
+    for (y = 0; y < h; y++) {
+        if (png_filter) {
+            *p++ = 0;
+        }
+        for (x = 0; x < w; x++) {
+            uint32_t c = px[(size_t)y * w + x];
+            *p++ = (uint8_t)(c & 0xFF);
+            *p++ = (uint8_t)((c >> 8) & 0xFF);
+            *p++ = (uint8_t)((c >> 16) & 0xFF);
+        }
+    }
+    return (size_t)(p - out);
+}
+
+/* ============================================================
+ * PNG (zlib stored blocks, no compression)
+ * ============================================================ */
+static uint32_t s_crc_table[256];
+
+static void crc_init(void)
+{
+    uint32_t n;
+    int k;
+
+    for (n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        s_crc_table[n] = c;
+    }
+}
+
+static uint32_t crc_update(uint32_t crc, const uint8_t *p, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++) {
+        crc = s_crc_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static void put_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static int png_chunk(FILE *f, const char *type, const uint8_t *data, size_t n)
+{
+    uint8_t hdr[8];
+    uint8_t tail[4];
+    uint32_t crc;
+
+    put_be32(hdr, (uint32_t)n);
+    memcpy(hdr + 4, type, 4);
+    crc = crc_update(0xFFFFFFFFu, hdr + 4, 4);
+    crc = crc_update(crc, data, n);
+    put_be32(tail, crc ^ 0xFFFFFFFFu);
+
+    return (fwrite(hdr, 1, 8, f) == 8 &&
+            (n == 0 || fwrite(data, 1, n, f) == n) &&
+            fwrite(tail, 1, 4, f) == 4) ? 0 : -1;
+}
+
+static int write_png(FILE *f, const uint8_t *raw, size_t raw_len, int w, int h,
+                     uint8_t *zbuf)
+{
+    static const uint8_t sig[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    uint8_t ihdr[13];
+    uint32_t s1 = 1, s2 = 0;
+    size_t pos = 0, z = 0;
+
+    put_be32(ihdr, (uint32_t)w);
+    put_be32(ihdr + 4, (uint32_t)h);
+    ihdr[8] = 8;        /* Bit depth */
+    ihdr[9] = 2;        /* RGB */
+    ihdr[10] = 0;
+    ihdr[11] = 0;
+    ihdr[12] = 0;
+
+    /* zlib header, stored blocks of up to 65535 bytes, Adler-32 */
+    zbuf[z++] = 0x78;
+    zbuf[z++] = 0x01;
+    while (pos < raw_len || raw_len == 0) {
+        size_t n = raw_len - pos > 65535 ? 65535 : raw_len - pos;
+        size_t i;
+
+        zbuf[z++] = (uint8_t)(pos + n >= raw_len ? 1 : 0);
+        zbuf[z++] = (uint8_t)(n & 0xFF);
+        zbuf[z++] = (uint8_t)(n >> 8);
+        zbuf[z++] = (uint8_t)(~n & 0xFF);
+        zbuf[z++] = (uint8_t)((~n >> 8) & 0xFF);
+        memcpy(zbuf + z, raw + pos, n);
+        z += n;
+        for (i = 0; i < n; i++) {
+            s1 = (s1 + raw[pos + i]) % 65521u;
+            s2 = (s2 + s1) % 65521u;
+        }
+        pos += n;
+        if (raw_len == 0) {
+            break;
+        }
+    }
+    put_be32(zbuf + z, (s2 << 16) | s1);
+    z += 4;
+
+    if (fwrite(sig, 1, 8, f) != 8 ||
+        png_chunk(f, "IHDR", ihdr, sizeof(ihdr)) != 0 ||
+        png_chunk(f, "IDAT", zbuf, z) != 0 ||
+        png_chunk(f, "IEND", NULL, 0) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/* ============================================================
+ * Writer Thread
+ * ============================================================ */
+static int write_frame(FrameWriter *w, const uint32_t *px, uint32_t index)
+{
+    size_t raw_len;
+    char path[RENDER_PATH_MAX];
+    FILE *f;
+    int ok;
+
+    if (w->format == OUT_Y4M) {
+        raw_len = encode_yuv420(w->scratch, px, w->width, w->height);
+        ok = fwrite("FRAME\n", 1, 6, w->stream) == 6 &&
+             fwrite(w->scratch, 1, raw_len, w->stream) == raw_len;
+        w->bytes += raw_len + 6;
+        return ok ? 0 : -1;
+    }
+
+    snprintf(path, sizeof(path), w->path, (unsigned)index);
+    f = fopen(path, "wb");
+    if (!f) {
+        return -1;
+    }
+
+    if (w->format == OUT_PPM) {
+        raw_len = encode_rgb(w->scratch, px, w->width, w->height, 0);
+        ok = fprintf(f, "P6\n%d %d\n255\n", w->width, w->height) > 0 &&
+             fwrite(w->scratch, 1, raw_len, f) == raw_len;
+    } else {
+        /* Filtered rows first, zlib stream after them in scratch */
+        raw_len = encode_rgb(w->scratch, px, w->width, w->height, 1);
+        ok = write_png(f, w->scratch, raw_len, w->width, w->height,
+                       w->scratch + raw_len) == 0;
+    }
+    w->bytes += (uint64_t)ftell(f);
+    return (fclose(f) == 0 && ok) ? 0 : -1;
+}
+
+static void *writer_main(void *arg)
+{
+    FrameWriter *w = (FrameWriter *)arg;
+    FrameQueue *q = &w->queue;
+
+#ifdef LGS_FRAME_PROFILER
+    profiler_register_thread("writer");
+#endif
+    for (;;) {
+        int slot;
+
+        pthread_mutex_lock(&q->lock);
+        while (q->count == 0 && !q->closed) {
+            pthread_cond_wait(&q->not_empty, &q->lock);
+        }
+        if (q->count == 0) {
+            pthread_mutex_unlock(&q->lock);
+            return NULL;
+        }
+        slot = q->head;
+        pthread_mutex_unlock(&q->lock);
+
+        LGS_PROF_BEGIN(PROF_ZONE_WRITE);
+        if (!w->failed && write_frame(w, q->slots[slot], q->index[slot]) != 0) {
+            w->failed = 1;
+        }
+        LGS_PROF_END(PROF_ZONE_WRITE);
+
+        pthread_mutex_lock(&q->lock);
+        q->head = (q->head + 1) % q->depth;
+        q->count--;
+        pthread_cond_signal(&q->not_full);
+        pthread_mutex_unlock(&q->lock);
+    }
+}
+
+/* Copy a finished frame into the queue; returns seconds spent waiting */
+static double queue_push(FrameQueue *q, const uint32_t *px, size_t bytes, uint32_t index)
+{
+    double waited = 0.0;
+
+    pthread_mutex_lock(&q->lock);
+    if (q->count == q->depth) {
+        double t0 = bench_now_seconds();
+        while (q->count == q->depth) {
+            pthread_cond_wait(&q->not_full, &q->lock);
+        }
+        waited = bench_now_seconds() - t0;
+    }
+    pthread_mutex_unlock(&q->lock);
+
+    /* Writer never touches slots[tail] while count < depth */
+    memcpy(q->slots[q->tail], px, bytes);
+    q->index[q->tail] = index;
+
+    pthread_mutex_lock(&q->lock);
+    q->tail = (q->tail + 1) % q->depth;
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+    return waited;
+}
+
+static int writer_open(FrameWriter *w, pthread_t *thread)
+{
+    size_t frame_bytes = (size_t)w->width * w->height * 4;
+    size_t raw_rgb = ((size_t)w->width * 3 + 1) * w->height;
+    /* PNG: filtered rows + stored zlib stream (5 bytes per 64KB block) */
+    size_t scratch = raw_rgb * 2 + (raw_rgb / 65535 + 1) * 5 + 16;
+    FrameQueue *q = &w->queue;
+    int i;
+
+    w->scratch = (uint8_t *)malloc(scratch);
+    if (!w->scratch) {
+        return -1;
+    }
+    for (i = 0; i < q->depth; i++) {
+        q->slots[i] = (uint32_t *)malloc(frame_bytes);
+        if (!q->slots[i]) {
+            return -1;
+        }
+    }
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+
+    if (w->format == OUT_Y4M) {
+        w->stream = fopen(w->path, "wb");
+        if (!w->stream) {
+            return -1;
+        }
+        fprintf(w->stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n",
+                w->width, w->height, w->fps);
+    }
+    crc_init();
+
+    return pthread_create(thread, NULL, writer_main, w) == 0 ? 0 : -1;
+}
+
+static void writer_close(FrameWriter *w, pthread_t thread)
+{
+    FrameQueue *q = &w->queue;
+    int i;
+
+    pthread_mutex_lock(&q->lock);
+    q->closed = 1;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+    pthread_join(thread, NULL);
+
+    if (w->stream && fclose(w->stream) != 0) {
+        w->failed = 1;
+    }
+    for (i = 0; i < q->depth; i++) {
+        free(q->slots[i]);
+    }
+    free(w->scratch);
+    pthread_cond_destroy(&q->not_full);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_mutex_destroy(&q->lock);
+}
+
+static OutFormat format_from_path(const char *path)
+{
+    size_t n = strlen(path);
+
+    if (n >= 4 && strcmp(path + n - 4, ".y4m") == 0) return OUT_Y4M;
+    if (n >= 4 && strcmp(path + n - 4, ".ppm") == 0) return OUT_PPM;
+    if (n >= 4 && strcmp(path + n - 4, ".png") == 0) return OUT_PNG;
+    return OUT_NONE;
+}
+
+static const char *filter_name(RenderFilter filter)
+{
+    return filter == RENDER_FILTER_BILINEAR ? "bilinear" : "nearest";
+}
+
+/* ============================================================
+ * Render Loop
+ * ============================================================
+ * Runs the graph for frames frames on a synthetic clock (time from
+ * the frame index, no drift). Returns seconds spent, with the time
+ * spent waiting on a full queue reported in *stall.
+ * ============================================================ */
+static double render_frames(int frames, int fps, FragmentRenderer *fragment,
+                            FrameWriter *writer, double *stall)
+{
+    RuntimeContext ctx;
+    double t0;
+    int i;
+
+    runtime_init(&ctx);
+    ctx.dt = 1.0f / (float)fps;
+    *stall = 0.0;
+
+    t0 = bench_now_seconds();
+    for (i = 0; i < frames; i++) {
+        LGS_PROF_FRAME_BEGIN();
+        ctx.time = (float)((double)i / (double)fps);
+        ctx.frame = (uint32_t)i;
+        LGS_PROF_BEGIN(PROF_ZONE_EVAL);
+        graph_eval(&s_graph, &s_frame_plan, &s_bank, &ctx);
+        LGS_PROF_END(PROF_ZONE_EVAL);
+
+        /* Draw target is only resized by render_begin_frame */
+        LGS_PROF_BEGIN(PROF_ZONE_RENDER);
+        render_begin_frame();
+        if (fragment) {
+            render_fragment(fragment, &s_graph, &s_frag, &s_bank, &ctx,
+                            render_soft_draw_target());
+        } else {
+            render_clear(RENDER_COLOR(20, 20, 30, 128));
+        }
+        LGS_PROF_BEGIN(PROF_ZONE_SINKS);
+        render_sinks(&s_graph, &s_plan, &s_bank);
+        LGS_PROF_END(PROF_ZONE_SINKS);
+        LGS_PROF_END(PROF_ZONE_RENDER);
+        LGS_PROF_BEGIN(PROF_ZONE_FLIP);
+        render_end_frame();
+        LGS_PROF_END(PROF_ZONE_FLIP);
+
+        if (writer && writer->format != OUT_NONE) {
+            const SoftTarget *out = render_soft_target();
+            LGS_PROF_BEGIN(PROF_ZONE_QUEUE);
+            *stall += queue_push(&writer->queue, out->pixels,
+                                 (size_t)out->width * out->height * sizeof(uint32_t),
+                                 (uint32_t)i);
+            LGS_PROF_END(PROF_ZONE_QUEUE);
+        }
+        LGS_PROF_FRAME_END();
+    }
+    return bench_now_seconds() - t0;
+}
+
+/* Time every quality level; prints one row each and the pick */
+static int sweep_levels(int frames, int fps, FragmentRenderer *fragment)
+{
+    double budget = 1000.0 / fps;
+    int pick = -1;
+    size_t l;
+
+    printf("quality sweep (%d frames per level, %.2f ms budget at %d fps):\n",
+           frames, budget, fps);
+    for (l = 0; l < sizeof(s_levels) / sizeof(s_levels[0]); l++) {
+        double stall, ms;
+
+        if (render_set_scale(s_levels[l].divisor, s_levels[l].filter) != 0) {
+            fprintf(stderr, "render_set_scale(%d) failed\n", s_levels[l].divisor);
+            return -1;
+        }
+        ms = render_frames(frames, fps, fragment, NULL, &stall) * 1000.0 / frames;
+        if (pick < 0 && ms <= budget) {
+            pick = (int)l;
+        }
+        printf("  1/%d %-8s  %4dx%-4d  %8.2f ms/frame  %8.1f frames/s%s\n",
+               s_levels[l].divisor, filter_name(s_levels[l].filter),
+               render_soft_draw_target()->width, render_soft_draw_target()->height,
+               ms, 1000.0 / ms, ms <= budget ? "" : "  (over budget)");
+    }
+    if (pick >= 0) {
+        printf("pick:    -s %d -f %s\n", s_levels[pick].divisor,
+               filter_name(s_levels[pick].filter));
+    } else {
+        printf("pick:    none fits %d fps (lower -r or the output size)\n", fps);
+    }
+    return 0;
+}
+
+/* ============================================================
+ * Main
+ * ============================================================ */
+int main(int argc, char **argv)
+{
+    const char *graph_path = "assets/graphs/default.gph";
+    const char *out_path = NULL;
+    const char *trace_path = NULL;
+    int frames = 300;
+    int width = RENDER_SCREEN_WIDTH;
+    int height = RENDER_SCREEN_HEIGHT;
+    int fps = 60;
+    int depth = 4;
+    int threads = 1;
+    int scale = 1;
+    int sweep = 0;
+    RenderFilter filter = RENDER_FILTER_NEAREST;
+    FrameWriter writer;
+    FragmentRenderer fragment;
+    int has_fragment;
+    pthread_t writer_thread;
+    GraphIoResult io;
+    Status st;
+    double t0, t_render, t_total, t_stall = 0.0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            graph_path = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-W") == 0 && i + 1 < argc) {
+            width = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-H") == 0 && i + 1 < argc) {
+            height = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            fps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-q") == 0 && i + 1 < argc) {
+            depth = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            scale = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "nearest") == 0) {
+                filter = RENDER_FILTER_NEAREST;
+            } else if (strcmp(argv[i], "bilinear") == 0) {
+                filter = RENDER_FILTER_BILINEAR;
+            } else {
+                fprintf(stderr, "Unknown filter: %s (nearest or bilinear)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-S") == 0) {
+            sweep = 1;
+        } else if (strcmp(argv[i], "-T") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [-g graph.gph] [-n frames] [-W width] [-H height]\n"
+                            "       [-r fps] [-o out.y4m|f_%%05d.ppm|f_%%05d.png] "
+                            "[-q queue_depth] [-t threads]\n"
+                            "       [-s divisor] [-f nearest|bilinear] [-S] [-T trace.json]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    memset(&writer, 0, sizeof(writer));
+    writer.format = out_path ? format_from_path(out_path) : OUT_NONE;
+    if (out_path && writer.format == OUT_NONE) {
+        fprintf(stderr, "Unknown output format (use .y4m, .ppm or .png): %s\n", out_path);
+        return 1;
+    }
+    if (frames < 1 || fps < 1 || depth < 1 || depth > RENDER_QUEUE_MAX) {
+        fprintf(stderr, "Invalid frames/fps/queue depth (queue 1..%d)\n", RENDER_QUEUE_MAX);
+        return 1;
+    }
+#ifdef LGS_FRAME_PROFILER
+    profiler_init();
+#else
+    if (trace_path) {
+        fprintf(stderr, "-T needs a build with -DLGS_FRAME_PROFILER\n");
+        return 1;
+    }
+#endif
+
+    /* Graph */
+    node_registry_init();
+    io = graph_io_load(graph_path, &s_graph, NULL);
+    if (io != GRAPH_IO_OK) {
+        fprintf(stderr, "Failed to load %s: %s\n", graph_path, graph_io_result_str(io));
+        return 1;
+    }
+    st = graph_build_eval_plan(&s_graph, &s_plan);
+    if (st != STATUS_OK) {
+        fprintf(stderr, "%s\n", st == STATUS_ERR_NO_SINK ? "Graph has no sink node" :
+                                "Graph has a cycle or invalid connection");
+        return 1;
+    }
+    graph_eval_init_outputs(&s_bank);
+
+    st = graph_build_fragment_plan(&s_graph, &s_plan, &s_frag);
+    if (st == STATUS_ERR_VALIDATION_FAIL) {
+        fprintf(stderr, "FRAG_OUT depends on a stateful node (per-pixel nodes must be stateless)\n");
+        return 1;
+    }
+    has_fragment = (st == STATUS_OK);
+    if (has_fragment) {
+        graph_fragment_uniform_plan(&s_frag, &s_plan, &s_frame_plan);
+    } else {
+        s_frame_plan = s_plan;
+    }
+
+    /* Renderer */
+    if (render_set_resolution(width, height) != 0 || render_soft_set_threads(threads) != 0 ||
+        render_set_backend(render_backend_soft()) != 0 || render_init() != 0) {
+        fprintf(stderr, "Render init failed (%dx%d, %d threads)\n", width, height, threads);
+        return 1;
+    }
+    if (render_set_scale(scale, filter) != 0) {
+        fprintf(stderr, "Invalid scale divisor %d (1..%d)\n", scale, RENDER_SCALE_MAX);
+        return 1;
+    }
+    if (has_fragment && render_fragment_init(&fragment, threads) != 0) {
+        fprintf(stderr, "Fragment renderer init failed (%d threads)\n", threads);
+        return 1;
+    }
+
+    printf("graph:   %s (%u nodes, %u sinks)\n", graph_path,
+           (unsigned)s_plan.count, (unsigned)s_plan.sink_count);
+    if (has_fragment) {
+        printf("shader:  %u per-pixel nodes, %u uniforms\n",
+               (unsigned)s_frag.count, (unsigned)s_frag.uniform_count);
+    }
+
+    if (sweep) {
+        int rc = sweep_levels(frames, fps, has_fragment ? &fragment : NULL);
+
+        if (has_fragment) {
+            render_fragment_shutdown(&fragment);
+        }
+        render_shutdown();
+        return rc == 0 ? 0 : 1;
+    }
+
+    /* Writer */
+    if (writer.format != OUT_NONE) {
+        writer.queue.depth = depth;
+        writer.path = out_path;
+        writer.width = width;
+        writer.height = height;
+        writer.fps = fps;
+        if (writer_open(&writer, &writer_thread) != 0) {
+            fprintf(stderr, "Failed to open output %s\n", out_path);
+            return 1;
+        }
+    }
+
+    t0 = bench_now_seconds();
+    t_render = render_frames(frames, fps, has_fragment ? &fragment : NULL,
+                             &writer, &t_stall);
+
+    if (writer.format != OUT_NONE) {
+        writer_close(&writer, writer_thread);
+    }
+    t_total = bench_now_seconds() - t0;
+    if (has_fragment) {
+        render_fragment_shutdown(&fragment);
+    }
+    render_shutdown();
+
+    printf("frames:  %d at %dx%d (drawn at 1/%d, %s), %d fps clock, %d raster thread%s\n",
+           frames, width, height, scale, filter_name(filter), fps, threads,
+           threads == 1 ? "" : "s");
+    printf("render:  %10.1f frames/s (%.2f ms/frame, %.2f s stalled on a full queue)\n",
+           (double)frames / (t_render - t_stall), (t_render - t_stall) * 1000.0 / frames,
+           t_stall);
+    printf("total:   %10.1f frames/s (%.2f s wall, including writer drain)\n",
+           (double)frames / t_total, t_total);
+#ifdef LGS_FRAME_PROFILER
+    if (trace_path) {
+        if (profiler_export_chrome(trace_path, (uint32_t)frames) != 0) {
+            fprintf(stderr, "Failed to write %s\n", trace_path);
+            return 1;
+        }
+        printf("trace:   %s\n", trace_path);
+    }
+#endif
+    if (writer.format != OUT_NONE) {
+        printf("wrote:   %s (%.1f MB)\n", out_path, (double)writer.bytes / (1024.0 * 1024.0));
+        if (writer.failed) {
+            fprintf(stderr, "Write error on %s\n", out_path);
+            return 1;
+        }
+    }
+    return 0;
+}
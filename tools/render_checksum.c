@@ -0,0 +1,195 @@
+/*
+ * PS2 Live Graph Studio - Render Checksum (host)
+ * render_checksum.c - Pixel-exact regression check for the render layer
+ *
+ * Draws a fixed scene through render.h and font.h (rects, outlines,
+ * lines, triangles, filled and outline circles, opaque and alpha
+ * layers, text) with the software backend, then prints an FNV-1a
+ * checksum of the framebuffer. The rasterizer is integer-exact, so
+ * the checksum only changes when rendering does.
+ *
+ * Usage:
+ *   render_checksum [--threads N] [--scale N [--bilinear]] [--ppm out.ppm]
+ *                   [--expect HEX]
+ *   --threads uses the tile-binned rasterizer (same checksum).
+ *   --scale draws at 1/N size and upscales (nearest unless
+ *   --bilinear); each setting has its own checksum, which must not
+ *   change with --threads.
+ *   --expect exits 1 when the checksum differs.
+ *
+ * Build (add -DSOFT_RASTER_NO_SIMD for the scalar path; the
+ * checksum must match):
+ *   cc -O2 -std=c99 -Isrc -o tools/render_checksum tools/render_checksum.c \
+ *      src/render/render.c src/render/render_soft.c src/render/soft_raster.c \
+ *      src/render/soft_tiles.c src/render/soft_pool.c src/render/soft_scale.c \
+ *      src/render/display_list.c src/render/circle_lut.c src/render/font.c \
+ *      src/render/text_fmt.c -lm -pthread
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/render/render.h"
+#include "../src/render/render_backend.h"
+#include "../src/render/render_soft.h"
+#include "../src/render/font.h"
+
+/* ============================================================
+ * Scene
+ * ============================================================ */
+static void draw_scene(void)
+{
+    int i;
+
+    render_begin_frame();
+    render_clear(RENDER_COLOR(16, 16, 32, 128));
+
+    /* Scene layer: opaque shapes */
+    render_set_layer(DL_LAYER_SCENE);
+    render_rect(0.05f, 0.05f, 0.30f, 0.20f, RENDER_COLOR_RED);
+    render_rect_outline(0.05f, 0.30f, 0.30f, 0.20f, RENDER_COLOR_YELLOW);
+    render_circle_filled(0.60f, 0.25f, 0.12f, RENDER_COLOR_BLUE, RENDER_CIRCLE_SEGMENTS_AUTO);
+    render_circle_filled(0.85f, 0.20f, 0.01f, RENDER_COLOR_WHITE, 6);
+    render_circle(0.60f, 0.25f, 0.15f, RENDER_COLOR_CYAN, RENDER_CIRCLE_SEGMENTS_AUTO);
+    render_triangle_screen(20, 300, 200, 260, 120, 460, RENDER_COLOR_GREEN);
+    render_triangle_screen(200, 260, 300, 420, 120, 460, RENDER_COLOR_MAGENTA);
+    for (i = 0; i < 16; i++) {
+        render_line_screen(320, 240, 320 + (i - 8) * 37, 470, RENDER_COLOR_GRAY);
+    }
+
+    /* Particle layer: overlapping alpha shapes */
+    render_set_layer(DL_LAYER_PARTICLES);
+    render_set_blend(DL_BLEND_ALPHA);
+    for (i = 0; i < 24; i++) {
+        float t = (float)i / 24.0f;
+        render_circle_filled(0.40f + t * 0.5f, 0.55f + t * 0.3f, 0.02f + t * 0.04f,
+                             RENDER_COLOR(255, (i * 10) & 0xFF, 64, 16 + i * 4),
+                             RENDER_CIRCLE_SEGMENTS_AUTO);
+    }
+    render_rect_screen(380, 40, 200, 80, RENDER_COLOR(0, 255, 0, 64));
+    render_set_blend(DL_BLEND_OPAQUE);
+
+    /* HUD layer: text */
+    render_set_layer(DL_LAYER_HUD);
+    font_draw_string_screen("LIVE GRAPH STUDIO", 16, 8, RENDER_COLOR_WHITE, 2);
+    font_draw_string_screen("0123456789 !?:.-+", 16, 460, RENDER_COLOR_YELLOW, 1);
+
+    render_end_frame();
+}
+
+/* ============================================================
+ * Output
+ * ============================================================ */
+static uint32_t checksum_target(const SoftTarget *t)
+{
+    uint32_t h = 2166136261u;
+    int x, y;
+
+    for (y = 0; y < t->height; y++) {
+        const uint32_t *row = t->pixels + (long)y * t->stride;
+        for (x = 0; x < t->width; x++) {
+            uint32_t p = row[x];
+            int b;
+            for (b = 0; b < 4; b++) {
+                h ^= (p >> (b * 8)) & 0xFF;
+                h *= 16777619u;
+            }
+        }
+    }
+    return h;
+}
+
+static int write_ppm(const char *path, const SoftTarget *t)
+{
+    FILE *f = fopen(path, "wb");
+    int x, y;
+
+    if (!f) {
+        return -1;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", t->width, t->height);
+    for (y = 0; y < t->height; y++) {
+        const uint32_t *row = t->pixels + (long)y * t->stride;
+        for (x = 0; x < t->width; x++) {
+            unsigned char rgb[3];
+            rgb[0] = (unsigned char)(row[x] & 0xFF);
+            rgb[1] = (unsigned char)((row[x] >> 8) & 0xFF);
+            rgb[2] = (unsigned char)((row[x] >> 16) & 0xFF);
+            fwrite(rgb, 1, 3, f);
+        }
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+/* ============================================================
+ * Main
+ * ============================================================ */
+int main(int argc, char **argv)
+{
+    const char *ppm_path = NULL;
+    const char *expect = NULL;
+    int threads = 1;
+    int scale = 1;
+    RenderFilter filter = RENDER_FILTER_NEAREST;
+    const SoftTarget *target;
+    uint32_t sum;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ppm") == 0 && i + 1 < argc) {
+            ppm_path = argv[++i];
+        } else if (strcmp(argv[i], "--expect") == 0 && i + 1 < argc) {
+            expect = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            scale = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bilinear") == 0) {
+            filter = RENDER_FILTER_BILINEAR;
+        } else {
+            fprintf(stderr, "usage: %s [--threads N] [--scale N [--bilinear]] [--ppm out.ppm]"
+                            " [--expect HEX]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (render_soft_set_threads(threads) != 0) {
+        fprintf(stderr, "bad thread count: %d\n", threads);
+        return 2;
+    }
+    if (render_set_backend(render_backend_soft()) != 0 || render_init() != 0 ||
+        font_init() != 0) {
+        fprintf(stderr, "render init failed\n");
+        return 2;
+    }
+    if (render_set_scale(scale, filter) != 0) {
+        fprintf(stderr, "bad scale: %d (1..%d)\n", scale, RENDER_SCALE_MAX);
+        return 2;
+    }
+
+    draw_scene();
+
+    target = render_soft_target();
+    sum = checksum_target(target);
+    printf("backend:  %s (%d thread%s, scale 1/%d %s)\n", render_get_backend()->name,
+           threads, threads == 1 ? "" : "s", render_get_scale(),
+           render_get_scale_filter() == RENDER_FILTER_BILINEAR ? "bilinear" : "nearest");
+    printf("prims:    %u in %u batches\n",
+           (unsigned)render_get_display_list()->stat_cmds,
+           (unsigned)render_get_display_list()->stat_batches);
+    printf("checksum: %08x\n", (unsigned)sum);
+
+    if (ppm_path && write_ppm(ppm_path, target) != 0) {
+        fprintf(stderr, "failed to write %s\n", ppm_path);
+        return 2;
+    }
+
+    font_shutdown();
+    render_shutdown();
+
+    if (expect && (uint32_t)strtoul(expect, NULL, 16) != sum) {
+        fprintf(stderr, "MISMATCH: expected %s\n", expect);
+        return 1;
+    }
+    return 0;
+}